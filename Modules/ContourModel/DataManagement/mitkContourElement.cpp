@@ -13,6 +13,266 @@ found in the LICENSE file.
 #include <mitkContourElement.h>
 #include <vtkMath.h>
 
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+  /** Squared distance of the point to the line segment v1-v2. Used by the brute force and the grid
+  search to get identical results. Degenerated segments yield NaN and are therefore never close.*/
+  double SquaredDistanceToSegment(const mitk::Point3D &point,
+                                  const mitk::Point3D &v1,
+                                  const mitk::Point3D &v2,
+                                  mitk::Point3D &crossPoint)
+  {
+    const float l2 = v1.SquaredEuclideanDistanceTo(v2);
+
+    mitk::Vector3D p_v1 = point - v1;
+    mitk::Vector3D v2_v1 = v2 - v1;
+
+    double tc = (p_v1 * v2_v1) / l2;
+
+    // take into account we have line segments and not (infinite) lines
+    if (tc < 0.0)
+    {
+      tc = 0.0;
+    }
+    if (tc > 1.0)
+    {
+      tc = 1.0;
+    }
+
+    crossPoint = v1 + v2_v1 * tc;
+
+    return point.SquaredEuclideanDistanceTo(crossPoint);
+  }
+}
+
+/** Uniform hash grid over the vertices and the line segments of a contour. Cells store the
+indices of the vertices resp. of the segments (segment i starts at vertex i and ends at
+vertex i+1, the last one wraps to the first vertex) in ascending order.*/
+class mitk::ContourElement::SpatialIndex
+{
+public:
+  using CellIndexType = std::array<long long, 3>;
+  using IndexListType = std::vector<VertexSizeType>;
+
+  explicit SpatialIndex(const VertexListType &vertices);
+
+  /** Collects the indices of all vertices that may be closer than radius to the point, in ascending order.*/
+  void GetVertexCandidates(const mitk::Point3D &point, double radius, IndexListType &candidates) const;
+
+  /** Collects the indices of all segments that may be closer than radius to the point, in ascending order.*/
+  void GetSegmentCandidates(const mitk::Point3D &point, double radius, IndexListType &candidates) const;
+
+private:
+  struct CellIndexHash
+  {
+    std::size_t operator()(const CellIndexType &index) const
+    {
+      return (static_cast<std::size_t>(index[0]) * 73856093u) ^ (static_cast<std::size_t>(index[1]) * 19349663u) ^
+             (static_cast<std::size_t>(index[2]) * 83492791u);
+    }
+  };
+
+  using CellMapType = std::unordered_map<CellIndexType, IndexListType, CellIndexHash>;
+
+  /** Desired mean number of vertices per occupied cell.*/
+  static constexpr double VerticesPerCell = 8.0;
+  /** Segments covering more cells are not sorted into the grid but always tested.*/
+  static constexpr long long MaximumCellsPerSegment = 64;
+
+  CellIndexType GetCellIndex(const mitk::Point3D &point) const;
+  void CollectCandidates(const mitk::Point3D &point, double radius, const CellMapType &cells, IndexListType &candidates) const;
+
+  double m_CellSize;
+  CellMapType m_VertexCells;
+  CellMapType m_SegmentCells;
+  IndexListType m_LargeSegments;
+};
+
+mitk::ContourElement::SpatialIndex::SpatialIndex(const VertexListType &vertices) : m_CellSize(1.0)
+{
+  const auto numberOfVertices = vertices.size();
+
+  double lengthSum = 0.0;
+  for (VertexSizeType i = 0; i < numberOfVertices; ++i)
+  {
+    lengthSum += vertices[i]->Coordinates.EuclideanDistanceTo(vertices[(i + 1) % numberOfVertices]->Coordinates);
+  }
+
+  const double meanLength = numberOfVertices > 0 ? lengthSum / numberOfVertices : 0.0;
+  if (std::isfinite(meanLength) && meanLength > 0.0)
+  {
+    m_CellSize = VerticesPerCell * meanLength;
+  }
+
+  for (VertexSizeType i = 0; i < numberOfVertices; ++i)
+  {
+    m_VertexCells[this->GetCellIndex(vertices[i]->Coordinates)].push_back(i);
+  }
+
+  for (VertexSizeType i = 0; i < numberOfVertices; ++i)
+  {
+    const auto &v1 = vertices[i]->Coordinates;
+    const auto &v2 = vertices[(i + 1) % numberOfVertices]->Coordinates;
+
+    const auto cell1 = this->GetCellIndex(v1);
+    const auto cell2 = this->GetCellIndex(v2);
+
+    CellIndexType lower;
+    CellIndexType upper;
+    long long numberOfCells = 1;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      lower[d] = std::min(cell1[d], cell2[d]);
+      upper[d] = std::max(cell1[d], cell2[d]);
+      numberOfCells *= upper[d] - lower[d] + 1;
+    }
+
+    if (numberOfCells > MaximumCellsPerSegment)
+    {
+      m_LargeSegments.push_back(i);
+      continue;
+    }
+
+    for (auto x = lower[0]; x <= upper[0]; ++x)
+      for (auto y = lower[1]; y <= upper[1]; ++y)
+        for (auto z = lower[2]; z <= upper[2]; ++z)
+          m_SegmentCells[{{x, y, z}}].push_back(i);
+  }
+}
+
+mitk::ContourElement::SpatialIndex::CellIndexType mitk::ContourElement::SpatialIndex::GetCellIndex(
+  const mitk::Point3D &point) const
+{
+  CellIndexType index;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    index[d] = static_cast<long long>(std::floor(point[d] / m_CellSize));
+  }
+  return index;
+}
+
+void mitk::ContourElement::SpatialIndex::CollectCandidates(const mitk::Point3D &point,
+                                                           double radius,
+                                                           const CellMapType &cells,
+                                                           IndexListType &candidates) const
+{
+  // small margin against rounding at the cell borders
+  const double extent = radius + 1e-6 * m_CellSize;
+
+  // the range is kept in floating point until it is known to be small, so huge or invalid queries cannot overflow
+  double lower[3];
+  double upper[3];
+  double numberOfCells = 1.0;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    lower[d] = std::floor((point[d] - extent) / m_CellSize);
+    upper[d] = std::floor((point[d] + extent) / m_CellSize);
+    numberOfCells *= upper[d] - lower[d] + 1.0;
+  }
+
+  if (!std::isfinite(numberOfCells))
+  {
+    // e.g. unbounded eps, every cell has to be checked
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      lower[d] = -std::numeric_limits<double>::infinity();
+      upper[d] = std::numeric_limits<double>::infinity();
+    }
+  }
+
+  if (numberOfCells <= static_cast<double>(cells.size()))
+  {
+    const auto lowerX = static_cast<long long>(lower[0]);
+    const auto lowerY = static_cast<long long>(lower[1]);
+    const auto lowerZ = static_cast<long long>(lower[2]);
+    const auto upperX = static_cast<long long>(upper[0]);
+    const auto upperY = static_cast<long long>(upper[1]);
+    const auto upperZ = static_cast<long long>(upper[2]);
+
+    for (auto x = lowerX; x <= upperX; ++x)
+      for (auto y = lowerY; y <= upperY; ++y)
+        for (auto z = lowerZ; z <= upperZ; ++z)
+        {
+          const auto finding = cells.find({{x, y, z}});
+          if (finding != cells.end())
+          {
+            candidates.insert(candidates.end(), finding->second.begin(), finding->second.end());
+          }
+        }
+  }
+  else
+  {
+    // the query range is larger than the occupied part of the grid
+    for (const auto &cell : cells)
+    {
+      if (lower[0] <= cell.first[0] && cell.first[0] <= upper[0] && lower[1] <= cell.first[1] &&
+          cell.first[1] <= upper[1] && lower[2] <= cell.first[2] && cell.first[2] <= upper[2])
+      {
+        candidates.insert(candidates.end(), cell.second.begin(), cell.second.end());
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+void mitk::ContourElement::SpatialIndex::GetVertexCandidates(const mitk::Point3D &point,
+                                                             double radius,
+                                                             IndexListType &candidates) const
+{
+  candidates.clear();
+  this->CollectCandidates(point, radius, m_VertexCells, candidates);
+}
+
+void mitk::ContourElement::SpatialIndex::GetSegmentCandidates(const mitk::Point3D &point,
+                                                              double radius,
+                                                              IndexListType &candidates) const
+{
+  candidates = m_LargeSegments;
+  this->CollectCandidates(point, radius, m_SegmentCells, candidates);
+}
+
+mitk::ContourElement::VertexType *mitk::ContourElement::VertexPool::Create(const mitk::Point3D &point,
+                                                                           bool isControlPoint)
+{
+  if (!m_ReleasedVertices.empty())
+  {
+    auto vertex = m_ReleasedVertices.back();
+    m_ReleasedVertices.pop_back();
+    vertex->Coordinates = point;
+    vertex->IsControlPoint = isControlPoint;
+    return vertex;
+  }
+
+  if (m_Chunks.empty() || m_Chunks.back().size() == m_Chunks.back().capacity())
+  {
+    // chunks are never reallocated, so the addresses of the vertices stay valid
+    const std::size_t chunkSize = m_Chunks.empty() ? 64 : std::min<std::size_t>(2 * m_Chunks.back().capacity(), 4096);
+    m_Chunks.emplace_back();
+    m_Chunks.back().reserve(chunkSize);
+  }
+
+  m_Chunks.back().emplace_back(point, isControlPoint);
+  return &(m_Chunks.back().back());
+}
+
+void mitk::ContourElement::VertexPool::Release(VertexType *vertex)
+{
+  m_ReleasedVertices.push_back(vertex);
+}
+
+void mitk::ContourElement::VertexPool::Clear()
+{
+  m_Chunks.clear();
+  m_ReleasedVertices.clear();
+}
+
 bool mitk::ContourElement::ContourModelVertex::operator==(const ContourModelVertex &other) const
 {
   return this->Coordinates == other.Coordinates && this->IsControlPoint == other.IsControlPoint;
@@ -58,12 +318,14 @@ mitk::ContourElement::VertexIterator mitk::ContourElement::end()
   return this->m_Vertices.end();
 }
 
+mitk::ContourElement::ContourElement() = default;
+
 mitk::ContourElement::ContourElement(const mitk::ContourElement &other)
-  : itk::LightObject(), m_IsClosed(other.m_IsClosed)
+  : itk::LightObject(), m_IsClosed(other.m_IsClosed), m_UseSpatialIndex(other.m_UseSpatialIndex)
 {
   for (const auto &v : other.m_Vertices)
   {
-    m_Vertices.push_back(new ContourModelVertex(*v));
+    m_Vertices.push_back(m_VertexPool.Create(v->Coordinates, v->IsControlPoint));
   }
 }
 
@@ -74,7 +336,7 @@ mitk::ContourElement &mitk::ContourElement::operator=(const ContourElement &othe
     this->Clear();
     for (const auto &v : other.m_Vertices)
     {
-      m_Vertices.push_back(new ContourModelVertex(*v));
+      m_Vertices.push_back(m_VertexPool.Create(v->Coordinates, v->IsControlPoint));
     }
   }
 
@@ -94,12 +356,14 @@ mitk::ContourElement::VertexSizeType mitk::ContourElement::GetSize() const
 
 void mitk::ContourElement::AddVertex(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_back(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_back(m_VertexPool.Create(vertex, isControlPoint));
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::AddVertexAtFront(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_front(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_front(m_VertexPool.Create(vertex, isControlPoint));
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool isControlPoint, VertexSizeType index)
@@ -108,7 +372,8 @@ void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool
   {
     auto _where = this->m_Vertices.begin();
     _where += index;
-    this->m_Vertices.insert(_where, new VertexType(vertex, isControlPoint));
+    this->m_Vertices.insert(_where, m_VertexPool.Create(vertex, isControlPoint));
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -117,6 +382,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const Point3D &po
   if (this->GetSize() > pointId)
   {
     this->m_Vertices[pointId]->Coordinates = point;
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -131,6 +397,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const VertexType
   {
     this->m_Vertices[pointId]->Coordinates = vertex->Coordinates;
     this->m_Vertices[pointId]->IsControlPoint = vertex->IsControlPoint;
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -151,28 +418,59 @@ bool mitk::ContourElement::IsEmpty() const
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetControlVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps, true);
+    return this->GetNearestVertex(point, eps, true);
   } // if eps < 0
   return nullptr;
 }
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps);
+    return this->GetNearestVertex(point, eps, false);
   } // if eps < 0
   return nullptr;
 }
 
+mitk::ContourElement::VertexType *mitk::ContourElement::GetNearestVertex(const mitk::Point3D &point,
+                                                                         double eps,
+                                                                         bool isControlPoint)
+{
+  auto spatialIndex = this->GetSpatialIndex();
+  SpatialIndex::IndexListType candidates;
+
+  if (nullptr == spatialIndex)
+  {
+    return BruteForceGetVertexAt(point, eps, isControlPoint);
+  }
+
+  spatialIndex->GetVertexCandidates(point, eps, candidates);
+
+  // candidates are sorted, so ties are resolved in favor of the first vertex like the brute force search does
+  VertexType *nearestVertex = nullptr;
+  double nearestPointDistance = std::numeric_limits<double>::max();
+
+  for (const auto index : candidates)
+  {
+    auto vertex = m_Vertices[index];
+    if (isControlPoint && !vertex->IsControlPoint)
+    {
+      continue;
+    }
+
+    const double distance = vertex->Coordinates.EuclideanDistanceTo(point);
+    if (distance < eps && distance < nearestPointDistance)
+    {
+      nearestVertex = vertex;
+      nearestPointDistance = distance;
+    }
+  }
+
+  return nearestVertex;
+}
+
 mitk::ContourElement::VertexType *mitk::ContourElement::GetNextControlVertexAt(const mitk::Point3D &point, float eps)
 {
   /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
@@ -299,6 +597,42 @@ bool mitk::ContourElement::IsNearContour(const mitk::Point3D& point, float eps)
 bool mitk::ContourElement::GetLineSegmentForPoint(const mitk::Point3D& point,
   float eps, VertexSizeType& segmentStartIndex, VertexSizeType& segmentEndIndex, mitk::Point3D& closestContourPoint, bool findClosest) const
 {
+  auto spatialIndex = this->GetSpatialIndex();
+  SpatialIndex::IndexListType candidates;
+
+  // eps is compared with the squared distance
+  if (nullptr != spatialIndex && eps > 0)
+  {
+    spatialIndex->GetSegmentCandidates(point, std::sqrt(eps), candidates);
+    const auto numberOfVertices = m_Vertices.size();
+
+    bool closePointFound = false;
+    double closestDistance = std::numeric_limits<double>::max();
+    for (const auto index : candidates)
+    {
+      const auto nextIndex = (index + 1) % numberOfVertices;
+
+      mitk::Point3D crossPoint;
+      const double distance =
+        SquaredDistanceToSegment(point, m_Vertices[index]->Coordinates, m_Vertices[nextIndex]->Coordinates, crossPoint);
+
+      if (distance < eps && distance < closestDistance)
+      {
+        closestDistance = distance;
+        closePointFound = true;
+        closestContourPoint = crossPoint;
+        segmentStartIndex = index;
+        segmentEndIndex = nextIndex;
+        if (!findClosest)
+        {
+          return true;
+        }
+      }
+    }
+
+    return closePointFound;
+  }
+
   ConstVertexIterator it1 = this->m_Vertices.begin();
   ConstVertexIterator it2 = this->m_Vertices.begin();
   it2++; // it2 runs one position ahead
@@ -312,29 +646,8 @@ bool mitk::ContourElement::GetLineSegmentForPoint(const mitk::Point3D& point,
     if (it2 == end)
       it2 = this->m_Vertices.begin();
 
-    mitk::Point3D v1 = (*it1)->Coordinates;
-    mitk::Point3D v2 = (*it2)->Coordinates;
-
-    const float l2 = v1.SquaredEuclideanDistanceTo(v2);
-
-    mitk::Vector3D p_v1 = point - v1;
-    mitk::Vector3D v2_v1 = v2 - v1;
-
-    double tc = (p_v1 * v2_v1) / l2;
-
-    // take into account we have line segments and not (infinite) lines
-    if (tc < 0.0)
-    {
-      tc = 0.0;
-    }
-    if (tc > 1.0)
-    {
-      tc = 1.0;
-    }
-
-    mitk::Point3D crossPoint = v1 + v2_v1 * tc;
-
-    double distance = point.SquaredEuclideanDistanceTo(crossPoint);
+    mitk::Point3D crossPoint;
+    double distance = SquaredDistanceToSegment(point, (*it1)->Coordinates, (*it2)->Coordinates, crossPoint);
 
     if (distance < eps && distance < closestDistance)
     {
@@ -425,14 +738,15 @@ void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool c
 
         if (finding == this->m_Vertices.end())
         {
-          this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+          this->m_Vertices.push_back(m_VertexPool.Create(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
         }
       }
       else
       {
-        this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+        this->m_Vertices.push_back(m_VertexPool.Create(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
       }
     }
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -472,9 +786,29 @@ bool mitk::ContourElement::RemoveVertexAt(const mitk::Point3D &point, double eps
 {
   if (eps > 0)
   {
-    auto finding = std::find_if(this->m_Vertices.begin(), this->m_Vertices.end(), [point, eps](const VertexType *v) {
-      return v->Coordinates.EuclideanDistanceTo(point) < eps;
-    });
+    auto finding = this->m_Vertices.end();
+
+    auto spatialIndex = this->GetSpatialIndex();
+    SpatialIndex::IndexListType candidates;
+    if (nullptr != spatialIndex)
+    {
+      spatialIndex->GetVertexCandidates(point, eps, candidates);
+      // the first vertex within eps is removed, like in the linear search below
+      auto candidate = std::find_if(candidates.begin(), candidates.end(), [this, point, eps](VertexSizeType index) {
+        return this->m_Vertices[index]->Coordinates.EuclideanDistanceTo(point) < eps;
+      });
+
+      if (candidate != candidates.end())
+      {
+        finding = this->m_Vertices.begin() + *candidate;
+      }
+    }
+    else
+    {
+      finding = std::find_if(this->m_Vertices.begin(), this->m_Vertices.end(), [point, eps](const VertexType *v) {
+        return v->Coordinates.EuclideanDistanceTo(point) < eps;
+      });
+    }
 
     return RemoveVertexByIterator(finding);
   }
@@ -485,8 +819,9 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 {
   if (iter != this->m_Vertices.end())
   {
-    delete *iter;
+    m_VertexPool.Release(*iter);
     this->m_Vertices.erase(iter);
+    this->InvalidateSpatialIndex();
     return true;
   }
 
@@ -495,11 +830,45 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 
 void mitk::ContourElement::Clear()
 {
-  for (auto vertex : m_Vertices)
+  this->m_Vertices.clear();
+  this->m_VertexPool.Clear();
+  this->InvalidateSpatialIndex();
+}
+
+void mitk::ContourElement::SetUseSpatialIndex(bool useSpatialIndex)
+{
+  m_UseSpatialIndex = useSpatialIndex;
+  if (!m_UseSpatialIndex)
   {
-    delete vertex;
+    m_SpatialIndex.reset();
+    m_SpatialIndexIsValid = false;
   }
-  this->m_Vertices.clear();
+}
+
+bool mitk::ContourElement::GetUseSpatialIndex() const
+{
+  return m_UseSpatialIndex;
+}
+
+void mitk::ContourElement::InvalidateSpatialIndex()
+{
+  m_SpatialIndexIsValid = false;
+}
+
+const mitk::ContourElement::SpatialIndex *mitk::ContourElement::GetSpatialIndex() const
+{
+  if (!m_UseSpatialIndex || m_Vertices.size() < SpatialIndexMinimumSize)
+  {
+    return nullptr;
+  }
+
+  if (!m_SpatialIndexIsValid || nullptr == m_SpatialIndex)
+  {
+    m_SpatialIndex.reset(new SpatialIndex(m_Vertices));
+    m_SpatialIndexIsValid = true;
+  }
+
+  return m_SpatialIndex.get();
 }
 
 //----------------------------------------------------------------------
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <mitkNumericTypes.h>
 
 #include <deque>
+#include <memory>
+#include <vector>
 
 namespace mitk
 {
@@ -29,9 +31,17 @@ namespace mitk
   \note This class assumes that it manages its vertices. So if a vertex instance is added to this
   class the ownership of the vertex is transfered to the ContourElement instance.
   The ContourElement instance takes care of deleting vertex instances if needed.
+  The vertices themselves are allocated in contiguous chunks; the pointers stay valid until the
+  vertex is removed or the contour is cleared.
   It is highly not recommend to use this class directly as it is designed as a internal class of
   ContourModel. Therefore it is adviced to use ContourModel if contour representations are needed in
   MITK.
+
+  Spatial queries (GetVertexAt(point, eps), GetControlVertexAt(), IsNearContour(),
+  GetLineSegmentForPoint() and RemoveVertexAt(point, eps)) use a uniform grid of the vertices and
+  line segments, if the contour is large enough. The grid is rebuilt lazily by the next query after
+  the contour was changed through the methods of this class. If the coordinates of vertices are
+  changed directly via vertex pointers or iterators, InvalidateSpatialIndex() has to be called.
   */
   class MITKCONTOURMODEL_EXPORT ContourElement : public itk::LightObject
   {
@@ -285,10 +295,24 @@ namespace mitk
     */
     void RedistributeControlVertices(const VertexType *vertex, int period);
 
+    /** \brief Enables or disables the spatial grid used by the spatial queries (default: enabled).
+    The results of the queries do not depend on this setting.
+    */
+    void SetUseSpatialIndex(bool useSpatialIndex);
+    bool GetUseSpatialIndex() const;
+
+    /** \brief Marks the spatial grid as outdated.
+    Has to be called after the coordinates of vertices were changed directly via vertex pointers or iterators.
+    */
+    void InvalidateSpatialIndex();
+
+    /** Contours with fewer vertices are always searched by brute force.*/
+    static const VertexSizeType SpatialIndexMinimumSize = 256;
+
   protected:
     mitkCloneMacro(Self);
 
-    ContourElement() = default;
+    ContourElement();
     ContourElement(const mitk::ContourElement &other);
     ~ContourElement();
 
@@ -300,8 +324,35 @@ namespace mitk
     \result Indicates if the element indicated by the iterator was removed. If iterator points to end it returns false.*/
     bool RemoveVertexByIterator(VertexListType::iterator& iter);
 
+    /** Allocates vertices in chunks of contiguous memory. Released vertices are reused by later
+    allocations, the memory is only freed by Clear().*/
+    class VertexPool
+    {
+    public:
+      VertexType *Create(const mitk::Point3D &point, bool isControlPoint);
+      void Release(VertexType *vertex);
+      void Clear();
+
+    private:
+      std::vector<std::vector<VertexType>> m_Chunks;
+      std::vector<VertexType *> m_ReleasedVertices;
+    };
+
+    class SpatialIndex;
+
+    /** Returns the nearest (control) vertex closer than eps to the point or nullptr.*/
+    VertexType *GetNearestVertex(const mitk::Point3D &point, double eps, bool isControlPoint);
+
+    /** Returns the spatial grid of the current vertices or nullptr if the contour should be searched by brute force.*/
+    const SpatialIndex *GetSpatialIndex() const;
+
     VertexListType m_Vertices; // double ended queue with vertices
+    VertexPool m_VertexPool;
     bool m_IsClosed = false;
+
+    bool m_UseSpatialIndex = true;
+    mutable std::unique_ptr<SpatialIndex> m_SpatialIndex;
+    mutable bool m_SpatialIndexIsValid = false;
   };
 } // namespace mitk
 
@@ -480,6 +480,10 @@ void mitk::ContourModel::ShiftSelectedVertex(Vector3D &translate)
   if (this->m_SelectedVertex)
   {
     this->ShiftVertex(this->m_SelectedVertex, translate);
+    for (auto &contour : this->m_ContourSeries)
+    {
+      contour->InvalidateSpatialIndex();
+    }
     this->Modified();
     this->m_UpdateBoundingBox = true;
   }
@@ -494,6 +498,7 @@ void mitk::ContourModel::ShiftContour(Vector3D &translate, TimeStepType timestep
     {
       this->ShiftVertex(vertex, translate);
     }
+    this->m_ContourSeries[timestep]->InvalidateSpatialIndex();
 
     this->Modified();
     this->m_UpdateBoundingBox = true;
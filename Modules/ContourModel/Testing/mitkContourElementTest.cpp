@@ -14,6 +14,8 @@ found in the LICENSE file.
 
 #include "mitkTestFixture.h"
 #include "mitkTestingMacros.h"
+#include <itkMath.h>
+#include <cmath>
 #include <limits>
 
 class mitkContourElementTestSuite : public mitk::TestFixture
@@ -33,6 +35,8 @@ class mitkContourElementTestSuite : public mitk::TestFixture
   MITK_TEST(GetControlVertices);
   MITK_TEST(RedistributeControlVertices);
   MITK_TEST(Others);
+  MITK_TEST(SpatialQueries);
+  MITK_TEST(SpatialIndexUpdate);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -346,6 +350,107 @@ public:
     CPPUNIT_ASSERT(m_Contour5to6->GetSize() == copyConstructed->GetSize());
   }
 
+  static mitk::ContourElement::Pointer GenerateLargeContour(unsigned int numberOfVertices, bool useSpatialIndex)
+  {
+    auto contour = mitk::ContourElement::New();
+    contour->SetUseSpatialIndex(useSpatialIndex);
+
+    for (unsigned int i = 0; i < numberOfVertices; ++i)
+    {
+      const double angle = 2 * itk::Math::pi * i / numberOfVertices;
+      const double radius = 100 + 10 * std::sin(13 * angle);
+      mitk::Point3D point;
+      point[0] = radius * std::cos(angle);
+      point[1] = radius * std::sin(angle);
+      point[2] = 5;
+      contour->AddVertex(point, 0 == i % 7);
+    }
+
+    return contour;
+  }
+
+  void SpatialQueries()
+  {
+    const unsigned int numberOfVertices = 5000;
+    auto indexed = GenerateLargeContour(numberOfVertices, true);
+    auto bruteForce = GenerateLargeContour(numberOfVertices, false);
+    CPPUNIT_ASSERT(indexed->GetSize() >= mitk::ContourElement::SpatialIndexMinimumSize);
+
+    // a duplicated vertex checks that ties are resolved like the brute force search does
+    indexed->InsertVertexAtIndex(indexed->GetVertexAt(42)->Coordinates, false, 43);
+    bruteForce->InsertVertexAtIndex(bruteForce->GetVertexAt(42)->Coordinates, false, 43);
+
+    for (unsigned int i = 0; i < 400; ++i)
+    {
+      mitk::Point3D point;
+      point[0] = -120 + 0.6 * i;
+      point[1] = 110 * std::sin(0.37 * i);
+      point[2] = 5 + ((i % 3) - 1) * 0.5;
+      if (0 == i % 4)
+      {
+        point = indexed->GetVertexAt(i * 11)->Coordinates;
+      }
+      const float eps = 0.05f + (i % 17) * 0.5f;
+
+      auto indexedVertex = indexed->GetVertexAt(point, eps);
+      auto bruteForceVertex = bruteForce->GetVertexAt(point, eps);
+      CPPUNIT_ASSERT_EQUAL(bruteForce->GetIndex(bruteForceVertex), indexed->GetIndex(indexedVertex));
+
+      indexedVertex = indexed->GetControlVertexAt(point, eps);
+      bruteForceVertex = bruteForce->GetControlVertexAt(point, eps);
+      CPPUNIT_ASSERT_EQUAL(bruteForce->GetIndex(bruteForceVertex), indexed->GetIndex(indexedVertex));
+
+      CPPUNIT_ASSERT_EQUAL(bruteForce->IsNearContour(point, eps), indexed->IsNearContour(point, eps));
+
+      mitk::ContourElement::VertexSizeType indexedStart = 0, indexedEnd = 0, bruteForceStart = 0, bruteForceEnd = 0;
+      mitk::Point3D indexedClosest, bruteForceClosest;
+      const bool indexedFound =
+        indexed->GetLineSegmentForPoint(point, eps, indexedStart, indexedEnd, indexedClosest, true);
+      const bool bruteForceFound =
+        bruteForce->GetLineSegmentForPoint(point, eps, bruteForceStart, bruteForceEnd, bruteForceClosest, true);
+      CPPUNIT_ASSERT_EQUAL(bruteForceFound, indexedFound);
+      if (bruteForceFound)
+      {
+        CPPUNIT_ASSERT_EQUAL(bruteForceStart, indexedStart);
+        CPPUNIT_ASSERT_EQUAL(bruteForceEnd, indexedEnd);
+        CPPUNIT_ASSERT(bruteForceClosest == indexedClosest);
+      }
+    }
+  }
+
+  void SpatialIndexUpdate()
+  {
+    auto contour = GenerateLargeContour(1000, true);
+    auto vertex = contour->GetVertexAt(10);
+
+    mitk::Point3D farAway(500);
+    CPPUNIT_ASSERT(nullptr == contour->GetVertexAt(farAway, 1));
+
+    // changes by the contour element are recognized ...
+    contour->SetVertexAt(10, farAway);
+    CPPUNIT_ASSERT(vertex == contour->GetVertexAt(farAway, 1));
+    CPPUNIT_ASSERT(contour->IsNearContour(farAway, 1));
+
+    // ... direct changes have to be announced
+    mitk::Point3D otherPoint(-500);
+    vertex->Coordinates = otherPoint;
+    contour->InvalidateSpatialIndex();
+    CPPUNIT_ASSERT(vertex == contour->GetVertexAt(otherPoint, 1));
+    CPPUNIT_ASSERT(nullptr == contour->GetVertexAt(farAway, 1));
+
+    // handles of the remaining vertices stay valid when vertices are removed and added
+    auto otherVertex = contour->GetVertexAt(20);
+    const auto coordinates = otherVertex->Coordinates;
+    CPPUNIT_ASSERT(contour->RemoveVertexAt(otherPoint, 1));
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+      contour->AddVertexAtFront(farAway, false);
+    }
+    CPPUNIT_ASSERT(otherVertex->Coordinates == coordinates);
+    CPPUNIT_ASSERT_EQUAL(mitk::ContourElement::VertexSizeType(1019), contour->GetIndex(otherVertex));
+    CPPUNIT_ASSERT(otherVertex == contour->GetVertexAt(coordinates, 0.001f));
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourElement)
@@ -63,6 +63,16 @@ namespace mitk
 
     DataStorage::SetOfObjects::Pointer Read(mitk::DataStorage &ds) override;
 
+    /**
+     * @brief Indicates if Read(mitk::DataStorage&) depends on the nodes that are already
+     * in the passed storage (e.g. to restore relations to them).
+     *
+     * The default implementation of Read(mitk::DataStorage&) only adds the read data, so
+     * it returns false. IOUtil only reads files concurrently into private storages if it
+     * is false, other files are read sequentially into the target storage.
+     */
+    virtual bool RequiresTargetDataStorage() const;
+
     ConfidenceLevel GetConfidenceLevel() const override;
 
     Options GetOptions() const override;
@@ -231,6 +231,24 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey, see GetProperty(const char*, const mitk::BaseRenderer*, bool).
+     *
+     * The property lists are searched by integer hash lookups, so callers that query the same keys
+     * repeatedly (e.g. mappers) should keep the PropertyKey.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
+    /**
+     * \brief Interned keys of the properties that the convenience methods and the mappers
+     * query on every render pass.
+     */
+    static const PropertyKey &GetVisiblePropertyKey();
+    static const PropertyKey &GetOpacityPropertyKey();
+    static const PropertyKey &GetColorPropertyKey();
+    static const PropertyKey &GetLayerPropertyKey();
+    static const PropertyKey &GetNamePropertyKey();
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -296,6 +314,9 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /** \brief Convenience access method for bool properties with an interned key. */
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -303,6 +324,9 @@ namespace mitk
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /** \brief Convenience access method for int properties with an interned key. */
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for float properties (instances of
      * FloatProperty)
@@ -312,6 +336,11 @@ namespace mitk
                           float &floatValue,
                           const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /** \brief Convenience access method for float properties with an interned key. */
+    bool GetFloatProperty(const PropertyKey &propertyKey,
+                          float &floatValue,
+                          const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for double properties (instances of
      * DoubleProperty)
@@ -341,6 +370,9 @@ namespace mitk
      */
     bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer = nullptr, const char *propertyKey = "color") const;
 
+    /** \brief Convenience access method for color properties with an interned key. */
+    bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
     /**
      * \brief Convenience access method for level-window properties (instances of
      * LevelWindowProperty)
@@ -384,7 +416,7 @@ namespace mitk
      */
     virtual std::string GetName() const
     {
-      mitk::StringProperty *sp = dynamic_cast<mitk::StringProperty *>(this->GetProperty("name"));
+      mitk::StringProperty *sp = dynamic_cast<mitk::StringProperty *>(this->GetProperty(GetNamePropertyKey()));
       if (sp == nullptr)
         return "";
       return sp->GetValue();
@@ -444,6 +476,12 @@ namespace mitk
       return GetBoolProperty(propertyKey, visible, renderer);
     }
 
+    /** \brief Convenience access method for visibility properties with an interned key. */
+    bool GetVisibility(bool &visible, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+    {
+      return GetBoolProperty(propertyKey, visible, renderer);
+    }
+
     /**
      * \brief Convenience access method for opacity properties (instances of
      * FloatProperty)
@@ -451,6 +489,9 @@ namespace mitk
      */
     bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey = "opacity") const;
 
+    /** \brief Convenience access method for opacity properties with an interned key. */
+    bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
     /**
      * \brief Convenience access method for boolean properties (instances
      * of BoolProperty). Return value is the value of the property. If the property is
@@ -98,7 +98,8 @@ namespace mitk
     //## (see definition of NodePredicateBase for details).
     //## The method returns a set of SmartPointers to the DataNodes that fulfill the
     //## conditions. A set of all objects can be retrieved with the GetAll() method;
-    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
+    //## Subclasses may answer queries from indices, but have to return the same set in the order of GetAll().
+    virtual SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
 
     //##Documentation
     //## @brief returns a set of source objects for a given node that meet the given condition(s).
@@ -392,6 +393,13 @@ namespace mitk
     //## If the cast succeeds the ChangedNodeEvent is emitted with this node.
     void OnNodeModifiedOrDeleted(const itk::Object *caller, const itk::EventObject &event);
 
+    //##Documentation
+    //## @brief  Called by OnNodeModifiedOrDeleted() for every modified event of a node.
+    //##
+    //## In contrast to the ChangedNodeEvent it is also called while node modified events are blocked,
+    //## so subclasses can keep node related caches up to date. The default implementation does nothing.
+    virtual void OnNodeModified(const DataNode *node);
+
     //##Documentation
     //## @brief  Adds a Modified-Listener to the given Node.
     void AddListeners(const DataNode *_Node);
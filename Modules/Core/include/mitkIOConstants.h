@@ -48,6 +48,11 @@ namespace mitk
     static std::string SIZE_Y();
     static std::string SIZE_Z();
     static std::string SIZE_T();
+
+    static std::string LOADING_STRATEGY();
+    static std::string LOADING_STRATEGY_READ();
+    static std::string LOADING_STRATEGY_LAZY();
+    static std::string LOADING_STRATEGY_ENUM();
   };
 }
 
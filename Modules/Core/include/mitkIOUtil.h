@@ -64,6 +64,9 @@ namespace mitk
       bool m_Cancel;
 
       const PropertyList* m_Properties;
+
+      /** Wall-clock time in milliseconds spent in the reader, 0 if the file was not read. */
+      double m_ReadDuration;
     };
 
     /**Struct that is the base class for option callbacks used in load operations. The callback is used by IOUtil, if
@@ -124,6 +127,26 @@ namespace mitk
     */
     static char GetDirectorySeparator();
 
+    /**
+     * @brief Set the maximum number of files that are read concurrently by the Load() methods.
+     *
+     * With more than one thread, the Load() methods taking multiple paths first select
+     * the readers (and call the options callback) for all files on the calling thread,
+     * then run the readers on a bounded pool of worker threads and finally add the
+     * results to the DataStorage in the order of the given paths on the calling thread.
+     * The results are identical to sequential loading. A file waits until the first
+     * preceding file of the same reader has been read. If that reader consumed further
+     * paths (e.g. a DICOM series), the file waits for all preceding files of that reader
+     * and is skipped if it has been consumed by one of them. Readers that depend on the
+     * nodes of the target DataStorage (see AbstractFileReader::RequiresTargetDataStorage(),
+     * e.g. the scene reader) are run sequentially into it on the calling thread.
+     *
+     * Readers must be thread-safe to be used concurrently. mitk::LocaleSwitch only switches
+     * the locale of its thread. The default of 1 keeps the sequential behavior.
+     */
+    static void SetNumberOfLoadThreads(unsigned int numberOfThreads);
+    static unsigned int GetNumberOfLoadThreads();
+
     /**
      * Create and open a temporary file.
      *
@@ -550,6 +550,14 @@ namespace mitk
 
     Image(const Image &other);
 
+    /**
+    * \brief Copies other like the copy constructor, but only copies the pixel data if copyPixelData is true.
+    *
+    * Without pixel data the image is initialized but empty. Subclasses that provide the pixel
+    * data themselves use this to avoid a copy that would be replaced immediately.
+    */
+    Image(const Image &other, bool copyPixelData);
+
     ~Image() override;
 
     void Clear() override;
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include "mitkImageDescriptor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
@@ -117,6 +119,12 @@ namespace mitk
 
     // Returns if image data should be deleted on destruction of ImageDataItem.
     bool GetManageMemory() const { return m_ManageMemory; }
+
+    /** Object owning referenced (not managed) image data, e.g. a memory mapping. It is kept
+        alive as long as this item or one of its sub-items exists. */
+    void SetMemoryOwner(std::shared_ptr<void> owner) { m_MemoryOwner = owner; }
+    const std::shared_ptr<void> &GetMemoryOwner() const { return m_MemoryOwner; }
+
     virtual void ConstructVtkImageData(ImageConstPointer) const;
 
     size_t GetSize() const { return m_Size; }
@@ -155,6 +163,8 @@ namespace mitk
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
 
     int m_Timestep;
+
+    std::shared_ptr<void> m_MemoryOwner;
   };
 
 } // namespace mitk
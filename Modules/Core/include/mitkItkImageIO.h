@@ -29,6 +29,16 @@ namespace mitk
    * For all ITK ImageIOs that support the serialization of MetaData
    * (e.g. nrrd or mhd) the ItkImageIO ensures the serialization
    * of Identification UID.
+   *
+   * The reader option IOConstants::LOADING_STRATEGY() selects how pixel data
+   * is brought into memory. By default, the whole file is read into a newly
+   * allocated buffer. With IOConstants::LOADING_STRATEGY_LAZY(), uncompressed
+   * NRRD, MetaImage and NIfTI files are memory mapped copy-on-write and
+   * referenced by the image, so pages are only loaded on first access. Files
+   * that cannot be mapped (e.g. compressed ones) are decoded into a memory
+   * mapped temporary file instead of a heap buffer, slab by slab (one time
+   * step at a time for 4D images) if the ITK ImageIO supports streaming. In
+   * both cases the mapping is owned by the channel data item of the image.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -62,6 +72,8 @@ namespace mitk
 
     ItkImageIO *IOClone() const override;
 
+    void InitializeDefaultReaderOptions();
+
     itk::ImageIOBase::Pointer m_ImageIO;
 
     std::vector<std::string> m_DefaultMetaDataKeys;
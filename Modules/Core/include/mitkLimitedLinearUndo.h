@@ -25,6 +25,8 @@ found in the LICENSE file.
 #pragma GCC visibility pop
 
 #include <deque>
+#include <fstream>
+#include <map>
 
 namespace mitk
 {
@@ -33,6 +35,12 @@ namespace mitk
   //##
   //## Derived from UndoModel AND itk::Object. Invokes ITK-events to signal listening
   //## GUI elements, whether each of the stacks is empty or not (to enable/disable button, ...)
+  //##
+  //## The history can be limited by the number of items (SetUndoLimit()) and by the memory
+  //## the items report (SetUndoMemoryLimit()). If swapping is enabled, items exceeding the
+  //## memory limit are first written to a temporary file and reloaded transparently when
+  //## they are undone or redone; items that cannot be swapped out are dropped. If swapped out
+  //## data cannot be reloaded, undo or redo stops there and both stacks are cleared.
   class MITKCORE_EXPORT LimitedLinearUndo : public UndoModel
   {
   public:
@@ -100,6 +108,38 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo and redo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetUndoMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo and redo history in bytes.
+    //## If the limit is exceeded, the oldest items are swapped out (see SetSwappingEnabled())
+    //## or dropped from the bottom of the undo stack. The newest item of each stack always
+    //## stays in memory. The 0 value means that there is no limit.
+    //## In the MITK workbench, the limit and swapping are set from the general preferences
+    //## (QmitkGeneralPreferencePage) for all undo models through UndoController::SetUndoMemoryLimit().
+    //## @param limit the maximum number of bytes held by the items of both stacks
+    void SetUndoMemoryLimit(std::size_t limit);
+
+    //##Documentation
+    //## @brief Enables swapping old items out to a temporary file instead of dropping them
+    //## when the memory limit is exceeded. Disabled by default.
+    void SetSwappingEnabled(bool enabled);
+    bool GetSwappingEnabled() const;
+
+    //##Documentation
+    //## @brief Returns the number of bytes currently held in memory by the items of both stacks.
+    std::size_t GetMemorySize() const;
+
+    //##Documentation
+    //## @brief Returns the number of bytes of the swap file that are in use, 0 if no item is
+    //## swapped out. The ranges of swapped in or deleted items are reused by later items, so
+    //## the file does not grow beyond the data of the items swapped out at the same time
+    //## (plus fragmentation).
+    std::size_t GetSwapFileSize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +168,18 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Swaps out or drops the oldest items until the undo limit and the
+    //## memory limit are met
+    void ApplyLimits();
+
+    //## @brief Reloads the data of the item if it has been swapped out
+    //## @throw mitk::Exception if the swapped data cannot be read
+    void SwapIn(UndoStackItem *item);
+
+    //## @brief Reloads the data of the top item of the list. If that fails, both stacks
+    //## are cleared (see Clear()) and false is returned
+    bool SwapInTopItem(UndoContainer *list);
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -135,7 +187,29 @@ namespace mitk
   private:
     int FirstObjectEventIdOfCurrentGroup(UndoContainer &stack);
 
+    //## @brief Returns the number of bytes released by swapping out the item
+    std::size_t SwapOut(UndoStackItem *item);
+    void DeleteItem(UndoStackItem *item);
+    void RemoveSwapFile();
+
+    //## @brief Returns the offset of size free bytes in the swap file. Released ranges are
+    //## reused (first fit) before the file is extended.
+    std::streamoff AllocateSwapRange(std::streamoff size);
+    //## @brief Marks the range as free and merges it with adjacent free ranges
+    void ReleaseSwapRange(std::streamoff offset, std::streamoff size);
+
     std::size_t m_UndoLimit;
+    std::size_t m_UndoMemoryLimit;
+    bool m_SwappingEnabled;
+
+    std::string m_SwapFileName;
+    std::ofstream m_SwapStream;
+    //## offset and size of the data of every swapped out item in the swap file
+    std::map<UndoStackItem *, std::pair<std::streamoff, std::streamoff>> m_SwapRanges;
+    //## free ranges within the used part of the swap file (offset to size)
+    std::map<std::streamoff, std::streamoff> m_FreeSwapRanges;
+    //## end of the used part of the swap file
+    std::streamoff m_SwapFileSize;
 
   };
 
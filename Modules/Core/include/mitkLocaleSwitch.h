@@ -29,8 +29,11 @@ namespace mitk
     printing numbers, in order to consistently get "." and not "," as
     a decimal separator.
 
-    WARNING: Please be aware that using setlocale and there for is not thread
-    safe. So use this class with care (see task T24295 for more information.
+    The locale is only switched for the calling thread (uselocale() on POSIX
+    systems, _configthreadlocale() on Windows), so switches of concurrently
+    running threads (e.g. file readers) do not affect each other. Direct calls of
+    setlocale are still process-wide and not thread safe (see task T24295 for
+    more information).
     This switch is especially use full if you have to deal with third party code
     where you have to control the locale via set locale
     \code
@@ -44,6 +44,18 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Returns the name of the property that is checked
+    const std::string &GetValidPropertyName() const { return m_ValidPropertyName; }
+
+    //##Documentation
+    //## @brief Returns the property value to compare with or nullptr if only the existence of the property is checked
+    const mitk::BaseProperty *GetValidProperty() const { return m_ValidProperty; }
+
+    //##Documentation
+    //## @brief Returns the renderer of the checked renderer-specific property or nullptr
+    const mitk::BaseRenderer *GetRenderer() const { return m_Renderer; }
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
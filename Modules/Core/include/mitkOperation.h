@@ -18,6 +18,8 @@ found in the LICENSE file.
 
 #include <mitkCommon.h>
 
+#include <iosfwd>
+
 namespace mitk
 {
   typedef int OperationType;
@@ -39,6 +41,24 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by the operation.
+    //## Used by undo models to limit the memory of the undo history. Operations that hold
+    //## large data (e.g. images) should add the size of this data.
+    virtual std::size_t GetMemorySize() const;
+
+    //##Documentation
+    //## @brief Writes the large data of the operation to the stream and releases it from memory.
+    //## Undo models may swap out old operations to a temporary file. The default implementation
+    //## does not support this.
+    //## @return true if data was written, false if the operation does not support swapping.
+    virtual bool SwapOut(std::ostream &stream);
+
+    //##Documentation
+    //## @brief Restores the data written by SwapOut(). The stream is positioned at the start of this data.
+    //## @throw mitk::Exception if the data cannot be read.
+    virtual void SwapIn(std::istream &stream);
+
   protected:
     OperationType m_OperationType;
   };
@@ -17,8 +17,10 @@ found in the LICENSE file.
 #include "mitkOperationActor.h"
 #include "mitkUndoModel.h"
 #include <MitkCoreExports.h>
+#include <iosfwd>
 #include <list>
 #include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -74,6 +76,24 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by this item.
+    virtual std::size_t GetMemorySize() const;
+
+    //##Documentation
+    //## @brief Writes the large data of this item to the stream and releases it from memory.
+    //## @return true if data was written, false if the item does not support swapping.
+    virtual bool SwapOut(std::ostream &stream);
+
+    //##Documentation
+    //## @brief Restores the data written by SwapOut(). Has to be called before the item is executed again.
+    //## @throw mitk::Exception if the data cannot be read.
+    virtual void SwapIn(std::istream &stream);
+
+    //##Documentation
+    //## @brief True, if the data of this item has been swapped out.
+    virtual bool IsSwappedOut() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -170,6 +190,16 @@ namespace mitk
     //## and false if it already has been deleted
     virtual bool IsValid();
 
+    //## @brief Returns the size of this event including both operations.
+    std::size_t GetMemorySize() const override;
+
+    //## @brief Swaps out those of the two operations that support it.
+    bool SwapOut(std::ostream &stream) override;
+
+    void SwapIn(std::istream &stream) override;
+
+    bool IsSwappedOut() const override;
+
   protected:
     void OnObjectDeleted();
 
@@ -184,6 +214,9 @@ namespace mitk
     //## reference to the undo operation
     Operation *m_UndoOperation;
 
+    //## operations that have been swapped out, in the order of their data in the swap stream
+    std::vector<Operation *> m_SwappedOutOperations;
+
     //## hide copy constructor
     OperationEvent(OperationEvent &);
     //## hide operator=
@@ -0,0 +1,67 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <optional>
+#include <string>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /** @brief Interned property key.
+   *
+   * Every distinct key string is mapped once to an integer atom, which stays valid for the lifetime
+   * of the process. PropertyList keeps an index of its properties by atom, so a PropertyKey that is
+   * created once, e.g. as a static variable of a mapper, looks up a property by an integer hash
+   * lookup instead of comparing strings:
+   *
+   * \code
+   * static const mitk::PropertyKey visibleKey("visible");
+   * auto property = node->GetProperty(visibleKey, renderer);
+   * \endcode
+   *
+   * The interning table is thread safe.
+   */
+  class MITKCORE_EXPORT PropertyKey final
+  {
+  public:
+    using AtomType = unsigned int;
+
+    /** @brief Interns the key, i.e. assigns an atom to it if it has none yet. */
+    explicit PropertyKey(const char *key);
+    explicit PropertyKey(const std::string &key);
+
+    AtomType GetAtom() const { return m_Atom; }
+    const std::string &GetKey() const { return *m_Key; }
+
+    bool operator==(const PropertyKey &other) const { return m_Atom == other.m_Atom; }
+    bool operator!=(const PropertyKey &other) const { return m_Atom != other.m_Atom; }
+
+    /** @brief Returns the interned key without interning it.
+     *
+     * @return nothing if the key was never interned. No property list contains a property with
+     *         such a key, because lists intern the keys of their properties.
+     */
+    static std::optional<PropertyKey> Find(const std::string &key);
+
+  private:
+    PropertyKey(AtomType atom, const std::string *key) : m_Atom(atom), m_Key(key) {}
+
+    AtomType m_Atom;
+    const std::string *m_Key;
+  };
+}
+
+#endif
@@ -17,12 +17,16 @@ found in the LICENSE file.
 #include "mitkGenericProperty.h"
 #include "mitkUIDGenerator.h"
 #include "mitkIPropertyOwner.h"
+#include "mitkPropertyKey.h"
 #include <MitkCoreExports.h>
 
+#include <itkCommand.h>
 #include <itkObjectFactory.h>
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace mitk
 {
@@ -94,6 +98,13 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * The properties are indexed by the atoms of their keys, so this is an integer hash lookup.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -222,6 +233,9 @@ namespace mitk
     /**
      * @brief Get the timestamp of the last change of the map or the last change of one of
      * the properties store in the list (whichever is later).
+     *
+     * The list observes the modified events of its properties, so this does not depend on
+     * the number of properties.
      */
     itk::ModifiedTimeType GetMTime() const override;
 
@@ -247,6 +261,25 @@ namespace mitk
 
   private:
     itk::LightObject::Pointer InternalClone() const override;
+
+    /** Adds a property that was inserted into m_Properties to the index and observes it. */
+    void RegisterProperty(const std::string &propertyKey, BaseProperty *property);
+    /** Removes a property from the index and stops observing it, before it is erased from m_Properties. */
+    void UnregisterProperty(const PropertyMap::iterator &propertyIter);
+    void OnPropertyModified(const itk::Object *caller, const itk::EventObject &event);
+
+    struct IndexEntry
+    {
+      BaseProperty *property;
+      unsigned long observerTag;
+    };
+
+    itk::MemberCommand<PropertyList>::Pointer m_PropertyModifiedCommand;
+    /** Index of m_Properties by the atoms of the keys. */
+    std::unordered_map<PropertyKey::AtomType, IndexEntry> m_PropertyIndex;
+
+    /** Latest modification time of a property reported by OnPropertyModified(). */
+    std::atomic<itk::ModifiedTimeType> m_LatestPropertyMTime;
   };
 
 } // namespace mitk
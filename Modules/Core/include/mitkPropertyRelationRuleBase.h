@@ -22,6 +22,8 @@ found in the LICENSE file.
 
 #include <MitkCoreExports.h>
 
+#include <map>
+#include <memory>
 #include <string>
 
 namespace mitk
@@ -376,6 +378,23 @@ namespace mitk
        Please remove if T24728 is done then could directly use owner->GetPropertyKeys() again.*/
     static std::vector<std::string> GetPropertyKeys(const IPropertyProvider *owner);
 
+    /** Structured view of the relation instance properties (MITK.Relations.<instanceID>.<name>) of a source.*/
+    struct RelationIndex
+    {
+      /** Values of the RII properties by instance ID and property name (e.g. "ruleID").*/
+      std::map<InstanceIDType, std::map<std::string, std::string>> instances;
+      /** Instance ID of each relation UID. If a relation UID is used by several instances, the first one is stored.*/
+      std::map<RelationUIDType, InstanceIDType> instanceIDByRelationUID;
+      /** Instance IDs of each destination UID, in the order of the instance IDs.*/
+      std::multimap<std::string, InstanceIDType> instanceIDsByDestinationUID;
+    };
+
+    /** Returns the relation index of the passed source. The index is cached per source and rebuilt as soon as
+    the property lists of the source (for data nodes also the one of their data) were modified. Sources that
+    are neither data nodes, base data nor property lists are parsed on every call.
+    @pre source must be valid.*/
+    static std::shared_ptr<const RelationIndex> GetRelationIndex(const IPropertyProvider *source);
+
     /** Helper method that tries to cast the provider to the Identifiable interface.*/
     const Identifiable* CastProviderAsIdentifiable(const mitk::IPropertyProvider* provider) const;
 
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <memory>
 #include <mutex>
 
 namespace mitk
@@ -33,6 +34,13 @@ namespace mitk
   //## Thus, nodes are stored in a noncyclical directed graph data structure.
   //## It is derived from mitk::DataStorage and implements its interface,
   //## including AddNodeEvent and RemoveNodeEvent.
+  //##
+  //## GetSubset() answers queries for data types (NodePredicateDataType) and for values of
+  //## non-renderer-specific properties (NodePredicateProperty), also combined with
+  //## NodePredicateAnd and NodePredicateOr, from secondary indices instead of checking every node.
+  //## This includes GetNamedNode(). Nodes are re-indexed lazily after they, the property list of
+  //## their data or one of their indexed properties were modified. Property keys are indexed on
+  //## their first query; "name" is always indexed.
   //## @ingroup StandaloneDataStorage
   class MITKCORE_EXPORT StandaloneDataStorage : public mitk::DataStorage
   {
@@ -89,6 +97,13 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief returns a set of data objects that meet the given condition(s)
+    //##
+    //## Queries that can be answered from the secondary indices only check the indexed candidates,
+    //## all other queries check every node as described in DataStorage::GetSubset().
+    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const override;
+
     mutable std::mutex m_Mutex;
 
   protected:
@@ -118,12 +133,23 @@ namespace mitk
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
+    //##Documentation
+    //## @brief Marks the node for re-indexing
+    void OnNodeModified(const mitk::DataNode *node) override;
+
     //##Documentation
     //## @brief Nodes and their relation are stored in m_SourceNodes
     AdjacencyList m_SourceNodes;
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+  private:
+    class NodeIndex;
+
+    //##Documentation
+    //## @brief Secondary indices of the nodes by data type and property values
+    std::unique_ptr<NodeIndex> m_NodeIndex;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
@@ -116,7 +116,19 @@ namespace mitk
     //## especially to retrieve text descriptions of the undo/redo stack
     static UndoModel *GetCurrentUndoModel();
 
+    //##Documentation
+    //## @brief Sets the memory limit in bytes and swapping (see LimitedLinearUndo::SetUndoMemoryLimit()
+    //## and LimitedLinearUndo::SetSwappingEnabled()) of all undo models, including the ones created later.
+    static void SetUndoMemoryLimit(std::size_t limit, bool swappingEnabled);
+
   private:
+    //##Documentation
+    //## @brief Applies the settings of SetUndoMemoryLimit() to the model if it is a LimitedLinearUndo
+    static void ApplyUndoMemoryLimit(UndoModel *undoModel);
+
+    static std::size_t m_UndoMemoryLimit;
+    static bool m_UndoSwappingEnabled;
+
     //##Documentation
     //## current selected UndoModel
     static UndoModel::Pointer m_CurUndoModel;
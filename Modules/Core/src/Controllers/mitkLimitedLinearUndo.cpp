@@ -11,8 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkLimitedLinearUndo.h"
+#include <mitkIOUtil.h>
 #include <mitkRenderingManager.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+
 namespace mitk
 {
   itkEventMacroDefinition(UndoStackEvent, itk::ModifiedEvent);
@@ -25,7 +31,7 @@ namespace mitk
 }
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_UndoMemoryLimit(0), m_SwappingEnabled(false), m_SwapFileSize(0)
 {
   // nothing to do
 }
@@ -35,6 +41,7 @@ mitk::LimitedLinearUndo::~LimitedLinearUndo()
   // delete undo and redo list
   this->ClearList(&m_UndoList);
   this->ClearList(&m_RedoList);
+  this->RemoveSwapFile();
 }
 
 void mitk::LimitedLinearUndo::ClearList(UndoContainer *list)
@@ -43,10 +50,210 @@ void mitk::LimitedLinearUndo::ClearList(UndoContainer *list)
   {
     UndoStackItem *item = list->back();
     list->pop_back();
-    delete item;
+    this->DeleteItem(item);
   }
 }
 
+void mitk::LimitedLinearUndo::DeleteItem(UndoStackItem *item)
+{
+  auto finding = m_SwapRanges.find(item);
+  if (finding != m_SwapRanges.end())
+  {
+    this->ReleaseSwapRange(finding->second.first, finding->second.second);
+    m_SwapRanges.erase(finding);
+
+    if (m_SwapRanges.empty())
+      this->RemoveSwapFile();
+  }
+
+  delete item;
+}
+
+void mitk::LimitedLinearUndo::ApplyLimits()
+{
+  while (0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit)
+  {
+    auto item = m_UndoList.front();
+    m_UndoList.pop_front();
+    this->DeleteItem(item);
+  }
+
+  if (0 == m_UndoMemoryLimit)
+    return;
+
+  auto memorySize = this->GetMemorySize();
+
+  if (m_SwappingEnabled)
+  {
+    // the bottom of both stacks is needed last, the top items stay in memory
+    for (auto list : { &m_UndoList, &m_RedoList })
+    {
+      for (std::size_t i = 0; m_SwappingEnabled && i + 1 < list->size() && memorySize > m_UndoMemoryLimit; ++i)
+        memorySize -= std::min(memorySize, this->SwapOut((*list)[i]));
+    }
+  }
+
+  while (memorySize > m_UndoMemoryLimit && m_UndoList.size() > 1)
+  {
+    auto item = m_UndoList.front();
+    m_UndoList.pop_front();
+    memorySize -= std::min(memorySize, item->GetMemorySize());
+    this->DeleteItem(item);
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::SwapOut(UndoStackItem *item)
+{
+  if (item->IsSwappedOut())
+    return 0;
+
+  if (!m_SwapStream.is_open())
+  {
+    try
+    {
+      m_SwapFileName = IOUtil::CreateTemporaryFile(m_SwapStream, std::ios_base::binary, "MITK-Undo-XXXXXX");
+    }
+    catch (const mitk::Exception &e)
+    {
+      MITK_WARN << "Undo items cannot be swapped out, they are dropped instead: " << e.GetDescription();
+      m_SwappingEnabled = false;
+      return 0;
+    }
+  }
+
+  const auto memorySize = item->GetMemorySize();
+
+  // the item is swapped out to a buffer first, so it can be restored if writing the file fails
+  std::stringstream buffer;
+  if (!item->SwapOut(buffer))
+    return 0;
+
+  const auto data = buffer.str();
+  const auto size = static_cast<std::streamoff>(data.size());
+  const auto offset = this->AllocateSwapRange(size);
+  m_SwapStream.seekp(offset);
+  m_SwapStream.write(data.data(), data.size());
+  m_SwapStream.flush();
+
+  if (!m_SwapStream)
+  {
+    MITK_ERROR << "Could not write undo item to swap file " << m_SwapFileName;
+    m_SwapStream.clear();
+    this->ReleaseSwapRange(offset, size);
+    item->SwapIn(buffer);
+    return 0;
+  }
+
+  m_SwapRanges[item] = std::make_pair(offset, size);
+
+  const auto swappedMemorySize = item->GetMemorySize();
+  return memorySize > swappedMemorySize ? memorySize - swappedMemorySize : 0;
+}
+
+void mitk::LimitedLinearUndo::SwapIn(UndoStackItem *item)
+{
+  auto finding = m_SwapRanges.find(item);
+  if (finding == m_SwapRanges.end())
+    return;
+
+  std::ifstream stream(m_SwapFileName, std::ios_base::binary);
+  stream.seekg(finding->second.first);
+
+  if (!stream)
+    mitkThrow() << "Could not read undo item from swap file " << m_SwapFileName;
+
+  item->SwapIn(stream);
+
+  this->ReleaseSwapRange(finding->second.first, finding->second.second);
+  m_SwapRanges.erase(finding);
+
+  if (m_SwapRanges.empty())
+    this->RemoveSwapFile();
+}
+
+bool mitk::LimitedLinearUndo::SwapInTopItem(UndoContainer *list)
+{
+  try
+  {
+    this->SwapIn(list->back());
+    return true;
+  }
+  catch (const mitk::Exception &e)
+  {
+    MITK_ERROR << "Undo history is discarded, because swapped out data cannot be restored: " << e.GetDescription();
+  }
+
+  // skipping the item would lead to a state that never existed, so no item can be undone or redone anymore
+  this->Clear();
+  return false;
+}
+
+std::streamoff mitk::LimitedLinearUndo::AllocateSwapRange(std::streamoff size)
+{
+  for (auto iter = m_FreeSwapRanges.begin(); iter != m_FreeSwapRanges.end(); ++iter)
+  {
+    if (iter->second < size)
+      continue;
+
+    const auto offset = iter->first;
+    const auto remainingSize = iter->second - size;
+    m_FreeSwapRanges.erase(iter);
+
+    if (0 != remainingSize)
+      m_FreeSwapRanges.emplace(offset + size, remainingSize);
+
+    return offset;
+  }
+
+  const auto offset = m_SwapFileSize;
+  m_SwapFileSize += size;
+  return offset;
+}
+
+void mitk::LimitedLinearUndo::ReleaseSwapRange(std::streamoff offset, std::streamoff size)
+{
+  auto next = m_FreeSwapRanges.lower_bound(offset);
+
+  if (next != m_FreeSwapRanges.end() && offset + size == next->first)
+  {
+    size += next->second;
+    next = m_FreeSwapRanges.erase(next);
+  }
+
+  if (next != m_FreeSwapRanges.begin())
+  {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset)
+    {
+      offset = previous->first;
+      size += previous->second;
+      m_FreeSwapRanges.erase(previous);
+    }
+  }
+
+  // a free range at the end is appended to by the next allocation anyway
+  if (offset + size == m_SwapFileSize)
+  {
+    m_SwapFileSize = offset;
+  }
+  else
+  {
+    m_FreeSwapRanges.emplace(offset, size);
+  }
+}
+
+void mitk::LimitedLinearUndo::RemoveSwapFile()
+{
+  if (m_SwapFileName.empty())
+    return;
+
+  m_SwapStream.close();
+  std::remove(m_SwapFileName.c_str());
+  m_SwapFileName.clear();
+  m_FreeSwapRanges.clear();
+  m_SwapFileSize = 0;
+}
+
 bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
 {
   auto *operationEvent = dynamic_cast<OperationEvent *>(stackItem);
@@ -60,13 +267,8 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
   m_UndoList.push_back(operationEvent);
+  this->ApplyLimits();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -106,6 +308,12 @@ bool mitk::LimitedLinearUndo::Undo(int oeid)
   bool rc = true;
   do
   {
+    if (!this->SwapInTopItem(&m_UndoList))
+    {
+      rc = false;
+      break;
+    }
+
     m_UndoList.back()->ReverseAndExecute();
 
     m_RedoList.push_back(m_UndoList.back()); // move to redo stack
@@ -120,6 +328,8 @@ bool mitk::LimitedLinearUndo::Undo(int oeid)
     }
   } while (m_UndoList.back()->GetObjectEventId() >= oeid);
 
+  this->ApplyLimits();
+
   // Update. Check Rendering Mechanism where to request updates
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
   return rc;
@@ -144,8 +354,15 @@ bool mitk::LimitedLinearUndo::Redo(int oeid)
   if (m_RedoList.empty())
     return false;
 
+  bool rc = true;
   do
   {
+    if (!this->SwapInTopItem(&m_RedoList))
+    {
+      rc = false;
+      break;
+    }
+
     m_RedoList.back()->ReverseAndExecute();
 
     m_UndoList.push_back(m_RedoList.back());
@@ -159,9 +376,11 @@ bool mitk::LimitedLinearUndo::Redo(int oeid)
     }
   } while (m_RedoList.back()->GetObjectEventId() <= oeid);
 
+  this->ApplyLimits();
+
   // Update. This should belong into the ExecuteOperation() of OperationActors, but it seems not to be used everywhere
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
-  return true;
+  return rc;
 }
 
 void mitk::LimitedLinearUndo::Clear()
@@ -193,14 +412,57 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+    this->ApplyLimits();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetUndoMemoryLimit() const
+{
+  return m_UndoMemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetUndoMemoryLimit(std::size_t limit)
+{
+  if (limit != m_UndoMemoryLimit)
+  {
+    m_UndoMemoryLimit = limit;
+    this->ApplyLimits();
   }
 }
 
+void mitk::LimitedLinearUndo::SetSwappingEnabled(bool enabled)
+{
+  if (enabled != m_SwappingEnabled)
+  {
+    m_SwappingEnabled = enabled;
+    this->ApplyLimits();
+  }
+}
+
+bool mitk::LimitedLinearUndo::GetSwappingEnabled() const
+{
+  return m_SwappingEnabled;
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+
+  for (auto item : m_UndoList)
+    memorySize += item->GetMemorySize();
+
+  for (auto item : m_RedoList)
+    memorySize += item->GetMemorySize();
+
+  return memorySize;
+}
+
+std::size_t mitk::LimitedLinearUndo::GetSwapFileSize() const
+{
+  return static_cast<std::size_t>(m_SwapFileSize);
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -72,6 +72,25 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return sizeof(UndoStackItem) + m_Description.capacity();
+}
+
+bool mitk::UndoStackItem::SwapOut(std::ostream &)
+{
+  return false;
+}
+
+void mitk::UndoStackItem::SwapIn(std::istream &)
+{
+}
+
+bool mitk::UndoStackItem::IsSwappedOut() const
+{
+  return false;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -148,3 +167,46 @@ bool mitk::OperationEvent::IsValid()
 {
   return !m_Invalid;
 }
+
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t size = UndoStackItem::GetMemorySize() + sizeof(OperationEvent) - sizeof(UndoStackItem);
+
+  if (nullptr != m_Operation)
+    size += m_Operation->GetMemorySize();
+
+  if (nullptr != m_UndoOperation && m_UndoOperation != m_Operation)
+    size += m_UndoOperation->GetMemorySize();
+
+  return size;
+}
+
+bool mitk::OperationEvent::SwapOut(std::ostream &stream)
+{
+  if (this->IsSwappedOut())
+    return false;
+
+  // both may refer to the same instance
+  Operation *undoOperation = m_UndoOperation != m_Operation ? m_UndoOperation : nullptr;
+
+  for (auto operation : { m_Operation, undoOperation })
+  {
+    if (nullptr != operation && operation->SwapOut(stream))
+      m_SwappedOutOperations.push_back(operation);
+  }
+
+  return !m_SwappedOutOperations.empty();
+}
+
+void mitk::OperationEvent::SwapIn(std::istream &stream)
+{
+  for (auto operation : m_SwappedOutOperations)
+    operation->SwapIn(stream);
+
+  m_SwappedOutOperations.clear();
+}
+
+bool mitk::OperationEvent::IsSwappedOut() const
+{
+  return !m_SwappedOutOperations.empty();
+}
@@ -20,6 +20,8 @@ found in the LICENSE file.
 mitk::UndoModel::Pointer mitk::UndoController::m_CurUndoModel;
 mitk::UndoController::UndoModelMap mitk::UndoController::m_UndoModelList;
 mitk::UndoController::UndoType mitk::UndoController::m_CurUndoType;
+std::size_t mitk::UndoController::m_UndoMemoryLimit = 0;
+bool mitk::UndoController::m_UndoSwappingEnabled = false;
 
 // const mitk::UndoController::UndoType mitk::UndoController::DEFAULTUNDOMODEL = LIMITEDLINEARUNDO;
 const mitk::UndoController::UndoType mitk::UndoController::DEFAULTUNDOMODEL = VERBOSE_LIMITEDLINEARUNDO;
@@ -48,6 +50,8 @@ mitk::UndoController::UndoController(UndoType undoType)
         m_CurUndoType = undoType;
         m_UndoModelList.insert(UndoModelMap::value_type(undoType, m_CurUndoModel));
     }
+
+    ApplyUndoMemoryLimit(m_CurUndoModel);
   }
 }
 
@@ -153,6 +157,8 @@ bool mitk::UndoController::AddUndoModel(UndoType undoType)
       // that undoType is not implemented!
       return false;
   }
+
+  ApplyUndoMemoryLimit(m_CurUndoModel);
   return true;
 }
 
@@ -211,3 +217,22 @@ mitk::UndoModel *mitk::UndoController::GetCurrentUndoModel()
 {
   return m_CurUndoModel;
 }
+
+void mitk::UndoController::SetUndoMemoryLimit(std::size_t limit, bool swappingEnabled)
+{
+  m_UndoMemoryLimit = limit;
+  m_UndoSwappingEnabled = swappingEnabled;
+
+  for (const auto &undoModel : m_UndoModelList)
+    ApplyUndoMemoryLimit(undoModel.second);
+}
+
+void mitk::UndoController::ApplyUndoMemoryLimit(UndoModel *undoModel)
+{
+  auto limitedLinearUndo = dynamic_cast<LimitedLinearUndo *>(undoModel);
+  if (nullptr == limitedLinearUndo)
+    return;
+
+  limitedLinearUndo->SetSwappingEnabled(m_UndoSwappingEnabled);
+  limitedLinearUndo->SetUndoMemoryLimit(m_UndoMemoryLimit);
+}
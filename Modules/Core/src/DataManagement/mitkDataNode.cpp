@@ -27,6 +27,8 @@ found in the LICENSE file.
 #include "mitkLevelWindowProperty.h"
 #include "mitkRenderingManager.h"
 
+#include <cstring>
+
 namespace mitk
 {
   itkEventMacroDefinition(InteractorChangedEvent, itk::AnyEvent);
@@ -221,11 +223,76 @@ void mitk::DataNode::ConcatenatePropertyList(PropertyList *pList, bool replace)
   m_PropertyList->ConcatenatePropertyList(pList, replace);
 }
 
+const mitk::PropertyKey &mitk::DataNode::GetVisiblePropertyKey()
+{
+  static const PropertyKey key("visible");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::DataNode::GetOpacityPropertyKey()
+{
+  static const PropertyKey key("opacity");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::DataNode::GetColorPropertyKey()
+{
+  static const PropertyKey key("color");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::DataNode::GetLayerPropertyKey()
+{
+  static const PropertyKey key("layer");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::DataNode::GetNamePropertyKey()
+{
+  static const PropertyKey key("name");
+  return key;
+}
+
+namespace
+{
+  // The frequent keys are interned once, so looking them up by string neither
+  // builds a std::string nor takes the interning lock.
+  const mitk::PropertyKey *FindFrequentPropertyKey(const char *propertyKey)
+  {
+    for (const auto *key : { &mitk::DataNode::GetVisiblePropertyKey(),
+                             &mitk::DataNode::GetOpacityPropertyKey(),
+                             &mitk::DataNode::GetColorPropertyKey(),
+                             &mitk::DataNode::GetLayerPropertyKey(),
+                             &mitk::DataNode::GetNamePropertyKey() })
+    {
+      if (0 == std::strcmp(propertyKey, key->GetKey().c_str()))
+        return key;
+    }
+
+    return nullptr;
+  }
+}
+
 mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
 {
   if (nullptr == propertyKey)
     return nullptr;
 
+  if (const auto *frequentKey = FindFrequentPropertyKey(propertyKey))
+    return this->GetProperty(*frequentKey, renderer, fallBackOnDataProperties);
+
+  // resolved once, as up to three lists are searched; a key that was never
+  // interned is not contained in any property list
+  const auto key = PropertyKey::Find(propertyKey);
+
+  if (!key)
+    return nullptr;
+
+  return this->GetProperty(*key, renderer, fallBackOnDataProperties);
+}
+
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
   if (nullptr != renderer)
   {
     auto it = m_MapOfPropertyLists.find(renderer->GetName());
@@ -242,7 +309,7 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   auto property = m_PropertyList->GetProperty(propertyKey);
 
   if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
-    property = m_Data->GetProperty(propertyKey);
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
 
   return property;
 }
@@ -277,6 +344,16 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = dynamic_cast<mitk::BoolProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -287,6 +364,16 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  auto intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == intprop)
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
@@ -299,6 +386,18 @@ bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetFloatProperty(const PropertyKey &propertyKey,
+                                      float &floatValue,
+                                      const mitk::BaseRenderer *renderer) const
+{
+  auto floatprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == floatprop)
+    return false;
+
+  floatValue = floatprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
                                        double &doubleValue,
                                        const mitk::BaseRenderer *renderer) const
@@ -347,6 +446,16 @@ bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer,
   return true;
 }
 
+bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto colorprop = dynamic_cast<mitk::ColorProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == colorprop)
+    return false;
+
+  memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+  return true;
+}
+
 bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
   mitk::FloatProperty::Pointer opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
@@ -357,6 +466,16 @@ bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *render
   return true;
 }
 
+bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == opacityprop)
+    return false;
+
+  opacity = opacityprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
@@ -193,18 +193,25 @@ void mitk::DataStorage::OnNodeInteractorChanged(itk::Object *caller, const itk::
 
 void mitk::DataStorage::OnNodeModifiedOrDeleted(const itk::Object *caller, const itk::EventObject &event)
 {
+  const auto *_Node = dynamic_cast<const DataNode *>(caller);
+  if (_Node == nullptr)
+    return;
+
+  const auto *modEvent = dynamic_cast<const itk::ModifiedEvent *>(&event);
+  if (modEvent)
+    this->OnNodeModified(_Node);
+
   if (m_BlockNodeModifiedEvents)
     return;
 
-  const auto *_Node = dynamic_cast<const DataNode *>(caller);
-  if (_Node)
-  {
-    const auto *modEvent = dynamic_cast<const itk::ModifiedEvent *>(&event);
-    if (modEvent)
-      ChangedNodeEvent.Send(_Node);
-    else
-      DeleteNodeEvent.Send(_Node);
-  }
+  if (modEvent)
+    ChangedNodeEvent.Send(_Node);
+  else
+    DeleteNodeEvent.Send(_Node);
+}
+
+void mitk::DataStorage::OnNodeModified(const DataNode *)
+{
 }
 
 void mitk::DataStorage::AddListeners(const DataNode *_Node)
@@ -560,7 +567,7 @@ mitk::DataNode::Pointer mitk::FindTopmostVisibleNode(const DataStorage::SetOfObj
     }
 
     int layer = 0;
-    if (!node->GetIntProperty("layer", layer, baseRender))
+    if (!node->GetIntProperty(mitk::DataNode::GetLayerPropertyKey(), layer, baseRender))
     {
       continue;
     }
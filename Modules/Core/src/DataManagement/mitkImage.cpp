@@ -46,7 +46,11 @@ mitk::Image::Image()
   m_Initialized = false;
 }
 
-mitk::Image::Image(const Image &other)
+mitk::Image::Image(const Image &other) : Image(other, true)
+{
+}
+
+mitk::Image::Image(const Image &other, bool copyPixelData)
   : SlicedData(other),
     m_Dimension(0),
     m_Dimensions(nullptr),
@@ -65,6 +69,9 @@ mitk::Image::Image(const Image &other)
   TimeGeometry::Pointer cloned = other.GetTimeGeometry()->Clone();
   this->SetTimeGeometry(cloned.GetPointer());
 
+  if (!copyPixelData)
+    return;
+
   if (this->GetDimension() > 3)
   {
     const unsigned int time_steps = this->GetDimension(3);
@@ -0,0 +1,81 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKey.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+  class InternTable
+  {
+  public:
+    static InternTable &GetInstance()
+    {
+      // never destroyed, static property keys may still be used during static destruction
+      static auto instance = new InternTable;
+      return *instance;
+    }
+
+    /** Returns the entry of the key, which is added if it is missing. The key strings
+        are nodes of the map and keep their address. */
+    const std::pair<const std::string, mitk::PropertyKey::AtomType> &Intern(const std::string &key)
+    {
+      {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        auto finding = m_Atoms.find(key);
+
+        if (finding != m_Atoms.end())
+          return *finding;
+      }
+
+      std::unique_lock<std::shared_mutex> lock(m_Mutex);
+      return *m_Atoms.emplace(key, static_cast<mitk::PropertyKey::AtomType>(m_Atoms.size())).first;
+    }
+
+    const std::pair<const std::string, mitk::PropertyKey::AtomType> *Find(const std::string &key) const
+    {
+      std::shared_lock<std::shared_mutex> lock(m_Mutex);
+      auto finding = m_Atoms.find(key);
+
+      return finding != m_Atoms.end() ? &*finding : nullptr;
+    }
+
+  private:
+    mutable std::shared_mutex m_Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::AtomType> m_Atoms;
+  };
+}
+
+mitk::PropertyKey::PropertyKey(const char *key)
+  : PropertyKey(std::string(key))
+{
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &key)
+{
+  const auto &entry = InternTable::GetInstance().Intern(key);
+  m_Atom = entry.second;
+  m_Key = &entry.first;
+}
+
+std::optional<mitk::PropertyKey> mitk::PropertyKey::Find(const std::string &key)
+{
+  const auto entry = InternTable::GetInstance().Find(key);
+
+  if (nullptr == entry)
+    return std::nullopt;
+
+  return PropertyKey(entry->second, &entry->first);
+}
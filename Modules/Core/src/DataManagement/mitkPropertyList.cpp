@@ -56,6 +56,16 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  auto finding = m_PropertyIndex.find(propertyKey.GetAtom());
+
+  if (finding != m_PropertyIndex.cend())
+    return finding->second.property;
+  else
+    return nullptr;
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +114,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->RegisterProperty(propertyKey, property);
   this->Modified();
 }
 
@@ -117,12 +128,14 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
   // Is a property with key @a propertyKey contained in the list?
   if (it != m_Properties.cend())
   {
+    this->UnregisterProperty(it);
     it->second = nullptr;
     m_Properties.erase(it);
   }
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->RegisterProperty(propertyKey, property);
   Modified();
 }
 
@@ -133,6 +146,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   // Is a property with key @a propertyKey contained in the list?
   if (it != m_Properties.cend())
   {
+    this->UnregisterProperty(it);
     it->second = nullptr;
     m_Properties.erase(it);
     Modified();
@@ -140,14 +154,24 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
 }
 
 mitk::PropertyList::PropertyList()
+  : m_PropertyModifiedCommand(itk::MemberCommand<PropertyList>::New()),
+    m_LatestPropertyMTime(0)
 {
+  m_PropertyModifiedCommand->SetCallbackFunction(this, &PropertyList::OnPropertyModified);
 }
 
-mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object()
+mitk::PropertyList::PropertyList(const mitk::PropertyList &other)
+  : itk::Object(),
+    m_PropertyModifiedCommand(itk::MemberCommand<PropertyList>::New()),
+    m_LatestPropertyMTime(0)
 {
+  m_PropertyModifiedCommand->SetCallbackFunction(this, &PropertyList::OnPropertyModified);
+
   for (auto i = other.m_Properties.cbegin(); i != other.m_Properties.cend(); ++i)
   {
-    m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
+    auto clone = i->second->Clone();
+    m_Properties.insert(std::make_pair(i->first, clone));
+    this->RegisterProperty(i->first, clone);
   }
 }
 
@@ -161,29 +185,52 @@ mitk::PropertyList::~PropertyList()
  */
 itk::ModifiedTimeType mitk::PropertyList::GetMTime() const
 {
-  for (auto it = m_Properties.cbegin(); it != m_Properties.cend(); ++it)
+  if (Superclass::GetMTime() < m_LatestPropertyMTime)
   {
-    if (it->second.IsNull())
-    {
-      itkWarningMacro(<< "Property '" << it->first << "' contains nothing (nullptr).");
-      continue;
-    }
-    if (Superclass::GetMTime() < it->second->GetMTime())
-    {
-      Modified();
-      break;
-    }
+    Modified();
   }
 
   return Superclass::GetMTime();
 }
 
+void mitk::PropertyList::RegisterProperty(const std::string &propertyKey, BaseProperty *property)
+{
+  IndexEntry entry;
+  entry.property = property;
+  entry.observerTag = property->AddObserver(itk::ModifiedEvent(), m_PropertyModifiedCommand);
+  m_PropertyIndex[PropertyKey(propertyKey).GetAtom()] = entry;
+}
+
+void mitk::PropertyList::UnregisterProperty(const PropertyMap::iterator &propertyIter)
+{
+  auto finding = m_PropertyIndex.find(PropertyKey(propertyIter->first).GetAtom());
+
+  if (finding != m_PropertyIndex.end())
+  {
+    if (propertyIter->second.IsNotNull())
+      propertyIter->second->RemoveObserver(finding->second.observerTag);
+
+    m_PropertyIndex.erase(finding);
+  }
+}
+
+void mitk::PropertyList::OnPropertyModified(const itk::Object *caller, const itk::EventObject &)
+{
+  const auto mTime = caller->GetMTime();
+  auto latestMTime = m_LatestPropertyMTime.load();
+
+  while (latestMTime < mTime && !m_LatestPropertyMTime.compare_exchange_weak(latestMTime, mTime))
+  {
+  }
+}
+
 bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
 {
   auto it = m_Properties.find(propertyKey);
 
   if (it != m_Properties.end())
   {
+    this->UnregisterProperty(it);
     it->second = nullptr;
     m_Properties.erase(it);
     Modified();
@@ -197,6 +244,7 @@ void mitk::PropertyList::Clear()
   auto it = m_Properties.begin(), end = m_Properties.end();
   while (it != end)
   {
+    this->UnregisterProperty(it);
     it->second = nullptr;
     ++it;
   }
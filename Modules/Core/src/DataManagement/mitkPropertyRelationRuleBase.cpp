@@ -19,8 +19,8 @@ found in the LICENSE file.
 #include <mitkUIDGenerator.h>
 
 #include <mutex>
-#include <regex>
 #include <algorithm>
+#include <cctype>
 
 bool mitk::PropertyRelationRuleBase::IsAbstract() const
 {
@@ -109,6 +109,132 @@ std::vector<std::string> mitk::PropertyRelationRuleBase::GetPropertyKeys(const m
 }
 //end workaround for T24729
 
+namespace
+{
+  using PropertyListStampsType = std::vector<std::pair<const mitk::PropertyList *, itk::ModifiedTimeType>>;
+
+  /** Collects the property lists the relation properties of the owner are read from, together with their current
+  modification times. Returns false if the type of the owner does not allow to track modifications.*/
+  bool GetPropertyListStamps(const mitk::IPropertyProvider *owner, PropertyListStampsType &stamps)
+  {
+    std::vector<const mitk::PropertyList *> lists;
+
+    if (auto node = dynamic_cast<const mitk::DataNode *>(owner))
+    {
+      lists.push_back(node->GetPropertyList());
+      if (nullptr != node->GetData())
+      {
+        lists.push_back(node->GetData()->GetPropertyList().GetPointer());
+      }
+    }
+    else if (auto data = dynamic_cast<const mitk::BaseData *>(owner))
+    {
+      lists.push_back(data->GetPropertyList().GetPointer());
+    }
+    else if (auto list = dynamic_cast<const mitk::PropertyList *>(owner))
+    {
+      lists.push_back(list);
+    }
+    else
+    {
+      return false;
+    }
+
+    // MTimes are unique over all objects, so a list that was recreated at the same address never matches
+    for (auto list : lists)
+    {
+      stamps.emplace_back(list, list->GetMTime());
+    }
+
+    return true;
+  }
+
+  bool IsInstanceIDCharacter(char c)
+  {
+    return std::isalnum(static_cast<unsigned char>(c)) || '-' == c || ' ' == c;
+  }
+
+  /** Bounds the memory held for owners that were deleted meanwhile.*/
+  const std::size_t RelationIndexCacheMaxSize = 1024;
+}
+
+std::shared_ptr<const mitk::PropertyRelationRuleBase::RelationIndex> mitk::PropertyRelationRuleBase::GetRelationIndex(
+  const IPropertyProvider *source)
+{
+  using CacheEntryType = std::pair<PropertyListStampsType, std::shared_ptr<const RelationIndex>>;
+  static std::mutex cacheLock;
+  static std::map<const IPropertyProvider *, CacheEntryType> cache;
+
+  PropertyListStampsType stamps;
+  const bool isCacheable = GetPropertyListStamps(source, stamps);
+
+  if (isCacheable)
+  {
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto finding = cache.find(source);
+    if (finding != cache.end() && finding->second.first == stamps)
+    {
+      return finding->second.second;
+    }
+  }
+
+  auto index = std::make_shared<RelationIndex>();
+  const auto prefix = PropertyKeyPathToPropertyName(GetRootKeyPath()) + ".";
+
+  //workaround until T24729 is done. You can use directly source->GetPropertyKeys again, when fixed.
+  const auto keys = GetPropertyKeys(source);
+  //end workaround for T24729
+
+  for (const auto &key : keys)
+  {
+    if (0 != key.compare(0, prefix.size(), prefix))
+    {
+      continue;
+    }
+
+    const auto instanceIDEnd = key.find('.', prefix.size());
+    if (std::string::npos == instanceIDEnd || prefix.size() == instanceIDEnd || key.size() == instanceIDEnd + 1 ||
+        !std::all_of(key.begin() + prefix.size(), key.begin() + instanceIDEnd, IsInstanceIDCharacter))
+    {
+      continue;
+    }
+
+    auto prop = source->GetConstProperty(key);
+    if (prop.IsNotNull())
+    {
+      auto &instance = index->instances[key.substr(prefix.size(), instanceIDEnd - prefix.size())];
+      instance[key.substr(instanceIDEnd + 1)] = prop->GetValueAsString();
+    }
+  }
+
+  for (const auto &instance : index->instances)
+  {
+    auto finding = instance.second.find("relationUID");
+    if (finding != instance.second.end())
+    {
+      index->instanceIDByRelationUID.emplace(finding->second, instance.first);
+    }
+
+    finding = instance.second.find("destinationUID");
+    if (finding != instance.second.end())
+    {
+      index->instanceIDsByDestinationUID.emplace(finding->second, instance.first);
+    }
+  }
+
+  if (isCacheable)
+  {
+    std::lock_guard<std::mutex> guard(cacheLock);
+    if (cache.size() >= RelationIndexCacheMaxSize && cache.find(source) == cache.end())
+    {
+      cache.clear();
+    }
+    cache[source] = CacheEntryType(stamps, index);
+  }
+
+  return index;
+}
+
 bool mitk::PropertyRelationRuleBase::IsSource(const IPropertyProvider *owner) const
 {
   return !this->GetExistingRelations(owner).empty();
@@ -221,25 +347,15 @@ mitk::PropertyRelationRuleBase::RelationUIDVectorType mitk::PropertyRelationRule
 
   if (layer != RelationType::Data)
   {
-    auto ruleIDRegExStr = this->GetRIIPropertyRegEx("ruleID");
-    auto regEx = std::regex(ruleIDRegExStr);
+    const auto index = GetRelationIndex(source);
 
-    //workaround until T24729 is done. You can use directly source->GetPropertyKeys again, when fixed.
-    const auto keys = GetPropertyKeys(source);
-    //end workaround for T24729
-
-    for (const auto& key : keys)
+    for (const auto& instance : index->instances)
     {
-      if (std::regex_match(key, regEx))
+      const auto ruleID = instance.second.find("ruleID");
+      if (ruleID != instance.second.end() && this->IsSupportedRuleID(ruleID->second))
       {
-        auto idProp = source->GetConstProperty(key);
-        auto ruleID = idProp->GetValueAsString();
-        if (this->IsSupportedRuleID(ruleID))
-        {
-          auto instanceID = this->GetInstanceIDByPropertyName(key);
-          instanceIDs.emplace_back(instanceID);
-          relationUIDs.push_back(this->GetRelationUIDByInstanceID(source, instanceID));
-        }
+        instanceIDs.emplace_back(instance.first);
+        relationUIDs.push_back(this->GetRelationUIDByInstanceID(source, instance.first));
       }
     }
   }
@@ -369,34 +485,10 @@ mitk::PropertyRelationRuleBase::InstanceIDType mitk::PropertyRelationRuleBase::G
     mitkThrow() << "Error. Passed source pointer is NULL";
   }
 
-  InstanceIDType result = NULL_INSTANCE_ID();
-
-  auto destRegExStr =
-    PropertyKeyPathToPropertyRegEx(GetRIIRelationUIDPropertyKeyPath());
-  auto regEx = std::regex(destRegExStr);
-  std::smatch instance_matches;
-
-  //workaround until T24729 is done. You can use directly source->GetPropertyKeys again, when fixed.
-  const auto keys = GetPropertyKeys(source);
-  //end workaround for T24729
-
-  for (const auto &key : keys)
-  {
-    if (std::regex_search(key, instance_matches, regEx))
-    {
-      auto idProp = source->GetConstProperty(key);
-      if (idProp->GetValueAsString() == relationUID)
-      {
-        if (instance_matches.size()>1)
-        {
-          result = instance_matches[1];
-          break;
-        }
-      }
-    }
-  }
+  const auto index = GetRelationIndex(source);
+  const auto finding = index->instanceIDByRelationUID.find(relationUID);
 
-  return result;
+  return finding != index->instanceIDByRelationUID.end() ? finding->second : NULL_INSTANCE_ID();
 }
 
 mitk::PropertyRelationRuleBase::InstanceIDVectorType mitk::PropertyRelationRuleBase::GetInstanceID_IDLayer(
@@ -417,33 +509,14 @@ mitk::PropertyRelationRuleBase::InstanceIDVectorType mitk::PropertyRelationRuleB
 
   if (identifiable)
   { // check for relations of type Connected_ID;
+    const auto index = GetRelationIndex(source);
+    const auto range = index->instanceIDsByDestinationUID.equal_range(identifiable->GetUID());
 
-    auto destRegExStr = this->GetRIIPropertyRegEx("destinationUID");
-    auto regEx = std::regex(destRegExStr);
-    std::smatch instance_matches;
-
-    auto destUID = identifiable->GetUID();
-
-    //workaround until T24729 is done. You can use directly source->GetPropertyKeys again, when fixed.
-    const auto keys = GetPropertyKeys(source);
-    //end workaround for T24729
-
-    for (const auto &key : keys)
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      if (std::regex_search(key, instance_matches, regEx))
+      if (this->IsSupportedRuleID(GetRuleIDByInstanceID(source, iter->second)))
       {
-        auto idProp = source->GetConstProperty(key);
-        if (idProp->GetValueAsString() == destUID)
-        {
-          if (instance_matches.size()>1)
-          {
-            auto instanceID = instance_matches[1];
-            if (this->IsSupportedRuleID(GetRuleIDByInstanceID(source, instanceID)))
-            {
-              result.push_back(instanceID);
-            }
-          }
-        }
+        result.push_back(iter->second);
       }
     }
   }
@@ -625,24 +698,13 @@ mitk::PropertyRelationRuleBase::InstanceIDType mitk::PropertyRelationRuleBase::C
   std::vector<int> instanceIDs;
   InstanceIDType newID = "1";
 
-  auto destRegExStr =
-    PropertyKeyPathToPropertyRegEx(GetRIIRelationUIDPropertyKeyPath());
-  auto regEx = std::regex(destRegExStr);
-  std::smatch instance_matches;
+  const auto index = GetRelationIndex(source);
 
-  //workaround until T24729 is done. You can use directly source->GetPropertyKeys again, when fixed.
-  const auto keys = GetPropertyKeys(source);
-  //end workaround for T24729
-
-
-  for (const auto &key : keys)
+  for (const auto &instance : index->instances)
   {
-    if (std::regex_search(key, instance_matches, regEx))
+    if (instance.second.find("relationUID") != instance.second.end())
     {
-      if (instance_matches.size()>1)
-      {
-        instanceIDs.push_back(std::stoi(instance_matches[1]));
-      }
+      instanceIDs.push_back(std::stoi(instance.first));
     }
   }
 
@@ -101,30 +101,23 @@ mitk::SourceImageRelationRule::GetRelationUIDs_DataLayer(const IPropertyProvider
 
   auto relevantIndicesAndRuleIDs = GetReferenceSequenceIndices(source, destination, instances_IDLayer);
 
-  auto itemRIIRegExStr = this->GetRIIPropertyRegEx("SourceImageSequenceItem");
-  auto regEx = std::regex(itemRIIRegExStr);
-
-  //workaround until T24729 is done. Please remove if T24728 is done
-  auto keys = PropertyRelationRuleBase::GetPropertyKeys(source);
-  //end workaround for T24729
+  const auto index = GetRelationIndex(source);
 
   for (const auto &indexNRule : relevantIndicesAndRuleIDs)
   {
     bool relationCoveredByRII = false;
-    for (const auto& key : keys)
+    const auto sequenceItem = std::to_string(indexNRule.first);
+
+    for (const auto& instance : index->instances)
     {
-      if (std::regex_match(key, regEx))
+      const auto sequItemFinding = instance.second.find("SourceImageSequenceItem");
+      if (sequItemFinding != instance.second.end() && sequItemFinding->second == sequenceItem)
       {
-        auto sequItemProp = source->GetConstProperty(key);
-        if (sequItemProp.IsNotNull() && sequItemProp->GetValueAsString() == std::to_string(indexNRule.first))
+        relationCoveredByRII = true;
+        auto ruleID = GetRuleIDByInstanceID(source, instance.first);
+        if (this->IsSupportedRuleID(ruleID))
         {
-          relationCoveredByRII = true;
-          auto instanceID = GetInstanceIDByPropertyName(key);
-          auto ruleID = GetRuleIDByInstanceID(source, instanceID);
-          if (this->IsSupportedRuleID(ruleID))
-          {
-            result.emplace_back(this->GetRelationUIDByInstanceID(source, instanceID), ruleID);
-          }
+          result.emplace_back(this->GetRelationUIDByInstanceID(source, instance.first), ruleID);
         }
       }
     }
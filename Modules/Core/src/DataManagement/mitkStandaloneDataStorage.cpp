@@ -14,11 +14,388 @@ found in the LICENSE file.
 
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateOr.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
+#include "mitkStringProperty.h"
 
-mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <typeinfo>
+
+namespace
+{
+  // Queries for further property keys are answered by checking every node. This keeps the costs
+  // of re-indexing a node bounded if many different keys are queried, e.g. UID properties.
+  constexpr std::size_t MaxNumberOfIndexedPropertyKeys = 32;
+
+  template <class TPredicate>
+  const TPredicate *GetPredicateOfType(const mitk::NodePredicateBase *predicate)
+  {
+    // derived predicates may change the semantics of CheckNode(), so only the exact type is indexed
+    return typeid(*predicate) == typeid(TPredicate) ? static_cast<const TPredicate *>(predicate) : nullptr;
+  }
+
+  // Equal properties of these types have an equal GetValueAsString(). Other types, e.g. lookup
+  // table properties, are compared by content but print their address.
+  bool HasComparableValueString(const mitk::BaseProperty *property)
+  {
+    const auto &type = typeid(*property);
+    return type == typeid(mitk::StringProperty) || type == typeid(mitk::BoolProperty) ||
+           type == typeid(mitk::IntProperty) || type == typeid(mitk::UIntProperty) ||
+           type == typeid(mitk::FloatProperty) || type == typeid(mitk::DoubleProperty);
+  }
+}
+
+/**
+ * Data type and property value buckets of the nodes of a StandaloneDataStorage.
+ *
+ * The buckets are sets of node pointers, so candidates are in the same order as the nodes in GetAll().
+ * Modified nodes are only collected by MarkNodeModified() and re-indexed by the next query, because
+ * many modified events (e.g. while setting up a node) would otherwise each re-index the node.
+ */
+class mitk::StandaloneDataStorage::NodeIndex
+{
+public:
+  NodeIndex() { m_PropertyBuckets["name"]; }
+
+  ~NodeIndex()
+  {
+    for (auto &entry : m_Entries)
+      this->RemoveFromIndex(entry.first, entry.second);
+  }
+
+  void AddNode(const DataNode *node)
+  {
+    std::lock_guard<std::mutex> locked(m_Mutex);
+
+    auto &entry = m_Entries[node];
+    entry.command = NodeModifiedCommand::New();
+    entry.command->Initialize(this, node);
+
+    this->MarkNodeModified(node);
+  }
+
+  void RemoveNode(const DataNode *node)
+  {
+    std::lock_guard<std::mutex> locked(m_Mutex);
+
+    auto finding = m_Entries.find(node);
+    if (finding == m_Entries.end())
+      return;
+
+    this->RemoveFromIndex(node, finding->second);
+    m_Entries.erase(finding);
+
+    std::lock_guard<std::mutex> modifiedNodesLocked(m_ModifiedNodesMutex);
+    m_ModifiedNodes.erase(node);
+  }
+
+  void MarkNodeModified(const DataNode *node)
+  {
+    std::lock_guard<std::mutex> locked(m_ModifiedNodesMutex);
+    m_ModifiedNodes.insert(node);
+  }
+
+  /** Returns the candidates of the condition in the order of GetAll() or nullptr if the condition is not indexed. */
+  SetOfObjects::Pointer GetCandidates(const NodePredicateBase *condition)
+  {
+    std::lock_guard<std::mutex> locked(m_Mutex);
+
+    this->UpdateModifiedNodes();
+
+    NodeSet candidates;
+    if (!this->GetCandidates(condition, candidates))
+      return nullptr;
+
+    auto result = SetOfObjects::New();
+
+    for (auto node : candidates)
+      result->InsertElement(result->Size(), const_cast<DataNode *>(node));
+
+    return result;
+  }
+
+private:
+  typedef std::set<const DataNode *> NodeSet;
+  typedef std::map<std::string, NodeSet> BucketMap;
+
+  /** Nodes having a property with a certain key. */
+  struct PropertyBuckets
+  {
+    /** Nodes by the value string of their property. */
+    BucketMap nodesByValue;
+    /** Nodes whose property does not have a comparable value string. */
+    NodeSet otherNodes;
+  };
+
+  /** Forwards modified events of everything a node is indexed by to MarkNodeModified(). */
+  class NodeModifiedCommand : public itk::Command
+  {
+  public:
+    mitkClassMacroItkParent(NodeModifiedCommand, itk::Command);
+    itkFactorylessNewMacro(Self);
+
+    void Initialize(NodeIndex *index, const DataNode *node)
+    {
+      m_Index = index;
+      m_Node = node;
+    }
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Index->MarkNodeModified(m_Node); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Index->MarkNodeModified(m_Node); }
+
+  private:
+    NodeIndex *m_Index = nullptr;
+    const DataNode *m_Node = nullptr;
+  };
+
+  struct IndexedProperty
+  {
+    BaseProperty::Pointer property;
+    bool hasComparableValue;
+    std::string value;
+    unsigned long observerTag;
+  };
+
+  struct Entry
+  {
+    NodeModifiedCommand::Pointer command;
+    std::string dataType;
+    PropertyList::Pointer dataPropertyList;
+    unsigned long dataPropertyListObserverTag = 0;
+    std::map<std::string, IndexedProperty> properties;
+  };
+
+  static void RemoveFromBucket(BucketMap &buckets, const std::string &key, const DataNode *node)
+  {
+    auto finding = buckets.find(key);
+    if (finding == buckets.end())
+      return;
+
+    finding->second.erase(node);
+    if (finding->second.empty())
+      buckets.erase(finding);
+  }
+
+  void RemoveFromIndex(const DataNode *node, Entry &entry)
+  {
+    if (!entry.dataType.empty())
+      RemoveFromBucket(m_NodesByDataType, entry.dataType, node);
+
+    entry.dataType.clear();
+
+    if (entry.dataPropertyList.IsNotNull())
+      entry.dataPropertyList->RemoveObserver(entry.dataPropertyListObserverTag);
+
+    entry.dataPropertyList = nullptr;
+
+    for (auto &indexedProperty : entry.properties)
+    {
+      auto &buckets = m_PropertyBuckets[indexedProperty.first];
+
+      if (indexedProperty.second.hasComparableValue)
+        RemoveFromBucket(buckets.nodesByValue, indexedProperty.second.value, node);
+      else
+        buckets.otherNodes.erase(node);
+
+      indexedProperty.second.property->RemoveObserver(indexedProperty.second.observerTag);
+    }
+
+    entry.properties.clear();
+  }
+
+  void IndexProperty(const DataNode *node, Entry &entry, const std::string &key, PropertyBuckets &buckets)
+  {
+    auto property = node->GetProperty(key.c_str());
+    if (nullptr == property)
+      return;
+
+    IndexedProperty indexedProperty;
+    indexedProperty.property = property;
+    indexedProperty.hasComparableValue = HasComparableValueString(property);
+    indexedProperty.observerTag = property->AddObserver(itk::ModifiedEvent(), entry.command);
+
+    if (indexedProperty.hasComparableValue)
+    {
+      indexedProperty.value = property->GetValueAsString();
+      buckets.nodesByValue[indexedProperty.value].insert(node);
+    }
+    else
+    {
+      buckets.otherNodes.insert(node);
+    }
+
+    entry.properties[key] = indexedProperty;
+  }
+
+  void Index(const DataNode *node, Entry &entry)
+  {
+    auto data = node->GetData();
+
+    if (nullptr != data)
+    {
+      entry.dataType = data->GetNameOfClass();
+      m_NodesByDataType[entry.dataType].insert(node);
+
+      // properties of the data are found by GetProperty() if the node does not have them
+      entry.dataPropertyList = data->GetPropertyList();
+      if (entry.dataPropertyList.IsNotNull())
+        entry.dataPropertyListObserverTag = entry.dataPropertyList->AddObserver(itk::ModifiedEvent(), entry.command);
+    }
+
+    for (auto &buckets : m_PropertyBuckets)
+      this->IndexProperty(node, entry, buckets.first, buckets.second);
+  }
+
+  void UpdateModifiedNodes()
+  {
+    NodeSet modifiedNodes;
+    {
+      std::lock_guard<std::mutex> locked(m_ModifiedNodesMutex);
+      modifiedNodes.swap(m_ModifiedNodes);
+    }
+
+    for (auto node : modifiedNodes)
+    {
+      auto finding = m_Entries.find(node);
+      if (finding == m_Entries.end())
+        continue;
+
+      this->RemoveFromIndex(node, finding->second);
+      this->Index(node, finding->second);
+    }
+  }
+
+  /** Returns the buckets of the property key, which is indexed on demand, or nullptr. */
+  const PropertyBuckets *GetPropertyBuckets(const std::string &key)
+  {
+    auto finding = m_PropertyBuckets.find(key);
+    if (finding != m_PropertyBuckets.end())
+      return &(finding->second);
+
+    if (m_PropertyBuckets.size() >= MaxNumberOfIndexedPropertyKeys)
+      return nullptr;
+
+    auto &buckets = m_PropertyBuckets[key];
+    for (auto &entry : m_Entries)
+      this->IndexProperty(entry.first, entry.second, key, buckets);
+
+    return &buckets;
+  }
+
+  bool GetCandidates(const NodePredicateBase *condition, NodeSet &candidates)
+  {
+    if (nullptr == condition)
+      return false;
+
+    if (auto dataTypePredicate = GetPredicateOfType<NodePredicateDataType>(condition))
+    {
+      auto finding = m_NodesByDataType.find(dataTypePredicate->GetValidDataType());
+      if (finding != m_NodesByDataType.end())
+        candidates = finding->second;
+
+      return true;
+    }
+
+    if (auto propertyPredicate = GetPredicateOfType<NodePredicateProperty>(condition))
+    {
+      if (nullptr != propertyPredicate->GetRenderer() || propertyPredicate->GetValidPropertyName().empty())
+        return false;
+
+      auto buckets = this->GetPropertyBuckets(propertyPredicate->GetValidPropertyName());
+      if (nullptr == buckets)
+        return false;
+
+      auto validProperty = propertyPredicate->GetValidProperty();
+
+      if (nullptr != validProperty && HasComparableValueString(validProperty))
+      {
+        // properties of a different type are never equal, so the other nodes are no candidates
+        auto finding = buckets->nodesByValue.find(validProperty->GetValueAsString());
+        if (finding != buckets->nodesByValue.end())
+          candidates = finding->second;
+      }
+      else
+      {
+        for (const auto &bucket : buckets->nodesByValue)
+          candidates.insert(bucket.second.begin(), bucket.second.end());
+
+        candidates.insert(buckets->otherNodes.begin(), buckets->otherNodes.end());
+      }
+
+      return true;
+    }
+
+    if (auto andPredicate = GetPredicateOfType<NodePredicateAnd>(condition))
+    {
+      // children that are not indexed are left to CheckNode()
+      bool isIndexed = false;
+
+      for (const auto &child : andPredicate->GetPredicates())
+      {
+        NodeSet childCandidates;
+        if (!this->GetCandidates(child, childCandidates))
+          continue;
+
+        if (isIndexed)
+        {
+          NodeSet intersection;
+          std::set_intersection(candidates.begin(),
+                                candidates.end(),
+                                childCandidates.begin(),
+                                childCandidates.end(),
+                                std::inserter(intersection, intersection.end()));
+          candidates.swap(intersection);
+        }
+        else
+        {
+          candidates.swap(childCandidates);
+          isIndexed = true;
+        }
+      }
+
+      return isIndexed;
+    }
+
+    if (auto orPredicate = GetPredicateOfType<NodePredicateOr>(condition))
+    {
+      const auto children = orPredicate->GetPredicates();
+      if (children.empty())
+        return false;
+
+      for (const auto &child : children)
+      {
+        NodeSet childCandidates;
+        if (!this->GetCandidates(child, childCandidates))
+          return false;
+
+        candidates.insert(childCandidates.begin(), childCandidates.end());
+      }
+
+      return true;
+    }
+
+    return false;
+  }
+
+  std::mutex m_Mutex;
+  std::map<const DataNode *, Entry> m_Entries;
+  BucketMap m_NodesByDataType;
+  std::map<std::string, PropertyBuckets> m_PropertyBuckets;
+
+  // guarded separately, because modified events may be sent while m_Mutex is locked
+  std::mutex m_ModifiedNodesMutex;
+  NodeSet m_ModifiedNodes;
+};
+
+mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage(), m_NodeIndex(new NodeIndex)
 {
 }
 
@@ -79,6 +456,9 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    if (node != nullptr)
+      m_NodeIndex->AddNode(node);
   }
 
   /* Notify observers */
@@ -110,6 +490,7 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
     /* remove node from both relation adjacency lists */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
+    m_NodeIndex->RemoveNode(node);
   }
 }
 
@@ -159,6 +540,17 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAl
   return SetOfObjects::ConstPointer(resultset);
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubset(
+  const NodePredicateBase *condition) const
+{
+  auto candidates = m_NodeIndex->GetCandidates(condition);
+
+  if (candidates.IsNull())
+    return Superclass::GetSubset(condition);
+
+  return this->FilterSetOfObjects(candidates, condition);
+}
+
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRelations(
   const mitk::DataNode *node,
   const AdjacencyList &relation,
@@ -249,6 +641,11 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetDe
   return this->GetRelations(node, m_DerivedNodes, condition, onlyDirectDerivations);
 }
 
+void mitk::StandaloneDataStorage::OnNodeModified(const mitk::DataNode *node)
+{
+  m_NodeIndex->MarkNodeModified(node);
+}
+
 void mitk::StandaloneDataStorage::PrintSelf(std::ostream &os, itk::Indent indent) const
 {
   os << indent << "StandaloneDataStorage:\n";
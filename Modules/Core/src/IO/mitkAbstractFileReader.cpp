@@ -128,6 +128,8 @@ namespace mitk
     return result;
   }
 
+  bool AbstractFileReader::RequiresTargetDataStorage() const { return false; }
+
   IFileReader::ConfidenceLevel AbstractFileReader::GetConfidenceLevel() const
   {
     if (d->m_Stream)
@@ -133,4 +133,28 @@ namespace mitk
     static std::string s("org.mitk.io.Size t");
     return s;
   }
+
+  std::string IOConstants::LOADING_STRATEGY()
+  {
+    static std::string s("org.mitk.io.Loading Strategy");
+    return s;
+  }
+
+  std::string IOConstants::LOADING_STRATEGY_READ()
+  {
+    static std::string s("Read into memory");
+    return s;
+  }
+
+  std::string IOConstants::LOADING_STRATEGY_LAZY()
+  {
+    static std::string s("Memory map / stream");
+    return s;
+  }
+
+  std::string IOConstants::LOADING_STRATEGY_ENUM()
+  {
+    static std::string s("org.mitk.io.Loading Strategy.enum");
+    return s;
+  }
 }
@@ -36,8 +36,16 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
 
 static std::string GetLastErrorStr()
 {
@@ -313,8 +321,32 @@ namespace mitk
     };
 
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
+
+    static IFileReader *SelectReader(LoadInfo &loadInfo,
+                                     std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                     const ReaderOptionsFunctorBase *optionsCallback,
+                                     std::string &errMsg,
+                                     bool &abort);
+
+    static DataStorage::SetOfObjects::Pointer ReadNodes(IFileReader *reader);
+
+    static void CollectNodes(LoadInfo &loadInfo,
+                             const DataStorage::SetOfObjects *nodes,
+                             DataStorage::SetOfObjects *nodeResult,
+                             std::string &errMsg);
+
+    static void TransferNodes(const DataStorage *source, const DataStorage::SetOfObjects *nodes, DataStorage *target);
+
+    static std::string LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                        DataStorage::SetOfObjects *nodeResult,
+                                        DataStorage *ds,
+                                        const ReaderOptionsFunctorBase *optionsCallback);
+
+    static std::atomic<unsigned int> NumberOfLoadThreads;
   };
 
+  std::atomic<unsigned int> IOUtil::Impl::NumberOfLoadThreads(1);
+
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
                                                        const ReaderOptionsFunctorBase *optionsCallback)
   {
@@ -374,6 +406,16 @@ namespace mitk
 #endif
   }
 
+  void IOUtil::SetNumberOfLoadThreads(unsigned int numberOfThreads)
+  {
+    Impl::NumberOfLoadThreads = std::max(numberOfThreads, 1u);
+  }
+
+  unsigned int IOUtil::GetNumberOfLoadThreads()
+  {
+    return Impl::NumberOfLoadThreads;
+  }
+
   std::string IOUtil::GetTempPath()
   {
     static std::string result;
@@ -576,6 +618,11 @@ namespace mitk
       return "No input files given";
     }
 
+    if (GetNumberOfLoadThreads() > 1 && loadInfos.size() > 1)
+    {
+      return Impl::LoadConcurrently(loadInfos, nodeResult, ds, optionsCallback);
+    }
+
     int filesToRead = loadInfos.size();
     mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
 
@@ -589,145 +636,442 @@ namespace mitk
       if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
         continue;
 
-      std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+      bool abort = false;
+      IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, abort);
+
+      if (abort)
+        break;
+
+      if (reader == nullptr)
+        continue;
+
+      reader->SetProperties(loadInfo.m_Properties);
 
-      if (readers.empty())
+      // Do the actual reading
+      try
       {
-        if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+        const auto startTime = std::chrono::steady_clock::now();
+
+        DataStorage::SetOfObjects::Pointer nodes;
+        if (ds != nullptr)
         {
-          errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+          nodes = reader->Read(*ds);
         }
         else
         {
-          errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+          nodes = Impl::ReadNodes(reader);
         }
-        continue;
+
+        loadInfo.m_ReadDuration =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        std::vector< std::string > new_files =  reader->GetReadFiles();
+        read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+
+        Impl::CollectNodes(loadInfo, nodes, nodeResult, errMsg);
+      }
+      catch (const std::exception &e)
+      {
+        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
+      }
+      mitk::ProgressBar::GetInstance()->Progress(2);
+      --filesToRead;
+    }
+
+    if (!errMsg.empty())
+    {
+      MITK_ERROR << errMsg;
+    }
+
+    mitk::ProgressBar::GetInstance()->Progress(2 * filesToRead);
+
+    return errMsg;
+  }
+
+  IFileReader *IOUtil::Impl::SelectReader(LoadInfo &loadInfo,
+                                          std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                          std::string &errMsg,
+                                          bool &abort)
+  {
+    std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+
+    if (readers.empty())
+    {
+      if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+      {
+        errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+      }
+      else
+      {
+        errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
       }
+      return nullptr;
+    }
 
-      bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+    bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
 
-      // check if we already used a reader which should be re-used
-      std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
-      std::string selectedMimeType;
-      for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
-                                                 mimeTypeIterEnd = currMimeTypes.end();
-           mimeTypeIter != mimeTypeIterEnd;
-           ++mimeTypeIter)
+    // check if we already used a reader which should be re-used
+    std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
+    std::string selectedMimeType;
+    for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
+                                               mimeTypeIterEnd = currMimeTypes.end();
+         mimeTypeIter != mimeTypeIterEnd;
+         ++mimeTypeIter)
+    {
+      std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
+        usedReaderItems.find(mimeTypeIter->GetName());
+      if (oldSelectedItemIter != usedReaderItems.end())
       {
-        std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
-          usedReaderItems.find(mimeTypeIter->GetName());
-        if (oldSelectedItemIter != usedReaderItems.end())
+        // we found an already used item for a mime-type which is contained
+        // in the current reader set, check all current readers if there service
+        // id equals the old reader
+        for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
+                                                                   currReaderItemEnd = readers.end();
+             currReaderItem != currReaderItemEnd;
+             ++currReaderItem)
         {
-          // we found an already used item for a mime-type which is contained
-          // in the current reader set, check all current readers if there service
-          // id equals the old reader
-          for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
-                                                                     currReaderItemEnd = readers.end();
-               currReaderItem != currReaderItemEnd;
-               ++currReaderItem)
+          if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
+              currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
+              currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
           {
-            if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
-                currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
-                currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
-            {
-              // okay, we used the same reader already, re-use its options
-              selectedMimeType = mimeTypeIter->GetName();
-              callOptionsCallback = false;
-              loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
-              loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
-                oldSelectedItemIter->second.GetReader()->GetOptions());
-              break;
-            }
-          }
-          if (!selectedMimeType.empty())
+            // okay, we used the same reader already, re-use its options
+            selectedMimeType = mimeTypeIter->GetName();
+            callOptionsCallback = false;
+            loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
+            loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
+              oldSelectedItemIter->second.GetReader()->GetOptions());
             break;
+          }
         }
+        if (!selectedMimeType.empty())
+          break;
       }
+    }
 
-      if (callOptionsCallback && optionsCallback)
+    if (callOptionsCallback && optionsCallback)
+    {
+      callOptionsCallback = (*optionsCallback)(loadInfo);
+      if (!callOptionsCallback && !loadInfo.m_Cancel)
       {
-        callOptionsCallback = (*optionsCallback)(loadInfo);
-        if (!callOptionsCallback && !loadInfo.m_Cancel)
-        {
-          usedReaderItems.erase(selectedMimeType);
-          FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
-          usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
-        }
+        usedReaderItems.erase(selectedMimeType);
+        FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
+        usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+      }
+    }
+
+    if (loadInfo.m_Cancel)
+    {
+      errMsg += "Reading operation(s) cancelled.";
+      abort = true;
+      return nullptr;
+    }
+
+    IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      errMsg += "Unexpected nullptr reader.";
+      abort = true;
+    }
+
+    return reader;
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Impl::ReadNodes(IFileReader *reader)
+  {
+    auto nodes = DataStorage::SetOfObjects::New();
+    std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
+    for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    {
+      if (iter->IsNotNull())
+      {
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(*iter);
+        nodes->InsertElement(nodes->Size(), node);
       }
+    }
+    return nodes;
+  }
 
-      if (loadInfo.m_Cancel)
+  void IOUtil::Impl::CollectNodes(LoadInfo &loadInfo,
+                                  const DataStorage::SetOfObjects *nodes,
+                                  DataStorage::SetOfObjects *nodeResult,
+                                  std::string &errMsg)
+  {
+    for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
+         nodeIter != nodeIterEnd;
+         ++nodeIter)
+    {
+      const mitk::DataNode::Pointer &node = nodeIter->Value();
+      mitk::BaseData::Pointer data = node->GetData();
+      if (data.IsNull())
       {
-        errMsg += "Reading operation(s) cancelled.";
-        break;
+        continue;
       }
 
-      IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
-      if (reader == nullptr)
+      data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+
+      loadInfo.m_Output.push_back(data);
+      if (nodeResult)
+      {
+        nodeResult->push_back(nodeIter->Value());
+      }
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+  }
+
+  void IOUtil::Impl::TransferNodes(const DataStorage *source,
+                                   const DataStorage::SetOfObjects *nodes,
+                                   DataStorage *target)
+  {
+    // Parents have to be added before their derivations. Start with the nodes
+    // in the order returned by the reader and add any remaining ones afterwards.
+    std::set<const DataNode *> transferredNodes;
+
+    std::function<void(DataNode *)> transfer = [&](DataNode *node) {
+      if (!transferredNodes.insert(node).second)
+        return;
+
+      auto sources = source->GetSources(node, nullptr, true);
+
+      for (const auto &sourceNode : *sources)
+        transfer(sourceNode);
+
+      target->Add(node, sources);
+    };
+
+    for (const auto &node : *nodes)
+      transfer(node);
+
+    auto allNodes = source->GetAll();
+
+    for (const auto &node : *allNodes)
+      transfer(node);
+  }
+
+  std::string IOUtil::Impl::LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                             DataStorage::SetOfObjects *nodeResult,
+                                             DataStorage *ds,
+                                             const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    const std::size_t numberOfFiles = loadInfos.size();
+    int filesToRead = numberOfFiles;
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
+
+    std::string errMsg;
+
+    // Select readers and call the options callback on the calling thread
+    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+    std::vector<IFileReader *> readers(numberOfFiles, nullptr);
+
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      bool abort = false;
+      readers[i] = SelectReader(loadInfos[i], usedReaderItems, optionsCallback, errMsg, abort);
+
+      if (abort)
       {
-        errMsg += "Unexpected nullptr reader.";
+        readers[i] = nullptr;
         break;
       }
 
-      reader->SetProperties(loadInfo.m_Properties);
+      if (readers[i] != nullptr)
+        readers[i]->SetProperties(loadInfos[i].m_Properties);
+    }
 
-      // Do the actual reading
-      try
+    // Readers that depend on the nodes of the target DataStorage (e.g. scene
+    // readers) are run sequentially into it on the calling thread, below.
+    std::vector<bool> readIntoTarget(numberOfFiles, false);
+
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      if (ds != nullptr && readers[i] != nullptr)
       {
-        DataStorage::SetOfObjects::Pointer nodes;
-        if (ds != nullptr)
-        {
-          nodes = reader->Read(*ds);
+        auto abstractReader = dynamic_cast<const AbstractFileReader *>(readers[i]);
+        readIntoTarget[i] = abstractReader == nullptr || abstractReader->RequiresTargetDataStorage();
+      }
+    }
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-        else
-        {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    // Run the other readers on a bounded pool of worker threads. Readers writing to
+    // a DataStorage get a private one, the final DataStorage is only touched below.
+    struct ReadResult
+    {
+      DataStorage::Pointer Storage;
+      DataStorage::SetOfObjects::Pointer Nodes;
+      std::vector<std::string> ReadFiles;
+      std::string ErrMsg;
+      bool Skipped = false;
+      bool Done = false;
+    };
+
+    std::vector<ReadResult> results(numberOfFiles);
+    std::atomic<std::size_t> nextFile(0);
+
+    // A reader may consume the paths of following files (e.g. a DICOM series).
+    // A file therefore waits for the first preceding file of the same reader
+    // service. If that one read more than its own path, the file also waits
+    // for all other preceding files of that reader. Files consumed in the
+    // meantime are skipped. Files are handed out in order and only wait for
+    // preceding ones, so the workers cannot block each other. Files read into
+    // the target storage are never waited for, as all files of their reader
+    // service are read into it.
+    std::vector<long> serviceIds(numberOfFiles, -1);
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      if (readers[i] != nullptr && !readIntoTarget[i])
+        serviceIds[i] = loadInfos[i].m_ReaderSelector.GetSelected().GetServiceId();
+      else
+        results[i].Done = true;
+    }
+
+    std::mutex consumedFilesMutex;
+    std::condition_variable fileDone;
+    std::set<std::string> consumedFiles;
+
+    auto waitForPrecedingFiles = [&](std::size_t i, std::unique_lock<std::mutex> &lock) {
+      const std::size_t firstFile =
+        std::find(serviceIds.begin(), serviceIds.begin() + i, serviceIds[i]) - serviceIds.begin();
+      if (firstFile == i)
+        return;
+
+      fileDone.wait(lock, [&]() { return results[firstFile].Done; });
+
+      if (results[firstFile].ReadFiles.size() > 1)
+      {
+        fileDone.wait(lock, [&]() {
+          for (std::size_t j = firstFile; j < i; ++j)
           {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
+            if (serviceIds[j] == serviceIds[i] && !results[j].Done)
+              return false;
           }
+          return true;
+        });
+      }
+    };
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
+    auto worker = [&]() {
+      for (std::size_t i = nextFile++; i < numberOfFiles; i = nextFile++)
+      {
+        if (readers[i] == nullptr || readIntoTarget[i])
+          continue;
 
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
         {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
+          std::unique_lock<std::mutex> lock(consumedFilesMutex);
+          waitForPrecedingFiles(i, lock);
+
+          if (consumedFiles.count(loadInfos[i].m_Path) != 0)
           {
+            results[i].Skipped = true;
+            results[i].Done = true;
+            lock.unlock();
+            fileDone.notify_all();
             continue;
           }
+        }
 
-          data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+        try
+        {
+          const auto startTime = std::chrono::steady_clock::now();
 
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
+          if (ds != nullptr)
+          {
+            results[i].Storage = StandaloneDataStorage::New().GetPointer();
+            results[i].Nodes = readers[i]->Read(*results[i].Storage);
+          }
+          else
           {
-            nodeResult->push_back(nodeIter->Value());
+            results[i].Nodes = ReadNodes(readers[i]);
           }
+
+          loadInfos[i].m_ReadDuration =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+          results[i].ReadFiles = readers[i]->GetReadFiles();
+        }
+        catch (const std::exception &e)
+        {
+          results[i].ErrMsg = "Exception occurred when reading file " + loadInfos[i].m_Path + ":\n" + e.what() + "\n\n";
+        }
+        catch (...)
+        {
+          results[i].ErrMsg = "Unknown exception occurred when reading file " + loadInfos[i].m_Path + "\n\n";
         }
 
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
         {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+          std::lock_guard<std::mutex> lock(consumedFilesMutex);
+          consumedFiles.insert(results[i].ReadFiles.begin(), results[i].ReadFiles.end());
+          results[i].Done = true;
         }
+
+        fileDone.notify_all();
       }
-      catch (const std::exception &e)
+    };
+
+    const std::size_t numberOfThreads = std::min<std::size_t>(GetNumberOfLoadThreads(), numberOfFiles);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+
+    // Merge the results in the order of the given paths
+    std::vector<std::string> read_files;
+
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      if (readers[i] == nullptr)
+        continue;
+
+      auto &loadInfo = loadInfos[i];
+
+      if (results[i].Skipped || std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
       {
-        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
+        // Already consumed by a multi-file reader of a preceding path
+        loadInfo.m_ReadDuration = 0.0;
+      }
+      else if (!results[i].ErrMsg.empty())
+      {
+        errMsg += results[i].ErrMsg;
+      }
+      else
+      {
+        try
+        {
+          if (readIntoTarget[i])
+          {
+            const auto startTime = std::chrono::steady_clock::now();
+
+            results[i].Nodes = readers[i]->Read(*ds);
+
+            loadInfo.m_ReadDuration =
+              std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+            results[i].ReadFiles = readers[i]->GetReadFiles();
+          }
+          else if (ds != nullptr)
+          {
+            TransferNodes(results[i].Storage, results[i].Nodes, ds);
+          }
+
+          read_files.insert(read_files.end(), results[i].ReadFiles.begin(), results[i].ReadFiles.end());
+
+          CollectNodes(loadInfo, results[i].Nodes, nodeResult, errMsg);
+        }
+        catch (const std::exception &e)
+        {
+          errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
+        }
       }
+
+      results[i] = ReadResult();
       mitk::ProgressBar::GetInstance()->Progress(2);
       --filesToRead;
     }
@@ -1009,7 +1353,8 @@ namespace mitk
     : m_Path(path),
       m_ReaderSelector(path),
       m_Cancel(false),
-      m_Properties(nullptr)
+      m_Properties(nullptr),
+      m_ReadDuration(0.0)
   {
   }
 }
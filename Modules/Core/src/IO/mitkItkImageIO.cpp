@@ -11,24 +11,33 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkItkImageIO.h"
+#include "mitkMemoryMappedFile.h"
 
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkCoreServices.h>
 #include <mitkCustomMimeType.h>
 #include <mitkIOMimeTypes.h>
 #include <mitkIPropertyPersistence.h>
+#include <mitkIOConstants.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <memory>
 
 namespace mitk
 {
@@ -38,6 +47,340 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
 
+  namespace
+  {
+    /** Upper bound for the size of a single chunk when streaming pixel data. */
+    const std::size_t STREAMING_CHUNK_SIZE_IN_BYTES = 64 * 1024 * 1024;
+
+    /** Position of the raw, uncompressed pixel data of an image file. */
+    struct RawDataLocation
+    {
+      std::string FileName;
+      std::uint64_t Offset = 0;
+    };
+
+    std::string Trim(const std::string &str)
+    {
+      const auto first = str.find_first_not_of(" \t\r");
+
+      if (std::string::npos == first)
+        return std::string();
+
+      return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    std::string ToLower(std::string str)
+    {
+      std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+      return str;
+    }
+
+    bool EndsWith(const std::string &str, const std::string &suffix)
+    {
+      return str.size() >= suffix.size() && 0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
+    }
+
+    bool IsBigEndianHost()
+    {
+      return itk::ByteSwapper<int>::SystemIsBigEndian();
+    }
+
+    /** Only attached headers with raw encoding in host byte order are supported. */
+    bool LocateNrrdRawData(const std::string &path, RawDataLocation &location)
+    {
+      std::ifstream stream(path, std::ios::binary);
+      std::string line;
+
+      if (!std::getline(stream, line) || 0 != line.compare(0, 4, "NRRD"))
+        return false;
+
+      bool isRaw = false;
+
+      while (std::getline(stream, line))
+      {
+        line = Trim(line);
+
+        if (line.empty()) // Header is terminated by an empty line
+        {
+          if (!isRaw)
+            return false;
+
+          location.FileName = path;
+          location.Offset = static_cast<std::uint64_t>(stream.tellg());
+          return true;
+        }
+
+        const auto pos = line.find(':');
+
+        if ('#' == line[0] || std::string::npos == pos)
+          continue;
+
+        const auto field = ToLower(Trim(line.substr(0, pos)));
+        const auto value = ToLower(Trim(line.substr(pos + 1)));
+
+        if ("encoding" == field)
+        {
+          isRaw = "raw" == value;
+        }
+        else if ("endian" == field)
+        {
+          if (("big" == value) != IsBigEndianHost())
+            return false;
+        }
+        else if ("data file" == field || "datafile" == field || "line skip" == field || "lineskip" == field ||
+                 "byte skip" == field || "byteskip" == field)
+        {
+          return false;
+        }
+      }
+
+      return false;
+    }
+
+    /** Only uncompressed data in host byte order stored in a single (local or external) data file is supported. */
+    bool LocateMetaImageRawData(const std::string &path, std::size_t imageSizeInBytes, RawDataLocation &location)
+    {
+      std::ifstream stream(path, std::ios::binary);
+      std::string line;
+      long long headerSize = 0;
+
+      while (std::getline(stream, line))
+      {
+        const auto pos = line.find('=');
+
+        if (std::string::npos == pos)
+          continue;
+
+        const auto key = Trim(line.substr(0, pos));
+        const auto value = Trim(line.substr(pos + 1));
+        const auto lowerValue = ToLower(value);
+
+        if ("CompressedData" == key)
+        {
+          if ("true" == lowerValue)
+            return false;
+        }
+        else if ("BinaryDataByteOrderMSB" == key || "ElementByteOrderMSB" == key)
+        {
+          if (("true" == lowerValue) != IsBigEndianHost())
+            return false;
+        }
+        else if ("HeaderSize" == key)
+        {
+          headerSize = std::stoll(value);
+        }
+        else if ("ElementDataFile" == key) // Always the last field of the header
+        {
+          if ("local" == lowerValue)
+          {
+            location.FileName = path;
+            location.Offset = static_cast<std::uint64_t>(stream.tellg());
+
+            if (0 != headerSize)
+              return false;
+          }
+          else
+          {
+            if ("list" == lowerValue || std::string::npos != value.find('%') || std::string::npos != value.find(' '))
+              return false;
+
+            location.FileName = itksys::SystemTools::FileIsFullPath(value)
+              ? value
+              : itksys::SystemTools::GetFilenamePath(path) + '/' + value;
+
+            if (0 > headerSize)
+            {
+              const auto fileSize = MemoryMappedFile::GetFileSize(location.FileName);
+
+              if (fileSize < imageSizeInBytes)
+                return false;
+
+              location.Offset = fileSize - imageSizeInBytes;
+            }
+            else
+            {
+              location.Offset = static_cast<std::uint64_t>(headerSize);
+            }
+          }
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /** Only single-file NIfTI-1 images in host byte order without intensity scaling are supported. */
+    bool LocateNiftiRawData(const std::string &path, RawDataLocation &location)
+    {
+      if (!EndsWith(ToLower(path), ".nii"))
+        return false;
+
+      std::ifstream stream(path, std::ios::binary);
+      char header[120];
+
+      if (!stream.read(header, sizeof(header)))
+        return false;
+
+      std::int32_t headerSize;
+      float voxOffset, sclSlope, sclInter;
+      std::memcpy(&headerSize, header, sizeof(headerSize));
+      std::memcpy(&voxOffset, header + 108, sizeof(voxOffset));
+      std::memcpy(&sclSlope, header + 112, sizeof(sclSlope));
+      std::memcpy(&sclInter, header + 116, sizeof(sclInter));
+
+      // A byte-swapped header size indicates non-native byte order
+      if (348 != headerSize || voxOffset < 348.0f)
+        return false;
+
+      if ((0.0f != sclSlope && 1.0f != sclSlope) || 0.0f != sclInter)
+        return false;
+
+      location.FileName = path;
+      location.Offset = static_cast<std::uint64_t>(voxOffset);
+      return true;
+    }
+
+    /**
+     * Reference the mapped data as channel of image. The channel data item
+     * owns the mapping, so it stays valid as long as the pixel data of the
+     * image (or any slice or volume of it) is in use.
+     */
+    bool ImportMappedChannel(Image *image, std::unique_ptr<MemoryMappedFile> mappedFile)
+    {
+      if (!image->SetImportChannel(mappedFile->GetData(), 0, Image::ReferenceMemory))
+        return false;
+
+      image->GetChannelData(0)->SetMemoryOwner(std::shared_ptr<MemoryMappedFile>(std::move(mappedFile)));
+      return true;
+    }
+
+    /**
+     * Try to reference the pixel data of the file read by imageIO directly
+     * via a copy-on-write memory mapping. Returns false if the file format or
+     * encoding does not allow it, in which case the image is left untouched.
+     */
+    bool MapImageData(itk::ImageIOBase *imageIO, Image *image)
+    {
+      if (imageIO->GetFileType() == itk::IOFileEnum::ASCII)
+        return false;
+
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      const std::string path = imageIO->GetFileName();
+      const std::size_t imageSizeInBytes = imageIO->GetImageSizeInBytes();
+      RawDataLocation location;
+      bool isLocated = false;
+
+      if ("NrrdImageIO" == imageIOName)
+      {
+        // ITK may permute multi-component NRRD data while reading
+        isLocated = 1 == imageIO->GetNumberOfComponents() && LocateNrrdRawData(path, location);
+      }
+      else if ("MetaImageIO" == imageIOName)
+      {
+        isLocated = LocateMetaImageRawData(path, imageSizeInBytes, location);
+      }
+      else if ("NiftiImageIO" == imageIOName)
+      {
+        // NIfTI stores vector components as separate volumes
+        isLocated = 1 == imageIO->GetNumberOfComponents() && LocateNiftiRawData(path, location);
+      }
+
+      if (!isLocated || location.Offset + imageSizeInBytes > MemoryMappedFile::GetFileSize(location.FileName))
+        return false;
+
+      std::unique_ptr<MemoryMappedFile> mappedFile;
+
+      try
+      {
+        mappedFile.reset(new MemoryMappedFile(location.FileName, location.Offset, imageSizeInBytes));
+      }
+      catch (const Exception &e)
+      {
+        MITK_WARN << e.GetDescription();
+        return false;
+      }
+
+      return ImportMappedChannel(image, std::move(mappedFile));
+    }
+
+    /**
+     * Read the IO region of imageIO chunk by chunk along its outermost
+     * dimension, so that ITK never has to decode more than a single chunk
+     * (e.g. a time step) at once.
+     */
+    void StreamImageData(itk::ImageIOBase *imageIO, const itk::ImageIORegion &ioRegion, void *buffer)
+    {
+      const unsigned int outerDim = ioRegion.GetImageDimension() - 1;
+      const std::size_t outerSize = ioRegion.GetSize(outerDim);
+      const std::size_t chunkStride = imageIO->GetImageSizeInBytes() / std::max<std::size_t>(outerSize, 1);
+      const std::size_t chunkLength = std::max<std::size_t>(STREAMING_CHUNK_SIZE_IN_BYTES / std::max<std::size_t>(chunkStride, 1), 1);
+
+      for (std::size_t start = 0; start < outerSize; start += chunkLength)
+      {
+        itk::ImageIORegion chunkRegion = ioRegion;
+        chunkRegion.SetIndex(outerDim, static_cast<itk::ImageIORegion::IndexValueType>(start));
+        chunkRegion.SetSize(outerDim, std::min(chunkLength, outerSize - start));
+
+        imageIO->SetIORegion(chunkRegion);
+        imageIO->Read(static_cast<char *>(buffer) + start * chunkStride);
+      }
+
+      imageIO->SetIORegion(ioRegion);
+    }
+
+    /**
+     * Read the pixel data of imageIO into a memory mapped temporary file
+     * instead of a heap buffer, streamed chunk by chunk if supported. No
+     * full-size buffer is allocated and pages can be written back to the
+     * temporary file under memory pressure. Returns false if the temporary
+     * file cannot be created, in which case the image is left untouched.
+     */
+    bool ReadImageDataIntoTemporaryFile(itk::ImageIOBase *imageIO, const itk::ImageIORegion &ioRegion, Image *image)
+    {
+      std::unique_ptr<MemoryMappedFile> mappedFile;
+
+      try
+      {
+        mappedFile.reset(new MemoryMappedFile(imageIO->GetImageSizeInBytes()));
+      }
+      catch (const Exception &e)
+      {
+        MITK_WARN << e.GetDescription();
+        return false;
+      }
+
+      if (imageIO->CanStreamRead())
+      {
+        StreamImageData(imageIO, ioRegion, mappedFile->GetData());
+      }
+      else
+      {
+        imageIO->Read(mappedFile->GetData());
+      }
+
+      return ImportMappedChannel(image, std::move(mappedFile));
+    }
+
+    /** Read the whole IO region of imageIO into a newly allocated buffer owned by image. */
+    void ReadImageData(itk::ImageIOBase *imageIO, Image *image)
+    {
+      auto buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
+
+      try
+      {
+        imageIO->Read(buffer);
+      }
+      catch (...)
+      {
+        delete[] buffer;
+        throw;
+      }
+
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
   {
@@ -122,6 +465,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -207,6 +551,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     if (rank)
     {
@@ -338,11 +683,21 @@ namespace mitk
 
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
 
     image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    const bool loadLazily =
+      this->GetReaderOption(IOConstants::LOADING_STRATEGY()).ToString() == IOConstants::LOADING_STRATEGY_LAZY();
+
+    if (!loadLazily)
+    {
+      ReadImageData(m_ImageIO, image);
+    }
+    else if ((m_ImageIO->GetNumberOfDimensions() > MAXDIM || !MapImageData(m_ImageIO, image)) &&
+             !ReadImageDataIntoTemporaryFile(m_ImageIO, ioRegion, image))
+    {
+      ReadImageData(m_ImageIO, image);
+    }
 
     const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
 
@@ -435,7 +790,6 @@ namespace mitk
 
     image->SetTimeGeometry(timeGeometry);
 
-    buffer = nullptr;
     MITK_INFO << "number of image components: " << image->GetPixelType().GetNumberOfComponents();
 
     for (auto iter = dictionary.Begin(), iterEnd = dictionary.End(); iter != iterEnd;
@@ -743,6 +1097,20 @@ namespace mitk
   }
 
   ItkImageIO *ItkImageIO::IOClone() const { return new ItkImageIO(*this); }
+
+  void ItkImageIO::InitializeDefaultReaderOptions()
+  {
+    Options defaultOptions;
+
+    defaultOptions[IOConstants::LOADING_STRATEGY()] = IOConstants::LOADING_STRATEGY_READ();
+    std::vector<std::string> loadingStrategyEnum;
+    loadingStrategyEnum.push_back(IOConstants::LOADING_STRATEGY_READ());
+    loadingStrategyEnum.push_back(IOConstants::LOADING_STRATEGY_LAZY());
+    defaultOptions[IOConstants::LOADING_STRATEGY_ENUM()] = loadingStrategyEnum;
+
+    this->SetDefaultReaderOptions(defaultOptions);
+  }
+
   void ItkImageIO::InitializeDefaultMetaDataKeys()
   {
     this->m_DefaultMetaDataKeys.push_back("NRRD.space");
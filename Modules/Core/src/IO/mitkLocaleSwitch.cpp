@@ -17,6 +17,10 @@ found in the LICENSE file.
 #include <clocale>
 #include <string>
 
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
 namespace mitk
 {
   struct LocaleSwitch::Impl
@@ -26,15 +30,30 @@ namespace mitk
     ~Impl();
 
   private:
+    /// locale during life-time of object
+    const std::string m_NewLocale;
+
+#if defined(_WIN32)
     /// locale at instantiation of object
     std::string m_OldLocale;
 
-    /// locale during life-time of object
-    const std::string m_NewLocale;
+    /// per-thread locale setting of the thread at instantiation of object
+    int m_OldThreadLocaleSetting;
+#else
+    /// locale of the thread at instantiation of object
+    locale_t m_OldLocale;
+
+    /// locale installed for the thread during life-time of object, 0 if none was installed
+    locale_t m_Locale;
+#endif
   };
 
+#if defined(_WIN32)
   LocaleSwitch::Impl::Impl(const std::string &newLocale) : m_NewLocale(newLocale)
   {
+    // setlocale only affects the calling thread while it uses a per-thread locale
+    m_OldThreadLocaleSetting = _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
+
     // query and keep the current locale
     const char *currentLocale = std::setlocale(LC_ALL, nullptr);
     if (currentLocale != nullptr)
@@ -59,7 +78,41 @@ namespace mitk
     {
       MITK_INFO << "Could not reset original locale " << m_OldLocale;
     }
+
+    if (m_OldThreadLocaleSetting != _ENABLE_PER_THREAD_LOCALE)
+      _configthreadlocale(_DISABLE_PER_THREAD_LOCALE);
+  }
+#else
+  LocaleSwitch::Impl::Impl(const std::string &newLocale) : m_NewLocale(newLocale), m_OldLocale(nullptr), m_Locale(nullptr)
+  {
+    // nothing to do if the thread uses the global locale and it already is the new one
+    if (uselocale(nullptr) == LC_GLOBAL_LOCALE)
+    {
+      const char *currentLocale = std::setlocale(LC_ALL, nullptr);
+      if (currentLocale != nullptr && m_NewLocale == currentLocale)
+        return;
+    }
+
+    // install the new locale for the calling thread only
+    m_Locale = newlocale(LC_ALL_MASK, m_NewLocale.c_str(), nullptr);
+    if (m_Locale == nullptr)
+    {
+      MITK_INFO << "Could not switch to locale " << m_NewLocale;
+      return;
+    }
+
+    m_OldLocale = uselocale(m_Locale);
+  }
+
+  LocaleSwitch::Impl::~Impl()
+  {
+    if (m_Locale != nullptr)
+    {
+      uselocale(m_OldLocale);
+      freelocale(m_Locale);
+    }
   }
+#endif
 
   LocaleSwitch::LocaleSwitch(const char *newLocale) : m_LocaleSwitchImpl(new Impl(newLocale)) {}
   LocaleSwitch::~LocaleSwitch() { delete m_LocaleSwitchImpl; }
@@ -0,0 +1,230 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryMappedFile.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+
+#include <fstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  std::string CreateBackingFile()
+  {
+    std::ofstream stream;
+    const auto path = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::out | std::ios_base::binary, "MITK-MappedData-XXXXXX");
+    stream.close();
+    return path;
+  }
+}
+
+#ifdef _WIN32
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string &path, std::uint64_t offset, std::size_t length)
+  : m_MappedAddress(nullptr), m_MappedLength(0), m_Data(nullptr), m_Length(length), m_FileHandle(nullptr), m_MappingHandle(nullptr)
+{
+  if (offset + length > GetFileSize(path))
+    mitkThrow() << "Cannot map " << length << " bytes at offset " << offset << " of \"" << path << "\": file is too small";
+
+  HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open \"" << path << "\" for memory mapping";
+
+  HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+
+  if (nullptr == mapping)
+  {
+    ::CloseHandle(file);
+    mitkThrow() << "Cannot create file mapping for \"" << path << "\"";
+  }
+
+  SYSTEM_INFO systemInfo;
+  ::GetSystemInfo(&systemInfo);
+  const std::uint64_t alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+  const std::size_t delta = static_cast<std::size_t>(offset - alignedOffset);
+
+  m_MappedLength = length + delta;
+  m_MappedAddress = ::MapViewOfFile(mapping,
+                                    FILE_MAP_COPY,
+                                    static_cast<DWORD>(alignedOffset >> 32),
+                                    static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                                    m_MappedLength);
+
+  if (nullptr == m_MappedAddress)
+  {
+    ::CloseHandle(mapping);
+    ::CloseHandle(file);
+    mitkThrow() << "Cannot map view of \"" << path << "\"";
+  }
+
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Data = static_cast<char *>(m_MappedAddress) + delta;
+}
+
+mitk::MemoryMappedFile::MemoryMappedFile(std::size_t length)
+  : m_MappedAddress(nullptr), m_MappedLength(length), m_Data(nullptr), m_Length(length), m_FileHandle(nullptr), m_MappingHandle(nullptr)
+{
+  const std::string path = CreateBackingFile();
+
+  // The file is deleted as soon as the last handle to it is closed
+  HANDLE file = ::CreateFileA(path.c_str(),
+                              GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                              nullptr);
+
+  if (INVALID_HANDLE_VALUE == file)
+  {
+    ::DeleteFileA(path.c_str());
+    mitkThrow() << "Cannot open temporary file \"" << path << "\" for memory mapping";
+  }
+
+  const auto size = static_cast<std::uint64_t>(length);
+  HANDLE mapping = ::CreateFileMappingA(
+    file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+
+  if (nullptr == mapping)
+  {
+    ::CloseHandle(file);
+    mitkThrow() << "Cannot create file mapping of " << length << " bytes for \"" << path << "\"";
+  }
+
+  m_MappedAddress = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, length);
+
+  if (nullptr == m_MappedAddress)
+  {
+    ::CloseHandle(mapping);
+    ::CloseHandle(file);
+    mitkThrow() << "Cannot map view of \"" << path << "\"";
+  }
+
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Data = m_MappedAddress;
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  ::UnmapViewOfFile(m_MappedAddress);
+  ::CloseHandle(m_MappingHandle);
+  ::CloseHandle(m_FileHandle);
+}
+
+std::uint64_t mitk::MemoryMappedFile::GetFileSize(const std::string &path)
+{
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+  if (!::GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes))
+    return 0;
+
+  return (static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+}
+
+#else
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string &path, std::uint64_t offset, std::size_t length)
+  : m_MappedAddress(nullptr), m_MappedLength(0), m_Data(nullptr), m_Length(length)
+{
+  if (offset + length > GetFileSize(path))
+    mitkThrow() << "Cannot map " << length << " bytes at offset " << offset << " of \"" << path << "\": file is too small";
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+
+  if (-1 == fd)
+    mitkThrow() << "Cannot open \"" << path << "\" for memory mapping";
+
+  const auto pageSize = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+  const std::uint64_t alignedOffset = offset - offset % pageSize;
+  const std::size_t delta = static_cast<std::size_t>(offset - alignedOffset);
+
+  m_MappedLength = length + delta;
+  m_MappedAddress = ::mmap(nullptr, m_MappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+
+  // The mapping stays valid after closing the file descriptor
+  ::close(fd);
+
+  if (MAP_FAILED == m_MappedAddress)
+  {
+    m_MappedAddress = nullptr;
+    mitkThrow() << "Cannot memory map \"" << path << "\"";
+  }
+
+  m_Data = static_cast<char *>(m_MappedAddress) + delta;
+}
+
+mitk::MemoryMappedFile::MemoryMappedFile(std::size_t length)
+  : m_MappedAddress(nullptr), m_MappedLength(length), m_Data(nullptr), m_Length(length)
+{
+  const std::string path = CreateBackingFile();
+  int fd = ::open(path.c_str(), O_RDWR);
+
+  // The file stays accessible through the descriptor and the mapping after removing its name
+  ::unlink(path.c_str());
+
+  if (-1 == fd)
+    mitkThrow() << "Cannot open temporary file \"" << path << "\" for memory mapping";
+
+  // Reserve the disk space up front, writing to a mapped hole on a full disk raises SIGBUS
+#ifdef __linux__
+  const bool isResized = 0 == ::posix_fallocate(fd, 0, static_cast<off_t>(length));
+#else
+  const bool isResized = 0 == ::ftruncate(fd, static_cast<off_t>(length));
+#endif
+
+  if (!isResized)
+  {
+    ::close(fd);
+    mitkThrow() << "Cannot resize temporary file \"" << path << "\" to " << length << " bytes";
+  }
+
+  m_MappedAddress = ::mmap(nullptr, m_MappedLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+
+  if (MAP_FAILED == m_MappedAddress)
+  {
+    m_MappedAddress = nullptr;
+    mitkThrow() << "Cannot memory map temporary file \"" << path << "\"";
+  }
+
+  m_Data = m_MappedAddress;
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  ::munmap(m_MappedAddress, m_MappedLength);
+}
+
+std::uint64_t mitk::MemoryMappedFile::GetFileSize(const std::string &path)
+{
+  struct stat fileStatus;
+
+  if (0 != ::stat(path.c_str(), &fileStatus))
+    return 0;
+
+  return static_cast<std::uint64_t>(fileStatus.st_size);
+}
+
+#endif
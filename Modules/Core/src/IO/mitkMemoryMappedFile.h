@@ -0,0 +1,70 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \brief Private copy-on-write mapping of a byte range of a file.
+   *
+   * The mapped range is readable and writable. Writes are private to the
+   * process (MAP_PRIVATE / FILE_MAP_COPY) and never reach the file on disk.
+   * Pages are only loaded on first access, so mapping a file costs neither
+   * I/O nor resident memory up front.
+   *
+   * Alternatively, a mapping of a new temporary file of a given size can be
+   * created as backing store for data that cannot be mapped from its source
+   * file. Writes to such a mapping go to the temporary file, so the operating
+   * system can page them out to it instead of keeping them in memory. The
+   * temporary file is removed together with the mapping.
+   *
+   * The mapping is released on destruction. Throws mitk::Exception if the
+   * file cannot be opened or the requested range exceeds the file size.
+   */
+  class MemoryMappedFile
+  {
+  public:
+    MemoryMappedFile(const std::string &path, std::uint64_t offset, std::size_t length);
+
+    /** Map a new zero-filled temporary file of length bytes in IOUtil::GetTempPath(). */
+    explicit MemoryMappedFile(std::size_t length);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    /** Pointer to the first byte of the requested range (not necessarily page aligned). */
+    void *GetData() const { return m_Data; }
+    std::size_t GetLength() const { return m_Length; }
+
+    /** Size of the file in bytes, or 0 if it cannot be determined. */
+    static std::uint64_t GetFileSize(const std::string &path);
+
+  private:
+    void *m_MappedAddress;
+    std::size_t m_MappedLength;
+    void *m_Data;
+    std::size_t m_Length;
+#ifdef _WIN32
+    void *m_FileHandle;
+    void *m_MappingHandle;
+#endif
+  };
+}
+
+#endif
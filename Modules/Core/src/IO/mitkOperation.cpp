@@ -24,3 +24,17 @@ mitk::OperationType mitk::Operation::GetOperationType()
 {
   return m_OperationType;
 }
+
+std::size_t mitk::Operation::GetMemorySize() const
+{
+  return sizeof(Operation);
+}
+
+bool mitk::Operation::SwapOut(std::ostream &)
+{
+  return false;
+}
+
+void mitk::Operation::SwapIn(std::istream &)
+{
+}
@@ -134,7 +134,7 @@ float mitk::ImageVtkMapper2D::CalculateLayerDepth(mitk::BaseRenderer *renderer)
   // Due to a VTK bug, we cannot use the whole clipping range. /100 is empirically determined
   float depth = -maxRange * 0.01; // divide by 100
   int layer = 0;
-  GetDataNode()->GetIntProperty("layer", layer, renderer);
+  GetDataNode()->GetIntProperty(mitk::DataNode::GetLayerPropertyKey(), layer, renderer);
   // add the layer property for each image to render images with a higher layer on top of the others
   depth += layer * 10; //*10: keep some room for each image (e.g. for ODFs in between)
   if (depth > 0.0f)
@@ -520,7 +520,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, mitk::DataNode::GetColorPropertyKey());
     }
   }
   if (binary && selected)
@@ -533,12 +533,12 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, mitk::DataNode::GetColorPropertyKey());
     }
   }
   if (!binary || (!hover && !selected))
   {
-    GetDataNode()->GetColor(rgb, renderer, "color");
+    GetDataNode()->GetColor(rgb, renderer, mitk::DataNode::GetColorPropertyKey());
   }
 
   double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
@@ -561,7 +561,7 @@ void mitk::ImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   // check for opacity prop and use it for rendering if it exists
-  GetDataNode()->GetOpacity(opacity, renderer, "opacity");
+  GetDataNode()->GetOpacity(opacity, renderer, mitk::DataNode::GetOpacityPropertyKey());
   // set the opacity according to the properties
   localStorage->m_ImageActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_ShadowOutlineActor->GetProperty()->SetOpacity(opacity);
@@ -674,7 +674,7 @@ void mitk::ImageVtkMapper2D::SetToInvalidState(mitk::ImageVtkMapper2D::LocalStor
 void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, mitk::DataNode::GetVisiblePropertyKey());
 
   if (!visible)
   {
@@ -131,7 +131,7 @@ void mitk::SurfaceVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   }
 
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, mitk::DataNode::GetVisiblePropertyKey());
 
   if (!visible)
   {
@@ -306,9 +306,9 @@ void mitk::SurfaceVtkMapper2D::ApplyAllProperties(mitk::BaseRenderer *renderer)
 
   // check for color and opacity properties, use it for rendering if they exists
   float color[3] = {1.0f, 1.0f, 1.0f};
-  node->GetColor(color, renderer, "color");
+  node->GetColor(color, renderer, mitk::DataNode::GetColorPropertyKey());
   float opacity = 1.0f;
-  node->GetOpacity(opacity, renderer, "opacity");
+  node->GetOpacity(opacity, renderer, mitk::DataNode::GetOpacityPropertyKey());
 
   // Pass properties to VTK
   localStorage->m_Actor->GetProperty()->SetColor(color[0], color[1], color[2]);
@@ -57,7 +57,7 @@ void mitk::SurfaceVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, mitk::DataNode::GetVisiblePropertyKey());
 
   if (!visible)
   {
@@ -151,8 +151,7 @@ void mitk::SurfaceVtkMapper3D::ApplyMitkPropertiesToVtkProperty(mitk::DataNode *
 
     // Color
     {
-      mitk::ColorProperty::Pointer p;
-      node->GetProperty(p, "color", renderer);
+      mitk::ColorProperty::Pointer p = dynamic_cast<mitk::ColorProperty *>(node->GetProperty(mitk::DataNode::GetColorPropertyKey(), renderer));
       if (p.IsNotNull())
       {
         mitk::Color c = p->GetColor();
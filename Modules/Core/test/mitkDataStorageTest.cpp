@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <algorithm>
 #include <fstream>
+#include <vector>
 
 #include "mitkColorProperty.h"
 #include "mitkDataNode.h"
@@ -37,6 +38,7 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 void TestDataStorage(mitk::DataStorage *ds, std::string filename);
+void TestStandaloneDataStorageIndices();
 
 namespace mitk
 {
@@ -146,9 +148,10 @@ int mitkDataStorageTest(int argc, char *argv[])
   MITK_TEST_OUTPUT(<< "Testing StandaloneDataStorage: ");
   MITK_TEST_CONDITION_REQUIRED(argc > 1, "Testing correct test invocation");
   TestDataStorage(sds, argv[1]);
-  // TODO: Add specific StandaloneDataStorage Tests here
   sds = nullptr;
 
+  TestStandaloneDataStorageIndices();
+
   MITK_TEST_END();
 }
 
@@ -872,3 +875,113 @@ void TestDataStorage(mitk::DataStorage *ds, std::string filename)
   ds->Remove(ds->GetAll());
   MITK_TEST_CONDITION(ds->GetAll()->Size() == 0, "Checking Clear DataStorage");
 }
+
+//##Documentation
+//## @brief Returns true if GetSubset() returns the same nodes in the same order as checking every node
+static bool SubsetMatchesCheckOfAllNodes(mitk::DataStorage *ds, const mitk::NodePredicateBase *condition)
+{
+  mitk::DataStorage::SetOfObjects::ConstPointer all = ds->GetAll();
+  std::vector<mitk::DataNode *> expected;
+  for (auto it = all->Begin(); it != all->End(); ++it)
+    if (condition->CheckNode(it.Value()))
+      expected.push_back(it.Value());
+
+  mitk::DataStorage::SetOfObjects::ConstPointer subset = ds->GetSubset(condition);
+  std::vector<mitk::DataNode *> actual;
+  for (auto it = subset->Begin(); it != subset->End(); ++it)
+    actual.push_back(it.Value());
+
+  return expected == actual;
+}
+
+//##Documentation
+//## @brief Test for the secondary indices that GetSubset() of the StandaloneDataStorage uses
+void TestStandaloneDataStorageIndices()
+{
+  mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+
+  std::vector<mitk::DataNode::Pointer> nodes;
+  for (int i = 0; i < 20; ++i)
+  {
+    mitk::DataNode::Pointer node = mitk::DataNode::New();
+    if (i % 3 == 0)
+      node->SetData(mitk::Image::New());
+    else if (i % 3 == 1)
+      node->SetData(mitk::Surface::New());
+
+    node->SetName(i % 2 == 0 ? "even" : "odd");
+    node->SetIntProperty("index", i);
+    node->SetColor(i % 4 == 0 ? 1.0f : 0.0f, 0.0f, 0.0f);
+    ds->Add(node);
+    nodes.push_back(node);
+  }
+
+  mitk::NodePredicateDataType::Pointer isImage = mitk::NodePredicateDataType::New("Image");
+  mitk::NodePredicateDataType::Pointer isSurface = mitk::NodePredicateDataType::New("Surface");
+  mitk::NodePredicateProperty::Pointer isEven =
+    mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("even"));
+  mitk::NodePredicateProperty::Pointer isRed =
+    mitk::NodePredicateProperty::New("color", mitk::ColorProperty::New(1.0f, 0.0f, 0.0f));
+  mitk::NodePredicateProperty::Pointer hasOrgan = mitk::NodePredicateProperty::New("organ");
+  mitk::NodePredicateProperty::Pointer isLiver =
+    mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New("liver"));
+  mitk::NodePredicateAnd::Pointer isEvenImage = mitk::NodePredicateAnd::New(isImage, isEven);
+  mitk::NodePredicateOr::Pointer isImageOrRed = mitk::NodePredicateOr::New(isImage, isRed);
+  mitk::NodePredicateAnd::Pointer isEvenAndNotSurface =
+    mitk::NodePredicateAnd::New(isEven, mitk::NodePredicateNot::New(isSurface));
+
+  auto checkAll = [&ds, &isImage, &isSurface, &isEven, &isRed, &hasOrgan, &isLiver, &isEvenImage, &isImageOrRed,
+                   &isEvenAndNotSurface]() {
+    return SubsetMatchesCheckOfAllNodes(ds, isImage) && SubsetMatchesCheckOfAllNodes(ds, isSurface) &&
+           SubsetMatchesCheckOfAllNodes(ds, isEven) && SubsetMatchesCheckOfAllNodes(ds, isRed) &&
+           SubsetMatchesCheckOfAllNodes(ds, hasOrgan) && SubsetMatchesCheckOfAllNodes(ds, isLiver) &&
+           SubsetMatchesCheckOfAllNodes(ds, isEvenImage) && SubsetMatchesCheckOfAllNodes(ds, isImageOrRed) &&
+           SubsetMatchesCheckOfAllNodes(ds, isEvenAndNotSurface);
+  };
+
+  MITK_TEST_CONDITION(checkAll(), "Indexed queries after adding nodes");
+  MITK_TEST_CONDITION(ds->GetSubset(isImage)->Size() == 7, "Data type query");
+  MITK_TEST_CONDITION(ds->GetSubset(isRed)->Size() == 5, "Query of a property without comparable value string");
+
+  nodes[1]->SetName("renamed");
+  MITK_TEST_CONDITION(ds->GetNamedNode("renamed") == nodes[1] && checkAll(), "Indexed queries after renaming a node");
+
+  dynamic_cast<mitk::StringProperty *>(nodes[3]->GetProperty("name"))->SetValue("even");
+  MITK_TEST_CONDITION(checkAll(), "Indexed queries after changing a property in place");
+
+  ds->BlockNodeModifiedEvents(true);
+  nodes[5]->SetName("blocked");
+  ds->BlockNodeModifiedEvents(false);
+  MITK_TEST_CONDITION(ds->GetNamedNode("blocked") == nodes[5], "Indexed queries while node modified events are blocked");
+
+  nodes[0]->SetData(mitk::Surface::New());
+  nodes[2]->SetData(nullptr);
+  MITK_TEST_CONDITION(checkAll(), "Indexed queries after replacing data");
+
+  nodes[4]->GetData()->SetProperty("organ", mitk::StringProperty::New("liver"));
+  nodes[7]->GetData()->SetProperty("organ", mitk::StringProperty::New("lung"));
+  MITK_TEST_CONDITION(ds->GetSubset(isLiver)->Size() == 1 && checkAll(), "Indexed queries of data properties");
+
+  dynamic_cast<mitk::StringProperty *>(nodes[7]->GetData()->GetProperty("organ").GetPointer())->SetValue("liver");
+  MITK_TEST_CONDITION(ds->GetSubset(isLiver)->Size() == 2 && checkAll(),
+                      "Indexed queries after changing a data property in place");
+
+  nodes[7]->SetStringProperty("organ", "heart");
+  MITK_TEST_CONDITION(ds->GetSubset(isLiver)->Size() == 1 && checkAll(),
+                      "Indexed queries of node properties hiding data properties");
+
+  ds->Remove(nodes[4]);
+  ds->Remove(nodes[6]);
+  MITK_TEST_CONDITION(ds->GetSubset(isLiver)->Size() == 0 && checkAll(), "Indexed queries after removing nodes");
+
+  // more keys than are indexed
+  for (int i = 0; i < 40; ++i)
+  {
+    const std::string key = "key" + std::to_string(i);
+    nodes[i % 20]->SetStringProperty(key.c_str(), "value");
+    mitk::NodePredicateProperty::Pointer hasValue =
+      mitk::NodePredicateProperty::New(key.c_str(), mitk::StringProperty::New("value"));
+    MITK_TEST_CONDITION(SubsetMatchesCheckOfAllNodes(ds, hasValue), "Query of property key " << key);
+  }
+  MITK_TEST_CONDITION(checkAll(), "Indexed queries after querying many property keys");
+}
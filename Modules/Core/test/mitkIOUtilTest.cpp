@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkUtf8Util.h>
 #include <mitkImageGenerator.h>
 #include <mitkIOMetaInformationPropertyConstants.h>
+#include <mitkStandaloneDataStorage.h>
 #include <mitkVersion.h>
 
 #include <itkMetaDataObject.h>
@@ -38,9 +39,19 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestIOMetaInformation);
   MITK_TEST(TestUtf8);
+  MITK_TEST(TestConcurrentLoad);
+  MITK_TEST(TestConcurrentLoadIntoDataStorage);
   CPPUNIT_TEST_SUITE_END();
 
 private:
+  /** Gives access to the LoadInfo based IOUtil::Load(). */
+  class TestIOUtil : public mitk::IOUtil
+  {
+  public:
+    using mitk::IOUtil::Load;
+  };
+
+  unsigned int m_NumberOfLoadThreads;
   std::string m_ImagePath;
   std::string m_SurfacePath;
   std::string m_PointSetPath;
@@ -48,11 +59,17 @@ private:
 public:
   void setUp() override
   {
+    m_NumberOfLoadThreads = mitk::IOUtil::GetNumberOfLoadThreads();
     m_ImagePath = GetTestDataFilePath("Pic3D.nrrd");
     m_SurfacePath = GetTestDataFilePath("binary.stl");
     m_PointSetPath = GetTestDataFilePath("pointSet.mps");
   }
 
+  void tearDown() override
+  {
+    mitk::IOUtil::SetNumberOfLoadThreads(m_NumberOfLoadThreads);
+  }
+
   void TestSaveEmptyData()
   {
     mitk::Surface::Pointer data = mitk::Surface::New();
@@ -307,6 +324,61 @@ public:
     CPPUNIT_ASSERT(image.IsNotNull());
   }
 
+  std::vector<std::string> GetConcurrentLoadPaths() const
+  {
+    return { m_ImagePath, m_SurfacePath, m_PointSetPath, m_ImagePath, m_SurfacePath, m_PointSetPath };
+  }
+
+  void TestConcurrentLoad()
+  {
+    const auto paths = this->GetConcurrentLoadPaths();
+    const auto sequentialData = mitk::IOUtil::Load(paths);
+
+    mitk::IOUtil::SetNumberOfLoadThreads(4);
+    std::vector<mitk::IOUtil::LoadInfo> loadInfos(paths.begin(), paths.end());
+    CPPUNIT_ASSERT(TestIOUtil::Load(loadInfos, nullptr, nullptr, nullptr).empty());
+
+    std::vector<mitk::BaseData::Pointer> concurrentData;
+    for (const auto &loadInfo : loadInfos)
+    {
+      CPPUNIT_ASSERT(loadInfo.m_ReadDuration > 0.0);
+      concurrentData.insert(concurrentData.end(), loadInfo.m_Output.begin(), loadInfo.m_Output.end());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(sequentialData.size(), concurrentData.size());
+
+    for (std::size_t i = 0; i < sequentialData.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::string(sequentialData[i]->GetNameOfClass()), std::string(concurrentData[i]->GetNameOfClass()));
+      CPPUNIT_ASSERT_EQUAL(sequentialData[i]->GetProperty("path")->GetValueAsString(),
+                           concurrentData[i]->GetProperty("path")->GetValueAsString());
+    }
+
+    auto image = dynamic_cast<mitk::Image *>(concurrentData.front().GetPointer());
+    CPPUNIT_ASSERT(image != nullptr);
+    CPPUNIT_ASSERT(mitk::Equal(*dynamic_cast<mitk::Image *>(sequentialData.front().GetPointer()), *image, mitk::eps, true));
+  }
+
+  void TestConcurrentLoadIntoDataStorage()
+  {
+    auto storage = mitk::StandaloneDataStorage::New();
+    const auto paths = this->GetConcurrentLoadPaths();
+
+    mitk::IOUtil::SetNumberOfLoadThreads(3);
+    mitk::DataStorage::SetOfObjects::Pointer nodes;
+    CPPUNIT_ASSERT_NO_THROW(nodes = mitk::IOUtil::Load(paths, *storage));
+
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(storage->GetAll()->Size()));
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+      CPPUNIT_ASSERT(storage->Exists(nodes->ElementAt(i)));
+      CPPUNIT_ASSERT_EQUAL(mitk::Utf8Util::Local8BitToUtf8(paths[i]),
+                           nodes->ElementAt(i)->GetData()->GetProperty("path")->GetValueAsString());
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkIOUtil)
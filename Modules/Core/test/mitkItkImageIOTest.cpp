@@ -16,15 +16,22 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 
 #include "mitkIOUtil.h"
+#include <mitkIOConstants.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkUtf8Util.h>
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkByteSwapper.h>
 #include <itkImageRegionIterator.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #ifdef WIN32
 #include "process.h"
@@ -44,6 +51,10 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestLazyLoadingOfUncompressedNrrd);
+  MITK_TEST(TestLazyLoadingOfUncompressedMHD);
+  MITK_TEST(TestLazyLoadingOfCompressedNrrd);
+  MITK_TEST(TestLazyLoadingDoesNotAllocateImageBuffer);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -68,6 +79,150 @@ public:
     // TODO
   }
 
+  void TestLazyLoadingOfUncompressedNrrd()
+  {
+    std::ofstream tmpStream;
+    const std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::out | std::ios_base::binary, "XXXXXX.nrrd");
+    tmpStream << "NRRD0004\ntype: short\ndimension: 3\nsizes: 16 8 4\nendian: "
+              << (itk::ByteSwapper<int>::SystemIsBigEndian() ? "big" : "little") << "\nencoding: raw\n\n";
+    WriteRampData(tmpStream);
+    tmpStream.close();
+
+    TestLazyLoading(tmpFilePath, true);
+
+    std::remove(tmpFilePath.c_str());
+  }
+
+  void TestLazyLoadingOfUncompressedMHD()
+  {
+    std::ofstream tmpStream;
+    const std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, "XXXXXX.mhd");
+    const std::string rawFilePath = tmpFilePath.substr(0, tmpFilePath.size() - 4) + ".raw";
+    tmpStream << "ObjectType = Image\nNDims = 3\nBinaryData = True\nBinaryDataByteOrderMSB = "
+              << (itk::ByteSwapper<int>::SystemIsBigEndian() ? "True" : "False")
+              << "\nCompressedData = False\nDimSize = 16 8 4\nElementType = MET_SHORT\nElementDataFile = "
+              << itksys::SystemTools::GetFilenameName(rawFilePath) << "\n";
+    tmpStream.close();
+
+    std::ofstream rawStream(rawFilePath, std::ios_base::out | std::ios_base::binary);
+    WriteRampData(rawStream);
+    rawStream.close();
+
+    TestLazyLoading(tmpFilePath, true);
+
+    std::remove(tmpFilePath.c_str());
+    std::remove(rawFilePath.c_str());
+  }
+
+  void TestLazyLoadingOfCompressedNrrd()
+  {
+    // Compressed files cannot be mapped and are decoded into a mapped temporary file
+    auto image = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+    std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile("XXXXXX.nrrd");
+    mitk::IOUtil::Save(image, tmpFilePath);
+
+    TestLazyLoading(tmpFilePath, false);
+
+    std::remove(tmpFilePath.c_str());
+  }
+
+  void TestLazyLoadingDoesNotAllocateImageBuffer()
+  {
+    // 512x512x128 shorts (64 MB) of raw data
+    const std::size_t imageSizeInBytes = 512 * 512 * 128 * sizeof(short);
+
+    std::ofstream tmpStream;
+    const std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::out | std::ios_base::binary, "XXXXXX.nrrd");
+    tmpStream << "NRRD0004\ntype: short\ndimension: 3\nsizes: 512 512 128\nendian: "
+              << (itk::ByteSwapper<int>::SystemIsBigEndian() ? "big" : "little") << "\nencoding: raw\n\n";
+    const std::vector<char> slice(512 * 512 * sizeof(short), 1);
+    for (int i = 0; i < 128; ++i)
+      tmpStream.write(slice.data(), slice.size());
+    tmpStream.close();
+
+    mitk::IFileReader::Options options;
+    options[mitk::IOConstants::LOADING_STRATEGY()] = mitk::IOConstants::LOADING_STRATEGY_LAZY();
+
+    // Load once, so that reader services and libraries are initialized before measuring
+    mitk::IOUtil::Load<mitk::Image>(tmpFilePath, options);
+
+    const std::size_t residentMemoryBefore = GetResidentMemoryUsage();
+    auto lazyImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath, options);
+    const std::size_t residentMemoryAfter = GetResidentMemoryUsage();
+
+    CPPUNIT_ASSERT_MESSAGE("Lazily loaded image does not own a pixel buffer", !lazyImage->GetChannelData(0)->GetManageMemory());
+    CPPUNIT_ASSERT_MESSAGE("Channel data item owns the mapping", nullptr != lazyImage->GetChannelData(0)->GetMemoryOwner());
+
+    // A full-size buffer would have been filled while reading and thus be resident
+    CPPUNIT_ASSERT_MESSAGE("Lazy loading does not allocate and fill a full-size pixel buffer",
+                           residentMemoryAfter < residentMemoryBefore + imageSizeInBytes / 4);
+
+    // The mapping lives as long as the channel data item, not as long as the image
+    mitk::ImageDataItem::Pointer channel = lazyImage->GetChannelData(0);
+    std::weak_ptr<void> mapping = channel->GetMemoryOwner();
+    lazyImage = nullptr;
+    CPPUNIT_ASSERT_MESSAGE("Mapping outlives the image while its channel is in use", !mapping.expired());
+    channel = nullptr;
+    CPPUNIT_ASSERT_MESSAGE("Mapping is released together with the channel", mapping.expired());
+
+    std::remove(tmpFilePath.c_str());
+  }
+
+  /** Resident set size of the test process in bytes, 0 where it cannot be determined. */
+  std::size_t GetResidentMemoryUsage()
+  {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+  }
+
+  /** 16x8x4 short ramp */
+  void WriteRampData(std::ostream &stream)
+  {
+    for (short value = 0; value < 16 * 8 * 4; ++value)
+      stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  void TestLazyLoading(const std::string &path, bool expectMapping)
+  {
+    mitk::IFileReader::Options options;
+    options[mitk::IOConstants::LOADING_STRATEGY()] = mitk::IOConstants::LOADING_STRATEGY_LAZY();
+
+    auto eagerImage = mitk::IOUtil::Load<mitk::Image>(path);
+    auto lazyImage = mitk::IOUtil::Load<mitk::Image>(path, options);
+
+    CPPUNIT_ASSERT_MESSAGE("Lazily loaded image is not null", lazyImage.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Lazily loaded image equals eagerly loaded image",
+                           mitk::Equal(*eagerImage, *lazyImage, mitk::eps, true));
+
+    // Mapped pixel data is only referenced by the image, read data is owned by it
+    CPPUNIT_ASSERT_MESSAGE("Eagerly loaded image owns its pixel data", eagerImage->GetChannelData(0)->GetManageMemory());
+    CPPUNIT_ASSERT_MESSAGE("Lazily loaded image references mapped pixel data", !lazyImage->GetChannelData(0)->GetManageMemory());
+    CPPUNIT_ASSERT_MESSAGE("Channel data item owns the mapping", nullptr != lazyImage->GetChannelData(0)->GetMemoryOwner());
+
+    if (expectMapping)
+    {
+      // Mapped pixel data is copy-on-write and must never change the file on disk
+      {
+        mitk::ImageWriteAccessor writeAccessor(lazyImage);
+        auto *data = static_cast<char *>(writeAccessor.GetData());
+        std::fill(data, data + lazyImage->GetPixelType().GetSize() * 16, 0x7F);
+      }
+
+      auto reloadedImage = mitk::IOUtil::Load<mitk::Image>(path, options);
+      CPPUNIT_ASSERT_MESSAGE("File on disk is unchanged after modifying a mapped image",
+                             mitk::Equal(*eagerImage, *reloadedImage, mitk::eps, true));
+
+      lazyImage = nullptr;
+      reloadedImage = nullptr;
+    }
+  }
+
   std::string AppendExtension(const std::string &filename, const char *extension)
   {
     std::string new_filename = filename;
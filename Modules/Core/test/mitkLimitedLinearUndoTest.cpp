@@ -0,0 +1,303 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkException.h>
+#include <mitkInteractionConst.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperationActor.h>
+#include <mitkOperationEvent.h>
+
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  int g_NumberOfPayloadOperations = 0;
+  bool g_FailSwapIn = false;
+
+  /** Operation holding a large payload that can optionally be swapped out. */
+  class PayloadOperation : public mitk::Operation
+  {
+  public:
+    PayloadOperation(const std::string &payload, bool supportsSwapping)
+      : Operation(mitk::OpTEST), m_Payload(payload), m_PayloadSize(payload.size()), m_SupportsSwapping(supportsSwapping)
+    {
+      ++g_NumberOfPayloadOperations;
+    }
+
+    ~PayloadOperation() override { --g_NumberOfPayloadOperations; }
+
+    std::size_t GetMemorySize() const override { return sizeof(PayloadOperation) + m_Payload.capacity(); }
+
+    bool SwapOut(std::ostream &stream) override
+    {
+      if (!m_SupportsSwapping)
+        return false;
+
+      stream.write(m_Payload.data(), m_PayloadSize);
+      std::string().swap(m_Payload);
+      return true;
+    }
+
+    void SwapIn(std::istream &stream) override
+    {
+      if (g_FailSwapIn)
+        mitkThrow() << "Swapped out payload is not readable.";
+
+      m_Payload.resize(m_PayloadSize);
+      stream.read(&m_Payload[0], m_PayloadSize);
+    }
+
+    const std::string &GetPayload() const { return m_Payload; }
+
+  private:
+    std::string m_Payload;
+    std::size_t m_PayloadSize;
+    bool m_SupportsSwapping;
+  };
+
+  /** Records the payloads of the executed operations. */
+  class PayloadActor : public mitk::OperationActor
+  {
+  public:
+    void ExecuteOperation(mitk::Operation *operation) override
+    {
+      executedPayloads.push_back(static_cast<PayloadOperation *>(operation)->GetPayload());
+    }
+
+    std::vector<std::string> executedPayloads;
+  };
+
+  /** Gives access to the undo stack. */
+  class TestUndo : public mitk::LimitedLinearUndo
+  {
+  public:
+    mitkClassMacro(TestUndo, LimitedLinearUndo);
+    itkFactorylessNewMacro(Self);
+
+    const UndoContainer &GetUndoList() const { return m_UndoList; }
+    const UndoContainer &GetRedoList() const { return m_RedoList; }
+  };
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(UndoLimitDeletesOldestItems);
+  MITK_TEST(MemoryLimitDropsOldestItems);
+  MITK_TEST(MemoryLimitSwapsOutOldestItems);
+  MITK_TEST(SwappedItemsAreReloadedOnUndoAndRedo);
+  MITK_TEST(SwapFileRangesAreReused);
+  MITK_TEST(UnswappableItemsAreDropped);
+  MITK_TEST(UnrestorableItemDiscardsHistoryOnUndo);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const std::size_t PayloadSize = 10000;
+
+  TestUndo::Pointer m_Undo;
+  PayloadActor m_Actor;
+  char m_NextPayloadChar;
+
+  /** Adds items whose do operations hold lower case and undo operations upper case letters. */
+  void AddItems(unsigned int numberOfItems, bool supportsSwapping = true)
+  {
+    for (unsigned int i = 0; i < numberOfItems; ++i, ++m_NextPayloadChar)
+    {
+      auto doOp = new PayloadOperation(std::string(PayloadSize, m_NextPayloadChar), supportsSwapping);
+      auto undoOp = new PayloadOperation(std::string(PayloadSize, static_cast<char>(std::toupper(m_NextPayloadChar))), supportsSwapping);
+      m_Undo->SetOperationEvent(new mitk::OperationEvent(&m_Actor, doOp, undoOp, "Test"));
+      mitk::OperationEvent::IncCurrObjectEventId();
+    }
+  }
+
+  bool IsSwappedOut(std::size_t index) const { return m_Undo->GetUndoList().at(index)->IsSwappedOut(); }
+
+public:
+  void setUp() override
+  {
+    m_Undo = TestUndo::New();
+    m_Actor.executedPayloads.clear();
+    m_NextPayloadChar = 'a';
+  }
+
+  void tearDown() override
+  {
+    m_Undo = nullptr;
+    CPPUNIT_ASSERT_EQUAL(0, g_NumberOfPayloadOperations);
+  }
+
+  void UndoLimitDeletesOldestItems()
+  {
+    this->AddItems(5);
+    CPPUNIT_ASSERT_EQUAL(10, g_NumberOfPayloadOperations);
+
+    m_Undo->SetUndoLimit(2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT_EQUAL(4, g_NumberOfPayloadOperations);
+
+    this->AddItems(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT_EQUAL(4, g_NumberOfPayloadOperations);
+  }
+
+  void MemoryLimitDropsOldestItems()
+  {
+    this->AddItems(1);
+    const auto itemSize = m_Undo->GetMemorySize();
+    CPPUNIT_ASSERT(itemSize > 2 * PayloadSize);
+
+    m_Undo->SetUndoMemoryLimit(3 * itemSize);
+    this->AddItems(7);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT(m_Undo->GetMemorySize() <= 3 * itemSize);
+    CPPUNIT_ASSERT_EQUAL(6, g_NumberOfPayloadOperations);
+
+    // the newest item is kept even if it exceeds the limit on its own
+    auto newestItem = m_Undo->GetUndoList().back();
+    m_Undo->SetUndoMemoryLimit(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT(newestItem == m_Undo->GetUndoList().back());
+  }
+
+  void MemoryLimitSwapsOutOldestItems()
+  {
+    this->AddItems(1);
+    const auto itemSize = m_Undo->GetMemorySize();
+
+    m_Undo->SetSwappingEnabled(true);
+    m_Undo->SetUndoMemoryLimit(3 * itemSize);
+    this->AddItems(9);
+
+    // nothing is dropped, the oldest items are swapped out instead
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT_EQUAL(20, g_NumberOfPayloadOperations);
+    CPPUNIT_ASSERT(m_Undo->GetMemorySize() <= 3 * itemSize);
+    CPPUNIT_ASSERT(this->IsSwappedOut(0));
+    CPPUNIT_ASSERT(!this->IsSwappedOut(9));
+  }
+
+  void SwappedItemsAreReloadedOnUndoAndRedo()
+  {
+    this->AddItems(1);
+    const auto itemSize = m_Undo->GetMemorySize();
+
+    m_Undo->SetSwappingEnabled(true);
+    m_Undo->SetUndoMemoryLimit(2 * itemSize);
+    this->AddItems(5);
+    CPPUNIT_ASSERT(this->IsSwappedOut(0));
+
+    while (m_Undo->Undo())
+    {
+    }
+
+    CPPUNIT_ASSERT(m_Undo->GetUndoList().empty());
+    CPPUNIT_ASSERT(m_Undo->GetMemorySize() <= 2 * itemSize);
+
+    const std::vector<std::string> expectedUndoPayloads = {std::string(PayloadSize, 'F'),
+                                                           std::string(PayloadSize, 'E'),
+                                                           std::string(PayloadSize, 'D'),
+                                                           std::string(PayloadSize, 'C'),
+                                                           std::string(PayloadSize, 'B'),
+                                                           std::string(PayloadSize, 'A')};
+    CPPUNIT_ASSERT(expectedUndoPayloads == m_Actor.executedPayloads);
+
+    m_Actor.executedPayloads.clear();
+    while (!m_Undo->RedoListEmpty())
+    {
+      m_Undo->Redo();
+    }
+
+    const std::vector<std::string> expectedRedoPayloads = {std::string(PayloadSize, 'a'),
+                                                           std::string(PayloadSize, 'b'),
+                                                           std::string(PayloadSize, 'c'),
+                                                           std::string(PayloadSize, 'd'),
+                                                           std::string(PayloadSize, 'e'),
+                                                           std::string(PayloadSize, 'f')};
+    CPPUNIT_ASSERT(expectedRedoPayloads == m_Actor.executedPayloads);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT(m_Undo->GetMemorySize() <= 2 * itemSize);
+  }
+
+  void SwapFileRangesAreReused()
+  {
+    this->AddItems(1);
+    const auto itemSize = m_Undo->GetMemorySize();
+
+    m_Undo->SetSwappingEnabled(true);
+    m_Undo->SetUndoMemoryLimit(2 * itemSize);
+    this->AddItems(5);
+
+    const auto swapFileSize = m_Undo->GetSwapFileSize();
+    CPPUNIT_ASSERT(swapFileSize > 0);
+
+    // every undo and redo swaps an item in and another one out
+    for (int cycle = 0; cycle < 10; ++cycle)
+    {
+      for (int i = 0; i < 3; ++i)
+        m_Undo->Undo();
+
+      for (int i = 0; i < 3; ++i)
+        m_Undo->Redo();
+
+      CPPUNIT_ASSERT(m_Undo->GetSwapFileSize() <= swapFileSize);
+    }
+
+    m_Undo->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetSwapFileSize());
+  }
+
+  void UnswappableItemsAreDropped()
+  {
+    this->AddItems(1, false);
+    const auto itemSize = m_Undo->GetMemorySize();
+
+    m_Undo->SetSwappingEnabled(true);
+    m_Undo->SetUndoMemoryLimit(2 * itemSize);
+    this->AddItems(4, false);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Undo->GetUndoList().size());
+    CPPUNIT_ASSERT_EQUAL(4, g_NumberOfPayloadOperations);
+  }
+
+  void UnrestorableItemDiscardsHistoryOnUndo()
+  {
+    this->AddItems(1);
+    const auto itemSize = m_Undo->GetMemorySize();
+
+    m_Undo->SetSwappingEnabled(true);
+    m_Undo->SetUndoMemoryLimit(2 * itemSize);
+    this->AddItems(3);
+    CPPUNIT_ASSERT(this->IsSwappedOut(0));
+
+    g_FailSwapIn = true;
+    CPPUNIT_ASSERT_NO_THROW(while (m_Undo->Undo()) {});
+    g_FailSwapIn = false;
+
+    // the items in memory are undone, undo stops at the first item that cannot be swapped in
+    CPPUNIT_ASSERT(m_Undo->GetUndoList().empty());
+    CPPUNIT_ASSERT(m_Undo->GetRedoList().empty());
+    CPPUNIT_ASSERT_EQUAL(0, g_NumberOfPayloadOperations);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Actor.executedPayloads.size());
+    CPPUNIT_ASSERT(std::string(PayloadSize, 'D') == m_Actor.executedPayloads.front());
+    CPPUNIT_ASSERT(std::string(PayloadSize, 'C') == m_Actor.executedPayloads.back());
+    CPPUNIT_ASSERT(!m_Undo->Redo());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
@@ -106,6 +106,38 @@ int mitkPropertyListTest(int /*argc*/, char * /*argv*/ [])
   }
   std::cout << "[PASSED]" << std::endl;
 
+  std::cout << "Testing MTime correctness when changing a removed property: ";
+  boolProp = mitk::BoolProperty::New(true);
+  propList->ReplaceProperty("removed", boolProp);
+  propList->RemoveProperty("removed");
+  tBefore = propList->GetMTime();
+  boolProp->SetValue(false);
+  tAfter = propList->GetMTime();
+
+  if (tBefore != tAfter)
+  {
+    std::cout << "[FAILED]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "[PASSED]" << std::endl;
+
+  std::cout << "Testing MTime correctness of a cloned list: ";
+  {
+    mitk::PropertyList::Pointer clonedList = propList->Clone();
+    tBefore = clonedList->GetMTime();
+    unsigned long tBeforeOriginal = propList->GetMTime();
+    dynamic_cast<mitk::BoolProperty *>(clonedList->GetProperty("test"))->SetValue(
+      !dynamic_cast<mitk::BoolProperty *>(clonedList->GetProperty("test"))->GetValue());
+    tAfter = clonedList->GetMTime();
+
+    if (tAfter <= tBefore || propList->GetMTime() != tBeforeOriginal || clonedList->GetMTime() != tAfter)
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "[PASSED]" << std::endl;
+
   std::cout << "Testing if existing properties survive SetProperty: ";
   propList->SetProperty("test", boolProp);
   mitk::BaseProperty *bpBefore = propList->GetProperty("test");
@@ -283,6 +315,38 @@ int mitkPropertyListTest(int /*argc*/, char * /*argv*/ [])
     return EXIT_FAILURE;
   }
 
+  std::cout << "Testing GetProperty() with interned keys: ";
+  {
+    const mitk::PropertyKey testKey("test");
+    const mitk::PropertyKey indexedKey("indexed");
+
+    auto indexedProp = mitk::IntProperty::New(1);
+    propList->SetProperty("indexed", indexedProp);
+    bool found = propList->GetProperty(testKey) == propList->GetProperty("test") &&
+                 propList->GetProperty(indexedKey) == indexedProp.GetPointer();
+
+    auto replacingProp = mitk::IntProperty::New(2);
+    propList->ReplaceProperty("indexed", replacingProp);
+    found = found && propList->GetProperty(indexedKey) == replacingProp.GetPointer();
+
+    mitk::PropertyList::Pointer clonedList = propList->Clone();
+    found = found && clonedList->GetProperty(indexedKey) == clonedList->GetProperty("indexed") &&
+            clonedList->GetProperty(indexedKey) != replacingProp.GetPointer();
+
+    propList->RemoveProperty("indexed");
+    found = found && propList->GetProperty(indexedKey) == nullptr && clonedList->GetProperty(indexedKey) != nullptr;
+
+    clonedList->Clear();
+    found = found && clonedList->GetProperty(testKey) == nullptr;
+
+    if (!found || mitk::PropertyKey::Find("test") != testKey || mitk::PropertyKey::Find("never used as a key"))
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "[PASSED]" << std::endl;
+
   std::cout << "[TEST DONE]" << std::endl;
   return EXIT_SUCCESS;
 }
@@ -172,6 +172,7 @@ class mitkPropertyRelationRuleBaseTestSuite : public mitk::TestFixture
   MITK_TEST(HasRelation);
   MITK_TEST(GetExistingRelations);
   MITK_TEST(GetRelationUIDs);
+  MITK_TEST(ModifiedRelationProperties);
   MITK_TEST(GetSourceCandidateIndicator);
   MITK_TEST(GetDestinationCandidateIndicator);
   MITK_TEST(GetConnectedSourcesDetector);
@@ -593,6 +594,33 @@ public:
 
   }
 
+  void ModifiedRelationProperties()
+  {
+    // the relation properties are parsed once and cached, so check that modifications are regarded nevertheless
+    CPPUNIT_ASSERT(rule->GetExistingRelations(source_multi).size() == 3);
+    CPPUNIT_ASSERT(rule->GetRelationUIDs(source_multi, dest_1).front() == "uid4");
+    CPPUNIT_ASSERT(rule->GetRelationUIDs(source_multi, dest_2).front() == "uid5");
+
+    auto ruleIDProp = dynamic_cast<mitk::StringProperty *>(source_multi->GetProperty("MITK.Relations.4.ruleID"));
+    ruleIDProp->SetValue("otherRuleID");
+    auto uids = rule->GetExistingRelations(source_multi);
+    CPPUNIT_ASSERT(uids.size() == 2);
+    CPPUNIT_ASSERT(std::find(uids.begin(), uids.end(), "uid5") == uids.end());
+    CPPUNIT_ASSERT(rule->GetRelationUIDs(source_multi, dest_2).empty());
+
+    auto relationUIDProp = dynamic_cast<mitk::StringProperty *>(source_multi->GetProperty("MITK.Relations.1.relationUID"));
+    relationUIDProp->SetValue("uid4_changed");
+    CPPUNIT_ASSERT(rule->GetRelationUIDs(source_multi, dest_1).front() == "uid4_changed");
+
+    source_multi->GetPropertyList()->DeleteProperty("MITK.Relations.2.ruleID");
+    uids = rule->GetExistingRelations(source_multi);
+    CPPUNIT_ASSERT(uids.size() == 1);
+    CPPUNIT_ASSERT(uids.front() == "uid4_changed");
+
+    source_multi->SetProperty("MITK.Relations.4.ruleID", mitk::StringProperty::New(rule->GetRuleID()));
+    CPPUNIT_ASSERT(rule->GetRelationUIDs(source_multi, dest_2).front() == "uid5");
+  }
+
   void GetSourceCandidateIndicator()
   {
     auto predicate = rule->GetSourceCandidateIndicator();
@@ -24,6 +24,7 @@
 #include "usAny.h"
 #include "usServicePropertiesImpl_p.h"
 
+#include <algorithm>
 #include <limits>
 #include <iterator>
 #include <cctype>
@@ -252,6 +253,72 @@ std::string LDAPExpr::ToLower(const std::string& str)
   return lowerStr;
 }
 
+bool LDAPExpr::GetMatchedValues(const std::string& attrName, ObjectClassSet& values) const
+{
+  if (d->m_operator == EQ)
+  {
+    if (d->m_attrName == attrName &&
+        d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos)
+    {
+      values.insert(d->m_attrValue);
+      return true;
+    }
+    return false;
+  }
+  else if (d->m_operator == AND)
+  {
+    // Values of different operands are not intersected, because a list valued attribute
+    // may match all of them. Any operand constraining the attribute is sufficient, so
+    // the one with the fewest values is used.
+    bool result = false;
+    LDAPExpr::ObjectClassSet matched;
+    for (std::size_t i = 0; i < d->m_args.size(); i++)
+    {
+      LDAPExpr::ObjectClassSet r;
+      if (d->m_args[i].GetMatchedValues(attrName, r) && (!result || r.size() < matched.size()))
+      {
+        matched.swap(r);
+        result = true;
+      }
+    }
+    values.insert(matched.begin(), matched.end());
+    return result;
+  }
+  else if (d->m_operator == OR)
+  {
+    LDAPExpr::ObjectClassSet matched;
+    for (std::size_t i = 0; i < d->m_args.size(); i++)
+    {
+      if (!d->m_args[i].GetMatchedValues(attrName, matched))
+      {
+        return false;
+      }
+    }
+    values.insert(matched.begin(), matched.end());
+    return true;
+  }
+  return false;
+}
+
+void LDAPExpr::GetEqualityAttributeNames(StringList& attrNames) const
+{
+  if (d->m_operator == EQ)
+  {
+    if (d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos &&
+        std::find(attrNames.begin(), attrNames.end(), d->m_attrName) == attrNames.end())
+    {
+      attrNames.push_back(d->m_attrName);
+    }
+  }
+  else if (d->m_operator == AND || d->m_operator == OR)
+  {
+    for (std::size_t i = 0; i < d->m_args.size(); i++)
+    {
+      d->m_args[i].GetEqualityAttributeNames(attrNames);
+    }
+  }
+}
+
 bool LDAPExpr::IsSimple(const StringList& keywords, LocalCache& cache,
                         bool matchCase ) const
 {
@@ -83,6 +83,26 @@ public:
    */
   bool GetMatchedObjectClasses(ObjectClassSet& objClasses) const;
 
+  /**
+   * Get a set of values of which the attribute <code>attrName</code> (matched case sensitively)
+   * must contain at least one for this LDAP expression to match. Like GetMatchedObjectClasses(),
+   * this will not work with wildcards and NOT expressions. If a set can not be determined
+   * return <code>false</code>.
+   *
+   * \param attrName The name of the attribute.
+   * \param values The set of matched values will be added to values.
+   * \return If the set cannot be determined, <code>false</code> is returned, <code>true</code> otherwise.
+   */
+  bool GetMatchedValues(const std::string& attrName, ObjectClassSet& values) const;
+
+  /**
+   * Get the names of all attributes which are compared for equality with a value
+   * without wildcards outside of NOT expressions, in the order of their occurrence.
+   *
+   * \param attrNames Names which are not contained yet will be appended to attrNames.
+   */
+  void GetEqualityAttributeNames(StringList& attrNames) const;
+
   /**
    * Checks if this LDAP expression is "simple". The definition of
    * a simple filter is:
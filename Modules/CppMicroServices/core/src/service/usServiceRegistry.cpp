@@ -19,9 +19,12 @@
 
 ============================================================================*/
 
+#include <algorithm>
+#include <cctype>
 #include <iterator>
 #include <stdexcept>
 #include <cassert>
+#include <typeinfo>
 
 #include "usServiceRegistry_p.h"
 #include "usServiceFactory.h"
@@ -34,6 +37,28 @@
 
 US_BEGIN_NAMESPACE
 
+namespace {
+
+// Number of parsed filters kept by ServiceRegistry::GetLDAPExpr_unlocked
+const std::size_t FILTER_CACHE_SIZE = 256;
+
+// Number of properties which are indexed per class
+const std::size_t MAX_INDICES_PER_CLASS = 8;
+
+bool IsObjectClass(const std::string& attrName)
+{
+  const std::string& objectClass = ServiceConstants::OBJECTCLASS();
+  if (attrName.size() != objectClass.size()) return false;
+
+  for (std::size_t i = 0; i < attrName.size(); ++i)
+  {
+    if (::tolower(attrName[i]) != objectClass[i]) return false;
+  }
+  return true;
+}
+
+}
+
 ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProperties& in,
                                                                const std::vector<std::string>& classes,
                                                                bool isFactory, bool isPrototypeFactory,
@@ -81,6 +106,9 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  filterCache.clear();
+  filterCacheEntries.clear();
+  classPropertyIndices.clear();
   core = nullptr;
 }
 
@@ -122,6 +150,7 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
       std::vector<ServiceRegistrationBase>::iterator ip =
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
+      classPropertyIndices.erase(*i);
     }
   }
 
@@ -144,6 +173,17 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
     std::vector<ServiceRegistrationBase>& s = classServices[*i];
     s.erase(std::remove(s.begin(), s.end(), sr), s.end());
     s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
+    classPropertyIndices.erase(*i);
+  }
+}
+
+void ServiceRegistry::ServicePropertiesChanged(const std::vector<std::string>& classes)
+{
+  MutexLock lock(mutex);
+  for (std::vector<std::string>::const_iterator i = classes.begin();
+       i != classes.end(); ++i)
+  {
+    classPropertyIndices.erase(*i);
   }
 }
 
@@ -198,12 +238,14 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
   std::vector<ServiceRegistrationBase> v;
+  std::vector<std::size_t> positions;
+  bool indexed = false;
   LDAPExpr ldap;
   if (clazz.empty())
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetLDAPExpr_unlocked(filter);
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched))
       {
@@ -253,17 +295,34 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetLDAPExpr_unlocked(filter);
+      indexed = GetCandidates_unlocked(clazz, it->second, ldap, positions);
     }
   }
 
-  for (; s != send; ++s)
+  if (indexed)
   {
-    ServiceReferenceBase sri = s->GetReference(clazz);
-
-    if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+    // positions are sorted, so the references keep the ranking order
+    for (std::vector<std::size_t>::const_iterator pos = positions.begin();
+         pos != positions.end(); ++pos)
+    {
+      const ServiceRegistrationBase& sr = *(s + *pos);
+      if (ldap.Evaluate(sr.d->properties, false))
+      {
+        res.push_back(sr.GetReference(clazz));
+      }
+    }
+  }
+  else
+  {
+    for (; s != send; ++s)
     {
-      res.push_back(sri);
+      ServiceReferenceBase sri = s->GetReference(clazz);
+
+      if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+      {
+        res.push_back(sri);
+      }
     }
   }
 
@@ -280,6 +339,127 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   }
 }
 
+LDAPExpr ServiceRegistry::GetLDAPExpr_unlocked(const std::string& filter) const
+{
+  US_UNORDERED_MAP_TYPE<std::string, FilterCacheList::iterator>::iterator entry = filterCacheEntries.find(filter);
+  if (entry != filterCacheEntries.end())
+  {
+    filterCache.splice(filterCache.begin(), filterCache, entry->second);
+    return entry->second->second;
+  }
+
+  // throws std::invalid_argument for invalid filters, which are not cached
+  LDAPExpr ldap(filter);
+
+  filterCache.push_front(std::make_pair(filter, ldap));
+  filterCacheEntries[filter] = filterCache.begin();
+
+  if (filterCache.size() > FILTER_CACHE_SIZE)
+  {
+    filterCacheEntries.erase(filterCache.back().first);
+    filterCache.pop_back();
+  }
+
+  return ldap;
+}
+
+bool ServiceRegistry::GetCandidates_unlocked(const std::string& clazz,
+                                             const std::vector<ServiceRegistrationBase>& serviceRegs,
+                                             const LDAPExpr& ldap, std::vector<std::size_t>& positions) const
+{
+  LDAPExpr::StringList attrNames;
+  ldap.GetEqualityAttributeNames(attrNames);
+
+  MapPropertyIndices& indices = classPropertyIndices[clazz];
+
+  for (LDAPExpr::StringList::const_iterator attrName = attrNames.begin();
+       attrName != attrNames.end(); ++attrName)
+  {
+    // all services of the class match their object class
+    if (IsObjectClass(*attrName))
+    {
+      continue;
+    }
+
+    LDAPExpr::ObjectClassSet values;
+    if (!ldap.GetMatchedValues(*attrName, values))
+    {
+      continue;
+    }
+
+    MapPropertyIndices::const_iterator indexIter = indices.find(*attrName);
+    if (indexIter == indices.end())
+    {
+      if (indices.size() >= MAX_INDICES_PER_CLASS)
+      {
+        continue;
+      }
+
+      PropertyIndex& index = indices[*attrName];
+      for (std::size_t pos = 0; pos < serviceRegs.size(); ++pos)
+      {
+        // look up the property like LDAPExpr::Evaluate does
+        const ServicePropertiesImpl& props = serviceRegs[pos].d->properties;
+        int i = props.FindCaseSensitive(*attrName);
+        if (i < 0) i = props.Find(*attrName);
+        if (i < 0) continue;
+
+        const Any& any = props.Value(i);
+        if (any.Empty())
+        {
+          continue;
+        }
+        else if (any.Type() == typeid(std::string))
+        {
+          index.positionsByValue[ref_any_cast<std::string>(any)].push_back(pos);
+        }
+        else if (any.Type() == typeid(std::vector<std::string>))
+        {
+          const std::vector<std::string>& list = ref_any_cast<std::vector<std::string> >(any);
+          for (std::vector<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+          {
+            std::vector<std::size_t>& p = index.positionsByValue[*it];
+            if (p.empty() || p.back() != pos) p.push_back(pos);
+          }
+        }
+        else if (any.Type() == typeid(std::list<std::string>))
+        {
+          const std::list<std::string>& list = ref_any_cast<std::list<std::string> >(any);
+          for (std::list<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+          {
+            std::vector<std::size_t>& p = index.positionsByValue[*it];
+            if (p.empty() || p.back() != pos) p.push_back(pos);
+          }
+        }
+        else
+        {
+          index.otherPositions.push_back(pos);
+        }
+      }
+      indexIter = indices.find(*attrName);
+    }
+
+    const PropertyIndex& index = indexIter->second;
+    for (LDAPExpr::ObjectClassSet::const_iterator value = values.begin();
+         value != values.end(); ++value)
+    {
+      US_UNORDERED_MAP_TYPE<std::string, std::vector<std::size_t> >::const_iterator p =
+          index.positionsByValue.find(*value);
+      if (p != index.positionsByValue.end())
+      {
+        positions.insert(positions.end(), p->second.begin(), p->second.end());
+      }
+    }
+    positions.insert(positions.end(), index.otherPositions.begin(), index.otherPositions.end());
+
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    return true;
+  }
+
+  return false;
+}
+
 void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& sr)
 {
   MutexLock lock(mutex);
@@ -293,6 +473,7 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
   for (std::vector<std::string>::const_iterator i = classes.begin();
        i != classes.end(); ++i)
   {
+    classPropertyIndices.erase(*i);
     std::vector<ServiceRegistrationBase>& s = classServices[*i];
     if (s.size() > 1)
     {
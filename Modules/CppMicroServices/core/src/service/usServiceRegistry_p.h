@@ -26,8 +26,11 @@
 #include "usServiceInterface.h"
 #include "usServiceRegistration.h"
 
+#include "usLDAPExpr_p.h"
 #include "usThreads_p.h"
 
+#include <list>
+
 US_BEGIN_NAMESPACE
 
 class CoreModuleContext;
@@ -116,6 +119,14 @@ public:
   void UpdateServiceRegistrationOrder(const ServiceRegistrationBase& sr,
                                       const std::vector<std::string>& classes);
 
+  /**
+   * Service properties changed, drop the property indices of the
+   * classes of the service.
+   *
+   * @param classes The class names of the service.
+   */
+  void ServicePropertiesChanged(const std::vector<std::string>& classes);
+
   /**
    * Get all services implementing a certain class.
    * Only used internally by the framework.
@@ -173,6 +184,54 @@ private:
 
   friend class ServiceHooks;
 
+  typedef std::list<std::pair<std::string, LDAPExpr> > FilterCacheList;
+
+  /**
+   * Positions of the registrations of a class in classServices by
+   * the values of one of their properties.
+   */
+  struct PropertyIndex
+  {
+    US_UNORDERED_MAP_TYPE<std::string, std::vector<std::size_t> > positionsByValue;
+
+    /**
+     * Positions of registrations whose property value is neither a string
+     * nor a list of strings. They are checked for every value.
+     */
+    std::vector<std::size_t> otherPositions;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, PropertyIndex> MapPropertyIndices;
+
+  /**
+   * Parsed filters, the most recently used first. The size is bounded.
+   */
+  mutable FilterCacheList filterCache;
+  mutable US_UNORDERED_MAP_TYPE<std::string, FilterCacheList::iterator> filterCacheEntries;
+
+  /**
+   * Mapping of classname to the property indices of its registered services,
+   * by property name. Indices are built on demand and dropped if a service
+   * of the class is registered, unregistered or changes its properties.
+   */
+  mutable US_UNORDERED_MAP_TYPE<std::string, MapPropertyIndices> classPropertyIndices;
+
+  /**
+   * Get the parsed filter from the cache or parse it.
+   *
+   * @exception std::invalid_argument If the filter is invalid.
+   */
+  LDAPExpr GetLDAPExpr_unlocked(const std::string& filter) const;
+
+  /**
+   * Get the positions of the registrations in serviceRegs which may match
+   * ldap, using an index on a property which ldap compares for equality.
+   *
+   * @return <code>false</code> if ldap cannot be answered from an index.
+   */
+  bool GetCandidates_unlocked(const std::string& clazz, const std::vector<ServiceRegistrationBase>& serviceRegs,
+                              const LDAPExpr& ldap, std::vector<std::size_t>& positions) const;
+
   void Get_unlocked(const std::string& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
   void Get_unlocked(const std::string& clazz, const std::string& filter,
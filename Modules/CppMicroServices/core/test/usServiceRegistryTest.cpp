@@ -26,6 +26,7 @@
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
 
+#include <list>
 #include <stdexcept>
 
 US_USE_NAMESPACE
@@ -127,6 +128,104 @@ void TestServicePropertiesUpdate()
   US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>().empty(), "Testing service count")
 }
 
+// Compares the filtered references with matching the filter against the properties of all references
+bool FilteredReferencesMatch(ModuleContext* context, const std::string& filter)
+{
+  std::vector<ServiceReference<ITestServiceA> > all = context->GetServiceReferences<ITestServiceA>();
+  std::vector<ServiceReference<ITestServiceA> > expected;
+  LDAPFilter ldap(filter);
+  for (std::size_t i = 0; i < all.size(); ++i)
+  {
+    std::vector<std::string> keys;
+    all[i].GetPropertyKeys(keys);
+
+    ServiceProperties props;
+    for (std::size_t j = 0; j < keys.size(); ++j)
+    {
+      props[keys[j]] = all[i].GetProperty(keys[j]);
+    }
+
+    if (ldap.Match(props)) expected.push_back(all[i]);
+  }
+
+  return context->GetServiceReferences<ITestServiceA>(filter) == expected;
+}
+
+void TestFilteredServiceReferences()
+{
+  struct TestServiceA : public ITestServiceA
+  {
+  };
+
+  ModuleContext* context = GetModuleContext();
+
+  TestServiceA services[6];
+  std::vector<ServiceRegistration<ITestServiceA> > regs;
+  const char* mimeTypes[] = { "a", "b", "a", "c", "b" };
+  for (int i = 0; i < 5; ++i)
+  {
+    ServiceProperties props;
+    props["mimetype"] = std::string(mimeTypes[i]);
+    props[ServiceConstants::SERVICE_RANKING()] = i % 3;
+    regs.push_back(context->RegisterService<ITestServiceA>(&services[i], props));
+  }
+
+  std::list<std::string> multipleMimeTypes;
+  multipleMimeTypes.push_back("a");
+  multipleMimeTypes.push_back("c");
+  ServiceProperties props;
+  props["MimeType"] = multipleMimeTypes;
+  regs.push_back(context->RegisterService<ITestServiceA>(&services[5], props));
+
+  const char* filters[] = { "(mimetype=a)",
+                            "(&(objectclass=ITestServiceA)(mimetype=b))",
+                            "(|(mimetype=a)(mimetype=b))",
+                            "(&(mimetype=a)(mimetype=c))",
+                            "(&(mimetype=a)(!(service.ranking=0)))",
+                            "(MIMETYPE=c)",
+                            "(mimetype=d)",
+                            "(mimetype=*)" };
+
+  for (std::size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); ++i)
+  {
+    US_TEST_CONDITION(FilteredReferencesMatch(context, filters[i]), "Testing filter " << filters[i])
+  }
+  US_TEST_CONDITION(context->GetServiceReferences<ITestServiceA>("(mimetype=a)").size() == 3, "Testing service count")
+
+  // repeated queries use the cached filter and index, which must follow property changes
+  props.clear();
+  props["mimetype"] = std::string("d");
+  regs[0].SetProperties(props);
+  US_TEST_CONDITION(context->GetServiceReferences<ITestServiceA>("(mimetype=a)").size() == 2, "Testing changed property")
+  US_TEST_CONDITION(context->GetServiceReferences<ITestServiceA>("(mimetype=d)").size() == 1, "Testing changed property")
+
+  props["mimetype"] = 5;
+  regs[1].SetProperties(props);
+  US_TEST_CONDITION(context->GetServiceReferences<ITestServiceA>("(mimetype=5)").size() == 1, "Testing non-string property")
+
+  regs[2].Unregister();
+  for (std::size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); ++i)
+  {
+    US_TEST_CONDITION(FilteredReferencesMatch(context, filters[i]), "Testing filter after unregistering " << filters[i])
+  }
+
+  for (int i = 0; i < 2; ++i)
+  {
+    try
+    {
+      context->GetServiceReferences<ITestServiceA>("(mimetype=a");
+      US_TEST_FAILED_MSG(<< "Invalid filter did not throw")
+    }
+    catch (const std::invalid_argument&)
+    {
+    }
+  }
+
+  for (std::size_t i = 0; i < regs.size(); ++i)
+  {
+    if (i != 2) regs[i].Unregister();
+  }
+}
 
 int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
 {
@@ -135,6 +234,7 @@ int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
   TestServiceInterfaceId();
   TestMultipleServiceRegistrations();
   TestServicePropertiesUpdate();
+  TestFilteredServiceReferences();
 
   US_TEST_END()
 }
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -43,6 +44,20 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initialize the cache from several scanners, each of which scanned one partition of the input files.
+        The input files of the cache are the concatenation of inputFilesPerScanner, the
+        frame list has the same order and content as if all files were scanned by a single scanner.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags,
+                     const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                     const std::vector<StringList>& inputFilesPerScanner);
+
+      /**
+        \brief Returns the (first) scanner the cache was initialized with.
+        @remark If the cache was filled by a partitioned scan, this scanner only knows
+        the first partition of files. Use GetFrameInfoList() to access all results.
+      */
       const gdcm::Scanner& GetScanner() const;
 
   protected:
@@ -52,7 +67,7 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
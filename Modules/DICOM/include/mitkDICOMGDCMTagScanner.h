@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkDICOMTagScanner.h"
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMTagCache.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 namespace mitk
 {
@@ -77,6 +78,34 @@ namespace mitk
       */
       void SetInputFiles(const StringList& filenames) override;
 
+      /**
+        \brief Number of worker threads used by Scan().
+        With more than one thread, the input files are split into contiguous
+        partitions that are scanned concurrently by separate gdcm::Scanner instances.
+        The resulting cache is identical to the one of a single threaded scan.
+        A value of 0 uses one thread per hardware core. Default is 1.
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
+      /**
+        \brief Controls whether Scan() consults a persistent tag index (see DICOMPersistentTagCache).
+        If enabled, files whose index entry is up to date (same size, modification time and all
+        requested tags present) are not read again. Only new or changed files are scanned and the
+        index is updated afterwards. The scan cache is a DICOMPersistentTagCache then. Default is off.
+      */
+      itkSetMacro(UsePersistentCache, bool);
+      itkGetConstMacro(UsePersistentCache, bool);
+      itkBooleanMacro(UsePersistentCache);
+
+      /**
+        \brief Directory for persistent tag index files.
+        Every directory of the input files gets an index file of its own in this directory.
+        If empty (default), DICOMPersistentTagCache::GetDefaultCacheDirectory() is used.
+      */
+      itkSetStringMacro(PersistentCacheDirectory);
+      itkGetStringMacro(PersistentCacheDirectory);
+
       /**
         \brief Start the scanning process.
         Calling Scan() will invalidate previous scans, forgetting
@@ -101,15 +130,31 @@ namespace mitk
       */
       virtual DICOMDatasetFinding GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const;
 
+      /**
+        \brief Number of files whose headers have been read by the last call of Scan().
+        Files taken from the persistent cache are not counted.
+      */
+      std::size_t GetNumberOfScannedFiles() const;
+
     protected:
 
       DICOMGDCMTagScanner();
       ~DICOMGDCMTagScanner() override;
 
+      /** Scans the passed files for all tags of interest (serial or partitioned, see SetNumberOfThreads()). */
+      DICOMGDCMTagCache::Pointer ScanFiles(const StringList& filenames);
+
+      /** Takes all up to date files from the persistent index and scans the remaining ones. */
+      DICOMPersistentTagCache::Pointer ScanWithPersistentCache();
+
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
-      DICOMGDCMTagCache::Pointer m_Cache;
+      DICOMTagCache::Pointer m_Cache;
       std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
+      unsigned int m_NumberOfThreads;
+      bool m_UsePersistentCache;
+      std::string m_PersistentCacheDirectory;
+      std::size_t m_NumberOfScannedFiles;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
@@ -206,6 +206,7 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     // void AllocateOutputImages();
     /**
       \brief Loads images using itk::ImageSeriesReader, potentially applies shearing to correct gantry tilt.
+      See SetNumberOfLoadThreads() for concurrent loading.
     */
     bool LoadImages() override;
 
@@ -259,6 +260,36 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
       return m_SimpleVolumeReading;
     };
 
+    /**
+      \brief Number of threads used to scan the DICOM headers in AnalyzeInputFiles() (see DICOMGDCMTagScanner::SetNumberOfThreads()).
+      A value of 0 uses one thread per hardware core. Default is 1.
+    */
+    void SetNumberOfScanThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfScanThreads() const;
+
+    /**
+      \brief Number of threads used to decode pixel data in LoadImages().
+      Outputs are loaded concurrently, and the threads that are not needed for this are used to decode the
+      slices within an output (see ITKDICOMSeriesReaderHelper::SetNumberOfThreads()). The loaded images are
+      identical to the ones of single threaded loading. A value of 0 uses one thread per hardware core. Default is 1.
+    */
+    void SetNumberOfLoadThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfLoadThreads() const;
+
+    /**
+      \brief Controls whether AnalyzeInputFiles() uses a persistent tag index, so that unchanged files are not scanned again
+      (see DICOMGDCMTagScanner::SetUsePersistentCache()). Default is off.
+    */
+    void SetUsePersistentTagCache(bool use);
+    bool GetUsePersistentTagCache() const;
+
+    /**
+      \brief Directory for the persistent tag index. If empty (default), a per-user cache directory is used
+      (see DICOMPersistentTagCache::GetDefaultCacheDirectory()).
+    */
+    void SetPersistentTagCacheDirectory(const std::string& directory);
+    std::string GetPersistentTagCacheDirectory() const;
+
     double GetToleratedOriginError() const;
     bool IsToleratedOriginOffsetAbsolute() const;
 
@@ -292,6 +323,8 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     /**
       \brief Remember current locale on stack, activate "C" locale.
       "C" locale is required for correct parsing of numbers by itk::ImageSeriesReader
+      Nested calls (e.g. from concurrently loaded blocks) only count the nesting depth,
+      the locale is restored by the PopLocale() matching the outermost PushLocale().
     */
     void PushLocale() const;
     /**
@@ -331,6 +364,9 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     virtual bool LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const;
 
+    /// \brief Number of threads an ITKDICOMSeriesReaderHelper may use to decode the slices of a single block
+    unsigned int GetNumberOfThreadsPerBlock() const;
+
     /// \brief Describe this reader's confidence for given SOP class UID
   static ReaderImplementationLevel GetReaderImplementationLevel(const std::string sopClassUID);
   private:
@@ -365,11 +401,19 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     mutable std::stack<std::string> m_ReplacedCLocales;
     mutable std::stack<std::locale> m_ReplacedCinLocales;
+    mutable unsigned int m_LocaleDepth;
 
     double m_DecimalPlacesForOrientation;
 
     DICOMTagCache::Pointer m_TagCache;
     bool m_ExternalCache;
+
+    unsigned int m_NumberOfScanThreads;
+    bool m_UsePersistentTagCache;
+    std::string m_PersistentTagCacheDirectory;
+
+    unsigned int m_NumberOfLoadThreads;
+    unsigned int m_NumberOfConcurrentlyLoadedBlocks;
 };
 
 }
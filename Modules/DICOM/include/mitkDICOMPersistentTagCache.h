@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include "mitkDICOMGenericTagCache.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Tag cache that can be stored in and restored from a binary index file.
+
+    For every indexed file the cache remembers the file size, the modification time,
+    the set of tags that were scanned and the values found for them. A file entry is
+    only considered up to date if size and modification time still match the file on
+    disk and all requested tags have been scanned before.
+
+    DICOMGDCMTagScanner uses this class (see DICOMGDCMTagScanner::SetUsePersistentCache())
+    to rescan only new or changed files when the same data is analyzed repeatedly.
+
+    After SetInputFiles() the frame list of the cache (GetFrameInfoList()) contains one
+    frame per input file that has an entry in the cache, in the order of the input files.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagCache : public DICOMGenericTagCache
+  {
+    public:
+
+      mitkClassMacro(DICOMPersistentTagCache, DICOMGenericTagCache);
+      itkFactorylessNewMacro( DICOMPersistentTagCache );
+
+      /**
+        \brief Per-user directory for index files.
+        This is MITK/DICOMTagCache in %LOCALAPPDATA% on Windows, in ~/Library/Caches on macOS
+        and in $XDG_CACHE_HOME (or ~/.cache) otherwise. Empty if none of these can be determined.
+      */
+      static std::string GetDefaultCacheDirectory();
+
+      /**
+        \brief Location of the index file for files in dataDirectory.
+        The index is located in cacheDirectory (GetDefaultCacheDirectory() if empty) and named after a
+        hash of dataDirectory, so that no files are written to the data directory.
+        Empty if no cache directory can be determined.
+      */
+      static std::string GetIndexFilePath(const std::string& dataDirectory, const std::string& cacheDirectory = "");
+
+      /**
+        \brief Replaces the content of the cache with the content of the index file.
+        @return false if the file does not exist or is no valid index file. The cache is empty then.
+      */
+      bool Load(const std::string& indexFile);
+
+      /**
+        \brief Writes all entries whose files still exist to the index file.
+        The file is written to a uniquely named temporary file in the same directory first and
+        then renamed, so that readers and concurrent writers never see a partially written index.
+        Throws mitk::Exception if the file cannot be written.
+      */
+      void Save(const std::string& indexFile) const;
+
+      /**
+        \brief Checks whether the entry of the file exists, matches size and modification time
+        of the file and contains values for all passed tags.
+      */
+      bool IsUpToDate(const std::string& filename, const std::set<DICOMTag>& tags) const;
+
+      /**
+        \brief Adds or updates the entry of the frame's file with the values of all scannedTags.
+        Values of other tags of an existing, still up to date entry are kept.
+      */
+      void AddScanResult(const DICOMDatasetAccessingImageFrameInfo* frame, const std::set<DICOMTag>& scannedTags);
+
+      /**
+        \brief Adds all entries of other, replacing entries for the same files.
+        Used to combine the indices of several data directories.
+      */
+      void Merge(const DICOMPersistentTagCache* other);
+
+      void SetInputFiles(const StringList& filenames) override;
+
+      std::size_t GetNumberOfEntries() const;
+
+  protected:
+
+      DICOMPersistentTagCache();
+      ~DICOMPersistentTagCache() override;
+
+      struct Entry
+      {
+        std::uint64_t size = 0;
+        std::int64_t modificationTime = 0;
+        std::set<DICOMTag> scannedTags;
+        DICOMGenericImageFrameInfo::Pointer frame;
+      };
+
+      /** Reads size and modification time of a file. Returns false if the file does not exist. */
+      static bool GetFileStatus(const std::string& filename, std::uint64_t& size, std::int64_t& modificationTime);
+
+      std::map<std::string, Entry> m_Entries;
+
+    private:
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
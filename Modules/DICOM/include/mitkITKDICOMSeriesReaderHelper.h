@@ -16,8 +16,12 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTag.h"
+#include "mitkDICOMTagCache.h"
 
 #include <itkGDCMImageIO.h>
+#include <itkImageSeriesReader.h>
+
+#include <map>
 
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
@@ -25,7 +29,7 @@ class OFDateTime;
 namespace mitk
 {
 
-class ITKDICOMSeriesReaderHelper
+class MITKDICOM_EXPORT ITKDICOMSeriesReaderHelper
 {
   public:
 
@@ -37,14 +41,42 @@ class ITKDICOMSeriesReaderHelper
     typedef std::list<StringContainer> StringContainerList;
 
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
-    Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
+    /** Loads a 3D+t image, one container of filenames per time step.
+     @param tagCache Optional tag cache that already holds AcquisitionDateTag,
+     AcquisitionTimeTag and TriggerTimeTag for the passed files (e.g. the cache
+     of the reader that sorted the files). The time bounds are then taken from
+     the cache; only files that are not part of the cache or whose cached frame
+     holds none of these tags are scanned again.
+     */
+    Image::Pointer Load3DnT( const StringContainerList& filenamesLists,
+                             bool correctTilt,
+                             const GantryTiltInformation& tiltInfo,
+                             const DICOMTagCache* tagCache = nullptr );
 
     static bool CanHandleFile(const std::string& filename);
 
+    /** Number of threads used to decode the slices of one volume. Every file is
+     decoded by an itk::GDCMImageIO of its thread directly into the mitk::Image.
+     Volumes whose files differ in pixel type or size and gantry tilted volumes are
+     read by a single itk::ImageSeriesReader as before. A value of 0 uses one thread
+     per hardware core. Default is 1. */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** Number of tag scanner runs of the last Load3DnT() call to get the time bounds. */
+    std::size_t GetNumberOfTagScans() const;
+    /** Number of files whose headers were read by the last Load3DnT() call to get the time bounds. */
+    std::size_t GetNumberOfScannedFiles() const;
+
   private:
 
+    unsigned int m_NumberOfThreads = 1;
+    std::size_t m_NumberOfTagScans = 0;
+    std::size_t m_NumberOfScannedFiles = 0;
+
     typedef std::vector<TimeBounds> TimeBoundsList;
     typedef itk::FixedArray<OFDateTime,2>  DateTimeBounds;
+    typedef std::map<std::string, DICOMDatasetAccessingImageFrameInfo::Pointer> FrameInfoLookup;
 
 
     /** Scans the given files for the acquisition time and returns the lowest and
@@ -52,18 +84,21 @@ class ITKDICOMSeriesReaderHelper
      @param bounds The acquisition date time bound extracted from the files.
      @param triggerBounds Time bounds for trigger information extracted from the files.
      If no trigger information was found than it returns trigger == [0.0, 0.0].
+     @param cachedFrames Frame infos of already scanned files. Only files missing
+     in this lookup, or whose frame info holds none of the time tags, are scanned.
      @return If no acquisition date times can be found the function return will be false. Otherwise
      it returns True.
      */
-    static bool ExtractDateTimeBoundsAndTriggerOfTimeStep( const StringContainer& filenamesOfTimeStep,
-      DateTimeBounds& bounds, TimeBounds& triggerBounds);
+    bool ExtractDateTimeBoundsAndTriggerOfTimeStep( const StringContainer& filenamesOfTimeStep,
+      DateTimeBounds& bounds, TimeBounds& triggerBounds, const FrameInfoLookup& cachedFrames);
 
     /* Determine the time bounds in ms respective to the baselineDateTime for the passed
     files. Additionally it regards the trigger time tag if set and acquisition date time
     carries not enough information.*/
-    static bool ExtractTimeBoundsOfTimeStep(const StringContainer& filenamesOfTimeStep,
+    bool ExtractTimeBoundsOfTimeStep(const StringContainer& filenamesOfTimeStep,
                                                  TimeBounds& bounds,
-                                                 const OFDateTime& baselineDateTime );
+                                                 const OFDateTime& baselineDateTime,
+                                                 const FrameInfoLookup& cachedFrames );
 
 
     /** Returns the list of time bounds of all passed time step containers.
@@ -71,8 +106,10 @@ class ITKDICOMSeriesReaderHelper
      Time steps where no time bounds could be extracted
      are indecated by "null" time bounds (both values "0"). The order of the returned
      list equals of passed filenamesOfTimeSteps order.
-     @remark The function regards acquisition date time tags and trigger time tags.*/
-    static TimeBoundsList ExtractTimeBoundsOfTimeSteps (const StringContainerList& filenamesOfTimeSteps);
+     @remark The function regards acquisition date time tags and trigger time tags.
+     If tagCache is set, the tag values are taken from it instead of rescanning the files.*/
+    TimeBoundsList ExtractTimeBoundsOfTimeSteps (const StringContainerList& filenamesOfTimeSteps,
+                                                        const DICOMTagCache* tagCache = nullptr);
 
     /** Helper function that generates  a time geometry using the template and the passed boundslist
         (which indicates the number of time steps).
@@ -83,6 +120,14 @@ class ITKDICOMSeriesReaderHelper
     typename ImageType::Pointer
     FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo );
 
+    /** Reads the files (one slice each) concurrently into the volume of the time step
+     of the passed image, which has to be initialized with the information determined by
+     the series reader.
+     @return false if the files do not match the image without conversion; the caller
+     has to use an itk::ImageSeriesReader then.*/
+    template <typename PixelType>
+    bool ReadSlicesIntoImage( const StringContainer& filenames, Image* image, unsigned int timeStep ) const;
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK( const StringContainer& filenames,
@@ -95,6 +140,7 @@ class ITKDICOMSeriesReaderHelper
     LoadDICOMByITK3DnT( const StringContainerList& filenames,
                         bool correctTilt,
                         const GantryTiltInformation& tiltInfo,
+                        const DICOMTagCache* tagCache,
                         itk::GDCMImageIO::Pointer& io);
 
 
@@ -12,7 +12,10 @@ found in the LICENSE file.
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
 
+#include <mitkImageWriteAccessor.h>
+
 #include <itkImageSeriesReader.h>
+#include <itkPixelTraits.h>
 #include <itkResampleImageFilter.h>
 //#include <itkAffineTransform.h>
 //#include <itkLinearInterpolateImageFunction.h>
@@ -20,6 +23,94 @@ found in the LICENSE file.
 
 #include "dcmtk/ofstd/ofdatime.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+template <typename PixelType>
+bool
+mitk::ITKDICOMSeriesReaderHelper
+::ReadSlicesIntoImage( const StringContainer& filenames, Image* image, unsigned int timeStep ) const
+{
+  typedef typename itk::PixelTraits<PixelType>::ValueType ComponentType;
+
+  const std::size_t sizeX = image->GetDimension(0);
+  const std::size_t sizeY = image->GetDimension(1);
+  const std::size_t pixelsPerSlice = sizeX * sizeY;
+
+  if (filenames.size() != image->GetDimension(2))
+    return false; // e.g. multi-frame files
+
+  const std::size_t numberOfThreads = std::min<std::size_t>(
+    0 == m_NumberOfThreads ? std::max(1u, std::thread::hardware_concurrency()) : m_NumberOfThreads,
+    filenames.size());
+
+  ImageWriteAccessor accessor(image, image->GetVolumeData(timeStep));
+  auto* buffer = static_cast<PixelType*>(accessor.GetData());
+
+  std::atomic<std::size_t> nextSlice(0);
+  std::atomic<bool> success(true);
+
+  auto decodeSlices = [&]()
+  {
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+
+    for (std::size_t slice = nextSlice++; slice < filenames.size() && success; slice = nextSlice++)
+    {
+      try
+      {
+        io->SetFileName(filenames[slice]);
+        io->ReadImageInformation();
+
+        // only take slices that the series reader would copy without any conversion
+        if (io->GetComponentType() != itk::ImageIOBase::MapPixelType<ComponentType>::CType
+            || io->GetNumberOfComponents() != itk::PixelTraits<PixelType>::Dimension
+            || io->GetDimensions(0) != sizeX || io->GetDimensions(1) != sizeY
+            || (io->GetNumberOfDimensions() > 2 && io->GetDimensions(2) != 1))
+        {
+          success = false;
+          break;
+        }
+
+        itk::ImageIORegion ioRegion(io->GetNumberOfDimensions());
+        for (unsigned int d = 0; d < io->GetNumberOfDimensions(); ++d)
+        {
+          ioRegion.SetSize(d, io->GetDimensions(d));
+        }
+        io->SetIORegion(ioRegion);
+
+        io->Read(buffer + slice * pixelsPerSlice);
+      }
+      catch (...)
+      {
+        // the fallback to itk::ImageSeriesReader will report the error
+        success = false;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(numberOfThreads - 1);
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+  {
+    workers.emplace_back(decodeSlices);
+  }
+
+  decodeSlices();
+
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  if (!success)
+  {
+    MITK_DEBUG << "Slices cannot be decoded into the image, falling back to itk::ImageSeriesReader";
+  }
+
+  return success;
+}
+
 template <typename PixelType>
 mitk::Image::Pointer
 mitk::ITKDICOMSeriesReaderHelper
@@ -46,17 +137,31 @@ mitk::ITKDICOMSeriesReaderHelper
                              // see NormalDirectionConsistencySorter.
 
   reader->SetFileNames(filenames);
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
 
-  // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
-  if (correctTilt)
+  // geometry and size exactly as the series reader determines them (only reads headers),
+  // the pixels are decoded straight into the image then
+  bool isRead = false;
+  if (!correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    reader->UpdateOutputInformation();
+    image->InitializeByItk(reader->GetOutput());
+    isRead = ReadSlicesIntoImage<PixelType>(filenames, image, 0);
   }
 
-  image->InitializeByItk(readVolume.GetPointer());
-  image->SetImportVolume(readVolume->GetBufferPointer());
+  if (!isRead)
+  {
+    reader->Update();
+    typename ImageType::Pointer readVolume = reader->GetOutput();
+
+    // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
+    if (correctTilt)
+    {
+      readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+    }
+
+    image->InitializeByItk(readVolume.GetPointer());
+    image->SetImportVolume(readVolume->GetBufferPointer());
+  }
 
 #ifdef MBILOG_ENABLE_DEBUG
 
@@ -87,12 +192,13 @@ mitk::ITKDICOMSeriesReaderHelper
     const StringContainerList& filenamesForTimeSteps,
     bool correctTilt,
     const GantryTiltInformation& tiltInfo,
+    const DICOMTagCache* tagCache,
     itk::GDCMImageIO::Pointer& io)
 {
   unsigned int numberOfTimeSteps = filenamesForTimeSteps.size();
 
   MITK_DEBUG << "Start extracting time bounds of time steps";
-  const TimeBoundsList timeBoundsList = ExtractTimeBoundsOfTimeSteps(filenamesForTimeSteps);
+  const TimeBoundsList timeBoundsList = ExtractTimeBoundsOfTimeSteps(filenamesForTimeSteps, tagCache);
   if (numberOfTimeSteps!=timeBoundsList.size())
   {
     mitkThrow() << "Error while loading 3D+t. Inconsistent size of generated time bounds list. List size: "<< timeBoundsList.size() << "; number of steps: "<<numberOfTimeSteps;
@@ -122,17 +228,32 @@ mitk::ITKDICOMSeriesReaderHelper
 #endif // MBILOG_ENABLE_DEBUG
 
   reader->SetFileNames(filenamesForTimeSteps.front());
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
 
-  // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
-  if (correctTilt)
+  // geometry and size exactly as the series reader determines them (only reads headers),
+  // the pixels are decoded straight into the image then
+  bool isRead = false;
+  if (!correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    reader->UpdateOutputInformation();
+    image->InitializeByItk(reader->GetOutput(), 1, numberOfTimeSteps);
+    isRead = ReadSlicesIntoImage<PixelType>(filenamesForTimeSteps.front(), image, currentTimeStep);
   }
 
-  image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
-  image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep++); // timestep 0
+  if (!isRead)
+  {
+    reader->Update();
+    typename ImageType::Pointer readVolume = reader->GetOutput();
+
+    // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
+    if (correctTilt)
+    {
+      readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+    }
+
+    image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
+    image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+  }
+  ++currentTimeStep; // timestep 0
 
   // for other time-steps
   for (auto timestepsIter = ++(filenamesForTimeSteps.cbegin()); // start with SECOND entry
@@ -144,16 +265,19 @@ mitk::ITKDICOMSeriesReaderHelper
     MITK_DEBUG_OUTPUT_FILELIST( *timestepsIter )
 #endif // MBILOG_ENABLE_DEBUG
 
-    reader->SetFileNames( *timestepsIter );
-    reader->Update();
-    readVolume = reader->GetOutput();
-
-    if (correctTilt)
+    if (correctTilt || !ReadSlicesIntoImage<PixelType>(*timestepsIter, image, currentTimeStep))
     {
-      readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
-    }
+      reader->SetFileNames( *timestepsIter );
+      reader->Update();
+      typename ImageType::Pointer readVolume = reader->GetOutput();
 
-    image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+      if (correctTilt)
+      {
+        readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+      }
+
+      image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+    }
   }
 
 #ifdef MBILOG_ENABLE_DEBUG
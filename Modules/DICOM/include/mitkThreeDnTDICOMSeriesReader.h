@@ -61,6 +61,10 @@ class MITKDICOM_EXPORT ThreeDnTDICOMSeriesReader : public DICOMITKSeriesGDCMRead
 
     bool operator==(const DICOMFileReader& other) const override;
 
+    /// \brief Adds the acquisition date/time and trigger time tags, so that the
+    /// time bounds of 3D+t blocks can be taken from the tag cache.
+    DICOMTagPathList GetTagsOfInterest() const override;
+
     static bool GetDefaultGroup3DandT()
     {
       return m_DefaultGroup3DandT;
@@ -83,22 +83,47 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
 {
+  this->InitCache(scannedTags,
+                  std::vector<std::shared_ptr<gdcm::Scanner>>(1, scanner),
+                  std::vector<StringList>(1, inputFiles));
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags,
+                                   const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                                   const std::vector<StringList>& inputFilesPerScanner)
+{
+  if (scanners.empty() || scanners.size() != inputFilesPerScanner.size())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). Number of scanners (" << scanners.size()
+                << ") does not match number of file partitions (" << inputFilesPerScanner.size() << ").";
+  }
+
   m_ScannedTags = scannedTags;
-  m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners; // keep alive, the frame infos point into the value storage of the scanners
+
+  m_InputFilenames.clear();
+  for (const auto& files : inputFilesPerScanner)
+  {
+    m_InputFilenames.insert(m_InputFilenames.end(), files.cbegin(), files.cend());
+  }
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
-  for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
+  for (std::size_t partition = 0; partition < m_Scanners.size(); ++partition)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    const auto& files = inputFilesPerScanner[partition];
+    for (auto inputIter = files.cbegin(); inputIter != files.cend(); ++inputIter)
+    {
+      m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
+        m_Scanners[partition]->GetMapping(inputIter->c_str())).GetPointer());
+    }
   }
 }
 
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
-  return *(this->m_Scanner);
+  return *(this->m_Scanners.front());
 }
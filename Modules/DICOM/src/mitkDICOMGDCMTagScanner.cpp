@@ -15,8 +15,16 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
 #include <gdcmScanner.h>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <set>
+#include <thread>
 
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
+  : m_NumberOfThreads(1), m_UsePersistentCache(false), m_NumberOfScannedFiles(0)
 {
   m_GDCMScanner = std::make_shared<gdcm::Scanner>();
 }
@@ -92,13 +100,170 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 
 void mitk::DICOMGDCMTagScanner::Scan()
 {
-  // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  m_NumberOfScannedFiles = 0;
+
+  if (m_UsePersistentCache && !m_InputFilenames.empty())
+  {
+    m_Cache = this->ScanWithPersistentCache().GetPointer();
+  }
+  else
+  {
+    m_Cache = this->ScanFiles(m_InputFilenames).GetPointer();
+  }
+}
+
+mitk::DICOMPersistentTagCache::Pointer mitk::DICOMGDCMTagScanner::ScanWithPersistentCache()
+{
+  // every data directory has an index of its own
+  std::map<std::string, DICOMPersistentTagCache::Pointer> directoryCaches;
+  std::map<std::string, std::string> indexFiles;
+  StringList outdatedFiles;
+
+  for (const auto& filename : m_InputFilenames)
+  {
+    const std::string dataDirectory = itksys::SystemTools::GetFilenamePath(filename);
+
+    auto& directoryCache = directoryCaches[dataDirectory];
+    if (directoryCache.IsNull())
+    {
+      directoryCache = DICOMPersistentTagCache::New();
+      indexFiles[dataDirectory] = DICOMPersistentTagCache::GetIndexFilePath(dataDirectory, m_PersistentCacheDirectory);
+      if (!indexFiles[dataDirectory].empty())
+        directoryCache->Load(indexFiles[dataDirectory]);
+    }
+
+    if (!directoryCache->IsUpToDate(filename, m_ScannedTags))
+      outdatedFiles.push_back(filename);
+  }
+
+  if (!outdatedFiles.empty())
+  {
+    std::set<std::string> modifiedDirectories;
+
+    const DICOMGDCMTagCache::Pointer scanResult = this->ScanFiles(outdatedFiles);
+    for (const auto& frame : scanResult->GetFrameInfoList())
+    {
+      const std::string dataDirectory = itksys::SystemTools::GetFilenamePath(frame->Filename);
+      directoryCaches[dataDirectory]->AddScanResult(frame, m_ScannedTags);
+      modifiedDirectories.insert(dataDirectory);
+    }
+
+    for (const auto& dataDirectory : modifiedDirectories)
+    {
+      const std::string& indexFile = indexFiles[dataDirectory];
+      if (indexFile.empty())
+      {
+        MITK_WARN << "No cache directory for the DICOM tag index of " << dataDirectory;
+        continue;
+      }
+
+      try
+      {
+        itksys::SystemTools::MakeDirectory(itksys::SystemTools::GetFilenamePath(indexFile));
+        directoryCaches[dataDirectory]->Save(indexFile);
+      }
+      catch (const mitk::Exception& e)
+      {
+        // not being able to persist the index only costs performance next time
+        MITK_WARN << "DICOM tag index could not be updated: " << e.GetDescription();
+      }
+    }
+  }
+
+  DICOMPersistentTagCache::Pointer cache = DICOMPersistentTagCache::New();
+  for (const auto& directoryCache : directoryCaches)
+    cache->Merge(directoryCache.second);
+
+  cache->SetInputFiles(m_InputFilenames);
+
+  return cache;
+}
+
+mitk::DICOMGDCMTagCache::Pointer mitk::DICOMGDCMTagScanner::ScanFiles(const StringList& filenames)
+{
+  std::size_t numberOfThreads = 0 == m_NumberOfThreads
+    ? std::max(1u, std::thread::hardware_concurrency())
+    : m_NumberOfThreads;
+  numberOfThreads = std::min(numberOfThreads, filenames.size());
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
 
-  m_Cache = newCache;
+  if (numberOfThreads < 2)
+  {
+    // TODO integrate push/pop locale??
+    m_GDCMScanner->Scan( filenames );
+    newCache->InitCache(m_ScannedTags, m_GDCMScanner, filenames);
+  }
+  else
+  {
+    // Split the input into contiguous partitions of (almost) equal size. Each
+    // partition gets its own gdcm::Scanner, because a scanner keeps its results
+    // (and the value storage the frame infos point into) in the scanner itself.
+    std::vector<std::shared_ptr<gdcm::Scanner>> scanners(numberOfThreads);
+    std::vector<StringList> partitions(numberOfThreads);
+
+    const std::size_t filesPerPartition = filenames.size() / numberOfThreads;
+    const std::size_t remainder = filenames.size() % numberOfThreads;
+    auto partitionStart = filenames.cbegin();
+
+    for (std::size_t i = 0; i < numberOfThreads; ++i)
+    {
+      const auto partitionEnd = partitionStart + (filesPerPartition + (i < remainder ? 1 : 0));
+      partitions[i].assign(partitionStart, partitionEnd);
+      partitionStart = partitionEnd;
+
+      scanners[i] = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanners[i]->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+    }
+
+    std::vector<std::exception_ptr> errors(numberOfThreads);
+    std::vector<std::thread> workers;
+    workers.reserve(numberOfThreads - 1);
+
+    auto scanPartition = [&scanners, &partitions, &errors](std::size_t i)
+    {
+      try
+      {
+        scanners[i]->Scan(partitions[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    };
+
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+    {
+      workers.emplace_back(scanPartition, i);
+    }
+
+    scanPartition(0); // the calling thread takes the first partition
+
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+
+    for (const auto& error : errors)
+    {
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    newCache->InitCache(m_ScannedTags, scanners, partitions);
+  }
+
+  m_NumberOfScannedFiles += filenames.size();
+
+  return newCache;
+}
+
+std::size_t mitk::DICOMGDCMTagScanner::GetNumberOfScannedFiles() const
+{
+  return m_NumberOfScannedFiles;
 }
 
 mitk::DICOMTagCache::Pointer
@@ -21,6 +21,11 @@ found in the LICENSE file.
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMGDCMTagScanner.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 std::mutex mitk::DICOMITKSeriesGDCMReader::s_LocaleMutex;
 
 
@@ -28,8 +33,13 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 : DICOMFileReader()
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
+, m_LocaleDepth( 0 )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
+, m_NumberOfScanThreads(1)
+, m_UsePersistentTagCache(false)
+, m_NumberOfLoadThreads(1)
+, m_NumberOfConcurrentlyLoadedBlocks(1)
 {
   this->EnsureMandatorySortersArePresent( decimalPlacesForOrientation, simpleVolumeImport );
 }
@@ -44,9 +54,15 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGD
 , m_NormalDirectionConsistencySorter( other.m_NormalDirectionConsistencySorter->Clone() )
 , m_ReplacedCLocales( other.m_ReplacedCLocales )
 , m_ReplacedCinLocales( other.m_ReplacedCinLocales )
+, m_LocaleDepth( other.m_LocaleDepth )
 , m_DecimalPlacesForOrientation( other.m_DecimalPlacesForOrientation )
 , m_TagCache( other.m_TagCache )
 , m_ExternalCache(other.m_ExternalCache)
+, m_NumberOfScanThreads(other.m_NumberOfScanThreads)
+, m_UsePersistentTagCache(other.m_UsePersistentTagCache)
+, m_PersistentTagCacheDirectory(other.m_PersistentTagCacheDirectory)
+, m_NumberOfLoadThreads(other.m_NumberOfLoadThreads)
+, m_NumberOfConcurrentlyLoadedBlocks(1)
 {
 }
 
@@ -67,8 +83,13 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
     this->m_NormalDirectionConsistencySorter = other.m_NormalDirectionConsistencySorter->Clone();
     this->m_ReplacedCLocales                 = other.m_ReplacedCLocales;
     this->m_ReplacedCinLocales               = other.m_ReplacedCinLocales;
+    this->m_LocaleDepth                      = other.m_LocaleDepth;
     this->m_DecimalPlacesForOrientation      = other.m_DecimalPlacesForOrientation;
     this->m_TagCache                         = other.m_TagCache;
+    this->m_NumberOfScanThreads              = other.m_NumberOfScanThreads;
+    this->m_UsePersistentTagCache            = other.m_UsePersistentTagCache;
+    this->m_PersistentTagCacheDirectory      = other.m_PersistentTagCacheDirectory;
+    this->m_NumberOfLoadThreads              = other.m_NumberOfLoadThreads;
   }
   return *this;
 }
@@ -130,6 +151,67 @@ bool mitk::DICOMITKSeriesGDCMReader::GetAcceptTwoSlicesGroups() const
   return m_EquiDistantBlocksSorter->GetAcceptTwoSlicesGroups();
 }
 
+void mitk::DICOMITKSeriesGDCMReader::SetNumberOfScanThreads( unsigned int numberOfThreads )
+{
+  if ( m_NumberOfScanThreads != numberOfThreads )
+  {
+    m_NumberOfScanThreads = numberOfThreads;
+    this->Modified();
+  }
+}
+
+unsigned int mitk::DICOMITKSeriesGDCMReader::GetNumberOfScanThreads() const
+{
+  return m_NumberOfScanThreads;
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetUsePersistentTagCache( bool use )
+{
+  if ( m_UsePersistentTagCache != use )
+  {
+    m_UsePersistentTagCache = use;
+    this->Modified();
+  }
+}
+
+bool mitk::DICOMITKSeriesGDCMReader::GetUsePersistentTagCache() const
+{
+  return m_UsePersistentTagCache;
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetPersistentTagCacheDirectory( const std::string& directory )
+{
+  if ( m_PersistentTagCacheDirectory != directory )
+  {
+    m_PersistentTagCacheDirectory = directory;
+    this->Modified();
+  }
+}
+
+std::string mitk::DICOMITKSeriesGDCMReader::GetPersistentTagCacheDirectory() const
+{
+  return m_PersistentTagCacheDirectory;
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetNumberOfLoadThreads( unsigned int numberOfThreads )
+{
+  m_NumberOfLoadThreads = numberOfThreads; // does not influence the analysis, thus no Modified()
+}
+
+unsigned int mitk::DICOMITKSeriesGDCMReader::GetNumberOfLoadThreads() const
+{
+  return m_NumberOfLoadThreads;
+}
+
+unsigned int mitk::DICOMITKSeriesGDCMReader::GetNumberOfThreadsPerBlock() const
+{
+  const unsigned int numberOfThreads = 0 == m_NumberOfLoadThreads
+    ? std::max( 1u, std::thread::hardware_concurrency() )
+    : m_NumberOfLoadThreads;
+
+  return std::max( 1u, numberOfThreads / std::max( 1u, m_NumberOfConcurrentlyLoadedBlocks ) );
+}
+
 void mitk::DICOMITKSeriesGDCMReader::InternalPrintConfiguration( std::ostream& os ) const
 {
   unsigned int sortIndex( 1 );
@@ -153,14 +235,17 @@ void mitk::DICOMITKSeriesGDCMReader::PushLocale() const
 {
   s_LocaleMutex.lock();
 
-  std::string currentCLocale = setlocale( LC_NUMERIC, nullptr );
-  m_ReplacedCLocales.push( currentCLocale );
-  setlocale( LC_NUMERIC, "C" );
-
-  std::locale currentCinLocale( std::cin.getloc() );
-  m_ReplacedCinLocales.push( currentCinLocale );
-  std::locale l( "C" );
-  std::cin.imbue( l );
+  if ( 0 == m_LocaleDepth++ )
+  {
+    std::string currentCLocale = setlocale( LC_NUMERIC, nullptr );
+    m_ReplacedCLocales.push( currentCLocale );
+    setlocale( LC_NUMERIC, "C" );
+
+    std::locale currentCinLocale( std::cin.getloc() );
+    m_ReplacedCinLocales.push( currentCinLocale );
+    std::locale l( "C" );
+    std::cin.imbue( l );
+  }
 
   s_LocaleMutex.unlock();
 }
@@ -169,6 +254,19 @@ void mitk::DICOMITKSeriesGDCMReader::PopLocale() const
 {
   s_LocaleMutex.lock();
 
+  if ( 0 == m_LocaleDepth )
+  {
+    MITK_WARN << "Mismatched PopLocale on DICOMITKSeriesGDCMReader.";
+    s_LocaleMutex.unlock();
+    return;
+  }
+
+  if ( 0 != --m_LocaleDepth )
+  {
+    s_LocaleMutex.unlock(); // still nested, keep "C" locale
+    return;
+  }
+
   if ( !m_ReplacedCLocales.empty() )
   {
     setlocale( LC_NUMERIC, m_ReplacedCLocales.top().c_str() );
@@ -237,6 +335,9 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     filescanner->SetInputFiles( inputFilenames );
     filescanner->AddTagPaths( this->GetTagsOfInterest() );
+    filescanner->SetNumberOfThreads( m_NumberOfScanThreads );
+    filescanner->SetUsePersistentCache( m_UsePersistentTagCache );
+    filescanner->SetPersistentCacheDirectory( m_PersistentTagCacheDirectory );
 
     PushLocale();
     filescanner->Scan();
@@ -422,13 +523,72 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadImages()
 {
   bool success = true;
 
-  unsigned int numberOfOutputs = this->GetNumberOfOutputs();
-  for ( unsigned int o = 0; o < numberOfOutputs; ++o )
+  const unsigned int numberOfOutputs = this->GetNumberOfOutputs();
+  const unsigned int numberOfThreads = 0 == m_NumberOfLoadThreads
+    ? std::max( 1u, std::thread::hardware_concurrency() )
+    : m_NumberOfLoadThreads;
+  const unsigned int numberOfWorkers = std::min( numberOfThreads, numberOfOutputs );
+
+  if ( numberOfWorkers < 2 )
   {
-    success &= this->LoadMitkImageForOutput( o );
+    for ( unsigned int o = 0; o < numberOfOutputs; ++o )
+    {
+      success &= this->LoadMitkImageForOutput( o );
+    }
+
+    return success;
   }
 
-  return success;
+  // Load the outputs concurrently. The locale is switched once for all workers,
+  // their own PushLocale()/PopLocale() calls are nested into this one.
+  PushLocale();
+  m_NumberOfConcurrentlyLoadedBlocks = numberOfWorkers;
+
+  std::atomic<unsigned int> nextOutput( 0 );
+  std::atomic<bool> allLoaded( true );
+  std::vector<std::exception_ptr> errors( numberOfOutputs );
+
+  auto loadOutputs = [&]()
+  {
+    for ( unsigned int o = nextOutput++; o < numberOfOutputs; o = nextOutput++ )
+    {
+      try
+      {
+        if ( !this->LoadMitkImageForOutput( o ) )
+          allLoaded = false;
+      }
+      catch ( ... )
+      {
+        errors[o] = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve( numberOfWorkers - 1 );
+  for ( unsigned int i = 1; i < numberOfWorkers; ++i )
+  {
+    workers.emplace_back( loadOutputs );
+  }
+
+  loadOutputs();
+
+  for ( auto& worker : workers )
+  {
+    worker.join();
+  }
+
+  m_NumberOfConcurrentlyLoadedBlocks = 1;
+  PopLocale();
+
+  // report errors like the serial loop would: the one of the first failing output
+  for ( const auto& error : errors )
+  {
+    if ( error )
+      std::rethrow_exception( error );
+  }
+
+  return allLoaded;
 }
 
 bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
@@ -447,6 +607,7 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
+  helper.SetNumberOfThreads( this->GetNumberOfThreadsPerBlock() );
   bool success( true );
   try
   {
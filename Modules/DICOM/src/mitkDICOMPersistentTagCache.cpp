@@ -0,0 +1,414 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  // Layout of the index file (all numbers in host byte order):
+  //   char[8]  magic "MITKDTIX"
+  //   uint32   byte order mark (0x01020304), uint32 format version
+  //   uint64   number of entries
+  //   per entry:
+  //     string path, uint64 size, int64 modification time
+  //     uint32 number of scanned tags, per tag: uint16 group, uint16 element
+  //     uint32 number of values, per value: uint16 group, uint16 element, string value
+  // with strings stored as uint32 length followed by the characters.
+  const char IndexMagic[8] = { 'M', 'I', 'T', 'K', 'D', 'T', 'I', 'X' };
+  const std::uint32_t IndexByteOrderMark = 0x01020304;
+  const std::uint32_t IndexVersion = 1;
+  const std::uint32_t MaxIndexStringLength = 1 << 24;
+
+  const std::string IndexFileExtension = ".mitkdicomtags";
+
+  template <typename T>
+  void WriteValue(std::ostream& stream, T value)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool ReadValue(std::istream& stream, T& value)
+  {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return stream.good();
+  }
+
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    WriteValue(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  bool ReadString(std::istream& stream, std::string& value)
+  {
+    std::uint32_t length = 0;
+    if (!ReadValue(stream, length) || length > MaxIndexStringLength)
+      return false;
+
+    value.resize(length);
+    stream.read(&value[0], length);
+    return stream.good();
+  }
+
+  void WriteTag(std::ostream& stream, const mitk::DICOMTag& tag)
+  {
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetGroup()));
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetElement()));
+  }
+
+  bool ReadTag(std::istream& stream, mitk::DICOMTag& tag)
+  {
+    std::uint16_t group = 0;
+    std::uint16_t element = 0;
+    if (!ReadValue(stream, group) || !ReadValue(stream, element))
+      return false;
+
+    tag = mitk::DICOMTag(group, element);
+    return true;
+  }
+
+  /** FNV-1a, used to derive a stable index file name from a directory path. */
+  std::uint64_t HashPath(const std::string& path)
+  {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const auto c : path)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+}
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache()
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+std::string
+mitk::DICOMPersistentTagCache::GetDefaultCacheDirectory()
+{
+  std::string baseDirectory;
+
+#if defined(_WIN32)
+  itksys::SystemTools::GetEnv("LOCALAPPDATA", baseDirectory);
+#elif defined(__APPLE__)
+  if (itksys::SystemTools::GetEnv("HOME", baseDirectory) && !baseDirectory.empty())
+    baseDirectory += "/Library/Caches";
+#else
+  if (!itksys::SystemTools::GetEnv("XDG_CACHE_HOME", baseDirectory) || baseDirectory.empty())
+  {
+    if (itksys::SystemTools::GetEnv("HOME", baseDirectory) && !baseDirectory.empty())
+      baseDirectory += "/.cache";
+  }
+#endif
+
+  if (baseDirectory.empty())
+    return "";
+
+  itksys::SystemTools::ConvertToUnixSlashes(baseDirectory);
+  return baseDirectory + "/MITK/DICOMTagCache";
+}
+
+std::string
+mitk::DICOMPersistentTagCache::GetIndexFilePath(const std::string& dataDirectory, const std::string& cacheDirectory)
+{
+  const std::string indexDirectory = cacheDirectory.empty() ? GetDefaultCacheDirectory() : cacheDirectory;
+  if (indexDirectory.empty())
+    return "";
+
+  // absolute, with forward slashes and without trailing separator
+  const std::string absoluteDataDirectory = itksys::SystemTools::CollapseFullPath(dataDirectory);
+
+  std::ostringstream fileName;
+  fileName << std::hex << std::setw(16) << std::setfill('0') << HashPath(absoluteDataDirectory)
+           << IndexFileExtension;
+
+  return indexDirectory + "/" + fileName.str();
+}
+
+bool
+mitk::DICOMPersistentTagCache::GetFileStatus(const std::string& filename, std::uint64_t& size, std::int64_t& modificationTime)
+{
+  itksys::SystemTools::Stat_t status;
+  if (0 != itksys::SystemTools::Stat(filename, &status))
+    return false;
+
+  // nanoseconds where the platform provides them, a file may be rewritten within a second
+  size = static_cast<std::uint64_t>(status.st_size);
+#if defined(_WIN32)
+  modificationTime = static_cast<std::int64_t>(status.st_mtime) * 1000000000;
+#elif defined(__APPLE__)
+  modificationTime = static_cast<std::int64_t>(status.st_mtimespec.tv_sec) * 1000000000 + status.st_mtimespec.tv_nsec;
+#else
+  modificationTime = static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+
+bool
+mitk::DICOMPersistentTagCache::Load(const std::string& indexFile)
+{
+  m_Entries.clear();
+  this->Reset();
+  this->Modified();
+
+  std::ifstream stream(indexFile, std::ios::binary);
+  if (!stream.is_open())
+    return false;
+
+  char magic[sizeof(IndexMagic)];
+  std::uint32_t byteOrderMark = 0;
+  std::uint32_t version = 0;
+  std::uint64_t numberOfEntries = 0;
+
+  stream.read(magic, sizeof(magic));
+  if (!stream.good() || !std::equal(magic, magic + sizeof(magic), IndexMagic)
+      || !ReadValue(stream, byteOrderMark) || IndexByteOrderMark != byteOrderMark
+      || !ReadValue(stream, version) || IndexVersion != version
+      || !ReadValue(stream, numberOfEntries))
+  {
+    MITK_WARN << "Ignoring invalid or outdated DICOM tag index file " << indexFile;
+    return false;
+  }
+
+  std::map<std::string, Entry> entries;
+
+  for (std::uint64_t i = 0; i < numberOfEntries; ++i)
+  {
+    std::string filename;
+    Entry entry;
+    std::uint32_t numberOfTags = 0;
+
+    if (!ReadString(stream, filename) || !ReadValue(stream, entry.size) || !ReadValue(stream, entry.modificationTime)
+        || !ReadValue(stream, numberOfTags))
+    {
+      MITK_WARN << "Ignoring corrupt DICOM tag index file " << indexFile;
+      return false;
+    }
+
+    for (std::uint32_t t = 0; t < numberOfTags; ++t)
+    {
+      DICOMTag tag(0, 0);
+      if (!ReadTag(stream, tag))
+      {
+        MITK_WARN << "Ignoring corrupt DICOM tag index file " << indexFile;
+        return false;
+      }
+      entry.scannedTags.insert(tag);
+    }
+
+    entry.frame = DICOMGenericImageFrameInfo::New(filename, 0);
+
+    std::uint32_t numberOfValues = 0;
+    if (!ReadValue(stream, numberOfValues))
+    {
+      MITK_WARN << "Ignoring corrupt DICOM tag index file " << indexFile;
+      return false;
+    }
+
+    for (std::uint32_t v = 0; v < numberOfValues; ++v)
+    {
+      DICOMTag tag(0, 0);
+      std::string value;
+      if (!ReadTag(stream, tag) || !ReadString(stream, value))
+      {
+        MITK_WARN << "Ignoring corrupt DICOM tag index file " << indexFile;
+        return false;
+      }
+      entry.frame->SetTagValue(DICOMTagPath(tag), value);
+    }
+
+    entries.emplace(filename, entry);
+  }
+
+  m_Entries.swap(entries);
+  return true;
+}
+
+void
+mitk::DICOMPersistentTagCache::Save(const std::string& indexFile) const
+{
+  // a uniquely named file next to the index, so that concurrent writers do not interfere and the
+  // rename below stays on the same file system
+  std::string indexDirectory = itksys::SystemTools::GetFilenamePath(indexFile);
+  if (indexDirectory.empty())
+    indexDirectory = ".";
+
+  std::ofstream stream;
+  const std::string temporaryFile = IOUtil::CreateTemporaryFile(stream, std::ios_base::binary,
+    itksys::SystemTools::GetFilenameName(indexFile) + ".XXXXXX", indexDirectory + "/");
+
+  if (!stream.is_open())
+  {
+    itksys::SystemTools::RemoveFile(temporaryFile);
+    mitkThrow() << "Cannot write DICOM tag index file " << temporaryFile;
+  }
+
+  std::vector<const std::pair<const std::string, Entry>*> existingEntries;
+  existingEntries.reserve(m_Entries.size());
+
+  for (const auto& entry : m_Entries)
+  {
+    if (itksys::SystemTools::FileExists(entry.first, true))
+      existingEntries.push_back(&entry);
+  }
+
+  stream.write(IndexMagic, sizeof(IndexMagic));
+  WriteValue(stream, IndexByteOrderMark);
+  WriteValue(stream, IndexVersion);
+  WriteValue(stream, static_cast<std::uint64_t>(existingEntries.size()));
+
+  for (const auto* entry : existingEntries)
+  {
+    WriteString(stream, entry->first);
+    WriteValue(stream, entry->second.size);
+    WriteValue(stream, entry->second.modificationTime);
+
+    WriteValue(stream, static_cast<std::uint32_t>(entry->second.scannedTags.size()));
+    for (const auto& tag : entry->second.scannedTags)
+      WriteTag(stream, tag);
+
+    std::vector<std::pair<DICOMTag, std::string>> values;
+    for (const auto& tag : entry->second.scannedTags)
+    {
+      const DICOMDatasetFinding finding = entry->second.frame->GetTagValueAsString(tag);
+      if (finding.isValid)
+        values.emplace_back(tag, finding.value);
+    }
+
+    WriteValue(stream, static_cast<std::uint32_t>(values.size()));
+    for (const auto& value : values)
+    {
+      WriteTag(stream, value.first);
+      WriteString(stream, value.second);
+    }
+  }
+
+  stream.close();
+  if (stream.fail())
+  {
+    itksys::SystemTools::RemoveFile(temporaryFile);
+    mitkThrow() << "Error while writing DICOM tag index file " << temporaryFile;
+  }
+
+  if (!itksys::SystemTools::RenameFile(temporaryFile, indexFile))
+  {
+    itksys::SystemTools::RemoveFile(temporaryFile);
+    mitkThrow() << "Cannot replace DICOM tag index file " << indexFile;
+  }
+}
+
+bool
+mitk::DICOMPersistentTagCache::IsUpToDate(const std::string& filename, const std::set<DICOMTag>& tags) const
+{
+  const auto finding = m_Entries.find(filename);
+  if (finding == m_Entries.cend())
+    return false;
+
+  const Entry& entry = finding->second;
+  std::uint64_t size = 0;
+  std::int64_t modificationTime = 0;
+
+  if (!GetFileStatus(filename, size, modificationTime) || size != entry.size || modificationTime != entry.modificationTime)
+    return false;
+
+  return std::includes(entry.scannedTags.cbegin(), entry.scannedTags.cend(), tags.cbegin(), tags.cend());
+}
+
+void
+mitk::DICOMPersistentTagCache::AddScanResult(const DICOMDatasetAccessingImageFrameInfo* frame, const std::set<DICOMTag>& scannedTags)
+{
+  if (nullptr == frame)
+    return;
+
+  Entry entry;
+  if (!GetFileStatus(frame->Filename, entry.size, entry.modificationTime))
+    return; // nothing sensible to remember for a file we cannot find
+
+  entry.frame = DICOMGenericImageFrameInfo::New(frame->Filename, frame->FrameNo);
+
+  // keep the values of tags that were scanned earlier, as long as the file did not change
+  const auto oldEntry = m_Entries.find(frame->Filename);
+  if (oldEntry != m_Entries.cend() && oldEntry->second.size == entry.size
+      && oldEntry->second.modificationTime == entry.modificationTime)
+  {
+    for (const auto& tag : oldEntry->second.scannedTags)
+    {
+      if (scannedTags.find(tag) != scannedTags.cend())
+        continue;
+
+      entry.scannedTags.insert(tag);
+      const DICOMDatasetFinding finding = oldEntry->second.frame->GetTagValueAsString(tag);
+      if (finding.isValid)
+        entry.frame->SetTagValue(DICOMTagPath(tag), finding.value);
+    }
+  }
+
+  for (const auto& tag : scannedTags)
+  {
+    entry.scannedTags.insert(tag);
+    const DICOMDatasetFinding finding = frame->GetTagValueAsString(tag);
+    if (finding.isValid)
+      entry.frame->SetTagValue(DICOMTagPath(tag), finding.value);
+  }
+
+  m_Entries[frame->Filename] = entry;
+  this->Modified();
+}
+
+void
+mitk::DICOMPersistentTagCache::Merge(const DICOMPersistentTagCache* other)
+{
+  if (nullptr == other)
+    return;
+
+  for (const auto& entry : other->m_Entries)
+    m_Entries[entry.first] = entry.second;
+
+  this->Modified();
+}
+
+void
+mitk::DICOMPersistentTagCache::SetInputFiles(const StringList& filenames)
+{
+  Superclass::SetInputFiles(filenames);
+
+  this->Reset();
+  for (const auto& filename : filenames)
+  {
+    const auto finding = m_Entries.find(filename);
+    if (finding != m_Entries.cend())
+      this->AddFrameInfo(finding->second.frame);
+  }
+}
+
+std::size_t
+mitk::DICOMPersistentTagCache::GetNumberOfEntries() const
+{
+  return m_Entries.size();
+}
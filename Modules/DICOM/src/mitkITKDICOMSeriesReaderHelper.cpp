@@ -48,6 +48,26 @@ bool mitk::ITKDICOMSeriesReaderHelper::CanHandleFile( const std::string& filenam
   return tester->CanReadFile( filename.c_str() );
 }
 
+void mitk::ITKDICOMSeriesReaderHelper::SetNumberOfThreads( unsigned int numberOfThreads )
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+std::size_t mitk::ITKDICOMSeriesReaderHelper::GetNumberOfTagScans() const
+{
+  return m_NumberOfTagScans;
+}
+
+std::size_t mitk::ITKDICOMSeriesReaderHelper::GetNumberOfScannedFiles() const
+{
+  return m_NumberOfScannedFiles;
+}
+
 mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load( const StringContainer& filenames,
                                                              bool correctTilt,
                                                              const GantryTiltInformation& tiltInfo )
@@ -124,11 +144,12 @@ mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load( const StringContain
 
 #define switch3DnTCase( IOType, T ) \
   case IOType:                      \
-    return LoadDICOMByITK3DnT<T>( filenamesLists, correctTilt, tiltInfo, io );
+    return LoadDICOMByITK3DnT<T>( filenamesLists, correctTilt, tiltInfo, tagCache, io );
 
 mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load3DnT( const StringContainerList& filenamesLists,
                                                                  bool correctTilt,
-                                                                 const GantryTiltInformation& tiltInfo )
+                                                                 const GantryTiltInformation& tiltInfo,
+                                                                 const DICOMTagCache* tagCache )
 {
   if ( filenamesLists.empty() || filenamesLists.front().empty() )
   {
@@ -280,16 +301,45 @@ double ComputeMiliSecDuration( const OFDateTime& start, const OFDateTime& stop )
 }
 
 bool mitk::ITKDICOMSeriesReaderHelper::ExtractDateTimeBoundsAndTriggerOfTimeStep(
-  const StringContainer& filenamesOfTimeStep, DateTimeBounds& bounds, TimeBounds& triggerBounds)
+  const StringContainer& filenamesOfTimeStep, DateTimeBounds& bounds, TimeBounds& triggerBounds,
+  const FrameInfoLookup& cachedFrames)
 {
-  DICOMGDCMTagScanner::Pointer filescanner = DICOMGDCMTagScanner::New();
-  filescanner->SetInputFiles(filenamesOfTimeStep);
-  filescanner->AddTag(AcquisitionDateTag);
-  filescanner->AddTag(AcquisitionTimeTag);
-  filescanner->AddTag(TriggerTimeTag);
-  filescanner->Scan();
+  DICOMDatasetAccessingImageFrameList frameList;
+  StringContainer filesToScan;
+
+  for (const auto& filename : filenamesOfTimeStep)
+  {
+    const auto finding = cachedFrames.find(filename);
 
-  const DICOMDatasetAccessingImageFrameList frameList = filescanner->GetFrameInfoList();
+    // caches of readers that did not scan the time tags are of no use, the file is read then
+    if (finding != cachedFrames.cend()
+        && (finding->second->GetTagValueAsString(AcquisitionDateTag).isValid
+            || finding->second->GetTagValueAsString(AcquisitionTimeTag).isValid
+            || finding->second->GetTagValueAsString(TriggerTimeTag).isValid))
+    {
+      frameList.push_back(finding->second);
+    }
+    else
+    {
+      filesToScan.push_back(filename);
+    }
+  }
+
+  if (!filesToScan.empty())
+  {
+    DICOMGDCMTagScanner::Pointer filescanner = DICOMGDCMTagScanner::New();
+    filescanner->SetInputFiles(filesToScan);
+    filescanner->AddTag(AcquisitionDateTag);
+    filescanner->AddTag(AcquisitionTimeTag);
+    filescanner->AddTag(TriggerTimeTag);
+    filescanner->Scan();
+
+    ++m_NumberOfTagScans;
+    m_NumberOfScannedFiles += filescanner->GetNumberOfScannedFiles();
+
+    const DICOMDatasetAccessingImageFrameList scannedFrames = filescanner->GetFrameInfoList();
+    frameList.insert(frameList.end(), scannedFrames.cbegin(), scannedFrames.cend());
+  }
 
   bool result = false;
   bool firstAq = true;
@@ -346,12 +396,13 @@ bool mitk::ITKDICOMSeriesReaderHelper::ExtractDateTimeBoundsAndTriggerOfTimeStep
 };
 
 bool mitk::ITKDICOMSeriesReaderHelper::ExtractTimeBoundsOfTimeStep(
-  const StringContainer& filenamesOfTimeStep, TimeBounds& bounds, const OFDateTime& baselineDateTime )
+  const StringContainer& filenamesOfTimeStep, TimeBounds& bounds, const OFDateTime& baselineDateTime,
+  const FrameInfoLookup& cachedFrames )
 {
   DateTimeBounds aqDTBounds;
   TimeBounds triggerBounds;
 
-  bool result = ExtractDateTimeBoundsAndTriggerOfTimeStep(filenamesOfTimeStep, aqDTBounds, triggerBounds);
+  bool result = ExtractDateTimeBoundsAndTriggerOfTimeStep(filenamesOfTimeStep, aqDTBounds, triggerBounds, cachedFrames);
 
   mitk::ScalarType lowerBound = ComputeMiliSecDuration( baselineDateTime, aqDTBounds[0] );
   mitk::ScalarType upperBound = ComputeMiliSecDuration( baselineDateTime, aqDTBounds[1] );
@@ -369,17 +420,32 @@ bool mitk::ITKDICOMSeriesReaderHelper::ExtractTimeBoundsOfTimeStep(
 
 mitk::ITKDICOMSeriesReaderHelper::TimeBoundsList
   mitk::ITKDICOMSeriesReaderHelper::ExtractTimeBoundsOfTimeSteps(
-    const StringContainerList& filenamesOfTimeSteps )
+    const StringContainerList& filenamesOfTimeSteps, const DICOMTagCache* tagCache )
 {
   TimeBoundsList result;
 
+  m_NumberOfTagScans = 0;
+  m_NumberOfScannedFiles = 0;
+
+  // index the already scanned frames once, so that each time step does a
+  // lookup per file instead of reading the file headers again
+  FrameInfoLookup cachedFrames;
+  if ( nullptr != tagCache )
+  {
+    const DICOMDatasetAccessingImageFrameList frameList = tagCache->GetFrameInfoList();
+    for ( const auto& frame : frameList )
+    {
+      cachedFrames.emplace( frame->Filename, frame );
+    }
+  }
+
   OFDateTime baseLine;
 
   // extract the timebounds
   DateTimeBounds baselineDateTimeBounds;
   TimeBounds triggerBounds;
   auto pos = filenamesOfTimeSteps.cbegin();
-  ExtractDateTimeBoundsAndTriggerOfTimeStep(*pos, baselineDateTimeBounds, triggerBounds);
+  ExtractDateTimeBoundsAndTriggerOfTimeStep(*pos, baselineDateTimeBounds, triggerBounds, cachedFrames);
   baseLine = baselineDateTimeBounds[0];
 
   // timebounds for baseline is 0
@@ -396,7 +462,7 @@ mitk::ITKDICOMSeriesReaderHelper::TimeBoundsList
     TimeBounds dateTimeBounds;
 
     // extract the timebounds relative to the baseline
-    if ( ExtractTimeBoundsOfTimeStep( *pos, dateTimeBounds, baseLine ) )
+    if ( ExtractTimeBoundsOfTimeStep( *pos, dateTimeBounds, baseLine, cachedFrames ) )
     {
 
       bounds[0] = dateTimeBounds[0];
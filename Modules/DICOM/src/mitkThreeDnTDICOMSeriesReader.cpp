@@ -74,6 +74,19 @@ mitk::ThreeDnTDICOMSeriesReader
   return m_Group3DandT;
 }
 
+mitk::DICOMTagPathList
+mitk::ThreeDnTDICOMSeriesReader
+::GetTagsOfInterest() const
+{
+  DICOMTagPathList completeList = Superclass::GetTagsOfInterest();
+
+  completeList.push_back( ITKDICOMSeriesReaderHelper::AcquisitionDateTag );
+  completeList.push_back( ITKDICOMSeriesReaderHelper::AcquisitionTimeTag );
+  completeList.push_back( ITKDICOMSeriesReaderHelper::TriggerTimeTag );
+
+  return completeList;
+}
+
 mitk::DICOMITKSeriesGDCMReader::SortingBlockList
 mitk::ThreeDnTDICOMSeriesReader
 ::Condense3DBlocks(SortingBlockList& resultOf3DGrouping)
@@ -199,35 +212,15 @@ bool
 mitk::ThreeDnTDICOMSeriesReader
 ::LoadImages()
 {
-  bool success = true;
-
-  unsigned int numberOfOutputs = this->GetNumberOfOutputs();
-  for (unsigned int o = 0; o < numberOfOutputs; ++o)
-  {
-    const DICOMImageBlockDescriptor& block = this->InternalGetOutput(o);
-
-    if (block.GetFlag("3D+t", false))
-    {
-      success &= this->LoadMitkImageForOutput(o);
-    }
-    else
-    {
-      success &= DICOMITKSeriesGDCMReader::LoadMitkImageForOutput(o); // let superclass handle non-3D+t
-    }
-  }
-
-  return success;
+  // LoadMitkImageForImageBlockDescriptor() distinguishes 3D+t blocks from others,
+  // so the superclass can load (and parallelize) all outputs
+  return Superclass::LoadImages();
 }
 
 bool
 mitk::ThreeDnTDICOMSeriesReader
 ::LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const
 {
-  PushLocale();
-  const DICOMImageFrameList& frames = block.GetImageFrameList();
-  const GantryTiltInformation tiltInfo = block.GetTiltInformation();
-  const bool hasTilt = tiltInfo.IsRegularGantryTilt();
-
   const int numberOfTimesteps = block.GetNumberOfTimeSteps();
 
   if (numberOfTimesteps == 1)
@@ -235,6 +228,11 @@ mitk::ThreeDnTDICOMSeriesReader
     return DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(block);
   }
 
+  PushLocale();
+  const DICOMImageFrameList& frames = block.GetImageFrameList();
+  const GantryTiltInformation tiltInfo = block.GetTiltInformation();
+  const bool hasTilt = tiltInfo.IsRegularGantryTilt();
+
   const int numberOfFramesPerTimestep = block.GetNumberOfFramesPerTimeStep();
 
   ITKDICOMSeriesReaderHelper::StringContainerList filenamesPerTimestep;
@@ -254,9 +252,18 @@ mitk::ThreeDnTDICOMSeriesReader
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
-  mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
+  helper.SetNumberOfThreads( this->GetNumberOfThreadsPerBlock() );
+  try
+  {
+    mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo, this->GetTagCache() );
 
-  block.SetMitkImage( mitkImage );
+    block.SetMitkImage( mitkImage );
+  }
+  catch (...)
+  {
+    PopLocale(); // keep the locale stack balanced
+    throw;
+  }
 
   PopLocale();
 
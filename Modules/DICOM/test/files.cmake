@@ -1,9 +1,12 @@
 set(MODULE_TESTS
   mitkDICOMReaderConfiguratorTest.cpp
   mitkDICOMDCMTKTagScannerTest.cpp
+  mitkDICOMGDCMTagScannerTest.cpp
   mitkDICOMSimpleVolumeImportTest.cpp
   mitkDICOMTagPathTest.cpp
   mitkDICOMPropertyTest.cpp
+  mitkDICOMPersistentTagCacheTest.cpp
+  mitkITKDICOMSeriesReaderHelperTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
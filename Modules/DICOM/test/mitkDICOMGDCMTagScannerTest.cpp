@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMImageBlockDescriptor.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkDICOMGDCMTagScannerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMGDCMTagScannerTestSuite);
+
+  MITK_TEST(SerialScanning);
+  MITK_TEST(ParallelScanningEqualsSerialScanning);
+  MITK_TEST(MoreThreadsThanFiles);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  mitk::DICOMTagList tags;
+
+  mitk::DICOMDatasetAccessingImageFrameList Scan(unsigned int numberOfThreads)
+  {
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTags(tags);
+    scanner->SetNumberOfThreads(numberOfThreads);
+    scanner->Scan();
+
+    return scanner->GetFrameInfoList();
+  }
+
+  void AssertEqualScanResults(const mitk::DICOMDatasetAccessingImageFrameList& expected,
+                              const mitk::DICOMDatasetAccessingImageFrameList& actual)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Frame order is preserved", expected[i]->Filename, actual[i]->Filename);
+      CPPUNIT_ASSERT_EQUAL(expected[i]->FrameNo, actual[i]->FrameNo);
+
+      for (const auto& tag : tags)
+      {
+        const mitk::DICOMDatasetFinding expectedFinding = expected[i]->GetTagValueAsString(tag);
+        const mitk::DICOMDatasetFinding actualFinding = actual[i]->GetTagValueAsString(tag);
+
+        CPPUNIT_ASSERT_EQUAL(expectedFinding.isValid, actualFinding.isValid);
+        CPPUNIT_ASSERT_EQUAL(expectedFinding.value, actualFinding.value);
+      }
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+    ctFiles.push_back(GetTestDataFilePath("Pic3D.nrrd")); // no DICOM, has to be handled like in a serial scan
+
+    tags = mitk::DICOMImageBlockDescriptor::GetTagsOfInterest();
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void SerialScanning()
+  {
+    const mitk::DICOMDatasetAccessingImageFrameList frames = this->Scan(1);
+    CPPUNIT_ASSERT_EQUAL(ctFiles.size(), frames.size());
+
+    const mitk::DICOMTag instanceUID(0x0008, 0x0018);
+    const mitk::DICOMDatasetFinding finding = frames[0]->GetTagValueAsString(instanceUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding of frame 0", finding.isValid);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940051"), finding.value);
+  }
+
+  void ParallelScanningEqualsSerialScanning()
+  {
+    const mitk::DICOMDatasetAccessingImageFrameList serialFrames = this->Scan(1);
+
+    AssertEqualScanResults(serialFrames, this->Scan(2));
+    AssertEqualScanResults(serialFrames, this->Scan(3));
+    AssertEqualScanResults(serialFrames, this->Scan(0));
+  }
+
+  void MoreThreadsThanFiles()
+  {
+    AssertEqualScanResults(this->Scan(1), this->Scan(static_cast<unsigned int>(ctFiles.size()) + 4));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMGDCMTagScanner)
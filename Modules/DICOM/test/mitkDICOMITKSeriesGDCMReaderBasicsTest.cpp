@@ -117,5 +117,31 @@ int mitkDICOMITKSeriesGDCMReaderBasicsTest(int argc, char* argv[])
   mitk::DICOMFileReaderTestHelper::TestMitkImagesAreLoaded( gdcmReader, additionalTags, expectedPropertyTypes );
 
 
+  //////////////////////////////////////////////////////////////////////////
+  //
+  // Concurrent loading has to produce the same images as serial loading
+  //
+  //////////////////////////////////////////////////////////////////////////
+
+  std::vector<mitk::Image::Pointer> seriallyLoadedImages;
+  for ( unsigned int o = 0; o < gdcmReader->GetNumberOfOutputs(); ++o )
+  {
+    seriallyLoadedImages.push_back( gdcmReader->GetOutput( o ).GetMitkImage() );
+  }
+
+  for ( unsigned int numberOfThreads : { 2u, 3u, 0u } )
+  {
+    gdcmReader->SetNumberOfLoadThreads( numberOfThreads );
+    MITK_TEST_CONDITION_REQUIRED( gdcmReader->LoadImages(), "Images can be loaded with " << numberOfThreads << " threads" );
+
+    for ( unsigned int o = 0; o < gdcmReader->GetNumberOfOutputs(); ++o )
+    {
+      mitk::Image::Pointer concurrentlyLoadedImage = gdcmReader->GetOutput( o ).GetMitkImage();
+      MITK_TEST_CONDITION_REQUIRED( concurrentlyLoadedImage.IsNotNull(), "Output " << o << " is loaded concurrently" );
+      MITK_TEST_CONDITION( mitk::Equal( *seriallyLoadedImages[o], *concurrentlyLoadedImage, mitk::eps, true ),
+                           "Output " << o << " loaded with " << numberOfThreads << " threads equals serially loaded image" );
+    }
+  }
+
   MITK_TEST_END();
 }
@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMImageBlockDescriptor.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+class mitkDICOMPersistentTagCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheTestSuite);
+
+  MITK_TEST(SecondScanReadsNoFiles);
+  MITK_TEST(NoIndexIsStoredNextToData);
+  MITK_TEST(DirectoriesAreIndexedSeparately);
+  MITK_TEST(ChangedFilesAreRescanned);
+  MITK_TEST(AdditionalTagsAreRescanned);
+  MITK_TEST(CorruptIndexIsIgnored);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::string m_DataDirectory;
+  std::string m_CacheDirectory;
+  mitk::StringList m_Files;
+  mitk::DICOMTagList m_Tags;
+
+  mitk::DICOMGDCMTagScanner::Pointer CreateScanner(bool usePersistentCache, const std::string& cacheDirectory) const
+  {
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(m_Files);
+    scanner->AddTags(m_Tags);
+    scanner->SetUsePersistentCache(usePersistentCache);
+    scanner->SetPersistentCacheDirectory(cacheDirectory);
+    return scanner;
+  }
+
+  /** Scans with the persistent cache and returns how many files had to be read. */
+  std::size_t ScanWithIndex(const std::string& cacheDirectory, mitk::DICOMDatasetAccessingImageFrameList* frames = nullptr)
+  {
+    auto scanner = this->CreateScanner(true, cacheDirectory);
+
+    scanner->Scan();
+
+    if (nullptr != frames)
+      *frames = scanner->GetFrameInfoList();
+
+    return scanner->GetNumberOfScannedFiles();
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_DataDirectory = mitk::IOUtil::CreateTemporaryDirectory("DICOMTagIndexData-XXXXXX");
+    m_CacheDirectory = mitk::IOUtil::CreateTemporaryDirectory("DICOMTagIndexCache-XXXXXX");
+
+    m_Files.clear();
+    for (const std::string name : { "100", "101", "102", "104" })
+    {
+      const std::string target = (std::filesystem::path(m_DataDirectory) / name).string();
+      std::filesystem::copy_file(GetTestDataFilePath("TinyCTAbdomen/" + name), target);
+      m_Files.push_back(target);
+    }
+
+    m_Tags = mitk::DICOMImageBlockDescriptor::GetTagsOfInterest();
+  }
+
+  void tearDown() override
+  {
+    std::error_code error;
+    std::filesystem::remove_all(m_DataDirectory, error);
+    std::filesystem::remove_all(m_CacheDirectory, error);
+  }
+
+  void SecondScanReadsNoFiles()
+  {
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), this->ScanWithIndex(m_CacheDirectory));
+
+    mitk::DICOMDatasetAccessingImageFrameList indexedFrames;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->ScanWithIndex(m_CacheDirectory, &indexedFrames));
+
+    auto scanner = this->CreateScanner(false, "");
+    scanner->Scan();
+    const mitk::DICOMDatasetAccessingImageFrameList scannedFrames = scanner->GetFrameInfoList();
+
+    CPPUNIT_ASSERT_EQUAL(scannedFrames.size(), indexedFrames.size());
+    for (std::size_t i = 0; i < scannedFrames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(scannedFrames[i]->Filename, indexedFrames[i]->Filename);
+      for (const auto& tag : m_Tags)
+      {
+        const auto scannedFinding = scannedFrames[i]->GetTagValueAsString(tag);
+        const auto indexedFinding = indexedFrames[i]->GetTagValueAsString(tag);
+        CPPUNIT_ASSERT_EQUAL(scannedFinding.isValid, indexedFinding.isValid);
+        CPPUNIT_ASSERT_EQUAL(scannedFinding.value, indexedFinding.value);
+      }
+    }
+  }
+
+  void NoIndexIsStoredNextToData()
+  {
+    this->ScanWithIndex(m_CacheDirectory);
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), static_cast<std::size_t>(std::distance(
+      std::filesystem::directory_iterator(m_DataDirectory), std::filesystem::directory_iterator())));
+
+    const std::string defaultDirectory = mitk::DICOMPersistentTagCache::GetDefaultCacheDirectory();
+    if (!defaultDirectory.empty())
+    {
+      CPPUNIT_ASSERT_EQUAL(std::filesystem::path(defaultDirectory).string(),
+        std::filesystem::path(mitk::DICOMPersistentTagCache::GetIndexFilePath(m_DataDirectory)).parent_path().string());
+    }
+  }
+
+  void DirectoriesAreIndexedSeparately()
+  {
+    const std::string subDirectory = (std::filesystem::path(m_DataDirectory) / "sub").string();
+    std::filesystem::create_directory(subDirectory);
+    for (std::size_t i = 2; i < m_Files.size(); ++i)
+    {
+      const std::string target = (std::filesystem::path(subDirectory) / std::filesystem::path(m_Files[i]).filename()).string();
+      std::filesystem::rename(m_Files[i], target);
+      m_Files[i] = target;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), this->ScanWithIndex(m_CacheDirectory));
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    CPPUNIT_ASSERT(cache->Load(mitk::DICOMPersistentTagCache::GetIndexFilePath(m_DataDirectory, m_CacheDirectory)));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache->GetNumberOfEntries());
+    CPPUNIT_ASSERT(cache->Load(mitk::DICOMPersistentTagCache::GetIndexFilePath(subDirectory, m_CacheDirectory)));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache->GetNumberOfEntries());
+
+    mitk::DICOMDatasetAccessingImageFrameList frames;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->ScanWithIndex(m_CacheDirectory, &frames));
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), frames.size());
+    for (std::size_t i = 0; i < m_Files.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL(m_Files[i], frames[i]->Filename);
+
+    const auto changedFile = m_Files[3];
+    std::filesystem::last_write_time(changedFile, std::filesystem::last_write_time(changedFile) + std::chrono::hours(1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), this->ScanWithIndex(m_CacheDirectory));
+  }
+
+  void ChangedFilesAreRescanned()
+  {
+    this->ScanWithIndex(m_CacheDirectory);
+
+    const auto changedFile = m_Files[1];
+    std::filesystem::last_write_time(changedFile, std::filesystem::last_write_time(changedFile) + std::chrono::hours(1));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), this->ScanWithIndex(m_CacheDirectory));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->ScanWithIndex(m_CacheDirectory));
+  }
+
+  void AdditionalTagsAreRescanned()
+  {
+    this->ScanWithIndex(m_CacheDirectory);
+
+    m_Tags.push_back(mitk::DICOMTag(0x0010, 0x0010)); // patient name
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), this->ScanWithIndex(m_CacheDirectory));
+
+    // fewer tags than indexed are served from the index
+    m_Tags.pop_back();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->ScanWithIndex(m_CacheDirectory));
+  }
+
+  void CorruptIndexIsIgnored()
+  {
+    this->ScanWithIndex(m_CacheDirectory);
+
+    const std::string indexFile = mitk::DICOMPersistentTagCache::GetIndexFilePath(m_DataDirectory, m_CacheDirectory);
+    CPPUNIT_ASSERT(std::filesystem::exists(indexFile));
+
+    {
+      std::ofstream stream(indexFile, std::ios::binary | std::ios::trunc);
+      stream << "no index";
+    }
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    CPPUNIT_ASSERT(!cache->Load(indexFile));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache->GetNumberOfEntries());
+
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), this->ScanWithIndex(m_CacheDirectory));
+    CPPUNIT_ASSERT(cache->Load(indexFile));
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), cache->GetNumberOfEntries());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCache)
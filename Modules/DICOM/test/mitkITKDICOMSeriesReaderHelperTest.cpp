@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkITKDICOMSeriesReaderHelper.h"
+#include "mitkDICOMGenericImageFrameInfo.h"
+#include "mitkThreeDnTDICOMSeriesReader.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+namespace
+{
+  /** Tag cache that holds made up acquisition times, so that time bounds that are
+      computed from these times can only stem from the cache, not from the files. */
+  class FixedAcquisitionTimeTagCache : public mitk::DICOMTagCache
+  {
+  public:
+    mitkClassMacro(FixedAcquisitionTimeTagCache, mitk::DICOMTagCache);
+    itkFactorylessNewMacro(Self);
+
+    void AddFrame(const std::string& filename, const std::string& acquisitionTime)
+    {
+      auto frame = mitk::DICOMGenericImageFrameInfo::New(filename);
+      frame->SetTagValue(mitk::ITKDICOMSeriesReaderHelper::AcquisitionDateTag, "20200101");
+      frame->SetTagValue(mitk::ITKDICOMSeriesReaderHelper::AcquisitionTimeTag, acquisitionTime);
+      m_Frames.push_back(frame.GetPointer());
+    }
+
+    /** Adds a frame that holds none of the time tags, like frames of readers that do not scan them. */
+    void AddFrameWithoutTimes(const std::string& filename)
+    {
+      auto frame = mitk::DICOMGenericImageFrameInfo::New(filename);
+      m_Frames.push_back(frame.GetPointer());
+    }
+
+    mitk::DICOMDatasetFinding GetTagValue(mitk::DICOMImageFrameInfo* frame, const mitk::DICOMTag& tag) const override
+    {
+      for (const auto& cachedFrame : m_Frames)
+      {
+        if (cachedFrame->Filename == frame->Filename)
+          return cachedFrame->GetTagValueAsString(tag);
+      }
+      return mitk::DICOMDatasetFinding();
+    }
+
+    FindingsListType GetTagValue(mitk::DICOMImageFrameInfo* frame, const mitk::DICOMTagPath& path) const override
+    {
+      FindingsListType result;
+      if (path.Size() == 1 && path.IsExplicit())
+      {
+        result.push_back(this->GetTagValue(frame, path.GetFirstNode().tag));
+      }
+      return result;
+    }
+
+    mitk::DICOMDatasetAccessingImageFrameList GetFrameInfoList() const override
+    {
+      return m_Frames;
+    }
+
+  protected:
+    FixedAcquisitionTimeTagCache() = default;
+
+  private:
+    mitk::DICOMDatasetAccessingImageFrameList m_Frames;
+  };
+}
+
+class mitkITKDICOMSeriesReaderHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkITKDICOMSeriesReaderHelperTestSuite);
+
+  MITK_TEST(Load3DnTWithTagCacheDoesNotRescanFiles);
+  MITK_TEST(Load3DnTWithTagCacheTakesTimesFromCache);
+  MITK_TEST(Load3DnTWithIncompleteTagCacheScansMissingFiles);
+  MITK_TEST(Load3DnTWithoutTagCacheScansFiles);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  mitk::ITKDICOMSeriesReaderHelper::StringContainerList filesPerTimeStep;
+
+  mitk::ThreeDnTDICOMSeriesReader::Pointer reader;
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    // pretend that the slices form two time steps of two slices each
+    filesPerTimeStep.clear();
+    filesPerTimeStep.push_back(mitk::ITKDICOMSeriesReaderHelper::StringContainer(ctFiles.begin(), ctFiles.begin() + 2));
+    filesPerTimeStep.push_back(mitk::ITKDICOMSeriesReaderHelper::StringContainer(ctFiles.begin() + 2, ctFiles.end()));
+
+    reader = mitk::ThreeDnTDICOMSeriesReader::New();
+    reader->SetInputFiles(ctFiles);
+    reader->AnalyzeInputFiles();
+  }
+
+  void tearDown() override
+  {
+    reader = nullptr;
+  }
+
+  void Load3DnTWithTagCacheDoesNotRescanFiles()
+  {
+    CPPUNIT_ASSERT_MESSAGE("Reader provides a tag cache after AnalyzeInputFiles()", reader->GetTagCache() != nullptr);
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+    mitk::Image::Pointer image =
+      helper.Load3DnT(filesPerTimeStep, false, mitk::GantryTiltInformation(), reader->GetTagCache());
+
+    CPPUNIT_ASSERT_MESSAGE("Image could be loaded", image.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(2u, image->GetTimeSteps());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No tag scanner is run for the time bounds",
+                                 std::size_t(0), helper.GetNumberOfTagScans());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No file header is read again for the time bounds",
+                                 std::size_t(0), helper.GetNumberOfScannedFiles());
+  }
+
+  void Load3DnTWithTagCacheTakesTimesFromCache()
+  {
+    CPPUNIT_ASSERT_MESSAGE("Reader provides a tag cache after AnalyzeInputFiles()", reader->GetTagCache() != nullptr);
+
+    // the second time step starts 10 s after the first and lasts 2 s
+    auto tagCache = FixedAcquisitionTimeTagCache::New();
+    tagCache->AddFrame(ctFiles[0], "120000");
+    tagCache->AddFrame(ctFiles[1], "120001");
+    tagCache->AddFrame(ctFiles[2], "120010");
+    tagCache->AddFrame(ctFiles[3], "120012");
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+    mitk::Image::Pointer image = helper.Load3DnT(filesPerTimeStep, false, mitk::GantryTiltInformation(), tagCache);
+
+    CPPUNIT_ASSERT_MESSAGE("Image could be loaded", image.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(2u, image->GetTimeSteps());
+
+    const mitk::TimeGeometry* timeGeometry = image->GetTimeGeometry();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time bounds are taken from the cache", 0.0, timeGeometry->GetMinimumTimePoint(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time bounds are taken from the cache", 10000.0, timeGeometry->GetMinimumTimePoint(1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time bounds are taken from the cache", 12000.0, timeGeometry->GetMaximumTimePoint(1));
+  }
+
+  void Load3DnTWithIncompleteTagCacheScansMissingFiles()
+  {
+    auto tagCache = FixedAcquisitionTimeTagCache::New();
+    tagCache->AddFrame(ctFiles[0], "120000");
+    tagCache->AddFrame(ctFiles[1], "120001");
+    tagCache->AddFrameWithoutTimes(ctFiles[2]);
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+    mitk::Image::Pointer image = helper.Load3DnT(filesPerTimeStep, false, mitk::GantryTiltInformation(), tagCache);
+
+    CPPUNIT_ASSERT_MESSAGE("Image could be loaded", image.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Only the time step with uncached times is scanned",
+                                 std::size_t(1), helper.GetNumberOfTagScans());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The file without cached times and the uncached file are read",
+                                 std::size_t(2), helper.GetNumberOfScannedFiles());
+  }
+
+  void Load3DnTWithoutTagCacheScansFiles()
+  {
+    mitk::ITKDICOMSeriesReaderHelper helper;
+
+    mitk::Image::Pointer scannedImage = helper.Load3DnT(filesPerTimeStep, false, mitk::GantryTiltInformation());
+
+    CPPUNIT_ASSERT_MESSAGE("Image could be loaded", scannedImage.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Every time step is scanned once",
+                                 filesPerTimeStep.size(), helper.GetNumberOfTagScans());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Every file header is read once for the time bounds",
+                                 ctFiles.size(), helper.GetNumberOfScannedFiles());
+
+    mitk::Image::Pointer cachedImage =
+      helper.Load3DnT(filesPerTimeStep, false, mitk::GantryTiltInformation(), reader->GetTagCache());
+
+    CPPUNIT_ASSERT_MESSAGE("Image could be loaded", cachedImage.IsNotNull());
+
+    const mitk::TimeGeometry* scannedGeometry = scannedImage->GetTimeGeometry();
+    const mitk::TimeGeometry* cachedGeometry = cachedImage->GetTimeGeometry();
+
+    CPPUNIT_ASSERT_EQUAL(scannedGeometry->CountTimeSteps(), cachedGeometry->CountTimeSteps());
+    for (mitk::TimeStepType t = 0; t < scannedGeometry->CountTimeSteps(); ++t)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Cached and scanned time bounds are equal",
+                                   scannedGeometry->GetMinimumTimePoint(t),
+                                   cachedGeometry->GetMinimumTimePoint(t));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Cached and scanned time bounds are equal",
+                                   scannedGeometry->GetMaximumTimePoint(t),
+                                   cachedGeometry->GetMaximumTimePoint(t));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkITKDICOMSeriesReaderHelper)
@@ -81,6 +81,10 @@ namespace mitk
     Image::Pointer GetDiffImage();
 
     bool IsImageStillValid() { return m_ImageStillValid; }
+
+    std::size_t GetMemorySize() const override;
+    bool SwapOut(std::ostream &stream) override;
+    void SwapIn(std::istream &stream) override;
   };
 
 } // namespace mitk
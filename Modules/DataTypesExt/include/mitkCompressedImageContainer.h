@@ -16,14 +16,29 @@ found in the LICENSE file.
 #include <MitkDataTypesExtExports.h>
 #include <mitkImage.h>
 #include <array>
+#include <iosfwd>
 #include <memory>
 #include <utility>
 
 namespace mitk
 {
+  /** \brief Holds an image as LZ4 compressed slices.
+   *
+   * Slices are compressed and decompressed independently and in parallel. The compression method
+   * and the row delta pre-pass only affect CompressImage(), the settings used for the currently
+   * held image are remembered for DecompressImage().
+   */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer
   {
   public:
+    enum class CompressionMethod
+    {
+      /** Fast LZ4 compression (default). */
+      LZ4,
+      /** LZ4 high compression. Compresses several times slower but better, decompression speed is unchanged. */
+      LZ4HC
+    };
+
     CompressedImageContainer();
     ~CompressedImageContainer();
 
@@ -31,8 +46,42 @@ namespace mitk
     CompressedImageContainer& operator=(const CompressedImageContainer&) = delete;
 
     void CompressImage(const Image* image);
+
+    void SetCompressionMethod(CompressionMethod method);
+    CompressionMethod GetCompressionMethod() const;
+
+    /** If enabled, every row of a slice is stored as byte-wise difference to the previous row before
+     *  it is compressed. Rows of label images mostly equal their predecessors and become runs of zeros,
+     *  which LZ4 compresses considerably better. Not useful for noisy grey value images. Default: off.
+     */
+    void SetUseRowDelta(bool useRowDelta);
+    bool GetUseRowDelta() const;
+
+    /** Selects LZ4 for all images and enables the row delta pre-pass only for images with a single
+     *  integer component, like label images and differences of them.
+     */
+    void AdaptSettingsToImage(const Image* image);
+
+    /** \throw mitk::Exception if the compressed data is swapped out. */
     Image::Pointer DecompressImage() const;
 
+    /** Returns the number of bytes held in memory by the compressed image. */
+    std::size_t GetMemorySize() const;
+
+    /** Writes the compressed slices to the stream and releases them from memory. The image
+     *  information needed for decompression is kept.
+     *  Returns false and keeps the slices in memory if there is nothing to swap out (empty or
+     *  already swapped out) or if writing failed.
+     */
+    bool SwapOut(std::ostream& stream);
+
+    /** Reads the compressed slices written by SwapOut().
+     *  \throw mitk::Exception if the stream does not provide the data. The container stays swapped out then.
+     */
+    void SwapIn(std::istream& stream);
+
+    bool IsSwappedOut() const;
+
   private:
     using CompressedSliceData = std::pair<int, char*>;
     using CompressedTimeStepData = std::vector<CompressedSliceData>;
@@ -46,6 +95,11 @@ namespace mitk
     TimeGeometry::Pointer m_TimeGeometry;
     std::array<unsigned int, 2> m_SliceDimensions;
     unsigned int m_Dimension;
+    bool m_IsSwappedOut;
+    bool m_IsRowDeltaEncoded;
+
+    CompressionMethod m_CompressionMethod;
+    bool m_UseRowDelta;
   };
 }
 
@@ -40,6 +40,7 @@ mitk::ApplyDiffImageOperation::ApplyDiffImageOperation(OperationType operationTy
     m_DeleteTag = image->AddObserver(itk::DeleteEvent(), command);
 
     // keep a compressed version of the image
+    m_CompressedImageContainer.AdaptSettingsToImage(diffImage);
     m_CompressedImageContainer.CompressImage(diffImage);
   }
 }
@@ -62,3 +63,18 @@ mitk::Image::Pointer mitk::ApplyDiffImageOperation::GetDiffImage()
   // uncompress image to create a valid mitk::Image
   return m_CompressedImageContainer.DecompressImage();
 }
+
+std::size_t mitk::ApplyDiffImageOperation::GetMemorySize() const
+{
+  return sizeof(ApplyDiffImageOperation) - sizeof(CompressedImageContainer) + m_CompressedImageContainer.GetMemorySize();
+}
+
+bool mitk::ApplyDiffImageOperation::SwapOut(std::ostream &stream)
+{
+  return m_CompressedImageContainer.SwapOut(stream);
+}
+
+void mitk::ApplyDiffImageOperation::SwapIn(std::istream &stream)
+{
+  m_CompressedImageContainer.SwapIn(stream);
+}
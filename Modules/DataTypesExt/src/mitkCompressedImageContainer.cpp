@@ -15,12 +15,46 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <lz4.h>
+#include <lz4hc.h>
 
 #include <algorithm>
+#include <atomic>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace
+{
+  // Byte-wise differences are exact for every pixel type, as the subtraction wraps around.
+  void EncodeRowDelta(const char* src, char* dest, std::size_t numRowBytes, std::size_t numSliceBytes)
+  {
+    const auto* in = reinterpret_cast<const unsigned char*>(src);
+    auto* out = reinterpret_cast<unsigned char*>(dest);
+
+    std::copy(in, in + std::min(numRowBytes, numSliceBytes), out);
+
+    for (std::size_t i = numRowBytes; i < numSliceBytes; ++i)
+      out[i] = static_cast<unsigned char>(in[i] - in[i - numRowBytes]);
+  }
+
+  void DecodeRowDelta(char* data, std::size_t numRowBytes, std::size_t numSliceBytes)
+  {
+    auto* inOut = reinterpret_cast<unsigned char*>(data);
+
+    for (std::size_t i = numRowBytes; i < numSliceBytes; ++i)
+      inOut[i] = static_cast<unsigned char>(inOut[i] + inOut[i - numRowBytes]);
+  }
+}
 
 mitk::CompressedImageContainer::CompressedImageContainer()
-  : m_Dimension(0)
+  : m_Dimension(0),
+    m_IsSwappedOut(false),
+    m_IsRowDeltaEncoded(false),
+    m_CompressionMethod(CompressionMethod::LZ4),
+    m_UseRowDelta(false)
 {
 }
 
@@ -44,6 +78,58 @@ void mitk::CompressedImageContainer::ClearCompressedImageData()
   m_SliceDimensions[0] = 0;
   m_SliceDimensions[1] = 0;
   m_Dimension = 0;
+  m_IsSwappedOut = false;
+  m_IsRowDeltaEncoded = false;
+}
+
+void mitk::CompressedImageContainer::SetCompressionMethod(CompressionMethod method)
+{
+  m_CompressionMethod = method;
+}
+
+mitk::CompressedImageContainer::CompressionMethod mitk::CompressedImageContainer::GetCompressionMethod() const
+{
+  return m_CompressionMethod;
+}
+
+void mitk::CompressedImageContainer::SetUseRowDelta(bool useRowDelta)
+{
+  m_UseRowDelta = useRowDelta;
+}
+
+bool mitk::CompressedImageContainer::GetUseRowDelta() const
+{
+  return m_UseRowDelta;
+}
+
+void mitk::CompressedImageContainer::AdaptSettingsToImage(const Image* image)
+{
+  bool isIntegerImage = false;
+
+  if (nullptr != image && 1 == image->GetPixelType().GetNumberOfComponents())
+  {
+    switch (image->GetPixelType().GetComponentType())
+    {
+      case itk::IOComponentEnum::CHAR:
+      case itk::IOComponentEnum::UCHAR:
+      case itk::IOComponentEnum::SHORT:
+      case itk::IOComponentEnum::USHORT:
+      case itk::IOComponentEnum::INT:
+      case itk::IOComponentEnum::UINT:
+      case itk::IOComponentEnum::LONG:
+      case itk::IOComponentEnum::ULONG:
+      case itk::IOComponentEnum::LONGLONG:
+      case itk::IOComponentEnum::ULONGLONG:
+        isIntegerImage = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // LZ4HC compresses several times slower, which would delay every undoable tool stroke
+  m_CompressionMethod = CompressionMethod::LZ4;
+  m_UseRowDelta = isIntegerImage;
 }
 
 void mitk::CompressedImageContainer::CompressImage(const Image* image)
@@ -58,43 +144,57 @@ void mitk::CompressedImageContainer::CompressImage(const Image* image)
   m_SliceDimensions[0] = image->GetDimension(0);
   m_SliceDimensions[1] = image->GetDimension(1);
   m_Dimension = image->GetDimension();
+  m_IsRowDeltaEncoded = m_UseRowDelta;
 
   const auto numTimeSteps = m_TimeGeometry->CountTimeSteps();
   const auto numSlices = image->GetDimension(2);
-  const auto numSliceBytes = image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1);
+  const std::size_t numRowBytes = image->GetPixelType().GetSize() * image->GetDimension(0);
+  const std::size_t numSliceBytes = numRowBytes * image->GetDimension(1);
+  const auto maxDestSize = LZ4_compressBound(static_cast<int>(numSliceBytes));
+  const auto useRowDelta = m_IsRowDeltaEncoded;
+  const auto method = m_CompressionMethod;
+
+  m_CompressedImageData.assign(numTimeSteps, CompressedTimeStepData(numSlices, CompressedSliceData(0, nullptr)));
 
-  m_CompressedImageData.reserve(numTimeSteps);
+  std::atomic<bool> failed(false);
+  auto multiThreader = itk::MultiThreaderBase::New();
 
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    CompressedTimeStepData slices;
-    slices.reserve(numSlices);
-
     ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    const auto* volume = reinterpret_cast<const char*>(accessor.GetData());
+    auto& slices = m_CompressedImageData[t];
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
-    {
-      const auto* src = reinterpret_cast<const char*>(accessor.GetData()) + numSliceBytes * s;
-      char* dest = new char[numSliceBytes];
-      const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numSliceBytes), static_cast<int>(numSliceBytes));
+    multiThreader->ParallelizeArray(0, numSlices, [&](itk::SizeValueType s) {
+      const auto* src = volume + numSliceBytes * s;
 
-      if (0 == destSize)
+      std::unique_ptr<char[]> deltaSrc;
+      if (useRowDelta)
       {
-        MITK_ERROR << "LZ4 compression failed!";
-        delete[] dest;
-        slices.emplace_back(0, nullptr);
+        deltaSrc.reset(new char[numSliceBytes]);
+        EncodeRowDelta(src, deltaSrc.get(), numRowBytes, numSliceBytes);
+        src = deltaSrc.get();
       }
-      else
+
+      std::unique_ptr<char[]> dest(new char[maxDestSize]);
+      const auto destSize = CompressionMethod::LZ4HC == method
+        ? LZ4_compress_HC(src, dest.get(), static_cast<int>(numSliceBytes), maxDestSize, LZ4HC_CLEVEL_DEFAULT)
+        : LZ4_compress_default(src, dest.get(), static_cast<int>(numSliceBytes), maxDestSize);
+
+      if (0 == destSize)
       {
-        char* shrinkedDest = new char[destSize];
-        std::copy(dest, dest + destSize, shrinkedDest);
-        delete[] dest;
-        slices.emplace_back(destSize, shrinkedDest);
+        failed = true;
+        return;
       }
-    }
 
-    m_CompressedImageData.push_back(slices);
+      char* shrinkedDest = new char[destSize];
+      std::copy(dest.get(), dest.get() + destSize, shrinkedDest);
+      slices[s] = CompressedSliceData(destSize, shrinkedDest);
+    }, nullptr);
   }
+
+  if (failed)
+    MITK_ERROR << "LZ4 compression failed!";
 }
 
 mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
@@ -102,9 +202,13 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
   if (m_CompressedImageData.empty())
     return nullptr;
 
+  if (m_IsSwappedOut)
+    mitkThrow() << "Cannot decompress image. The compressed data is swapped out.";
+
   const auto numSlices = static_cast<unsigned int>(m_CompressedImageData[0].size());
   const auto numTimeSteps = static_cast<unsigned int>(m_CompressedImageData.size());
-  const auto numSliceBytes = m_PixelType->GetSize() * m_SliceDimensions[0] * m_SliceDimensions[1];
+  const std::size_t numRowBytes = m_PixelType->GetSize() * m_SliceDimensions[0];
+  const std::size_t numSliceBytes = numRowBytes * m_SliceDimensions[1];
 
   std::array<unsigned int, 4> dimensions;
   dimensions[0] = m_SliceDimensions[0];
@@ -115,22 +219,130 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
   auto image = Image::New();
   image->Initialize(*m_PixelType, m_Dimension, dimensions.data());
 
+  std::atomic<bool> failed(false);
+  auto multiThreader = itk::MultiThreaderBase::New();
+
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
     ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    auto* volume = reinterpret_cast<char*>(accessor.GetData());
+    const auto& slices = m_CompressedImageData[t];
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
-    {
-      auto* dest = reinterpret_cast<char*>(accessor.GetData()) + numSliceBytes * s;
-      const auto& slice = m_CompressedImageData[t][s];
+    multiThreader->ParallelizeArray(0, numSlices, [&](itk::SizeValueType s) {
+      auto* dest = volume + numSliceBytes * s;
+      const auto& slice = slices[s];
       const auto destSize = LZ4_decompress_safe(slice.second, dest, slice.first, static_cast<int>(numSliceBytes));
 
       if (0 > destSize)
-        MITK_ERROR << "LZ4 decompression failed!";
-    }
+      {
+        failed = true;
+        return;
+      }
+
+      if (m_IsRowDeltaEncoded)
+        DecodeRowDelta(dest, numRowBytes, numSliceBytes);
+    }, nullptr);
   }
 
+  if (failed)
+    MITK_ERROR << "LZ4 decompression failed!";
+
   image->SetTimeGeometry(m_TimeGeometry->Clone());
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetMemorySize() const
+{
+  std::size_t size = sizeof(CompressedImageContainer);
+
+  for (const auto& timeStep : m_CompressedImageData)
+  {
+    size += timeStep.capacity() * sizeof(CompressedSliceData);
+
+    if (!m_IsSwappedOut)
+    {
+      for (const auto& slice : timeStep)
+        size += slice.first;
+    }
+  }
+
+  return size;
+}
+
+bool mitk::CompressedImageContainer::SwapOut(std::ostream& stream)
+{
+  if (m_IsSwappedOut)
+    return false;
+
+  // the slice sizes stay in memory, so only the compressed bytes are written
+  bool hasData = false;
+  for (const auto& timeStep : m_CompressedImageData)
+  {
+    for (const auto& slice : timeStep)
+    {
+      if (nullptr != slice.second)
+      {
+        stream.write(slice.second, slice.first);
+        hasData = true;
+      }
+    }
+  }
+
+  // the slices are only released once all of them have been written
+  if (!hasData || !stream)
+    return false;
+
+  for (auto& timeStep : m_CompressedImageData)
+  {
+    for (auto& slice : timeStep)
+    {
+      delete[] slice.second;
+      slice.second = nullptr;
+    }
+  }
+
+  m_IsSwappedOut = true;
+  return true;
+}
+
+void mitk::CompressedImageContainer::SwapIn(std::istream& stream)
+{
+  if (!m_IsSwappedOut)
+    return;
+
+  std::vector<std::unique_ptr<char[]>> buffers;
+
+  for (const auto& timeStep : m_CompressedImageData)
+  {
+    for (const auto& slice : timeStep)
+    {
+      if (0 < slice.first)
+      {
+        buffers.emplace_back(new char[slice.first]);
+        stream.read(buffers.back().get(), slice.first);
+      }
+    }
+  }
+
+  // on failure the buffers are released and the container stays swapped out
+  if (!stream)
+    mitkThrow() << "Could not read swapped out compressed image data.";
+
+  auto buffer = buffers.begin();
+  for (auto& timeStep : m_CompressedImageData)
+  {
+    for (auto& slice : timeStep)
+    {
+      if (0 < slice.first)
+        slice.second = (buffer++)->release();
+    }
+  }
+
+  m_IsSwappedOut = false;
+}
+
+bool mitk::CompressedImageContainer::IsSwappedOut() const
+{
+  return m_IsSwappedOut;
+}
@@ -8,6 +8,12 @@ set(MODULE_IMAGE_TESTS
   mitkCompressedImageContainerTest.cpp #only runs on images
 )
 
+if(MITK_DATATYPESEXT_BENCHMARKS_ENABLED)
+  set(MODULE_CUSTOM_TESTS
+    mitkCompressedImageContainerBenchmarkTest.cpp
+  )
+endif()
+
 set(MODULE_TESTIMAGE
   US4DCyl.nrrd
   Pic3D.nrrd
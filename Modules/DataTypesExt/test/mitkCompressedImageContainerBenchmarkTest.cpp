@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompressedImageContainer.h"
+#include "mitkIOUtil.h"
+
+#include <chrono>
+
+/**
+ * \brief Reports compression ratio and throughput of all compression settings for the given image.
+ *
+ * The benchmark is not part of the regular tests, configure MITK_DATATYPESEXT_BENCHMARKS_ENABLED to
+ * add it with the label "Benchmark".
+ */
+int mitkCompressedImageContainerBenchmarkTest(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "No file specified [FAILED]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  mitk::Image::Pointer image;
+  try
+  {
+    image = mitk::IOUtil::Load<mitk::Image>(argv[1]);
+  }
+  catch (const mitk::Exception &e)
+  {
+    std::cerr << "Could not load image: " << e.GetDescription() << " [FAILED]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const unsigned int numberOfRuns = 5;
+
+  double imageSizeInMB = image->GetPixelType().GetSize() / (1024.0 * 1024.0);
+  for (unsigned int dim = 0; dim < image->GetDimension(); ++dim)
+    imageSizeInMB *= image->GetDimension(dim);
+
+  const std::pair<mitk::CompressedImageContainer::CompressionMethod, const char *> methods[] = {
+    {mitk::CompressedImageContainer::CompressionMethod::LZ4, "LZ4"},
+    {mitk::CompressedImageContainer::CompressionMethod::LZ4HC, "LZ4HC"}};
+
+  for (const auto &method : methods)
+  {
+    for (const bool useRowDelta : {false, true})
+    {
+      mitk::CompressedImageContainer container;
+      container.SetCompressionMethod(method.first);
+      container.SetUseRowDelta(useRowDelta);
+
+      std::chrono::duration<double> compressionTime(0.0);
+      std::chrono::duration<double> decompressionTime(0.0);
+
+      for (unsigned int run = 0; run < numberOfRuns; ++run)
+      {
+        auto start = Clock::now();
+        container.CompressImage(image);
+        compressionTime += Clock::now() - start;
+
+        start = Clock::now();
+        container.DecompressImage();
+        decompressionTime += Clock::now() - start;
+      }
+
+      const double compressedSizeInMB = container.GetMemorySize() / (1024.0 * 1024.0);
+
+      std::cout << "  (II) " << method.second << (useRowDelta ? " + row delta" : "") << ": ratio "
+                << imageSizeInMB / compressedSizeInMB << ", compression "
+                << numberOfRuns * imageSizeInMB / compressionTime.count() << " MB/s, decompression "
+                << numberOfRuns * imageSizeInMB / decompressionTime.count() << " MB/s" << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -156,6 +156,26 @@ int mitkCompressedImageContainerTest(int argc, char *argv[])
 
   std::cout << "  (II) Freeing works." << std::endl;
 
+  // all compression settings must reproduce the image exactly
+  const std::pair<mitk::CompressedImageContainer::CompressionMethod, const char *> methods[] = {
+    {mitk::CompressedImageContainer::CompressionMethod::LZ4, "LZ4"},
+    {mitk::CompressedImageContainer::CompressionMethod::LZ4HC, "LZ4HC"}};
+
+  for (const auto &method : methods)
+  {
+    for (const bool useRowDelta : {false, true})
+    {
+      const std::string name = std::string(method.second) + (useRowDelta ? " + row delta" : "");
+      std::cout << "Testing " << name << std::endl;
+
+      mitk::CompressedImageContainer container;
+      container.SetCompressionMethod(method.first);
+      container.SetUseRowDelta(useRowDelta);
+
+      mitkCompressedImageContainerTestClass::Test(&container, image, numberFailed);
+    }
+  }
+
   if (numberFailed > 0)
   {
     std::cerr << numberFailed << " tests failed." << std::endl;
@@ -0,0 +1,9 @@
+set(MODULE_TESTS
+    itkShortestPathImageFilterTest.cpp
+)
+
+if(MITK_GRAPHALGORITHMS_BENCHMARKS_ENABLED)
+  set(MODULE_CUSTOM_TESTS
+      itkShortestPathImageFilterBenchmarkTest.cpp
+  )
+endif()
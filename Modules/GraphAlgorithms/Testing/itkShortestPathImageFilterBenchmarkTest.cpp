@@ -0,0 +1,77 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkShortestPathImageFilterTestHelper.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <chrono>
+
+using namespace ShortestPathImageFilterTestHelper;
+
+/**
+ * \brief Measures itk::ShortestPathImageFilter against the former multimap frontier on a large image.
+ *
+ * The benchmark is not part of the regular tests, configure MITK_GRAPHALGORITHMS_BENCHMARKS_ENABLED to
+ * add it with the label "Benchmark".
+ */
+class itkShortestPathImageFilterBenchmarkTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkShortestPathImageFilterBenchmarkTestSuite);
+
+  MITK_TEST(BenchmarkAgainstMultimapFrontier);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void BenchmarkAgainstMultimapFrontier()
+  {
+    const unsigned int size = 1024;
+    auto image = CreateRandomCostImage(size);
+    const IndexType start = MakeIndex(0, 0);
+    const IndexType end = MakeIndex(size - 1, size - 1);
+
+    auto filter = CreateFilter(image);
+
+    // first search allocates the node list, the second one shows the costs of a live-wire update
+    auto begin = std::chrono::steady_clock::now();
+    ComputePath(filter, end, start);
+    const double firstSearchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    const PathType path = ComputePath(filter, start, end);
+    const double heapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    const PathType referencePath = ComputeMultimapFrontierPath(image, start, end);
+    const double multimapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    // with a kept tree, moving the end point only traces the path back
+    filter->SetReuseShortestPathTree(true);
+    ComputePath(filter, start, end);
+    begin = std::chrono::steady_clock::now();
+    const PathType reusedPath = ComputePath(filter, start, MakeIndex(size - 2, size - 1));
+    const double reusedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    MITK_INFO << "Shortest path on " << size << "x" << size << " pixels: indexed heap " << heapMs
+              << " ms (first search " << firstSearchMs << " ms), multimap frontier " << multimapMs
+              << " ms, end point moved in kept tree " << reusedMs << " ms";
+
+    CPPUNIT_ASSERT(reusedPath == ComputeMultimapFrontierPath(image, start, MakeIndex(size - 2, size - 1)));
+
+    CPPUNIT_ASSERT(path == referencePath);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(GetPathCosts(image, referencePath), GetPathCosts(image, path), mitk::eps);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkShortestPathImageFilterBenchmark)
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkShortestPathImageFilterTestHelper.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+using namespace ShortestPathImageFilterTestHelper;
+
+class itkShortestPathImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkShortestPathImageFilterTestSuite);
+
+  MITK_TEST(PathFollowsCheapChannel);
+  MITK_TEST(RepeatedSearchesMatchFreshFilter);
+  MITK_TEST(MultipleEndPoints);
+  MITK_TEST(ReusedShortestPathTree);
+  MITK_TEST(HeapFrontierMatchesMultimapFrontier);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void PathFollowsCheapChannel()
+  {
+    CostImageType::SizeType imageSize;
+    imageSize.Fill(32);
+
+    auto image = CostImageType::New();
+    image->SetRegions(imageSize);
+    image->Allocate();
+    image->FillBuffer(10.0f);
+
+    // a U shaped channel of cheap pixels from (2,2) down to (2,28), over to (28,28) and up to (28,2)
+    for (itk::IndexValueType i = 2; i <= 28; ++i)
+    {
+      image->SetPixel(MakeIndex(2, i), 1.0f);
+      image->SetPixel(MakeIndex(i, 28), 1.0f);
+      image->SetPixel(MakeIndex(28, i), 1.0f);
+    }
+
+    auto filter = CreateFilter(image);
+    const PathType path = ComputePath(filter, MakeIndex(2, 2), MakeIndex(28, 2));
+
+    CPPUNIT_ASSERT_EQUAL(MakeIndex(2, 2), path.front());
+    CPPUNIT_ASSERT_EQUAL(MakeIndex(28, 2), path.back());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(26 * 3 + 1), path.size());
+    CPPUNIT_ASSERT_EQUAL(26.0 * 3, GetPathCosts(image, path));
+  }
+
+  void RepeatedSearchesMatchFreshFilter()
+  {
+    auto image = CreateRandomCostImage(64);
+    auto filter = CreateFilter(image);
+
+    const IndexType points[] = {MakeIndex(0, 0), MakeIndex(63, 63), MakeIndex(10, 50), MakeIndex(40, 5), MakeIndex(0, 0)};
+
+    // the node list of the filter is reused by every search, which must not leak state between searches
+    for (std::size_t i = 1; i < 5; ++i)
+    {
+      const PathType path = ComputePath(filter, points[i - 1], points[i]);
+      const PathType freshPath = ComputePath(CreateFilter(image), points[i - 1], points[i]);
+
+      CPPUNIT_ASSERT(path == freshPath);
+      CPPUNIT_ASSERT(path == ComputeMultimapFrontierPath(image, points[i - 1], points[i]));
+    }
+  }
+
+  void MultipleEndPoints()
+  {
+    auto image = CreateRandomCostImage(64);
+    const IndexType start = MakeIndex(32, 32);
+    const IndexType ends[] = {MakeIndex(0, 0), MakeIndex(63, 10), MakeIndex(33, 32)};
+
+    auto filter = CreateFilter(image);
+    filter->SetStartIndex(start);
+    for (const auto &end : ends)
+      filter->AddEndIndex(end);
+    filter->Update();
+
+    const auto paths = filter->GetMultipleVectorPaths();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), paths.size());
+
+    // paths are reported in the order the end points were reached
+    for (const auto &path : paths)
+    {
+      CPPUNIT_ASSERT(path == ComputeMultimapFrontierPath(image, start, path.back()));
+    }
+    CPPUNIT_ASSERT_EQUAL(MakeIndex(33, 32), paths.front().back());
+  }
+
+  void ReusedShortestPathTree()
+  {
+    auto image = CreateRandomCostImage(64);
+    const IndexType start = MakeIndex(20, 30);
+    const IndexType ends[] = {MakeIndex(21, 30), MakeIndex(60, 60), MakeIndex(25, 35), MakeIndex(0, 63)};
+
+    auto filter = CreateFilter(image);
+    filter->SetReuseShortestPathTree(true);
+
+    // ends inside and outside of the tree of the previous search
+    for (const auto &end : ends)
+    {
+      CPPUNIT_ASSERT(ComputePath(filter, start, end) == ComputeMultimapFrontierPath(image, start, end));
+    }
+
+    // modified costs invalidate the tree
+    image->SetPixel(MakeIndex(10, 50), 1000.0f);
+    image->Modified();
+    CPPUNIT_ASSERT(ComputePath(filter, start, ends[3]) == ComputeMultimapFrontierPath(image, start, ends[3]));
+
+    // as does a new start point
+    CPPUNIT_ASSERT(ComputePath(filter, ends[1], ends[3]) == ComputeMultimapFrontierPath(image, ends[1], ends[3]));
+  }
+
+  void HeapFrontierMatchesMultimapFrontier()
+  {
+    const unsigned int size = 64;
+    auto image = CreateRandomCostImage(size);
+    const IndexType start = MakeIndex(0, 0);
+    const IndexType end = MakeIndex(size - 1, size - 1);
+
+    auto filter = CreateFilter(image);
+    const PathType path = ComputePath(filter, start, end);
+    const PathType referencePath = ComputeMultimapFrontierPath(image, start, end);
+
+    CPPUNIT_ASSERT(path == referencePath);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(GetPathCosts(image, referencePath), GetPathCosts(image, path), mitk::eps);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkShortestPathImageFilter)
@@ -0,0 +1,193 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef itkShortestPathImageFilterTestHelper_h
+#define itkShortestPathImageFilterTestHelper_h
+
+#include "itkShortestPathImageFilter.h"
+
+#include <itkImageRegionIterator.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+/** Helpers shared by the unit test and the benchmark of itk::ShortestPathImageFilter. */
+namespace ShortestPathImageFilterTestHelper
+{
+  typedef itk::Image<float, 2> CostImageType;
+  typedef itk::Image<unsigned char, 2> PathImageType;
+  typedef itk::ShortestPathImageFilter<CostImageType, PathImageType> ShortestPathFilterType;
+  typedef CostImageType::IndexType IndexType;
+  typedef std::vector<IndexType> PathType;
+
+  // The costs of a step are the value of the pixel that is entered. No estimate is used, so the
+  // filter runs a plain Dijkstra search.
+  class PixelValueCostFunction : public itk::ShortestPathCostFunction<CostImageType>
+  {
+  public:
+    typedef PixelValueCostFunction Self;
+    typedef itk::ShortestPathCostFunction<CostImageType> Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+    typedef itk::SmartPointer<const Self> ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+
+    double GetCost(IndexType, IndexType p2) override { return m_Image->GetPixel(p2); }
+    double GetMinCost() override { return 0.0; }
+    void Initialize() override {}
+
+  protected:
+    PixelValueCostFunction() {}
+  };
+
+  inline CostImageType::Pointer CreateRandomCostImage(unsigned int size)
+  {
+    CostImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    auto image = CostImageType::New();
+    image->SetRegions(imageSize);
+    image->Allocate();
+
+    // integer costs produce many paths of equal costs, which also tests the order of equal keys
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(1, 9);
+    for (itk::ImageRegionIterator<CostImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(distribution(generator));
+    }
+
+    return image;
+  }
+
+  inline ShortestPathFilterType::Pointer CreateFilter(CostImageType *image)
+  {
+    auto costFunction = PixelValueCostFunction::New();
+    costFunction->SetImage(image);
+
+    auto filter = ShortestPathFilterType::New();
+    filter->SetInput(image);
+    filter->SetCostFunction(costFunction);
+    filter->SetMakeOutputImage(false);
+    return filter;
+  }
+
+  inline PathType ComputePath(ShortestPathFilterType *filter, const IndexType &start, const IndexType &end)
+  {
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Modified();
+    filter->Update();
+    return filter->GetVectorPath();
+  }
+
+  inline double GetPathCosts(const CostImageType *image, const PathType &path)
+  {
+    double costs = 0.0;
+    for (std::size_t i = 1; i < path.size(); ++i)
+      costs += image->GetPixel(path[i]);
+
+    return costs;
+  }
+
+  /** Dijkstra search on the 4-neighborhood with the frontier ShortestPathImageFilter used before the
+      indexed heap: a multimap of keys, where updating a key requires searching the node among all
+      entries with the old key. Neighbors are visited in the order of ShortestPathImageFilter. */
+  inline PathType ComputeMultimapFrontierPath(const CostImageType *image, const IndexType &start, const IndexType &end)
+  {
+    const auto region = image->GetLargestPossibleRegion();
+    const auto size = region.GetSize();
+
+    auto toNode = [&size](const IndexType &index) { return static_cast<std::size_t>(index[1]) * size[0] + index[0]; };
+    auto toIndex = [&size](std::size_t node) {
+      IndexType index;
+      index[0] = node % size[0];
+      index[1] = node / size[0];
+      return index;
+    };
+
+    std::vector<double> distances(size[0] * size[1], -1.0);
+    std::vector<std::size_t> previousNodes(size[0] * size[1], 0);
+    std::vector<bool> closed(size[0] * size[1], false);
+    std::multimap<double, std::size_t> frontier;
+
+    const std::size_t startNode = toNode(start);
+    const std::size_t endNode = toNode(end);
+    distances[startNode] = 0.0;
+    frontier.emplace(0.0, startNode);
+
+    const itk::Offset<2> offsets[4] = {{{0, -1}}, {{1, 0}}, {{0, 1}}, {{-1, 0}}};
+
+    while (!frontier.empty())
+    {
+      const std::size_t node = frontier.begin()->second;
+      frontier.erase(frontier.begin());
+      closed[node] = true;
+
+      if (node == endNode)
+        break;
+
+      const IndexType index = toIndex(node);
+      for (const auto &offset : offsets)
+      {
+        const IndexType neighborIndex = index + offset;
+        if (!region.IsInside(neighborIndex))
+          continue;
+
+        const std::size_t neighbor = toNode(neighborIndex);
+        if (closed[neighbor])
+          continue;
+
+        const double newDistance = distances[node] + image->GetPixel(neighborIndex);
+        if (distances[neighbor] == -1.0 || newDistance < distances[neighbor])
+        {
+          if (distances[neighbor] != -1.0)
+          {
+            auto range = frontier.equal_range(distances[neighbor]);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+              if (it->second == neighbor)
+              {
+                frontier.erase(it);
+                break;
+              }
+            }
+          }
+
+          distances[neighbor] = newDistance;
+          previousNodes[neighbor] = node;
+          frontier.emplace(newDistance, neighbor);
+        }
+      }
+    }
+
+    PathType path;
+    for (std::size_t node = endNode; node != startNode; node = previousNodes[node])
+      path.push_back(toIndex(node));
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+
+    return path;
+  }
+
+  inline IndexType MakeIndex(itk::IndexValueType x, itk::IndexValueType y)
+  {
+    IndexType index;
+    index[0] = x;
+    index[1] = y;
+    return index;
+  }
+}
+
+#endif
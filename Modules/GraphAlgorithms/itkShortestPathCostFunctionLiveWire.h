@@ -35,6 +35,12 @@ namespace itk
   To compute  the costs of the gradient magnitude dynamically
   an iverted map of the histogram of gradient magnitude image is used.
 
+  The local costs of a link only depend on the features of the target pixel. They are computed
+  for all pixels by Initialize() and kept until the image or the cost map settings change, so
+  GetCost() is a lookup. Repulsive points and the distance between the pixels are applied in GetCost().
+  Every change of the costs modifies the cost function, which allows a shortest path filter to
+  decide whether a previous search is still valid.
+
   */
   template <class TInputImageType>
   class ITK_EXPORT ShortestPathCostFunctionLiveWire : public ShortestPathCostFunction<TInputImageType>
@@ -83,24 +89,19 @@ namespace itk
     /** \brief Clear repulsive points in cost function*/
     virtual void ClearRepulsivePoints();
 
-    itkSetMacro(RequestedRegion, RegionType);
+    /** \brief Set the region of interest. It does not influence the costs and thus does not modify the cost function.*/
+    void SetRequestedRegion(const RegionType &region) { this->m_RequestedRegion = region; }
     itkGetMacro(RequestedRegion, RegionType);
 
     void SetImage(const TInputImageType *_arg) override;
 
-    void SetDynamicCostMap(std::map<int, int> &costMap)
-    {
-      this->m_CostMap = costMap;
-      this->m_UseCostMap = true;
-      this->m_MaxMapCosts = -1;
-      this->Modified();
-    }
+    void SetDynamicCostMap(std::map<int, int> &costMap);
 
-    void SetUseCostMap(bool useCostMap) { this->m_UseCostMap = useCostMap; }
+    void SetUseCostMap(bool useCostMap);
     /**
      \brief Set the maximum of the dynamic cost map to save computation time.
     */
-    void SetCostMapMaximum(double max) { this->m_MaxMapCosts = max; }
+    void SetCostMapMaximum(double max);
     enum Constants
     {
       MAPSCALEFACTOR = 10
@@ -152,6 +153,14 @@ namespace itk
 
     double m_MaxMapCosts;
 
+    /** \brief local costs of every pixel, see ComputeLocalCost()*/
+    FloatImageType::Pointer m_CostImage;
+
+    bool m_CostImageIsValid;
+
+    /** \brief calculates the costs of entering the pixel p2 from the features at p2*/
+    double ComputeLocalCost(const IndexType &p2);
+
   private:
     double SigmoidFunction(double I, double max, double min, double alpha, double beta);
   };
@@ -21,7 +21,9 @@ found in the LICENSE file.
 #include <itkCastImageFilter.h>
 #include <itkGradientImageFilter.h>
 #include <itkGradientMagnitudeImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
 #include <itkLaplacianImageFilter.h>
+#include <itkMultiThreaderBase.h>
 #include <itkStatisticsImageFilter.h>
 #include <itkZeroCrossingImageFilter.h>
 
@@ -29,7 +31,7 @@ namespace itk
 {
   // Constructor
   template <class TInputImageType>
-  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_GradientMax(0.0), m_Initialized(false),  m_UseCostMap(false), m_MaxMapCosts(-1.0)
+  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_GradientMax(0.0), m_Initialized(false),  m_UseCostMap(false), m_MaxMapCosts(-1.0), m_CostImageIsValid(false)
   {
   }
 
@@ -38,12 +40,14 @@ namespace itk
   {
     this->m_MaskImage->SetPixel(index, 255);
     m_UseRepulsivePoints = true;
+    this->Modified();
   }
 
   template <class TInputImageType>
   void ShortestPathCostFunctionLiveWire<TInputImageType>::RemoveRepulsivePoint(const IndexType &index)
   {
     this->m_MaskImage->SetPixel(index, 0);
+    this->Modified();
   }
 
   template <class TInputImageType>
@@ -64,6 +68,7 @@ namespace itk
 
       this->Modified();
       this->m_Initialized = false;
+      this->m_CostImageIsValid = false;
     }
   }
 
@@ -72,18 +77,44 @@ namespace itk
   {
     m_UseRepulsivePoints = false;
     this->m_MaskImage->FillBuffer(0);
+    this->Modified();
   }
 
   template <class TInputImageType>
-  double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCost(IndexType p1, IndexType p2)
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::SetDynamicCostMap(std::map<int, int> &costMap)
   {
-    // local component costs
-    // weights
-    double w1;
-    double w2;
-    double w3;
-    double costs = 0.0;
+    this->m_CostMap = costMap;
+    this->m_UseCostMap = true;
+    this->m_MaxMapCosts = -1;
+    this->m_CostImageIsValid = false;
+    this->Modified();
+  }
+
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::SetUseCostMap(bool useCostMap)
+  {
+    if (this->m_UseCostMap != useCostMap)
+    {
+      this->m_UseCostMap = useCostMap;
+      this->m_CostImageIsValid = false;
+      this->Modified();
+    }
+  }
+
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::SetCostMapMaximum(double max)
+  {
+    if (this->m_MaxMapCosts != max)
+    {
+      this->m_MaxMapCosts = max;
+      this->m_CostImageIsValid = false;
+      this->Modified();
+    }
+  }
 
+  template <class TInputImageType>
+  double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCost(IndexType p1, IndexType p2)
+  {
     // if we are on the mask, return asap
     if (m_UseRepulsivePoints)
     {
@@ -91,6 +122,29 @@ namespace itk
         return 1000;
     }
 
+    // the local costs only depend on the features at p2 and are precomputed in Initialize()
+    double costs = this->m_CostImage->GetPixel(p2);
+
+    // scale by euclidian distance
+    if (p1[0] != p2[0] && p1[1] != p2[1])
+    {
+      // diagonal neighbor
+      costs *= sqrt(2.0);
+    }
+
+    return costs;
+  }
+
+  template <class TInputImageType>
+  double ShortestPathCostFunctionLiveWire<TInputImageType>::ComputeLocalCost(const IndexType &p2)
+  {
+    // local component costs
+    // weights
+    double w1;
+    double w2;
+    double w3;
+    double costs = 0.0;
+
     double gradientX, gradientY;
     gradientX = gradientY = 0.0;
 
@@ -267,21 +321,6 @@ namespace itk
     }
     costs = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
 
-    // scale by euclidian distance
-    double costScale;
-    if (p1[0] == p2[0] || p1[1] == p2[1])
-    {
-      // horizontal or vertical neighbor
-      costScale = 1.0;
-    }
-    else
-    {
-      // diagonal neighbor
-      costScale = sqrt(2.0);
-    }
-
-    costs *= costScale;
-
     return costs;
   }
 
@@ -369,6 +408,28 @@ namespace itk
                       // but a different path.
 
       m_Initialized = true;
+      m_CostImageIsValid = false;
+    }
+
+    // the local costs of all pixels are computed once per image and cost map, the shortest path search
+    // only looks them up
+    if (!m_CostImageIsValid)
+    {
+      this->m_CostImage = FloatImageType::New();
+      this->m_CostImage->SetRegions(this->m_Image->GetLargestPossibleRegion());
+      this->m_CostImage->Allocate();
+
+      itk::MultiThreaderBase::New()->ParallelizeImageRegion<2>(
+        this->m_CostImage->GetLargestPossibleRegion(),
+        [this](const RegionType &region) {
+          for (itk::ImageRegionIteratorWithIndex<FloatImageType> it(this->m_CostImage, region); !it.IsAtEnd(); ++it)
+          {
+            it.Set(this->ComputeLocalCost(it.GetIndex()));
+          }
+        },
+        nullptr);
+
+      m_CostImageIsValid = true;
     }
 
     // check start/end point value
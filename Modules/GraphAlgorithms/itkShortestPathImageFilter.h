@@ -33,6 +33,8 @@ found in the LICENSE file.
 // algorithm time extends a lot. Necessary for GetDistanceImage
 // void SetStoreVectorOrder(bool) // Optional (default=false), Stores in which order the pixels were checked. Necessary
 // for GetVectorOrderImage
+// void SetReuseShortestPathTree(bool) // Optional (default=false), Keep the search of the last update. If only the end
+// point changed, the path is traced back in the existing shortest path tree or the search is continued to the new end.
 // void AddEndIndex(const IndexType & EndIndex) //Optional. By calling this function you can add several endpoints! The
 // algorithm will look for several shortest Pathes. From Start to all Endpoints.
 //
@@ -130,6 +132,13 @@ namespace itk
     itkSetMacro(ActivateTimeOut, bool);
     itkGetMacro(ActivateTimeOut, bool);
 
+    // \brief (default=false), Keep the shortest path tree of the last search. As long as the start point, the input
+    // and the cost function are not modified, a new end point is looked up in this tree (or the search is continued
+    // until the end point is reached) instead of searching again. Only used for single end point searches with cost
+    // functions without estimate (GetMinCost() == 0), whose trees do not depend on the end point.
+    itkSetMacro(ReuseShortestPathTree, bool);
+    itkGetMacro(ReuseShortestPathTree, bool);
+
     // \brief returns shortest Path as vector
     std::vector<IndexType> GetVectorPath();
 
@@ -163,7 +172,9 @@ namespace itk
       m_endPoints; // if you fill this vector, the algo will not rest until all endPoints have been reached
     std::vector<IndexType> m_endPointsClosed;
 
-    ShortestPathNode *m_Nodes; // main list that contains all nodes
+    ShortestPathNode *m_Nodes;       // main list that contains all nodes
+    unsigned int m_SearchNumber;     // number of the current search, nodes of other searches are stale (see GetNode)
+    ShortestPathNodeHeap m_OpenList; // discovered nodes that are not closed yet
     NodeNumType m_Graph_NumberOfNodes;
     NodeNumType m_Graph_StartNode;
     NodeNumType m_Graph_EndNode;
@@ -187,6 +198,13 @@ namespace itk
 
     bool m_Initialized;
 
+    bool m_ReuseShortestPathTree;
+    bool m_ShortestPathTreeValid;        // false if the start point changed since the last search
+    TimeStamp m_ShortestPathTreeTime;    // time of the last search start
+    const InputImageType *m_ShortestPathTreeInput;
+    const CostFunctionType *m_ShortestPathTreeCostFunction;
+    bool m_ShortestPathTreeFullNeighbors;
+
     CostFunctionTypePointer m_CostFunction;
     IndexType m_StartIndex, m_EndIndex;
     std::vector<IndexType> m_VectorPath;
@@ -215,6 +233,9 @@ namespace itk
     // \brief Convert image coordinate to a indexnumber of a node in m_Nodes
     unsigned int CoordToNode(IndexType);
 
+    // \brief Returns the node with the given indexnumber, reset to undiscovered if it was not touched by the current search yet
+    ShortestPathNode *GetNode(NodeNumType nodeNum);
+
     // \brief Returns the neighbors of a node
     std::vector<ShortestPathNode *> GetNeighbors(NodeNumType nodeNum, bool FullNeighbors);
 
@@ -224,6 +245,9 @@ namespace itk
     // \brief Initializes the graph
     void InitGraph();
 
+    // \brief Checks if the shortest path tree of the last search can be used for the current end point
+    bool CanReuseShortestPathTree();
+
     // \brief Start ShortestPathSearch
     void StartShortestPathSearch();
   };
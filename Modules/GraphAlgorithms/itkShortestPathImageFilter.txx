@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <ctime>
 #include <algorithm>
 #include <iostream>
+#include <unordered_set>
 #include <vector>
 
 namespace itk
@@ -26,7 +27,10 @@ namespace itk
   template <class TInputImageType, class TOutputImageType>
   ShortestPathImageFilter<TInputImageType, TOutputImageType>::ShortestPathImageFilter()
     : m_Nodes(nullptr),
+      m_SearchNumber(0),
       m_Graph_NumberOfNodes(0),
+      m_Graph_StartNode(0),
+      m_Graph_EndNode(0),
       m_Graph_fullNeighbors(false),
       m_useCostFunction(true),
       m_FullNeighborsMode(false),
@@ -35,7 +39,12 @@ namespace itk
       m_CalcAllDistances(false),
       multipleEndPoints(false),
       m_ActivateTimeOut(false),
-      m_Initialized(false)
+      m_Initialized(false),
+      m_ReuseShortestPathTree(false),
+      m_ShortestPathTreeValid(false),
+      m_ShortestPathTreeInput(nullptr),
+      m_ShortestPathTreeCostFunction(nullptr),
+      m_ShortestPathTreeFullNeighbors(false)
   {
     m_endPoints.clear();
     m_endPointsClosed.clear();
@@ -139,6 +148,22 @@ namespace itk
     return false;
   }
 
+  template <class TInputImageType, class TOutputImageType>
+  inline ShortestPathNode *ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNode(NodeNumType nodeNum)
+  {
+    ShortestPathNode *node = &m_Nodes[nodeNum];
+    if (node->searchNumber != m_SearchNumber)
+    {
+      node->distance = -1;
+      node->distAndEst = -1;
+      node->prevNode = -1;
+      node->closed = false;
+      node->heapIndex = ShortestPathNodeHeap::NotInHeap;
+      node->searchNumber = m_SearchNumber;
+    }
+    return node;
+  }
+
   template <class TInputImageType, class TOutputImageType>
   inline std::vector<ShortestPathNode *> ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNeighbors(
     unsigned int nodeNum, bool FullNeighbors)
@@ -159,22 +184,22 @@ namespace itk
       NeighborCoord[0] = Coord[0];
       NeighborCoord[1] = Coord[1] - neighborDistance;
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0] + neighborDistance;
       NeighborCoord[1] = Coord[1];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0];
       NeighborCoord[1] = Coord[1] + neighborDistance;
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0] - neighborDistance;
       NeighborCoord[1] = Coord[1];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       if (FullNeighbors)
       {
@@ -182,22 +207,22 @@ namespace itk
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
       }
     }
     if (dim == 3)
@@ -207,37 +232,37 @@ namespace itk
       NeighborCoord[1] = Coord[1] - neighborDistance;
       NeighborCoord[2] = Coord[2];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0] + neighborDistance;
       NeighborCoord[1] = Coord[1];
       NeighborCoord[2] = Coord[2];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0];
       NeighborCoord[1] = Coord[1] + neighborDistance;
       NeighborCoord[2] = Coord[2];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0] - neighborDistance;
       NeighborCoord[1] = Coord[1];
       NeighborCoord[2] = Coord[2];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0];
       NeighborCoord[1] = Coord[1];
       NeighborCoord[2] = Coord[2] + neighborDistance;
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       NeighborCoord[0] = Coord[0];
       NeighborCoord[1] = Coord[1];
       NeighborCoord[2] = Coord[2] - neighborDistance;
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
       if (FullNeighbors)
       {
@@ -247,125 +272,125 @@ namespace itk
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2];
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2];
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2];
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2];
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         // BackSlice (Diagonal)
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         // BackSlice (Non-Diag)
         NeighborCoord[0] = Coord[0];
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1];
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0];
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1];
         NeighborCoord[2] = Coord[2] - neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         // FrontSlice (Diagonal)
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         // FrontSlice(Non-Diag)
         NeighborCoord[0] = Coord[0];
         NeighborCoord[1] = Coord[1] - neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] + neighborDistance;
         NeighborCoord[1] = Coord[1];
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0];
         NeighborCoord[1] = Coord[1] + neighborDistance;
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
 
         NeighborCoord[0] = Coord[0] - neighborDistance;
         NeighborCoord[1] = Coord[1];
         NeighborCoord[2] = Coord[2] + neighborDistance;
         if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+          nodeList.push_back(GetNode(CoordToNode(NeighborCoord)));
       }
     }
     return nodeList;
@@ -379,10 +404,14 @@ namespace itk
     {
       m_StartIndex[i] = StartIndex[i];
     }
-    m_Graph_StartNode = CoordToNode(m_StartIndex);
+    NodeNumType startNode = CoordToNode(m_StartIndex);
+    if (startNode != m_Graph_StartNode)
+    {
+      m_ShortestPathTreeValid = false;
+    }
+    m_Graph_StartNode = startNode;
     // MITK_INFO << "StartIndex = " << StartIndex;
     // MITK_INFO << "StartNode = " << m_Graph_StartNode;
-    m_Initialized = false;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -418,9 +447,11 @@ namespace itk
   {
     // Returns the minimal possible costs for a path from "a" to targetnode.
     itk::Vector<float, 3> v;
-    v[0] = m_EndIndex[0] - a[0];
-    v[1] = m_EndIndex[1] - a[1];
-    v[2] = m_EndIndex[2] - a[2];
+    v.Fill(0.0);
+    for (unsigned int i = 0; i < TInputImageType::ImageDimension; ++i)
+    {
+      v[i] = m_EndIndex[i] - a[i];
+    }
 
     return m_CostFunction->GetMinCost() * v.GetNorm();
   }
@@ -428,40 +459,82 @@ namespace itk
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::InitGraph()
   {
-    if (!m_Initialized)
+    // Calc Number of nodes
+    auto imageDimensions = TInputImageType::ImageDimension;
+    const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
+    NodeNumType numberOfNodes = 1;
+    for (NodeNumType i = 0; i < imageDimensions; ++i)
+      numberOfNodes = numberOfNodes * size[i];
+
+    // The mainNodeList is only reallocated if the image size changed. Its nodes are reset lazily by GetNode()
+    // when a search touches them, so a search does not have to visit every node of the image up front.
+    if (!m_Initialized || numberOfNodes != m_Graph_NumberOfNodes)
     {
-      // Clean up previous stuff
       CleanUp();
 
-      // Calc Number of nodes
-      auto imageDimensions = TInputImageType::ImageDimension;
-      const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
-      m_Graph_NumberOfNodes = 1;
-      for (NodeNumType i = 0; i < imageDimensions; ++i)
-        m_Graph_NumberOfNodes = m_Graph_NumberOfNodes * size[i];
-
-      // Initialize mainNodeList with that number
+      m_Graph_NumberOfNodes = numberOfNodes;
       m_Nodes = new ShortestPathNode[m_Graph_NumberOfNodes];
-
-      // Initialize each node in nodelist
       for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
       {
-        m_Nodes[i].distAndEst = -1;
-        m_Nodes[i].distance = -1;
-        m_Nodes[i].prevNode = -1;
         m_Nodes[i].mainListIndex = i;
-        m_Nodes[i].closed = false;
+        m_Nodes[i].searchNumber = 0;
       }
+      m_SearchNumber = 0;
 
       m_Initialized = true;
     }
 
-    // In the beginning, the Startnode needs a distance of 0
-    m_Nodes[m_Graph_StartNode].distance = 0;
-    m_Nodes[m_Graph_StartNode].distAndEst = 0;
+    m_VectorOrder.clear();
+    m_VectorPath.clear();
+    m_MultipleVectorPaths.clear();
+    m_OpenList.Clear();
+
+    // Start a new search, which makes all nodes stale
+    ++m_SearchNumber;
+    if (0 == m_SearchNumber)
+    {
+      for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
+        m_Nodes[i].searchNumber = 0;
+      m_SearchNumber = 1;
+    }
+
+    // In the beginning, the Startnode needs a distance of 0 and is the only discovered node
+    ShortestPathNode *startNode = GetNode(m_Graph_StartNode);
+    startNode->distance = 0;
+    startNode->distAndEst = 0;
+    m_OpenList.Push(startNode);
 
     // initalize cost function
     m_CostFunction->Initialize();
+
+    // remember what the search depends on, so it can be reused for other end points
+    m_ShortestPathTreeValid = true;
+    m_ShortestPathTreeInput = this->GetInput();
+    m_ShortestPathTreeCostFunction = m_CostFunction.GetPointer();
+    m_ShortestPathTreeFullNeighbors = m_Graph_fullNeighbors;
+    m_ShortestPathTreeTime.Modified();
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::CanReuseShortestPathTree()
+  {
+    if (!m_ReuseShortestPathTree || !m_ShortestPathTreeValid || !m_Initialized || multipleEndPoints ||
+        m_CalcAllDistances || !m_useCostFunction)
+    {
+      return false;
+    }
+
+    // with an estimate, the order of the search depends on the end point
+    if (m_CostFunction->GetMinCost() != 0.0)
+    {
+      return false;
+    }
+
+    return m_ShortestPathTreeInput == this->GetInput() &&
+           this->GetInput()->GetMTime() < m_ShortestPathTreeTime.GetMTime() &&
+           m_ShortestPathTreeCostFunction == m_CostFunction.GetPointer() &&
+           m_CostFunction->GetMTime() < m_ShortestPathTreeTime.GetMTime() &&
+           m_ShortestPathTreeFullNeighbors == m_Graph_fullNeighbors;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -478,43 +551,31 @@ namespace itk
     DistanceType curNodeDistance = 0;
     NodeNumType numberOfNodesChecked = 0;
 
-    // Create Multimap (tree structure for fast searching)
-    std::multimap<double, ShortestPathNode *> myMap;
-    std::pair<std::multimap<double, ShortestPathNode *>::iterator, std::multimap<double, ShortestPathNode *>::iterator>
-      ret;
-    std::multimap<double, ShortestPathNode *>::iterator it;
+    // If the search is continued with a new end point, the end may already be closed
+    if (!multipleEndPoints && !m_CalcAllDistances && GetNode(m_Graph_EndNode)->closed)
+    {
+      return;
+    }
 
-    // At first, only startNote is discovered.
-    myMap.insert(
-      std::pair<double, ShortestPathNode *>(m_Nodes[m_Graph_StartNode].distAndEst, &m_Nodes[m_Graph_StartNode]));
+    // Nodes of the end points of a multiple end points search, to recognize them without comparing all end points
+    std::unordered_set<NodeNumType> endNodes;
+    if (multipleEndPoints)
+    {
+      for (const auto &endPoint : m_endPoints)
+        endNodes.insert(CoordToNode(endPoint));
+    }
 
     // While there are discovered Nodes, pick the one with lowest distance,
     // update its neighbors and eventually delete it from the discovered Nodes list.
-    while (!myMap.empty())
+    while (!m_OpenList.IsEmpty())
     {
       numberOfNodesChecked++;
-      /*if ( (numberOfNodesChecked % (m_Graph_NumberOfNodes/100)) == 0)
-      {
-        MITK_INFO << "Checked " << ( numberOfNodesChecked / (m_Graph_NumberOfNodes/100) ) << "% List: " << myMap.size()
-      << "\n";
-      }*/
-
-      // Get element with lowest score
-      mainNodeListIndex = myMap.begin()->second->mainListIndex;
-      curNodeDistance = myMap.begin()->second->distance;
-      myMap.begin()->second->closed = true; // close it
-
-      // Debug:
-      // MITK_INFO << "INFO: size " << myMap.size();
-      /*
-      for (it = myMap.begin(); it != myMap.end(); ++it)
-      {
-      MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-      }
-      */
 
-      // Kicks out element with lowest score
-      myMap.erase(myMap.begin());
+      // Kicks out element with lowest score and closes it
+      ShortestPathNode *curNode = m_OpenList.Pop();
+      mainNodeListIndex = curNode->mainListIndex;
+      curNodeDistance = curNode->distance;
+      curNode->closed = true;
 
       // if wanted, store vector order
       if (m_StoreVectorOrder)
@@ -523,137 +584,36 @@ namespace itk
       }
 
       // Check neighbors
+      IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
       std::vector<ShortestPathNode *> neighborNodes = GetNeighbors(mainNodeListIndex, m_Graph_fullNeighbors);
       for (NodeNumType i = 0; i < neighborNodes.size(); i++)
       {
-        if (neighborNodes[i]->closed)
+        ShortestPathNode *neighborNode = neighborNodes[i];
+        if (neighborNode->closed)
           continue; // this nodes is already closed, go to next neighbor
 
-        IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
-        IndexType coordNeighborNode = NodeToCoord(neighborNodes[i]->mainListIndex);
+        IndexType coordNeighborNode = NodeToCoord(neighborNode->mainListIndex);
 
         // calculate the new Distance to the current neighbor
         double newDistance = curNodeDistance + (m_CostFunction->GetCost(coordCurNode, coordNeighborNode));
 
         // if it is shorter than any yet known path to this neighbor, than the current path is better. Save that!
-        if ((newDistance < neighborNodes[i]->distance) || (neighborNodes[i]->distance == -1))
+        if ((newDistance < neighborNode->distance) || (neighborNode->distance == -1))
         {
-          // if that neighbornode is not in discoverednodeList yet, Push it there and update
-          if (neighborNodes[i]->distance == -1)
+          bool discovered = neighborNode->distance != -1;
+
+          neighborNode->distance = newDistance;
+          neighborNode->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
+          neighborNode->prevNode = mainNodeListIndex;
+
+          // if that neighbornode is not in discoverednodeList yet, Push it there, otherwise update its position
+          if (discovered)
           {
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-            /*
-            MITK_INFO << "Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            MITK_INFO << "INFO: size " << myMap.size();
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }
-            */
+            m_OpenList.UpdateKey(neighborNode);
           }
-          // or if is already in discoverednodelist, update
           else
           {
-            /*
-            it = myMap.find(neighborNodes[i]->distAndEst);
-            if (it == myMap.end() )
-            {
-            MITK_INFO << "Nothing!";
-            // look further
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            if ((*it).second->mainListIndex == lookForId)
-            {
-            MITK_INFO << "But it is there!!!";
-            MITK_INFO << "Searched for: " << lookFor << "   but had: " << (*it).second->distAndEst;
-            }
-
-            }
-            }
-            */
-
-            // 1st : find and delete old element
-            bool found = false;
-            ret = myMap.equal_range(neighborNodes[i]->distAndEst);
-
-            if ((ret.first == ret.second))
-            {
-              /*+++++++++++++ no exact match +++++++++++++*/
-              // MITK_INFO << "No exact match!"; // if this happens, you are screwed
-              /*
-              MITK_INFO << "Was looking for: " << lookFor << "  ID: " << lookForId;
-              if (ret.first != myMap.end() )
-              {
-              it = ret.first;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              ++it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              --it;
-              --it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              }
-
-              // look if that ID is found in the map
-              for (it = myMap.begin(); it != myMap.end(); ++it)
-              {
-              if ((*it).second->mainListIndex == lookForId)
-              {
-              MITK_INFO << "But it is there!!!";
-              MITK_INFO << "Searched dist: " << lookFor << "  found dist: " << (*it).second->distAndEst;
-              }
-
-              }
-              */
-            }
-            else
-            {
-              for (it = ret.first; it != ret.second; ++it)
-              {
-                if (it->second->mainListIndex == neighborNodes[i]->mainListIndex)
-                {
-                  found = true;
-                  myMap.erase(it);
-                  /*
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  MITK_INFO << "Erase: " << it->first << "|" << it->second->mainListIndex;
-
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  for (it = myMap.begin(); it != myMap.end(); ++it)
-                  {
-                  MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-                  }
-                  */
-                  break;
-                }
-              }
-            }
-
-            if (!found)
-            {
-              // MITK_INFO << "Could not find it! :(";
-              continue;
-            }
-
-            // 2nd: update and insert new element
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            // myMap.insert( std::pair<double,ShortestPathNode*> (neighborNodes[i]->distAndEst, neighborNodes[i]));
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-
-            // MITK_INFO << "Re-Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            // m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            // MITK_INFO << "INFO: size " << myMap.size();
-            /*for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }*/
+            m_OpenList.Push(neighborNode);
           }
         }
       }
@@ -675,23 +635,24 @@ namespace itk
       // For multiple points
       if (multipleEndPoints)
       {
-        // super slow, make it faster
-        for (unsigned int i = 0; i < m_endPoints.size(); i++)
+        if (endNodes.erase(mainNodeListIndex) > 0)
         {
-          if (CoordToNode(m_endPoints[i]) == mainNodeListIndex)
+          m_endPointsClosed.push_back(NodeToCoord(mainNodeListIndex));
+          m_endPoints.erase(std::remove_if(m_endPoints.begin(),
+                                           m_endPoints.end(),
+                                           [this, mainNodeListIndex](const IndexType &endPoint) {
+                                             return CoordToNode(endPoint) == mainNodeListIndex;
+                                           }),
+                            m_endPoints.end());
+          if (m_endPoints.empty())
           {
-            m_endPointsClosed.push_back(NodeToCoord(mainNodeListIndex));
-            m_endPoints.erase(m_endPoints.begin() + i);
-            if (m_endPoints.empty())
-            {
-              // Finished! break
-              return;
-            }
-            if (m_Graph_EndNode == mainNodeListIndex)
-            {
-              // set new end
-              SetEndIndex(m_endPoints[0]);
-            }
+            // Finished! All end points are reached, the rest of the image is not searched
+            return;
+          }
+          if (m_Graph_EndNode == mainNodeListIndex)
+          {
+            // set new end
+            SetEndIndex(m_endPoints[0]);
           }
         }
       }
@@ -789,9 +750,10 @@ namespace itk
     {
       IndexType index = distanceImageIt.GetIndex();
       myNodeNum = CoordToNode(index);
-      double newVal = m_Nodes[myNodeNum].distance;
+      double newVal = GetNode(myNodeNum)->distance;
       distanceImageIt.Set(newVal);
     }
+    return image;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -864,17 +826,24 @@ namespace itk
   {
     m_VectorOrder.clear();
     m_VectorPath.clear();
-    // TODO: if multiple Path, clear all multiple Paths
+    m_MultipleVectorPaths.clear();
 
-    if (m_Nodes)
-      delete[] m_Nodes;
+    m_OpenList.Clear();
+    delete[] m_Nodes;
+    m_Nodes = nullptr;
+    m_Graph_NumberOfNodes = 0;
+    m_Initialized = false;
+    m_ShortestPathTreeValid = false;
   }
 
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::GenerateData()
   {
-    // Build Graph
-    InitGraph();
+    // Build Graph, unless the search of the last update can be continued
+    if (!CanReuseShortestPathTree())
+    {
+      InitGraph();
+    }
 
     // Calc Shortest Parth
     StartShortestPathSearch();
@@ -21,4 +21,105 @@ namespace itk
   //  {
   //    return (this->mainListIndex == a.mainListIndex);
   //  }
+
+  const NodeNumType ShortestPathNodeHeap::NotInHeap;
+
+  void ShortestPathNodeHeap::Clear()
+  {
+    for (const auto &entry : m_Entries)
+      entry.node->heapIndex = NotInHeap;
+
+    m_Entries.clear();
+    m_NextOrder = 0;
+  }
+
+  void ShortestPathNodeHeap::Push(ShortestPathNode *node)
+  {
+    m_Entries.push_back(Entry{node->distAndEst, m_NextOrder++, node});
+    node->heapIndex = static_cast<NodeNumType>(m_Entries.size() - 1);
+    this->SiftUp(m_Entries.size() - 1);
+  }
+
+  ShortestPathNode *ShortestPathNodeHeap::Pop()
+  {
+    ShortestPathNode *top = m_Entries.front().node;
+    top->heapIndex = NotInHeap;
+
+    const Entry last = m_Entries.back();
+    m_Entries.pop_back();
+
+    if (!m_Entries.empty())
+    {
+      this->Place(0, last);
+      this->SiftDown(0);
+    }
+
+    return top;
+  }
+
+  void ShortestPathNodeHeap::UpdateKey(ShortestPathNode *node)
+  {
+    const std::size_t position = node->heapIndex;
+    const Entry oldEntry = m_Entries[position];
+
+    // an updated node is queued behind nodes of equal key, like a newly pushed one
+    m_Entries[position].key = node->distAndEst;
+    m_Entries[position].order = m_NextOrder++;
+
+    if (m_Entries[position] < oldEntry)
+    {
+      this->SiftUp(position);
+    }
+    else
+    {
+      this->SiftDown(position);
+    }
+  }
+
+  void ShortestPathNodeHeap::Place(std::size_t position, const Entry &entry)
+  {
+    m_Entries[position] = entry;
+    entry.node->heapIndex = static_cast<NodeNumType>(position);
+  }
+
+  void ShortestPathNodeHeap::SiftUp(std::size_t position)
+  {
+    const Entry entry = m_Entries[position];
+
+    while (position > 0)
+    {
+      const std::size_t parent = (position - 1) / 2;
+      if (!(entry < m_Entries[parent]))
+        break;
+
+      this->Place(position, m_Entries[parent]);
+      position = parent;
+    }
+
+    this->Place(position, entry);
+  }
+
+  void ShortestPathNodeHeap::SiftDown(std::size_t position)
+  {
+    const Entry entry = m_Entries[position];
+    const std::size_t size = m_Entries.size();
+
+    while (true)
+    {
+      std::size_t child = 2 * position + 1;
+      if (child >= size)
+        break;
+
+      if (child + 1 < size && m_Entries[child + 1] < m_Entries[child])
+        ++child;
+
+      if (!(m_Entries[child] < entry))
+        break;
+
+      this->Place(position, m_Entries[child]);
+      position = child;
+    }
+
+    this->Place(position, entry);
+  }
 }
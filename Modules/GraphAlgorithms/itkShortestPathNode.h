@@ -14,6 +14,9 @@ found in the LICENSE file.
 
 #include "MitkGraphAlgorithmsExports.h"
 
+#include <cstddef>
+#include <vector>
+
 namespace itk
 {
   typedef double DistanceType; // Type to declare the costs
@@ -28,6 +31,52 @@ namespace itk
     NodeNumType prevNode;      // previous node. Important to find the Shortest Path
     NodeNumType mainListIndex; // Indexnumber of this node in m_Nodes
     bool closed;               // determines if this node is closes, so its optimal path to startNode is known
+    NodeNumType heapIndex;     // position in the ShortestPathNodeHeap, NotInHeap if the node is not discovered
+    unsigned int searchNumber; // search this node was last touched by. Nodes of older searches are reset on access
+  };
+
+  // \brief Indexed binary min-heap of ShortestPathNodes, ordered by distAndEst.
+  //
+  // The position of every node in the heap is stored in ShortestPathNode::heapIndex, so a node whose
+  // distAndEst changed can be moved in O(log n) without searching it (UpdateKey). Nodes with equal
+  // keys are popped in the order they were pushed or updated (first in, first out).
+  class MITKGRAPHALGORITHMS_EXPORT ShortestPathNodeHeap
+  {
+  public:
+    static const NodeNumType NotInHeap = static_cast<NodeNumType>(-1);
+
+    void Clear();
+    bool IsEmpty() const { return m_Entries.empty(); }
+    std::size_t GetSize() const { return m_Entries.size(); }
+
+    // \brief Inserts a node that is not in the heap yet, with its current distAndEst as key.
+    void Push(ShortestPathNode *node);
+
+    // \brief Removes and returns the node with the lowest key.
+    ShortestPathNode *Pop();
+
+    // \brief Restores the heap order after the distAndEst of a node in the heap has changed.
+    void UpdateKey(ShortestPathNode *node);
+
+  private:
+    struct Entry
+    {
+      DistanceType key;
+      unsigned long long order;
+      ShortestPathNode *node;
+
+      bool operator<(const Entry &other) const
+      {
+        return key < other.key || (key == other.key && order < other.order);
+      }
+    };
+
+    void Place(std::size_t position, const Entry &entry);
+    void SiftUp(std::size_t position);
+    void SiftDown(std::size_t position);
+
+    std::vector<Entry> m_Entries;
+    unsigned long long m_NextOrder = 0;
   };
 
   // bool operator<(const ShortestPathNode &a) const;
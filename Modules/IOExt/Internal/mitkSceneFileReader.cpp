@@ -61,6 +61,12 @@ namespace mitk
     return result;
   }
 
+  bool SceneFileReader::RequiresTargetDataStorage() const
+  {
+    // the scene is added to the nodes of the storage (e.g. as derivations of them)
+    return true;
+  }
+
   std::vector<BaseData::Pointer> SceneFileReader::DoRead()
   {
     std::vector<BaseData::Pointer> result;
@@ -26,6 +26,8 @@ namespace mitk
     using AbstractFileReader::Read;
     DataStorage::SetOfObjects::Pointer Read(DataStorage &ds) override;
 
+    bool RequiresTargetDataStorage() const override;
+
   protected:
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
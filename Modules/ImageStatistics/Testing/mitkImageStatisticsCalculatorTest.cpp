@@ -20,6 +20,14 @@ found in the LICENSE file.
 #include <mitkPlanarFigureMaskGenerator.h>
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelWriteAccessor.h>
+
+#include <itkImageRegionConstIterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 /**
  * \brief Test class for mitkImageStatisticsCalculator
@@ -47,12 +55,16 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestPic3DCroppedNoMask);
   MITK_TEST(TestPic3DCroppedBinMask);
   MITK_TEST(TestPic3DCroppedMultilabelMask);
+  MITK_TEST(TestPic3DCroppedMultilabelMaskSliceWise);
+  MITK_TEST(TestPic3DCroppedModifiedMask);
+  MITK_TEST(TestPic3DCroppedMaskBackground);
   MITK_TEST(TestPic3DCroppedPlanarFigure);
   MITK_TEST(TestUS4DCroppedNoMaskTimeStep1);
   MITK_TEST(TestUS4DCroppedBinMaskTimeStep1);
   MITK_TEST(TestUS4DCroppedMultilabelMaskTimeStep1);
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
+  MITK_TEST(TestUS4DCroppedSingleTimeStepOnDemand);
   MITK_TEST(TestUS4DCropped3DMask);
   CPPUNIT_TEST_SUITE_END();
 
@@ -76,6 +88,9 @@ public:
   void TestPic3DCroppedNoMask();
   void TestPic3DCroppedBinMask();
   void TestPic3DCroppedMultilabelMask();
+  void TestPic3DCroppedMultilabelMaskSliceWise();
+  void TestPic3DCroppedModifiedMask();
+  void TestPic3DCroppedMaskBackground();
   void TestPic3DCroppedPlanarFigure();
 
   void TestUS4DCroppedNoMaskTimeStep1();
@@ -83,6 +98,7 @@ public:
   void TestUS4DCroppedMultilabelMaskTimeStep1();
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
+  void TestUS4DCroppedSingleTimeStepOnDemand();
   void TestUS4DCropped3DMask();
 private:
   mitk::Image::ConstPointer m_TestImage;
@@ -112,6 +128,9 @@ private:
   void VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
     mitk::ImageStatisticsContainer::RealType testMean, mitk::ImageStatisticsContainer::RealType testSD, mitk::ImageStatisticsContainer::RealType testMedian = 0);
 
+  // compares the statistics of two containers for all labels and time step 0
+  void VerifyEqualStatistics(const mitk::ImageStatisticsContainer* expected, const mitk::ImageStatisticsContainer* actual);
+
   // T26098 histogram statistics need to be tested (median, uniformity, UPP, entropy)
   void VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
     mitk::ImageStatisticsContainer::VoxelCountType N,
@@ -672,6 +691,207 @@ void mitkImageStatisticsCalculatorTestSuite::TestPic3DCroppedMultilabelMask()
     expected_maxIndex);
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestPic3DCroppedMultilabelMaskSliceWise()
+{
+  MITK_INFO << std::endl << "Test Pic3D cropped multilabel mask slice-wise:-----------------------------------------------------------------------------------";
+
+  std::string Pic3DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_cropped.nrrd");
+  m_Pic3DCroppedImage = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D_cropped", m_Pic3DCroppedImage.IsNotNull());
+
+  std::string Pic3DCroppedMultilabelMaskFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_croppedMultilabelMask.nrrd");
+  m_Pic3DCroppedMultilabelMask = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedMultilabelMaskFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D multilabel mask", m_Pic3DCroppedMultilabelMask.IsNotNull());
+
+  // work on an editable copy of the mask
+  typedef itk::Image<unsigned short, 3> MaskType;
+  MaskType::Pointer itkMask;
+  mitk::CastToItkImage(m_Pic3DCroppedMultilabelMask, itkMask);
+  mitk::Image::Pointer mask;
+  mitk::CastToMitkImage(itkMask, mask);
+
+  // draws the label over the complete slice, like a brush stroke of a segmentation tool
+  auto writeSlice = [&mask](itk::IndexValueType slice, unsigned short label) {
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> writeAccess(mask);
+    itk::Index<3> index;
+    index[2] = slice;
+    for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(mask->GetDimension(1)); ++index[1])
+    {
+      for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(mask->GetDimension(0)); ++index[0])
+      {
+        writeAccess.SetPixelByIndex(index, label);
+      }
+    }
+  };
+
+  mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+  imgMaskGen->SetImageMask(mask);
+  imgMaskGen->SetInputImage(m_Pic3DCroppedImage);
+  imgMaskGen->SetTimeStep(0);
+
+  mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+  imgStatCalc->SetInputImage(m_Pic3DCroppedImage);
+  imgStatCalc->SetMask(imgMaskGen.GetPointer());
+  imgStatCalc->SetUseSliceWiseMaskedStatistics(true);
+
+  mitk::ImageStatisticsContainer::Pointer statisticsContainer;
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(2));
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer(), nullptr, 2), statisticsContainer);
+  const auto statisticsBeforeWrite = statisticsContainer->GetStatisticsForTimeStep(0);
+
+  // edit one slice and report it, only this slice is scanned again
+  auto mTimeBeforeWrite = mask->GetMTime();
+  writeSlice(1, 2);
+  mask->Modified();
+  imgStatCalc->SetMaskSlicesModified(0, 1, 1, mTimeBeforeWrite);
+
+  mitk::ImageStatisticsContainer::Pointer updatedStatisticsContainer;
+  CPPUNIT_ASSERT_NO_THROW(updatedStatisticsContainer = imgStatCalc->GetStatistics(2));
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer(), nullptr, 2), updatedStatisticsContainer);
+
+  CPPUNIT_ASSERT_MESSAGE("The edited slice did not change the statistics of label 2",
+    statisticsBeforeWrite.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()) <
+    updatedStatisticsContainer->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+  CPPUNIT_ASSERT_MESSAGE("A container handed out before the edit was changed",
+    statisticsBeforeWrite.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()) ==
+    statisticsContainer->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+  // an edit that is not reported makes the next report useless, the whole mask has to be scanned again
+  writeSlice(0, 1);
+  mask->Modified();
+  mTimeBeforeWrite = mask->GetMTime();
+  writeSlice(2, 2);
+  mask->Modified();
+  imgStatCalc->SetMaskSlicesModified(0, 2, 2, mTimeBeforeWrite);
+
+  CPPUNIT_ASSERT_NO_THROW(updatedStatisticsContainer = imgStatCalc->GetStatistics(2));
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer(), nullptr, 2), updatedStatisticsContainer);
+  CPPUNIT_ASSERT_NO_THROW(updatedStatisticsContainer = imgStatCalc->GetStatistics(1));
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer(), nullptr, 1), updatedStatisticsContainer);
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestPic3DCroppedModifiedMask()
+{
+  MITK_INFO << std::endl << "Test Pic3D cropped modified mask:-----------------------------------------------------------------------------------";
+
+  std::string Pic3DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_cropped.nrrd");
+  m_Pic3DCroppedImage = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D_cropped", m_Pic3DCroppedImage.IsNotNull());
+
+  std::string Pic3DCroppedMultilabelMaskFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_croppedMultilabelMask.nrrd");
+  m_Pic3DCroppedMultilabelMask = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedMultilabelMaskFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D multilabel mask", m_Pic3DCroppedMultilabelMask.IsNotNull());
+
+  typedef itk::Image<unsigned short, 3> MaskType;
+  MaskType::Pointer itkMask;
+  mitk::CastToItkImage(m_Pic3DCroppedMultilabelMask, itkMask);
+  mitk::Image::Pointer mask;
+  mitk::CastToMitkImage(itkMask, mask);
+
+  mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+  imgMaskGen->SetImageMask(mask);
+  imgMaskGen->SetInputImage(m_Pic3DCroppedImage);
+  imgMaskGen->SetTimeStep(0);
+
+  // the calculator is kept, as the statistics jobs of the GUI do
+  mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+  imgStatCalc->SetInputImage(m_Pic3DCroppedImage);
+  imgStatCalc->SetMask(imgMaskGen.GetPointer());
+
+  mitk::ImageStatisticsContainer::Pointer statisticsContainer;
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(2));
+  const auto numberOfVoxels = statisticsContainer->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS());
+
+  // changing the pixels of the mask image is noticed without touching the mask generator
+  {
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> writeAccess(mask);
+    itk::Index<3> index;
+    index[2] = 1;
+    for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(mask->GetDimension(1)); ++index[1])
+    {
+      for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(mask->GetDimension(0)); ++index[0])
+      {
+        writeAccess.SetPixelByIndex(index, 2);
+      }
+    }
+  }
+  mask->Modified();
+
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(2));
+  CPPUNIT_ASSERT(numberOfVoxels != statisticsContainer->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer(), nullptr, 2), statisticsContainer);
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestPic3DCroppedMaskBackground()
+{
+  MITK_INFO << std::endl << "Test Pic3D cropped mask background:-----------------------------------------------------------------------------------";
+
+  std::string Pic3DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_cropped.nrrd");
+  m_Pic3DCroppedImage = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D_cropped", m_Pic3DCroppedImage.IsNotNull());
+
+  std::string Pic3DCroppedMultilabelMaskFile = this->GetTestDataFilePath("ImageStatisticsTestData/Pic3D_croppedMultilabelMask.nrrd");
+  m_Pic3DCroppedMultilabelMask = mitk::IOUtil::Load<mitk::Image>(Pic3DCroppedMultilabelMaskFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading Pic3D multilabel mask", m_Pic3DCroppedMultilabelMask.IsNotNull());
+
+  // a single foreground voxel, so the foreground statistics are computed on a cropped region
+  typedef itk::Image<unsigned short, 3> MaskType;
+  MaskType::Pointer itkMask;
+  mitk::CastToItkImage(m_Pic3DCroppedMultilabelMask, itkMask);
+  itkMask->FillBuffer(0);
+  MaskType::IndexType foregroundIndex;
+  foregroundIndex.Fill(0);
+  itkMask->SetPixel(foregroundIndex, 1);
+  mitk::Image::Pointer mask;
+  mitk::CastToMitkImage(itkMask, mask);
+
+  mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+  imgMaskGen->SetImageMask(mask);
+  imgMaskGen->SetInputImage(m_Pic3DCroppedImage);
+  imgMaskGen->SetTimeStep(0);
+
+  mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+  imgStatCalc->SetInputImage(m_Pic3DCroppedImage);
+  imgStatCalc->SetMask(imgMaskGen.GetPointer());
+
+  mitk::ImageStatisticsContainer::Pointer statisticsContainer;
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(1));
+  CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(1), statisticsContainer->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+  // the background label refers to the whole image, although the time step was computed for the foreground before
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(0));
+  auto statisticsObject = statisticsContainer->GetStatisticsForTimeStep(0);
+
+  typedef itk::Image<double, 3> ReferenceImageType;
+  ReferenceImageType::Pointer referenceImage;
+  mitk::CastToItkImage(m_Pic3DCroppedImage, referenceImage);
+
+  mitk::ImageStatisticsContainer::VoxelCountType expected_N = 0;
+  double sum = 0.0;
+  double expected_min = std::numeric_limits<double>::max();
+  double expected_max = std::numeric_limits<double>::lowest();
+  itk::ImageRegionConstIterator<ReferenceImageType> imageIt(referenceImage, referenceImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<MaskType> maskIt(itkMask, itkMask->GetLargestPossibleRegion());
+  for (; !imageIt.IsAtEnd(); ++imageIt, ++maskIt)
+  {
+    if (0 == maskIt.Get())
+    {
+      ++expected_N;
+      sum += imageIt.Get();
+      expected_min = std::min(expected_min, imageIt.Get());
+      expected_max = std::max(expected_max, imageIt.Get());
+    }
+  }
+
+  CPPUNIT_ASSERT_EQUAL(expected_N, statisticsObject.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(sum / expected_N, statisticsObject.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEAN()), 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expected_min, statisticsObject.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MINIMUM()), mitk::eps);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expected_max, statisticsObject.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MAXIMUM()), mitk::eps);
+
+  // the foreground statistics are not affected by the recomputation
+  VerifyEqualStatistics(ComputeStatistics(m_Pic3DCroppedImage, imgMaskGen.GetPointer()), imgStatCalc->GetStatistics(1));
+}
+
 // T26098 histogram statistics need to be tested (median, uniformity, UPP, entropy)
 void mitkImageStatisticsCalculatorTestSuite::TestPic3DCroppedPlanarFigure()
 {
@@ -969,6 +1189,51 @@ void mitkImageStatisticsCalculatorTestSuite::TestUS4DCroppedAllTimesteps()
   }
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestUS4DCroppedSingleTimeStepOnDemand()
+{
+  MITK_INFO << std::endl << "Test US4D cropped single timestep on demand:-----------------------------------------------------------------------------------";
+
+  std::string US4DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/US4D_cropped.nrrd");
+  m_US4DCroppedImage = mitk::IOUtil::Load<mitk::Image>(US4DCroppedFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading US4D_cropped", m_US4DCroppedImage.IsNotNull());
+
+  mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+  imgStatCalc->SetInputImage(m_US4DCroppedImage);
+
+  mitk::ImageStatisticsContainer::Pointer statisticsContainer;
+  CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(1, 1));
+  CPPUNIT_ASSERT_MESSAGE("Requested timestep was not computed", statisticsContainer->TimeStepExists(1));
+  CPPUNIT_ASSERT_MESSAGE("Other timestep was computed although not requested", !statisticsContainer->TimeStepExists(0));
+  CPPUNIT_ASSERT_THROW(imgStatCalc->GetStatistics(1, 4), mitk::Exception);
+
+  const auto singleTimeStepStatistics = statisticsContainer->GetStatisticsForTimeStep(1);
+  auto allTimeStepsContainer = imgStatCalc->GetStatistics();
+  for (int i = 0; i < 4; i++)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Error computing statistics for remaining timesteps", allTimeStepsContainer->TimeStepExists(i));
+  }
+
+  // same results as for the complete computation (see TestUS4DCroppedNoMaskTimeStep1)
+  mitk::ImageStatisticsContainer::IndexType expected_minIndex;
+  expected_minIndex.set_size(3);
+  expected_minIndex[0] = 0;
+  expected_minIndex[1] = 2;
+  expected_minIndex[2] = 0;
+
+  mitk::ImageStatisticsContainer::IndexType expected_maxIndex;
+  expected_maxIndex.set_size(3);
+  expected_maxIndex[0] = 0;
+  expected_maxIndex[1] = 0;
+  expected_maxIndex[2] = 1;
+
+  VerifyStatistics(singleTimeStepStatistics, 27, 157.74074074074073, 157.74074074074073, 0.0347280313508018,
+    1.5398359155908228, 1076.0455840455834, 32.803133753432512, 101, 199, 161.11544579426010,
+    expected_minIndex, expected_maxIndex);
+  VerifyStatistics(allTimeStepsContainer->GetStatisticsForTimeStep(1), 27, 157.74074074074073, 157.74074074074073,
+    0.0347280313508018, 1.5398359155908228, 1076.0455840455834, 32.803133753432512, 101, 199, 161.11544579426010,
+    expected_minIndex, expected_maxIndex);
+}
+
 void mitkImageStatisticsCalculatorTestSuite::TestUS4DCropped3DMask()
 {
   MITK_INFO << std::endl << "Test US4D cropped with 3D binary Mask:-----------------------------------------------------------------------------------";
@@ -1138,4 +1403,37 @@ void mitkImageStatisticsCalculatorTestSuite::VerifyStatistics(mitk::ImageStatist
     CPPUNIT_ASSERT_MESSAGE("Calculated value does not fit expected value", std::abs(maxIndexObject[i] - maxIndex[i]) < mitk::eps);
   }
 }
+void mitkImageStatisticsCalculatorTestSuite::VerifyEqualStatistics(const mitk::ImageStatisticsContainer* expected, const mitk::ImageStatisticsContainer* actual)
+{
+  CPPUNIT_ASSERT(expected->TimeStepExists(0));
+  CPPUNIT_ASSERT(actual->TimeStepExists(0));
+
+  const auto expectedStatistics = expected->GetStatisticsForTimeStep(0);
+  const auto actualStatistics = actual->GetStatisticsForTimeStep(0);
+
+  CPPUNIT_ASSERT_EQUAL(expectedStatistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()),
+    actualStatistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+  for (const auto& name : { mitk::ImageStatisticsConstants::MEAN(), mitk::ImageStatisticsConstants::MINIMUM(),
+    mitk::ImageStatisticsConstants::MAXIMUM(), mitk::ImageStatisticsConstants::STANDARDDEVIATION(),
+    mitk::ImageStatisticsConstants::VARIANCE(), mitk::ImageStatisticsConstants::SKEWNESS(),
+    mitk::ImageStatisticsConstants::KURTOSIS(), mitk::ImageStatisticsConstants::RMS(),
+    mitk::ImageStatisticsConstants::MPP(), mitk::ImageStatisticsConstants::VOLUME(),
+    mitk::ImageStatisticsConstants::MEDIAN(), mitk::ImageStatisticsConstants::ENTROPY(),
+    mitk::ImageStatisticsConstants::UNIFORMITY(), mitk::ImageStatisticsConstants::UPP() })
+  {
+    const auto expectedValue = expectedStatistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(name);
+    const auto actualValue = actualStatistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(name);
+
+    if (std::isnan(expectedValue))
+    {
+      CPPUNIT_ASSERT_MESSAGE(name + " differs", std::isnan(actualValue));
+    }
+    else
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(name + " differs", expectedValue, actualValue, 1e-6 * std::max(1.0, std::abs(expectedValue)));
+    }
+  }
+}
+
 MITK_TEST_SUITE_REGISTRATION(mitkImageStatisticsCalculator)
@@ -448,8 +448,10 @@ struct mitkImageStatisticsHotspotTestClass
     \brief Calculates hotspot statistics for given test image and ROI parameters.
 
     Uses ImageStatisticsCalculator to find a hotspot in a defined ROI within the given image.
+    The hotspot is searched with the given search engine of HotspotMaskGenerator.
   */
-  static mitk::ImageStatisticsContainer::ImageStatisticsObject CalculateStatistics(mitk::Image* image, const Parameters& testParameters,  unsigned int label)
+  static mitk::ImageStatisticsContainer::ImageStatisticsObject CalculateStatistics(mitk::Image* image, const Parameters& testParameters,  unsigned int label,
+                                                                                   mitk::HotspotMaskGenerator::SearchEngine searchEngine)
   {
     const unsigned int Dimension = 3;
     typedef itk::Image<unsigned short, Dimension> MaskImageType;
@@ -519,6 +521,7 @@ struct mitkImageStatisticsHotspotTestClass
       hotspotMaskGen->SetLabel(testParameters.m_Label[label]);
       hotspotMaskGen->SetMask(imgMaskGen.GetPointer());
       hotspotMaskGen->SetHotspotRadiusInMM(testParameters.m_HotspotRadiusInMM);
+      hotspotMaskGen->SetSearchEngine(searchEngine);
       if(testParameters.m_EntireHotspotInImage == 1)
       {
         MITK_INFO << "Hotspot must be completly inside image";
@@ -538,6 +541,7 @@ struct mitkImageStatisticsHotspotTestClass
       mitk::HotspotMaskGenerator::Pointer hotspotMaskGen = mitk::HotspotMaskGenerator::New();
       hotspotMaskGen->SetInputImage(image);
       hotspotMaskGen->SetHotspotRadiusInMM(testParameters.m_HotspotRadiusInMM);
+      hotspotMaskGen->SetSearchEngine(searchEngine);
       if(testParameters.m_EntireHotspotInImage == 1)
       {
         MITK_INFO << "Hotspot must be completly inside image";
@@ -627,9 +631,14 @@ int mitkImageStatisticsHotspotTest(int argc, char* argv[])
 
       for(unsigned int label = 0; label < parameters.m_NumberOfLabels; ++label)
       {
-        mitk::ImageStatisticsContainer::ImageStatisticsObject statistics = mitkImageStatisticsHotspotTestClass::CalculateStatistics(image, parameters, label);
+        // both search engines have to find the reference hotspot
+        for (auto searchEngine : { mitk::HotspotMaskGenerator::SearchEngine::FFTConvolution, mitk::HotspotMaskGenerator::SearchEngine::SphereRuns })
+        {
+          mitk::ImageStatisticsContainer::ImageStatisticsObject statistics = mitkImageStatisticsHotspotTestClass::CalculateStatistics(image, parameters, label,
+            searchEngine);
 
-        mitkImageStatisticsHotspotTestClass::ValidateStatistics(statistics, parameters, label);
+          mitkImageStatisticsHotspotTestClass::ValidateStatistics(statistics, parameters, label);
+        }
         std::cout << std::endl;
       }
 
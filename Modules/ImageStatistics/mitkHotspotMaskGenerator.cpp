@@ -13,18 +13,25 @@ found in the LICENSE file.
 #include <mitkHotspotMaskGenerator.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageCast.h>
+#include <mitkMaskUtilities.h>
 #include <mitkPoint.h>
 #include <itkImageRegionIterator.h>
 #include "mitkImageAccessByItk.h"
 #include <itkImageDuplicator.h>
 #include <itkFFTConvolutionImageFilter.h>
 #include <mitkITKImageImport.h>
+#include <itkImageScanlineConstIterator.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace mitk
 {
     HotspotMaskGenerator::HotspotMaskGenerator():
         m_HotspotRadiusinMM(6.2035049089940),   // radius of a 1cm3 sphere in mm
         m_HotspotMustBeCompletelyInsideImage(true),
+        m_SearchEngine(SearchEngine::FFTConvolution),
         m_Label(1)
     {
         m_TimeStep = 0;
@@ -84,6 +91,20 @@ namespace mitk
         }
     }
 
+    HotspotMaskGenerator::SearchEngine HotspotMaskGenerator::GetSearchEngine() const
+    {
+        return m_SearchEngine;
+    }
+
+    void HotspotMaskGenerator::SetSearchEngine(SearchEngine engine)
+    {
+        if (m_SearchEngine != engine)
+        {
+            m_SearchEngine = engine;
+            this->Modified();
+        }
+    }
+
 
     mitk::Image::ConstPointer HotspotMaskGenerator::GetMask()
     {
@@ -185,26 +206,14 @@ namespace mitk
         return m_ConvolutionImageMaxIndex;
     }
 
-    template <typename TPixel, unsigned int VImageDimension  >
-    HotspotMaskGenerator::ImageExtrema
-      HotspotMaskGenerator::CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
-                                                    const itk::Image<unsigned short, VImageDimension>* maskImage,
-                                                    double neccessaryDistanceToImageBorderInMM,
-                                                    unsigned int label )
+    template <typename TPixel, unsigned int VImageDimension>
+    typename itk::Image<TPixel, VImageDimension>::RegionType
+      HotspotMaskGenerator::CalculateHotspotSearchRegion( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                          double neccessaryDistanceToImageBorderInMM )
     {
       typedef itk::Image< TPixel, VImageDimension > ImageType;
-      typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
-
-      typedef itk::ImageRegionConstIteratorWithIndex<MaskImageType> MaskImageIteratorType;
-      typedef itk::ImageRegionConstIteratorWithIndex<ImageType> InputImageIndexIteratorType;
 
       typename ImageType::SpacingType spacing = inputImage->GetSpacing();
-
-      ImageExtrema minMax;
-      minMax.Defined = false;
-      minMax.MaxIndex.set_size(VImageDimension);
-      minMax.MaxIndex.set_size(VImageDimension);
-
       typename ImageType::RegionType allowedExtremaRegion = inputImage->GetLargestPossibleRegion();
 
       bool keepDistanceToImageBorders( neccessaryDistanceToImageBorderInMM > 0 );
@@ -223,6 +232,27 @@ namespace mitk
         allowedExtremaRegion.ShrinkByRadius(distanceInPixels);
       }
 
+      return allowedExtremaRegion;
+    }
+
+    template <typename TPixel, unsigned int VImageDimension  >
+    HotspotMaskGenerator::ImageExtrema
+      HotspotMaskGenerator::CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                    const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                                    const typename itk::Image<TPixel, VImageDimension>::RegionType& allowedExtremaRegion,
+                                                    unsigned int label )
+    {
+      typedef itk::Image< TPixel, VImageDimension > ImageType;
+      typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
+
+      typedef itk::ImageRegionConstIteratorWithIndex<MaskImageType> MaskImageIteratorType;
+      typedef itk::ImageRegionConstIteratorWithIndex<ImageType> InputImageIndexIteratorType;
+
+      ImageExtrema minMax;
+      minMax.Defined = false;
+      minMax.MaxIndex.set_size(VImageDimension);
+      minMax.MaxIndex.set_size(VImageDimension);
+
       InputImageIndexIteratorType imageIndexIt(inputImage, allowedExtremaRegion);
 
       float maxValue = itk::NumericTraits<float>::min();
@@ -243,9 +273,20 @@ namespace mitk
         typename ImageType::IndexType imageIndex;
         typename ImageType::IndexType maskIndex;
 
+        // the mask may only cover a part of the image (e.g. masks of planar figures),
+        // its origin is mapped like in the statistics calculation
+        auto maskUtil = MaskUtilities<TPixel, VImageDimension>::New();
+        maskUtil->SetImage(inputImage);
+        maskUtil->SetMask(maskImage);
+        const auto maskOriginIndex = maskUtil->ComputeMaskOriginIndex();
+
         for(maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt)
         {
-          imageIndex = maskIndex = maskIt.GetIndex();
+          maskIndex = maskIt.GetIndex();
+          for (unsigned int i = 0; i < VImageDimension; ++i)
+          {
+            imageIndex[i] = maskIndex[i] + maskOriginIndex[i];
+          }
 
           if(maskIt.Get() == label)
           {
@@ -476,6 +517,232 @@ namespace mitk
       return convolutionImage;
     }
 
+    template <typename TPixel, unsigned int VImageDimension>
+    itk::SmartPointer<itk::Image<TPixel, VImageDimension> >
+      HotspotMaskGenerator::GenerateConvolutionImageOfMaskRegion( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                                  const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                                                  unsigned int label,
+                                                                  typename itk::Image<TPixel, VImageDimension>::RegionType& searchRegion )
+    {
+      typedef itk::Image< TPixel, VImageDimension > InputImageType;
+      typedef itk::Image< TPixel, VImageDimension > ConvolutionImageType;
+      typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
+      typedef itk::Image< float, VImageDimension > KernelImageType;
+      typedef typename InputImageType::RegionType RegionType;
+      typedef typename InputImageType::IndexType IndexType;
+      typedef typename InputImageType::OffsetType OffsetType;
+
+      // restrict the search region to the bounding box of the label (in image indices)
+      auto maskUtil = MaskUtilities<TPixel, VImageDimension>::New();
+      maskUtil->SetImage(inputImage);
+      maskUtil->SetMask(maskImage);
+      const IndexType maskOriginIndex = maskUtil->ComputeMaskOriginIndex();
+      OffsetType maskOffset;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+      {
+        maskOffset[d] = maskOriginIndex[d];
+      }
+
+      IndexType labelMinIndex;
+      IndexType labelMaxIndex;
+      bool labelFound = false;
+
+      itk::ImageScanlineConstIterator<MaskImageType> maskIt(maskImage, maskImage->GetLargestPossibleRegion());
+      while (!maskIt.IsAtEnd())
+      {
+        while (!maskIt.IsAtEndOfLine())
+        {
+          if (maskIt.Get() == label)
+          {
+            const IndexType imageIndex = maskIt.GetIndex() + maskOffset;
+            for (unsigned int d = 0; d < VImageDimension; ++d)
+            {
+              labelMinIndex[d] = labelFound ? std::min(labelMinIndex[d], imageIndex[d]) : imageIndex[d];
+              labelMaxIndex[d] = labelFound ? std::max(labelMaxIndex[d], imageIndex[d]) : imageIndex[d];
+            }
+            labelFound = true;
+          }
+          ++maskIt;
+        }
+        maskIt.NextLine();
+      }
+
+      RegionType labelRegion;
+      if (labelFound)
+      {
+        labelRegion.SetIndex(labelMinIndex);
+        labelRegion.SetUpperIndex(labelMaxIndex);
+      }
+
+      if (!labelFound || !labelRegion.Crop(searchRegion))
+      {
+        searchRegion.SetSize(typename RegionType::SizeType());
+        return nullptr;
+      }
+      searchRegion = labelRegion;
+
+      // decompose the kernel into runs of equal weight along the first axis
+      double mmPerPixel[VImageDimension];
+      for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
+      {
+        mmPerPixel[dimension] = inputImage->GetSpacing()[dimension];
+      }
+
+      typename KernelImageType::Pointer convolutionKernel = this->GenerateHotspotSearchConvolutionKernel<VImageDimension>(mmPerPixel, m_HotspotRadiusinMM);
+      const typename KernelImageType::SizeType kernelSize = convolutionKernel->GetLargestPossibleRegion().GetSize();
+
+      typename RegionType::SizeType kernelRadius;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+      {
+        kernelRadius[d] = (kernelSize[d] - 1) / 2;
+      }
+
+      struct KernelRun
+      {
+        OffsetType start;
+        itk::OffsetValueType length;
+        double weight;
+      };
+      std::vector<KernelRun> kernelRuns;
+      double kernelSum = 0.0;
+
+      itk::ImageScanlineConstIterator<KernelImageType> kernelIt(convolutionKernel, convolutionKernel->GetLargestPossibleRegion());
+      while (!kernelIt.IsAtEnd())
+      {
+        bool runIsOpen = false;
+        while (!kernelIt.IsAtEndOfLine())
+        {
+          const double weight = kernelIt.Get();
+          if (weight != 0.0)
+          {
+            kernelSum += weight;
+            if (runIsOpen && kernelRuns.back().weight == weight)
+            {
+              ++kernelRuns.back().length;
+            }
+            else
+            {
+              KernelRun run;
+              for (unsigned int d = 0; d < VImageDimension; ++d)
+              {
+                run.start[d] = kernelIt.GetIndex()[d] - static_cast<itk::OffsetValueType>(kernelRadius[d]);
+              }
+              run.length = 1;
+              run.weight = weight;
+              kernelRuns.push_back(run);
+            }
+          }
+          runIsOpen = weight != 0.0;
+          ++kernelIt;
+        }
+        kernelIt.NextLine();
+      }
+
+      // row-wise prefix sums of all input pixels the kernel can reach from the search region
+      RegionType inputRegion = searchRegion;
+      inputRegion.PadByRadius(kernelRadius);
+      inputRegion.Crop(inputImage->GetLargestPossibleRegion());
+
+      const IndexType inputLowerIndex = inputRegion.GetIndex();
+      const IndexType inputUpperIndex = inputRegion.GetUpperIndex();
+      const std::size_t rowLength = inputRegion.GetSize(0);
+      const std::size_t numberOfRows = inputRegion.GetNumberOfPixels() / rowLength;
+
+      std::size_t rowStrides[VImageDimension];
+      rowStrides[0] = 0;
+      for (unsigned int d = 1; d < VImageDimension; ++d)
+      {
+        rowStrides[d] = 1 == d ? 1 : rowStrides[d - 1] * inputRegion.GetSize(d - 1);
+      }
+
+      std::vector<double> rowPrefixSums(numberOfRows * (rowLength + 1));
+      itk::ImageScanlineConstIterator<InputImageType> inputIt(inputImage, inputRegion);
+      for (double* prefixSum = rowPrefixSums.data(); !inputIt.IsAtEnd(); inputIt.NextLine())
+      {
+        *prefixSum = 0.0;
+        while (!inputIt.IsAtEndOfLine())
+        {
+          prefixSum[1] = prefixSum[0] + static_cast<double>(inputIt.Get());
+          ++prefixSum;
+          ++inputIt;
+        }
+        ++prefixSum;
+      }
+
+      typename ConvolutionImageType::Pointer convolutionImage = ConvolutionImageType::New();
+      convolutionImage->SetRegions(searchRegion);
+      convolutionImage->SetOrigin(inputImage->GetOrigin());
+      convolutionImage->SetSpacing(inputImage->GetSpacing());
+      convolutionImage->SetDirection(inputImage->GetDirection());
+      convolutionImage->Allocate();
+      convolutionImage->FillBuffer(0);
+
+      // Pixels outside the image are handled like in GenerateConvolutionImage(): if the hotspot has to be inside
+      // the image, the kernel never leaves it; otherwise the nearest image pixel is used (zero flux Neumann).
+      auto clamp = [&inputLowerIndex, &inputUpperIndex](itk::IndexValueType index, unsigned int d)
+      {
+        return std::max(inputLowerIndex[d], std::min(inputUpperIndex[d], index));
+      };
+
+      const auto maskRegion = maskImage->GetLargestPossibleRegion();
+
+      itk::MultiThreaderBase::New()->ParallelizeImageRegion<VImageDimension>(
+        searchRegion,
+        [&](const RegionType& region)
+        {
+          itk::ImageRegionIteratorWithIndex<ConvolutionImageType> convolutionIt(convolutionImage, region);
+          for (; !convolutionIt.IsAtEnd(); ++convolutionIt)
+          {
+            const IndexType center = convolutionIt.GetIndex();
+            const IndexType maskIndex = center - maskOffset;
+            if (!maskRegion.IsInside(maskIndex) || maskImage->GetPixel(maskIndex) != label)
+            {
+              continue;
+            }
+
+            double sum = 0.0;
+            for (const auto& run : kernelRuns)
+            {
+              std::size_t row = 0;
+              for (unsigned int d = 1; d < VImageDimension; ++d)
+              {
+                row += (clamp(center[d] + run.start[d], d) - inputLowerIndex[d]) * rowStrides[d];
+              }
+              const double* prefixSum = rowPrefixSums.data() + row * (rowLength + 1);
+
+              // the part of the run inside the image is summed up by the prefix sums, pixels left or right of
+              // the image are clamped to the first or last pixel of the row
+              const itk::IndexValueType first = center[0] + run.start[0] - inputLowerIndex[0];
+              const itk::IndexValueType last = first + run.length - 1;
+              const itk::IndexValueType upper = static_cast<itk::IndexValueType>(rowLength) - 1;
+              const itk::IndexValueType insideFirst = std::max<itk::IndexValueType>(first, 0);
+              const itk::IndexValueType insideLast = std::min(last, upper);
+
+              double runSum = 0.0;
+              if (insideFirst <= insideLast)
+              {
+                runSum = prefixSum[insideLast + 1] - prefixSum[insideFirst];
+              }
+              if (first < 0)
+              {
+                runSum += (std::min<itk::IndexValueType>(last, -1) - first + 1) * prefixSum[1];
+              }
+              if (last > upper)
+              {
+                runSum += (last - std::max(first, upper + 1) + 1) * (prefixSum[upper + 1] - prefixSum[upper]);
+              }
+
+              sum += run.weight * runSum;
+            }
+
+            convolutionIt.Set(static_cast<TPixel>(sum / kernelSum));
+          }
+        },
+        nullptr);
+
+      return convolutionImage;
+    }
+
     template < typename TPixel, unsigned int VImageDimension>
     void
       HotspotMaskGenerator::FillHotspotMaskPixels( itk::Image<TPixel, VImageDimension>* maskImage,
@@ -509,14 +776,6 @@ namespace mitk
         typedef itk::Image< TPixel, VImageDimension > ConvolutionImageType;
         typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
 
-        typename ConvolutionImageType::Pointer convolutionImage = this->GenerateConvolutionImage(inputImage);
-
-        if (convolutionImage.IsNull())
-        {
-          MITK_ERROR << "Empty convolution image in CalculateHotspotStatistics(). We should never reach this state (logic error).";
-          throw std::logic_error("Empty convolution image in CalculateHotspotStatistics()");
-        }
-
         typename MaskImageType::ConstPointer usedMask = maskImage;
         // if mask image is not defined, create an image of the same size as inputImage and fill it with 1's
         // there is maybe a better way to do this!?
@@ -539,9 +798,32 @@ namespace mitk
             label = 1;
         }
 
-        // find maximum in convolution image, given the current mask
         double requiredDistanceToBorder = m_HotspotMustBeCompletelyInsideImage ? m_HotspotRadiusinMM : -1.0;
-        ImageExtrema convolutionImageInformation = CalculateExtremaWorld(convolutionImage.GetPointer(), usedMask.GetPointer(), requiredDistanceToBorder, label);
+        typename InputImageType::RegionType searchRegion = this->CalculateHotspotSearchRegion(inputImage, requiredDistanceToBorder);
+
+        typename ConvolutionImageType::Pointer convolutionImage;
+        if (SearchEngine::SphereRuns == m_SearchEngine)
+        {
+          // the convolution image only covers the pixels of the label, it is empty if there are none
+          convolutionImage = this->GenerateConvolutionImageOfMaskRegion(inputImage, usedMask.GetPointer(), label, searchRegion);
+        }
+        else
+        {
+          convolutionImage = this->GenerateConvolutionImage(inputImage);
+
+          if (convolutionImage.IsNull())
+          {
+            MITK_ERROR << "Empty convolution image in CalculateHotspotStatistics(). We should never reach this state (logic error).";
+            throw std::logic_error("Empty convolution image in CalculateHotspotStatistics()");
+          }
+        }
+
+        // find maximum in convolution image, given the current mask
+        ImageExtrema convolutionImageInformation;
+        if (convolutionImage.IsNotNull())
+        {
+          convolutionImageInformation = CalculateExtremaWorld(convolutionImage.GetPointer(), usedMask.GetPointer(), searchRegion, label);
+        }
 
         bool isHotspotDefined = convolutionImageInformation.Defined;
 
@@ -33,6 +33,18 @@ namespace mitk
      * The maximum value of the convolved image then corresponds to the hotspot.
      * If a maskGenerator is set, only the pixels of the convolved image where the corresponding mask is == @a label
      * are searched for the maximum value.
+     *
+     * Alternatively to the fourier domain convolution (SearchEngine::FFTConvolution, default), the sphere mean can be
+     * evaluated directly for the candidate pixels only (SearchEngine::SphereRuns): The kernel is decomposed into runs
+     * of equal weight along the first axis, which are summed up with row-wise prefix sums of the input image. Only the
+     * bounding box of @a label, enlarged by the kernel radius, is processed, so no padded copies of the whole image
+     * are needed. Both engines use the same kernel and boundary handling and therefore yield the same hotspot up to
+     * rounding errors.
+     *
+     * FFTConvolution stays the default, because its run time does not depend on the radius, it is faster if large
+     * regions are searched with large radii, and it reproduces the results of earlier versions exactly. SphereRuns
+     * avoids the padded full-image copies of the convolution and should be chosen for lesion-sized labels in large
+     * images. The engine is set by SetSearchEngine().
      */
     class MITKIMAGESTATISTICS_EXPORT HotspotMaskGenerator: public MaskGenerator
     {
@@ -43,6 +55,13 @@ namespace mitk
         typedef itk::SmartPointer< Self >           Pointer;
         typedef itk::SmartPointer< const Self >     ConstPointer;
 
+        /** Algorithms that can be used to compute the mean values of the hotspot sphere. */
+        enum class SearchEngine
+        {
+          FFTConvolution, ///< convolves the whole image with the sphere kernel in fourier domain
+          SphereRuns      ///< sums the sphere as runs of row pixels, only for the pixels of the mask label
+        };
+
         /** Method for creation through the object factory. */
         itkNewMacro(Self); /** Runtime information support. */
         itkTypeMacro(HotspotMaskGenerator, MaskGenerator);
@@ -71,6 +90,13 @@ namespace mitk
 
         bool GetHotspotMustBeCompletelyInsideImage() const;
 
+        /**
+        @brief Define the algorithm used to search the hotspot. Default is SearchEngine::FFTConvolution
+         */
+        void SetSearchEngine(SearchEngine engine);
+
+        SearchEngine GetSearchEngine() const;
+
         /**
         @brief If a maskGenerator is set, this detemines which mask value is used
          */
@@ -135,6 +161,22 @@ namespace mitk
         itk::SmartPointer< itk::Image<TPixel, VImageDimension> >
           GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage );
 
+        /** \brief Computes the convolution of the image with the spherical kernel only for the pixels with
+         * mask == label inside searchRegion, using row-wise prefix sums. searchRegion is reduced to the bounding
+         * box of these pixels, which is also the region of the returned image. Returns nullptr if there are no such pixels. */
+        template <typename TPixel, unsigned int VImageDimension>
+        itk::SmartPointer< itk::Image<TPixel, VImageDimension> >
+          GenerateConvolutionImageOfMaskRegion( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                                unsigned int label,
+                                                typename itk::Image<TPixel, VImageDimension>::RegionType& searchRegion );
+
+        /** \brief Returns the region of the image where the hotspot center may be located. */
+        template <typename TPixel, unsigned int VImageDimension>
+        typename itk::Image<TPixel, VImageDimension>::RegionType
+          CalculateHotspotSearchRegion( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                        double neccessaryDistanceToImageBorderInMM );
+
 
         /** \brief Fills pixels of the spherical hotspot mask. */
         template < typename TPixel, unsigned int VImageDimension>
@@ -155,7 +197,7 @@ namespace mitk
         template <typename TPixel, unsigned int VImageDimension  >
         ImageExtrema CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
                                                         const itk::Image<unsigned short, VImageDimension>* maskImage,
-                                                        double neccessaryDistanceToImageBorderInMM,
+                                                        const typename itk::Image<TPixel, VImageDimension>::RegionType& allowedExtremaRegion,
                                                         unsigned int label);
 
         bool IsUpdateRequired() const;
@@ -170,6 +212,7 @@ namespace mitk
         itk::Image<unsigned short, 3>::ConstPointer m_internalMask3D;
         double m_HotspotRadiusinMM;
         bool m_HotspotMustBeCompletelyInsideImage;
+        SearchEngine m_SearchEngine;
         unsigned short m_Label;
         vnl_vector<int> m_ConvolutionImageMinIndex, m_ConvolutionImageMaxIndex;
         unsigned long m_InternalMaskUpdateTime;
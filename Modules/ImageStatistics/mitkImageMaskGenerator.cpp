@@ -12,6 +12,8 @@ found in the LICENSE file.
 
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageTimeSelector.h>
+
+#include <algorithm>
 #include <stdexcept>
 
 namespace mitk {
@@ -25,6 +27,16 @@ void ImageMaskGenerator::SetImageMask(const Image* maskImage)
     }
 }
 
+itk::ModifiedTimeType ImageMaskGenerator::GetMTime() const
+{
+    auto mtime = Superclass::GetMTime();
+    if (m_InternalMaskImage.IsNotNull())
+    {
+        mtime = std::max(mtime, m_InternalMaskImage->GetMTime());
+    }
+    return mtime;
+}
+
 void ImageMaskGenerator::SetTimeStep(unsigned int timeStep)
 {
     if (timeStep != m_TimeStep)
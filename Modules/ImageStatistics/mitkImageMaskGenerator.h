@@ -40,6 +40,9 @@ public:
 
     void SetImageMask(const mitk::Image* maskImage);
 
+    /** Includes the modification time of the mask image, so that users of the generator notice changed masks. */
+    itk::ModifiedTimeType GetMTime() const override;
+
 protected:
     ImageMaskGenerator():Superclass(){
         m_InternalMaskUpdateTime = 0;
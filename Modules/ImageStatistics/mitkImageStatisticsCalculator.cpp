@@ -11,7 +11,9 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageStatisticsCalculator.h"
+#include <mitkHistogramStatisticsCalculator.h>
 #include <mitkLabelStatisticsImageFilter.h>
+#include <mitkMaskedStatisticsSliceCache.h>
 #include <mitkStatisticsImageFilter.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
@@ -20,12 +22,42 @@ found in the LICENSE file.
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
-#include <mitkMinMaxImageFilterWithIndex.h>
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <itkExtractImageFilter.h>
+
+#include <algorithm>
+
+namespace
+{
+  /** Extracts a region without moving it, the output keeps the indices and the origin of the input. */
+  template <typename TImage>
+  typename TImage::ConstPointer ExtractRegion(const TImage* image, const typename TImage::RegionType& region)
+  {
+    auto extractFilter = itk::ExtractImageFilter<TImage, TImage>::New();
+    extractFilter->SetInput(image);
+    extractFilter->SetExtractionRegion(region);
+    extractFilter->Update();
+    return extractFilter->GetOutput();
+  }
+}
+
 namespace mitk
 {
+  ImageStatisticsCalculator::ImageStatisticsCalculator()
+    : m_nBinsForHistogramStatistics(100),
+      m_binSizeForHistogramStatistics(10),
+      m_UseBinSizeOverNBins(false),
+      m_UseSliceWiseMaskedStatistics(true),
+      m_AnnouncedMaskMTime(0)
+  {
+  }
+
+  ImageStatisticsCalculator::~ImageStatisticsCalculator()
+  {
+  }
+
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
   {
     if (image != m_Image)
@@ -35,6 +67,11 @@ namespace mitk
     }
   }
 
+  const mitk::Image* ImageStatisticsCalculator::GetInputImage() const
+  {
+    return m_Image;
+  }
+
   void ImageStatisticsCalculator::SetMask(mitk::MaskGenerator *mask)
   {
     if (mask != m_MaskGenerator)
@@ -44,6 +81,11 @@ namespace mitk
     }
   }
 
+  mitk::MaskGenerator* ImageStatisticsCalculator::GetMask() const
+  {
+    return m_MaskGenerator;
+  }
+
   void ImageStatisticsCalculator::SetSecondaryMask(mitk::MaskGenerator *mask)
   {
     if (mask != m_SecondaryMaskGenerator)
@@ -53,6 +95,11 @@ namespace mitk
     }
   }
 
+  mitk::MaskGenerator* ImageStatisticsCalculator::GetSecondaryMask() const
+  {
+    return m_SecondaryMaskGenerator;
+  }
+
   void ImageStatisticsCalculator::SetNBinsForHistogramStatistics(unsigned int nBins)
   {
     if (nBins != m_nBinsForHistogramStatistics)
@@ -90,6 +137,58 @@ namespace mitk
 
   double ImageStatisticsCalculator::GetBinSizeForHistogramStatistics() const { return m_binSizeForHistogramStatistics; }
 
+  void ImageStatisticsCalculator::SetUseSliceWiseMaskedStatistics(bool useSliceWiseStatistics)
+  {
+    if (useSliceWiseStatistics != m_UseSliceWiseMaskedStatistics)
+    {
+      m_UseSliceWiseMaskedStatistics = useSliceWiseStatistics;
+      m_SliceCaches.clear();
+      this->Modified();
+    }
+  }
+
+  bool ImageStatisticsCalculator::GetUseSliceWiseMaskedStatistics() const
+  {
+    return m_UseSliceWiseMaskedStatistics;
+  }
+
+  void ImageStatisticsCalculator::SetMaskSlicesModified(TimeStepType timeStep,
+                                                        unsigned int firstSlice,
+                                                        unsigned int lastSlice,
+                                                        itk::ModifiedTimeType maskMTimeBeforeWrite)
+  {
+    if (m_Image.IsNull() || m_MaskGenerator.IsNull())
+    {
+      return;
+    }
+
+    // the report only describes the change of the mask if everything else is as it was when the
+    // statistics were computed, otherwise IsUpdateRequired() has to see the modified mask
+    const auto upToDateTime = std::max(m_StatisticsTime.GetMTime(), m_AnnouncedMaskMTime);
+    if (maskMTimeBeforeWrite > upToDateTime || this->GetMTime() > upToDateTime || m_Image->GetMTime() > upToDateTime ||
+        m_MaskGenerator->itk::Object::GetMTime() > upToDateTime ||
+        (m_SecondaryMaskGenerator.IsNotNull() && m_SecondaryMaskGenerator->GetMTime() > upToDateTime))
+    {
+      return;
+    }
+
+    auto finding = m_SliceCaches.find(timeStep);
+    if (finding != m_SliceCaches.end())
+    {
+      finding->second->InvalidateSlices(firstSlice, lastSlice);
+    }
+
+    // containers handed out before keep their content, the other time steps are copied
+    for (auto& labelAndContainer : m_StatisticContainers)
+    {
+      labelAndContainer.second = labelAndContainer.second->Clone();
+    }
+
+    // no Modified(), the statistics of the other time steps stay valid
+    m_ComputedTimeSteps.erase(timeStep);
+    m_AnnouncedMaskMTime = m_MaskGenerator->GetMTime();
+  }
+
   mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatistics(LabelIndex label)
   {
     if (m_Image.IsNull())
@@ -102,68 +201,399 @@ namespace mitk
       mitkThrow() << "Image not initialized!";
     }
 
-    if (IsUpdateRequired(label))
+    for (TimeStepType timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
+    {
+      this->UpdateStatistics(timeStep, 0 == label);
+    }
+
+    return this->GetStatisticsContainer(label);
+  }
+
+  mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatistics(LabelIndex label, TimeStepType timeStep)
+  {
+    if (m_Image.IsNull())
+    {
+      mitkThrow() << "no image";
+    }
+
+    if (!m_Image->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    if (!m_Image->IsValidTimeStep(timeStep))
+    {
+      mitkThrow() << "Invalid time step " << timeStep << ".";
+    }
+
+    this->UpdateStatistics(timeStep, 0 == label);
+
+    return this->GetStatisticsContainer(label);
+  }
+
+  void ImageStatisticsCalculator::UpdateStatistics(TimeStepType timeStep, bool includeBackground)
+  {
+    if (IsUpdateRequired())
     {
-      auto timeGeometry = m_Image->GetTimeGeometry();
-      // always compute statistics on all timesteps
-      for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
+      // containers handed out before keep their content, new ones are filled from now on
+      m_StatisticContainers.clear();
+      m_ComputedTimeSteps.clear();
+      m_ForegroundOnlyTimeSteps.clear();
+
+      // the slice caches are kept to reuse their memory, but they cannot tell what has changed
+      for (auto& sliceCache : m_SliceCaches)
       {
-        if (m_MaskGenerator.IsNotNull())
+        sliceCache.second->InvalidateAll();
+      }
+    }
+
+    const bool isComputed = m_ComputedTimeSteps.find(timeStep) != m_ComputedTimeSteps.end();
+    const bool lacksBackground = m_ForegroundOnlyTimeSteps.find(timeStep) != m_ForegroundOnlyTimeSteps.end();
+
+    if (!isComputed || (includeBackground && lacksBackground))
+    {
+      this->CalculateStatistics(timeStep, includeBackground);
+      m_ComputedTimeSteps.insert(timeStep);
+      m_StatisticsTime.Modified();
+    }
+  }
+
+  mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatisticsContainer(LabelIndex label) const
+  {
+    auto it = m_StatisticContainers.find(label);
+    if (it != m_StatisticContainers.end())
+    {
+      return (it->second).GetPointer();
+    }
+    else
+    {
+      mitkThrow() << "unknown label";
+      return nullptr;
+    }
+  }
+
+  mitk::Image::ConstPointer ImageStatisticsCalculator::GetImageOfTimeStep(const mitk::Image* image, TimeStepType timeStep)
+  {
+    // images with a single time step are used as they are, the time selector
+    // only creates a new image that references the volume of the time step
+    if (image->GetDimension() < 4)
+    {
+      return image;
+    }
+
+    return SelectImageByTimeStep(image, timeStep);
+  }
+
+  void ImageStatisticsCalculator::CalculateStatistics(TimeStepType timeStep, bool includeBackground)
+  {
+    auto timeGeometry = m_Image->GetTimeGeometry();
+
+    if (m_MaskGenerator.IsNotNull())
+    {
+      m_MaskGenerator->SetTimeStep(timeStep);
+      //See T25625: otherwise, the mask is not computed again after setting a different time step
+      m_MaskGenerator->Modified();
+      m_InternalMask = m_MaskGenerator->GetMask();
+      if (m_MaskGenerator->GetReferenceImage().IsNotNull())
+      {
+        m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
+      }
+      else
+      {
+        m_InternalImageForStatistics = m_Image;
+      }
+    }
+    else
+    {
+      m_InternalImageForStatistics = m_Image;
+    }
+
+    if (m_SecondaryMaskGenerator.IsNotNull())
+    {
+      m_SecondaryMaskGenerator->SetTimeStep(timeStep);
+      m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
+    }
+
+    // the pixel data is only read, AccessByItk just requires a non const image
+    m_ImageTimeSlice = const_cast<Image*>(GetImageOfTimeStep(m_InternalImageForStatistics, timeStep).GetPointer());
+
+    // Calculate statistics with/without mask
+    if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
+    {
+      // 1) calculate statistics unmasked:
+      AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeGeometry, timeStep)
+    }
+    else if (this->IsSliceWiseStatisticsApplicable())
+    {
+      // 2) calculate statistics masked, using the partial statistics of unchanged slices
+      AccessFixedDimensionByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsSliceWise, 3, timeGeometry, timeStep)
+    }
+    else
+    {
+      // 3) calculate statistics masked
+      m_SliceCaches.erase(timeStep);
+      AccessByItk_3(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeGeometry, timeStep, includeBackground)
+    }
+  }
+
+  bool ImageStatisticsCalculator::IsSliceWiseStatisticsApplicable() const
+  {
+    if (!m_UseSliceWiseMaskedStatistics || m_MaskGenerator.IsNull() || m_SecondaryMaskGenerator.IsNotNull() ||
+        m_InternalMask.IsNull() || m_InternalImageForStatistics != m_Image)
+    {
+      return false;
+    }
+
+    if (3 != m_ImageTimeSlice->GetDimension() || 3 != m_InternalMask->GetDimension())
+    {
+      return false;
+    }
+
+    // the slice cache counts every pixel value, which is only feasible for small integer ranges
+    const auto pixelType = m_ImageTimeSlice->GetPixelType();
+    const auto componentType = pixelType.GetComponentType();
+    if (1 != pixelType.GetNumberOfComponents() ||
+        (itk::IOComponentEnum::CHAR != componentType && itk::IOComponentEnum::UCHAR != componentType &&
+         itk::IOComponentEnum::SHORT != componentType && itk::IOComponentEnum::USHORT != componentType))
+    {
+      return false;
+    }
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (m_ImageTimeSlice->GetDimension(i) != m_InternalMask->GetDimension(i))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalCalculateStatisticsSliceWise(
+    typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
+    typedef MaskedStatisticsSliceCache::SliceStatisticsMapType SliceStatisticsMapType;
+
+    typename MaskType::ConstPointer maskImage;
+    try
+    {
+      maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(m_InternalMask);
+    }
+    catch (const itk::ExceptionObject &)
+    {
+      typename MaskType::Pointer noneConstMaskImage;
+      CastToItkImage(m_InternalMask, noneConstMaskImage);
+      maskImage = noneConstMaskImage;
+    }
+
+    const auto region = image->GetLargestPossibleRegion();
+    const unsigned int dimensions[3] = { static_cast<unsigned int>(region.GetSize(0)),
+                                         static_cast<unsigned int>(region.GetSize(1)),
+                                         static_cast<unsigned int>(region.GetSize(2)) };
+
+    // the slice-wise statistics always cover the whole mask, including the background label
+    m_ForegroundOnlyTimeSteps.erase(timeStep);
+
+    auto &sliceCache = m_SliceCaches[timeStep];
+    if (nullptr == sliceCache)
+    {
+      sliceCache = std::make_unique<MaskedStatisticsSliceCache>();
+    }
+
+    if (!sliceCache->HasDimensions(dimensions))
+    {
+      sliceCache->Initialize(dimensions);
+    }
+
+    const TPixel *imageBuffer = image->GetBufferPointer();
+    const MaskPixelType *maskBuffer = maskImage->GetBufferPointer();
+    const typename ImageType::IndexType regionIndex = region.GetIndex();
+    const std::size_t sliceSize = static_cast<std::size_t>(dimensions[0]) * dimensions[1];
+
+    sliceCache->Update([=](unsigned int z, SliceStatisticsMapType &result) {
+      const std::size_t sliceOffset = z * sliceSize;
+      MaskedStatisticsSliceCache::IndexType index;
+      index[2] = regionIndex[2] + z;
+
+      auto finding = result.end();
+      for (unsigned int y = 0; y < dimensions[1]; ++y)
+      {
+        index[1] = regionIndex[1] + y;
+        const std::size_t lineOffset = sliceOffset + static_cast<std::size_t>(y) * dimensions[0];
+
+        for (unsigned int x = 0; x < dimensions[0]; ++x)
         {
-          m_MaskGenerator->SetTimeStep(timeStep);
-          //See T25625: otherwise, the mask is not computed again after setting a different time step
-          m_MaskGenerator->Modified();
-          m_InternalMask = m_MaskGenerator->GetMask();
-          if (m_MaskGenerator->GetReferenceImage().IsNotNull())
-          {
-            m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
-          }
-          else
+          const auto label = maskBuffer[lineOffset + x];
+          if (finding == result.end() || finding->first != label)
           {
-            m_InternalImageForStatistics = m_Image;
+            finding = result.try_emplace(label).first;
           }
-        }
-        else
-        {
-          m_InternalImageForStatistics = m_Image;
-        }
 
-        if (m_SecondaryMaskGenerator.IsNotNull())
-        {
-          m_SecondaryMaskGenerator->SetTimeStep(timeStep);
-          m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
+          index[0] = regionIndex[0] + x;
+          finding->second.aggregate.Add(static_cast<double>(imageBuffer[lineOffset + x]), index);
         }
+      }
 
-        ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
-        imgTimeSel->SetInput(m_InternalImageForStatistics);
-        imgTimeSel->SetTimeNr(timeStep);
-        imgTimeSel->UpdateLargestPossibleRegion();
-        imgTimeSel->Update();
-        m_ImageTimeSlice = imgTimeSel->GetOutput();
+      // the value range of every label is known after the first pass, so the counts are never reallocated
+      for (auto &statistics : result)
+      {
+        statistics.second.valueCounts.Reserve(static_cast<long long>(statistics.second.aggregate.min),
+                                              static_cast<long long>(statistics.second.aggregate.max));
+      }
 
-        // Calculate statistics with/without mask
-        if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
-        {
-          // 1) calculate statistics unmasked:
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeGeometry, timeStep)
-        }
-        else
+      finding = result.end();
+      const std::size_t sliceEnd = sliceOffset + sliceSize;
+      for (std::size_t offset = sliceOffset; offset < sliceEnd; ++offset)
+      {
+        const auto label = maskBuffer[offset];
+        if (finding == result.end() || finding->first != label)
         {
-          // 2) calculate statistics masked
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeGeometry, timeStep)
+          finding = result.find(label);
         }
+
+        finding->second.valueCounts.Add(static_cast<long long>(imageBuffer[offset]));
+      }
+    });
+
+    const auto labels = sliceCache->GetLabelValues();
+
+    // containers of labels that vanished from this time step must not keep their outdated statistics;
+    // other time steps of these labels are computed again
+    bool labelRemoved = false;
+    for (auto it = m_StatisticContainers.begin(); it != m_StatisticContainers.end();)
+    {
+      if (it->second->TimeStepExists(timeStep) && nullptr == sliceCache->GetAggregate(it->first))
+      {
+        it = m_StatisticContainers.erase(it);
+        labelRemoved = true;
+      }
+      else
+      {
+        ++it;
       }
     }
 
-    auto it = m_StatisticContainers.find(label);
-    if (it != m_StatisticContainers.end())
+    if (labelRemoved)
     {
-      return (it->second).GetPointer();
+      m_ComputedTimeSteps.clear();
     }
-    else
+
+    const auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+
+    for (const auto label : labels)
     {
-      mitkThrow() << "unknown label";
-      return nullptr;
+      ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
+      auto labelIt = m_StatisticContainers.find(label);
+      if (labelIt != m_StatisticContainers.end())
+      {
+        statisticContainerForLabelImage = labelIt->second;
+      }
+      else
+      {
+        statisticContainerForLabelImage = ImageStatisticsContainer::New();
+        statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
+        m_StatisticContainers.emplace(label, statisticContainerForLabelImage);
+      }
+
+      const auto &stats = *(sliceCache->GetAggregate(label));
+      const auto &valueCounts = *(sliceCache->GetValueCounts(label));
+
+      // moments as computed by LabelStatisticsImageFilter
+      const double count = static_cast<double>(stats.count);
+      const double mean = stats.sum / count;
+      const double variance =
+        stats.count > 1 ? (stats.sumOfSquares - stats.sum * stats.sum / count) / (count - 1.0) : 0.0;
+      const double sigma = std::sqrt(variance);
+      const double secondMoment = stats.sumOfSquares / count;
+      const double thirdMoment = stats.sumOfCubes / count;
+      const double fourthMoment = stats.sumOfQuadruples / count;
+      const double skewness = (thirdMoment - 3 * secondMoment * mean + 2 * std::pow(mean, 3)) /
+                              std::pow(secondMoment - std::pow(mean, 2), 1.5);
+      const double kurtosis = (fourthMoment - 4 * thirdMoment * mean + 6 * secondMoment * std::pow(mean, 2) -
+                               3 * std::pow(mean, 4)) / std::pow(secondMoment - std::pow(mean, 2), 2);
+      const double mpp = stats.sumOfPositivePixels / static_cast<double>(stats.countOfPositivePixels);
+
+      // the histogram is built from the value counts, because its range follows the current min/max of the label
+      unsigned int nBinsForHistogram;
+      if (m_UseBinSizeOverNBins)
+      {
+        nBinsForHistogram = std::max(static_cast<double>(std::ceil(stats.max - stats.min)) /
+                                       m_binSizeForHistogramStatistics,
+                                     10.); // do not allow less than 10 bins
+      }
+      else
+      {
+        nBinsForHistogram = m_nBinsForHistogramStatistics;
+      }
+
+      HistogramType::SizeType histogramSize(1);
+      histogramSize[0] = nBinsForHistogram;
+      HistogramType::MeasurementVectorType histogramLowerBound(1);
+      histogramLowerBound[0] = stats.min;
+      HistogramType::MeasurementVectorType histogramUpperBound(1);
+      histogramUpperBound[0] = stats.max;
+
+      HistogramType::Pointer histogram = HistogramType::New();
+      histogram->SetMeasurementVectorSize(1);
+      histogram->Initialize(histogramSize, histogramLowerBound, histogramUpperBound);
+
+      HistogramType::MeasurementVectorType histogramMeasurement(1);
+      HistogramType::IndexType histogramIndex(1);
+      for (std::size_t i = 0; i < valueCounts.counts.size(); ++i)
+      {
+        if (0 == valueCounts.counts[i])
+          continue;
+
+        histogramMeasurement[0] = static_cast<double>(valueCounts.firstValue + static_cast<long long>(i));
+        histogram->GetIndex(histogramMeasurement, histogramIndex);
+        histogram->IncreaseFrequencyOfIndex(histogramIndex, valueCounts.counts[i]);
+      }
+
+      HistogramStatisticsCalculator histogramStatisticsCalculator;
+      histogramStatisticsCalculator.SetHistogram(histogram);
+      histogramStatisticsCalculator.CalculateStatistics();
+
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+      vnl_vector<int> minIndex, maxIndex;
+      minIndex.set_size(3);
+      maxIndex.set_size(3);
+      for (unsigned int i = 0; i < 3; i++)
+      {
+        minIndex[i] = stats.minIndex[i];
+        maxIndex[i] = stats.maxIndex[i];
+      }
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+      const auto numberOfVoxels = static_cast<unsigned long>(stats.count);
+      const auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
+      const auto rms = std::sqrt(std::pow(mean, 2.) + variance); // variance = sigma^2
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+        static_cast<ImageStatisticsContainer::RealType>(stats.min));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+        static_cast<ImageStatisticsContainer::RealType>(stats.max));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), sigma * sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), kurtosis);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), mpp);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), histogramStatisticsCalculator.GetEntropy());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), histogramStatisticsCalculator.GetMedian());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), histogramStatisticsCalculator.GetUniformity());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), histogramStatisticsCalculator.GetUPP());
+      statObj.m_Histogram = histogram;
+      statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
     }
   }
 
@@ -173,7 +603,6 @@ namespace mitk
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
     typedef typename mitk::StatisticsImageFilter<ImageType> ImageStatisticsFilterType;
-    typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
 
     // reset statistics container if exists
     ImageStatisticsContainer::Pointer statisticContainerForImage;
@@ -197,50 +626,17 @@ namespace mitk
     statisticsFilter->SetCoordinateTolerance(0.001);
     statisticsFilter->SetDirectionTolerance(0.001);
 
-    // TODO: this is single threaded. Implement our own image filter that does this multi threaded
-    //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
-    //        itk::MinimumMaximumImageCalculator<ImageType>::New(); imgMinMaxFilter->SetImage(image);
-    //        imgMinMaxFilter->Compute();
-    vnl_vector<int> minIndex, maxIndex;
-
-    typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(image);
-    minMaxFilter->UpdateLargestPossibleRegion();
-    typename ImageType::PixelType minval = minMaxFilter->GetMin();
-    typename ImageType::PixelType maxval = minMaxFilter->GetMax();
-
-    typename ImageType::IndexType tmpMinIndex = minMaxFilter->GetMinIndex();
-    typename ImageType::IndexType tmpMaxIndex = minMaxFilter->GetMaxIndex();
-
-    //        typename ImageType::IndexType tmpMinIndex = imgMinMaxFilter->GetIndexOfMinimum();
-    //        typename ImageType::IndexType tmpMaxIndex = imgMinMaxFilter->GetIndexOfMaximum();
-
-    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
-    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
-
-    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
-    {
-      minIndex[i] = tmpMinIndex[i];
-      maxIndex[i] = tmpMaxIndex[i];
-    }
-
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
-
-    // convert m_binSize in m_nBins if necessary
-    unsigned int nBinsForHistogram;
+    // min/max with their indices, moments and histogram are gathered by a single filter; the
+    // histogram covers the data range, which the filter determines itself
     if (m_UseBinSizeOverNBins)
     {
-      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxval - minval)) / m_binSizeForHistogramStatistics,
-                                   10.); // do not allow less than 10 bins
+      statisticsFilter->SetHistogramBinSizeForDataRange(m_binSizeForHistogramStatistics);
     }
     else
     {
-      nBinsForHistogram = m_nBinsForHistogramStatistics;
+      statisticsFilter->SetHistogramParametersForDataRange(m_nBinsForHistogramStatistics);
     }
 
-    statisticsFilter->SetHistogramParameters(nBinsForHistogram, minval, maxval);
-
     try
     {
       statisticsFilter->Update();
@@ -250,6 +646,22 @@ namespace mitk
       mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
     }
 
+    vnl_vector<int> minIndex, maxIndex;
+    typename ImageType::IndexType tmpMinIndex = statisticsFilter->GetMinimumIndex();
+    typename ImageType::IndexType tmpMaxIndex = statisticsFilter->GetMaximumIndex();
+
+    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
+    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
+
+    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
+    {
+      minIndex[i] = tmpMinIndex[i];
+      maxIndex[i] = tmpMaxIndex[i];
+    }
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
     auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
     auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
@@ -295,7 +707,8 @@ namespace mitk
   template <typename TPixel, unsigned int VImageDimension>
   void ImageStatisticsCalculator::InternalCalculateStatisticsMasked(typename itk::Image<TPixel, VImageDimension> *image,
                                                                     const TimeGeometry *timeGeometry,
-                                                                    unsigned int timeStep)
+                                                                    unsigned int timeStep,
+                                                                    bool includeBackground)
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
@@ -374,6 +787,45 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
+    // the mask may be smaller than the image, indices of the filters below are relative to the mask
+    const auto maskOriginIndex = maskUtil->ComputeMaskOriginIndex();
+
+    // restrict all filters to the bounding region of the mask foreground unless the background label is requested.
+    // Image and mask share the index space here, the extracted images keep their indices.
+    m_ForegroundOnlyTimeSteps.erase(timeStep);
+    if (!includeBackground)
+    {
+      // the region is only scanned again if one of the masks has changed
+      const auto maskMTime = m_InternalMask->GetMTime();
+      const auto secondaryMaskMTime = m_SecondaryMask.IsNotNull() ? m_SecondaryMask->GetMTime() : 0;
+      auto &cachedRegion = m_ForegroundRegionCache[timeStep];
+      typename MaskType::RegionType foregroundRegion;
+
+      if (VImageDimension == cachedRegion.index.size() && maskMTime == cachedRegion.maskMTime &&
+          secondaryMaskMTime == cachedRegion.secondaryMaskMTime)
+      {
+        for (unsigned int i = 0; i < VImageDimension; i++)
+        {
+          foregroundRegion.SetIndex(i, cachedRegion.index[i]);
+          foregroundRegion.SetSize(i, cachedRegion.size[i]);
+        }
+      }
+      else
+      {
+        foregroundRegion = MaskUtilType::ComputeForegroundRegion(maskImage);
+        cachedRegion.maskMTime = maskMTime;
+        cachedRegion.secondaryMaskMTime = secondaryMaskMTime;
+        cachedRegion.index.assign(foregroundRegion.GetIndex().begin(), foregroundRegion.GetIndex().end());
+        cachedRegion.size.assign(foregroundRegion.GetSize().begin(), foregroundRegion.GetSize().end());
+      }
+      if (0 != foregroundRegion.GetNumberOfPixels() && foregroundRegion != maskImage->GetLargestPossibleRegion())
+      {
+        maskImage = ExtractRegion<MaskType>(maskImage, foregroundRegion);
+        adaptedImage = ExtractRegion<ImageType>(adaptedImage, foregroundRegion);
+        m_ForegroundOnlyTimeSteps.insert(timeStep);
+      }
+    }
+
     // find min, max, minindex and maxindex
     typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
     minMaxFilter->SetInput(adaptedImage);
@@ -448,8 +900,15 @@ namespace mitk
       mitk::Point3D worldCoordinateMax;
       mitk::Point3D indexCoordinateMin;
       mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
+      auto minIndexInImage = minMaxFilter->GetMinIndex(*it);
+      auto maxIndexInImage = minMaxFilter->GetMaxIndex(*it);
+      for (unsigned int i = 0; i < VImageDimension; i++)
+      {
+        minIndexInImage[i] += maskOriginIndex[i];
+        maxIndexInImage[i] += maskOriginIndex[i];
+      }
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minIndexInImage, worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(maxIndexInImage, worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
@@ -504,45 +963,29 @@ namespace mitk
     }
   }
 
-  bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
+  bool ImageStatisticsCalculator::IsUpdateRequired() const
   {
-    unsigned long thisClassTimeStamp = this->GetMTime();
-    unsigned long inputImageTimeStamp = m_Image->GetMTime();
+    const auto statisticsTimeStamp = m_StatisticsTime.GetMTime();
 
-    auto it = m_StatisticContainers.find(label);
-    if (it == m_StatisticContainers.end())
+    if (this->GetMTime() > statisticsTimeStamp) // inputs have changed
     {
       return true;
     }
 
-    unsigned long statisticsTimeStamp = it->second->GetMTime();
-
-    if (thisClassTimeStamp > statisticsTimeStamp) // inputs have changed
+    if (m_Image->GetMTime() > statisticsTimeStamp) // image has changed
     {
       return true;
     }
 
-    if (inputImageTimeStamp > statisticsTimeStamp) // image has changed
+    // changes of the mask reported with SetMaskSlicesModified() only concern single time steps
+    if (m_MaskGenerator.IsNotNull() && m_MaskGenerator->GetMTime() > std::max(statisticsTimeStamp, m_AnnouncedMaskMTime))
     {
-      return true;
+      return true; // there is a mask generator and it has changed
     }
 
-    if (m_MaskGenerator.IsNotNull())
+    if (m_SecondaryMaskGenerator.IsNotNull() && m_SecondaryMaskGenerator->GetMTime() > statisticsTimeStamp)
     {
-      unsigned long maskGeneratorTimeStamp = m_MaskGenerator->GetMTime();
-      if (maskGeneratorTimeStamp > statisticsTimeStamp) // there is a mask generator and it has changed
-      {
-        return true;
-      }
-    }
-
-    if (m_SecondaryMaskGenerator.IsNotNull())
-    {
-      unsigned long maskGeneratorTimeStamp = m_SecondaryMaskGenerator->GetMTime();
-      if (maskGeneratorTimeStamp > statisticsTimeStamp) // there is a secondary mask generator and it has changed
-      {
-        return true;
-      }
+      return true; // there is a secondary mask generator and it has changed
     }
 
     return false;
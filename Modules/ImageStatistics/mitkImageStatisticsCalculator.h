@@ -18,8 +18,15 @@ found in the LICENSE file.
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
 
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
 namespace mitk
 {
+    class MaskedStatisticsSliceCache;
+
     class MITKIMAGESTATISTICS_EXPORT ImageStatisticsCalculator: public itk::Object
     {
     public:
@@ -43,15 +50,27 @@ namespace mitk
         @brief Set the image for which the statistics are to be computed.*/
         void SetInputImage(const mitk::Image* image);
 
+        /**Documentation
+        @brief Returns the image set by SetInputImage(), nullptr if none is set.*/
+        const mitk::Image* GetInputImage() const;
+
         /**Documentation
         @brief Set the mask generator that creates the mask which is to be used to calculate statistics. If no more mask is desired simply set @param mask to nullptr*/
         void SetMask(mitk::MaskGenerator* mask);
 
+        /**Documentation
+        @brief Returns the mask generator set by SetMask(), nullptr if none is set.*/
+        mitk::MaskGenerator* GetMask() const;
+
         /**Documentation
         @brief Set this if more than one mask should be applied (for instance if a IgnorePixelValueMask were to be used alongside with a segmentation).
         Both masks are combined using pixel wise AND operation. The secondary mask does not have to be the same size than the primary but they need to have some overlap*/
         void SetSecondaryMask(mitk::MaskGenerator* mask);
 
+        /**Documentation
+        @brief Returns the mask generator set by SetSecondaryMask(), nullptr if none is set.*/
+        mitk::MaskGenerator* GetSecondaryMask() const;
+
         /**Documentation
         @brief Set number of bins to be used for histogram statistics. If Bin size is set after number of bins, bin size will be used instead!*/
         void SetNBinsForHistogramStatistics(unsigned int nBins);
@@ -73,30 +92,78 @@ namespace mitk
         /**Documentation
         @brief Returns the statistics for label @a label. If these requested statistics are not computed yet the computation is done as well.
         For performance reasons, statistics for all labels in the image are computed at once.
+        Only time steps that are not up to date are computed.
+        Foreground labels are computed within the bounding region of the mask foreground only. The background label 0
+        always refers to the whole mask, time steps computed before for foreground labels are computed again if needed.
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
+        /**Documentation
+        @brief Returns the statistics for label @a label, but only computes time step @a timeStep if it is not up to date.
+        Use it to get the statistics of the time step that is currently shown without waiting for all other time steps.
+        The returned container only contains other time steps if they have been computed before with the same inputs.
+        Throws mitk::Exception if the time step is invalid.
+         */
+        ImageStatisticsContainer* GetStatistics(LabelIndex label, TimeStepType timeStep);
+
+        /**Documentation
+        @brief If enabled, masked statistics are gathered from partial statistics per axial slice of the mask.
+        After slice-wise edits of the mask, only the slices reported with SetMaskSlicesModified() are scanned again.
+        Only used for 3D volumes of 8 or 16 bit integer pixels with a mask of the same size and without secondary
+        mask, otherwise the statistics are computed as usual. Enabled by default.*/
+        void SetUseSliceWiseMaskedStatistics(bool useSliceWiseStatistics);
+        bool GetUseSliceWiseMaskedStatistics() const;
+
+        /**Documentation
+        @brief Reports that the pixels of the mask have been written in the slices @a firstSlice to @a lastSlice
+        (inclusive, index coordinates along the third axis) of time step @a timeStep.
+        @a maskMTimeBeforeWrite is the modification time of the mask image before the write. The report is only
+        applied if the statistics were up to date at that time and no other input has changed since. Then only
+        time step @a timeStep is computed again on the next request and, with slice-wise statistics, only the
+        reported slices are scanned. Otherwise the report is ignored and the modified mask is handled as usual.
+        Call it after the write, once the mask image is marked as modified.*/
+        void SetMaskSlicesModified(TimeStepType timeStep, unsigned int firstSlice, unsigned int lastSlice,
+                                   itk::ModifiedTimeType maskMTimeBeforeWrite);
+
     protected:
-        ImageStatisticsCalculator(){
-            m_nBinsForHistogramStatistics = 100;
-            m_binSizeForHistogramStatistics = 10;
-            m_UseBinSizeOverNBins = false;
-        };
+        ImageStatisticsCalculator();
+        ~ImageStatisticsCalculator() override;
 
 
     private:
+        //Calculates the statistics of a time step unless they are up to date. If includeBackground is false, the
+        //statistics of label 0 may only cover the bounding region of the mask foreground.
+        void UpdateStatistics(TimeStepType timeStep, bool includeBackground);
+
+        //Calculates the statistics of all labels for one time step of the image
+        void CalculateStatistics(TimeStepType timeStep, bool includeBackground);
+
+        /** Returns the image of the time step. The pixel data is referenced, not copied. */
+        static mitk::Image::ConstPointer GetImageOfTimeStep(const mitk::Image* image, TimeStepType timeStep);
+
+        ImageStatisticsContainer* GetStatisticsContainer(LabelIndex label) const;
+
         //Calculates statistics for each timestep for image
         template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsUnmasked(
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry, TimeStepType timeStep);
 
         template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsMasked(
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
-                unsigned int timeStep);
+                unsigned int timeStep, bool includeBackground);
+
+        //Calculates the statistics of all labels for one time step from the slice-wise partial statistics
+        template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsSliceWise(
+                typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
+                TimeStepType timeStep);
+
+        /** Returns true if the slice-wise statistics can be used for the current inputs of the time step. */
+        bool IsSliceWiseStatisticsApplicable() const;
 
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
-        bool IsUpdateRequired(LabelIndex label) const;
+        /** Returns true if any input was modified since the statistics were computed. */
+        bool IsUpdateRequired() const;
 
         mitk::Image::ConstPointer m_Image;
         mitk::Image::Pointer m_ImageTimeSlice;
@@ -111,8 +178,32 @@ namespace mitk
         unsigned int m_nBinsForHistogramStatistics;
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
+        bool m_UseSliceWiseMaskedStatistics;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+        /** Time steps whose statistics are up to date, as of m_StatisticsTime. */
+        std::set<TimeStepType> m_ComputedTimeSteps;
+        /** Computed time steps whose background statistics only cover the bounding region of the mask foreground. */
+        std::set<TimeStepType> m_ForegroundOnlyTimeSteps;
+        itk::TimeStamp m_StatisticsTime;
+        /** Modification time of the mask up to which all changes were reported with SetMaskSlicesModified(). */
+        itk::ModifiedTimeType m_AnnouncedMaskMTime;
+
+        /** Bounding region of the mask foreground and the modification times of the masks it was computed for. */
+        struct ForegroundRegionCacheEntry
+        {
+          itk::ModifiedTimeType maskMTime = 0;
+          itk::ModifiedTimeType secondaryMaskMTime = 0;
+          std::vector<itk::IndexValueType> index;
+          std::vector<itk::SizeValueType> size;
+        };
+
+        /** Foreground region of the mask per time step, used to restrict the masked statistics. */
+        std::map<TimeStepType, ForegroundRegionCacheEntry> m_ForegroundRegionCache;
+
+        /** Slice-wise partial statistics per time step, only used if m_UseSliceWiseMaskedStatistics is set. */
+        std::map<TimeStepType, std::unique_ptr<MaskedStatisticsSliceCache>> m_SliceCaches;
     };
 
 }
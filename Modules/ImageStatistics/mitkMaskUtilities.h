@@ -62,6 +62,18 @@ class MaskUtilities: public itk::Object
          */
         typename ImageType::ConstPointer ExtractMaskImageRegion();
 
+        /**
+         * @brief Returns the index of the image pixel at the origin of the mask, i.e. the offset between the
+         * indices of the mask and the image as used by ExtractMaskImageRegion()
+         */
+        typename ImageType::IndexType ComputeMaskOriginIndex() const;
+
+        /**
+         * @brief Returns the smallest region of the mask that contains all pixels with a value other than 0.
+         * The size of the returned region is 0 if the mask contains no such pixel.
+         */
+        static typename MaskType::RegionType ComputeForegroundRegion(const MaskType* mask);
+
     protected:
         MaskUtilities(): m_Image(nullptr), m_Mask(nullptr){}
 
@@ -17,8 +17,11 @@ found in the LICENSE file.
 #include <mitkImageAccessByItk.h>
 #include <itkExtractImageFilter.h>
 #include <itkChangeInformationImageFilter.h>
+#include <itkImageScanlineConstIterator.h>
 #include <mitkITKImageImport.h>
 
+#include <algorithm>
+
 namespace mitk
 {
     template <class TPixel, unsigned int VImageDimension>
@@ -155,19 +158,9 @@ namespace mitk
         if ( maskSmallerImage )
         {
           typename ExtractImageFilterType::Pointer extractImageFilter = ExtractImageFilterType::New();
-          typename MaskType::PointType maskOrigin = m_Mask->GetOrigin();
-          typename ImageType::PointType imageOrigin = m_Image->GetOrigin();
-          typename MaskType::SpacingType maskSpacing = m_Mask->GetSpacing();
           typename ImageType::RegionType extractionRegion;
-          typename ImageType::IndexType extractionRegionIndex;
-
-
-          for (unsigned int i=0; i < maskOrigin.GetPointDimension(); i++)
-          {
-              extractionRegionIndex[i] = (maskOrigin[i] - imageOrigin[i]) / maskSpacing[i];
-          }
 
-          extractionRegion.SetIndex(extractionRegionIndex);
+          extractionRegion.SetIndex(this->ComputeMaskOriginIndex());
           extractionRegion.SetSize(m_Mask->GetLargestPossibleRegion().GetSize());
 
           extractImageFilter->SetInput( m_Image );
@@ -189,6 +182,86 @@ namespace mitk
         return resultImg;
     }
 
+    template <class TPixel, unsigned int VImageDimension>
+    typename MaskUtilities<TPixel, VImageDimension>::ImageType::IndexType
+      MaskUtilities<TPixel, VImageDimension>::ComputeMaskOriginIndex() const
+    {
+        typename MaskType::PointType maskOrigin = m_Mask->GetOrigin();
+        typename ImageType::PointType imageOrigin = m_Image->GetOrigin();
+        typename MaskType::SpacingType maskSpacing = m_Mask->GetSpacing();
+        typename ImageType::IndexType maskOriginIndex;
+
+        for (unsigned int i=0; i < maskOrigin.GetPointDimension(); i++)
+        {
+            maskOriginIndex[i] = (maskOrigin[i] - imageOrigin[i]) / maskSpacing[i];
+        }
+
+        return maskOriginIndex;
+    }
+
+    template <class TPixel, unsigned int VImageDimension>
+    typename MaskUtilities<TPixel, VImageDimension>::MaskType::RegionType
+      MaskUtilities<TPixel, VImageDimension>::ComputeForegroundRegion(const MaskType* mask)
+    {
+        typedef typename MaskType::IndexType IndexType;
+        typedef typename MaskType::RegionType RegionType;
+
+        const RegionType maskRegion = mask->GetLargestPossibleRegion();
+        IndexType minIndex = maskRegion.GetUpperIndex();
+        IndexType maxIndex = maskRegion.GetIndex();
+        bool foundForeground = false;
+
+        // the buffer is scanned line by line, only the first and the last foreground pixel of a line matter
+        itk::ImageScanlineConstIterator<MaskType> it(mask, maskRegion);
+        while (!it.IsAtEnd())
+        {
+            const IndexType lineStart = it.GetIndex();
+            bool lineHasForeground = false;
+            itk::IndexValueType first = 0;
+            itk::IndexValueType last = 0;
+            for (itk::IndexValueType x = lineStart[0]; !it.IsAtEndOfLine(); ++it, ++x)
+            {
+                if (0 != it.Get())
+                {
+                    if (!lineHasForeground)
+                        first = x;
+                    last = x;
+                    lineHasForeground = true;
+                }
+            }
+
+            if (lineHasForeground)
+            {
+                foundForeground = true;
+                minIndex[0] = std::min(minIndex[0], first);
+                maxIndex[0] = std::max(maxIndex[0], last);
+                for (unsigned int i = 1; i < VImageDimension; ++i)
+                {
+                    minIndex[i] = std::min(minIndex[i], lineStart[i]);
+                    maxIndex[i] = std::max(maxIndex[i], lineStart[i]);
+                }
+            }
+
+            it.NextLine();
+        }
+
+        RegionType foregroundRegion;
+        if (foundForeground)
+        {
+            foregroundRegion.SetIndex(minIndex);
+            foregroundRegion.SetUpperIndex(maxIndex);
+        }
+        else
+        {
+            foregroundRegion.SetIndex(maskRegion.GetIndex());
+            typename RegionType::SizeType emptySize;
+            emptySize.Fill(0);
+            foregroundRegion.SetSize(emptySize);
+        }
+
+        return foregroundRegion;
+    }
+
 }
 
 #endif
@@ -0,0 +1,252 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMaskedStatisticsSliceCache.h"
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+void mitk::MaskedStatisticsSliceCache::Aggregate::Add(double value, const IndexType &index)
+{
+  if (0 == count || value < min)
+  {
+    min = value;
+    minIndex = index;
+  }
+
+  if (0 == count || value > max)
+  {
+    max = value;
+    maxIndex = index;
+  }
+
+  const double squareValue = value * value;
+  sum += value;
+  sumOfSquares += squareValue;
+  sumOfCubes += squareValue * value;
+  sumOfQuadruples += squareValue * squareValue;
+  ++count;
+
+  if (0 < value)
+  {
+    sumOfPositivePixels += value;
+    ++countOfPositivePixels;
+  }
+}
+
+void mitk::MaskedStatisticsSliceCache::Aggregate::Merge(const Aggregate &other)
+{
+  if (0 == other.count)
+    return;
+
+  // other is expected to follow this in memory order, so ties keep the own index
+  if (0 == count || other.min < min)
+  {
+    min = other.min;
+    minIndex = other.minIndex;
+  }
+
+  if (0 == count || other.max > max)
+  {
+    max = other.max;
+    maxIndex = other.maxIndex;
+  }
+
+  sum += other.sum;
+  sumOfSquares += other.sumOfSquares;
+  sumOfCubes += other.sumOfCubes;
+  sumOfQuadruples += other.sumOfQuadruples;
+  count += other.count;
+  sumOfPositivePixels += other.sumOfPositivePixels;
+  countOfPositivePixels += other.countOfPositivePixels;
+}
+
+void mitk::MaskedStatisticsSliceCache::ValueCounts::Reserve(long long minValue, long long maxValue)
+{
+  if (minValue > maxValue)
+    return;
+
+  if (counts.empty())
+  {
+    firstValue = minValue;
+    counts.assign(static_cast<std::size_t>(maxValue - minValue + 1), 0);
+    return;
+  }
+
+  const long long lastValue = firstValue + static_cast<long long>(counts.size()) - 1;
+  if (maxValue > lastValue)
+    counts.resize(static_cast<std::size_t>(maxValue - firstValue + 1), 0);
+
+  if (minValue < firstValue)
+  {
+    counts.insert(counts.begin(), static_cast<std::size_t>(firstValue - minValue), 0);
+    firstValue = minValue;
+  }
+}
+
+void mitk::MaskedStatisticsSliceCache::ValueCounts::Merge(const ValueCounts &other)
+{
+  if (other.counts.empty())
+    return;
+
+  this->Reserve(other.firstValue, other.firstValue + static_cast<long long>(other.counts.size()) - 1);
+
+  const auto offset = static_cast<std::size_t>(other.firstValue - firstValue);
+  for (std::size_t i = 0; i < other.counts.size(); ++i)
+    counts[offset + i] += other.counts[i];
+}
+
+void mitk::MaskedStatisticsSliceCache::ValueCounts::Subtract(const ValueCounts &other)
+{
+  if (other.counts.empty())
+    return;
+
+  const auto offset = static_cast<std::size_t>(other.firstValue - firstValue);
+  for (std::size_t i = 0; i < other.counts.size(); ++i)
+    counts[offset + i] -= other.counts[i];
+
+  const auto first = std::find_if(counts.cbegin(), counts.cend(), [](std::size_t n) { return 0 != n; });
+  if (first == counts.cend())
+  {
+    counts.clear();
+    return;
+  }
+
+  const auto last = std::find_if(counts.crbegin(), counts.crend(), [](std::size_t n) { return 0 != n; }).base();
+  firstValue += static_cast<long long>(first - counts.cbegin());
+  counts = std::vector<std::size_t>(first, last);
+}
+
+mitk::MaskedStatisticsSliceCache::MaskedStatisticsSliceCache()
+{
+  std::fill(m_Dimensions, m_Dimensions + 3, 0);
+}
+
+void mitk::MaskedStatisticsSliceCache::Initialize(const unsigned int dimensions[3])
+{
+  std::copy(dimensions, dimensions + 3, m_Dimensions);
+
+  m_Labels.clear();
+  m_Slices.assign(m_Dimensions[2], SliceStatisticsMapType());
+  m_InvalidSlices.assign(m_Dimensions[2], true);
+}
+
+bool mitk::MaskedStatisticsSliceCache::HasDimensions(const unsigned int dimensions[3]) const
+{
+  return std::equal(dimensions, dimensions + 3, m_Dimensions);
+}
+
+void mitk::MaskedStatisticsSliceCache::InvalidateSlices(unsigned int firstSlice, unsigned int lastSlice)
+{
+  if (m_InvalidSlices.empty() || firstSlice > lastSlice || firstSlice >= m_InvalidSlices.size())
+    return;
+
+  lastSlice = std::min(lastSlice, static_cast<unsigned int>(m_InvalidSlices.size() - 1));
+  std::fill(m_InvalidSlices.begin() + firstSlice, m_InvalidSlices.begin() + lastSlice + 1, true);
+}
+
+void mitk::MaskedStatisticsSliceCache::InvalidateAll()
+{
+  this->InvalidateSlices(0, std::numeric_limits<unsigned int>::max());
+}
+
+void mitk::MaskedStatisticsSliceCache::Update(const SliceScannerType &scanner)
+{
+  std::vector<unsigned int> invalidSlices;
+  for (unsigned int z = 0; z < m_InvalidSlices.size(); ++z)
+  {
+    if (m_InvalidSlices[z])
+      invalidSlices.push_back(z);
+  }
+
+  if (invalidSlices.empty())
+    return;
+
+  std::vector<SliceStatisticsMapType> results(invalidSlices.size());
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    invalidSlices.size(),
+    [&scanner, &invalidSlices, &results](itk::SizeValueType i) { scanner(invalidSlices[i], results[i]); },
+    nullptr);
+
+  std::set<LabelPixelType> affectedLabels;
+
+  for (std::size_t i = 0; i < invalidSlices.size(); ++i)
+  {
+    const unsigned int z = invalidSlices[i];
+
+    // remove the value counts of the previous scan of the slice ...
+    for (const auto &oldStatistics : m_Slices[z])
+    {
+      m_Labels[oldStatistics.first].valueCounts.Subtract(oldStatistics.second.valueCounts);
+      affectedLabels.insert(oldStatistics.first);
+    }
+
+    // ... and add the new ones
+    for (const auto &newStatistics : results[i])
+    {
+      m_Labels[newStatistics.first].valueCounts.Merge(newStatistics.second.valueCounts);
+      affectedLabels.insert(newStatistics.first);
+    }
+
+    m_Slices[z].swap(results[i]);
+    m_InvalidSlices[z] = false;
+  }
+
+  // sums are merged from the slices again instead of subtracting the old contribution, which
+  // keeps them free of cancellation errors and is cheap compared to scanning a single slice
+  for (const auto label : affectedLabels)
+  {
+    auto finding = m_Labels.find(label);
+    if (finding->second.valueCounts.IsEmpty())
+    {
+      m_Labels.erase(finding);
+      continue;
+    }
+
+    Aggregate aggregate;
+    for (const auto &slice : m_Slices)
+    {
+      const auto sliceFinding = slice.find(label);
+      if (sliceFinding != slice.cend())
+        aggregate.Merge(sliceFinding->second.aggregate);
+    }
+
+    finding->second.aggregate = aggregate;
+  }
+}
+
+std::vector<mitk::MaskedStatisticsSliceCache::LabelPixelType> mitk::MaskedStatisticsSliceCache::GetLabelValues() const
+{
+  std::vector<LabelPixelType> labels;
+  labels.reserve(m_Labels.size());
+  for (const auto &label : m_Labels)
+    labels.push_back(label.first);
+
+  return labels;
+}
+
+const mitk::MaskedStatisticsSliceCache::Aggregate *mitk::MaskedStatisticsSliceCache::GetAggregate(LabelPixelType label) const
+{
+  const auto finding = m_Labels.find(label);
+  return finding != m_Labels.cend() ? &(finding->second.aggregate) : nullptr;
+}
+
+const mitk::MaskedStatisticsSliceCache::ValueCountsType *mitk::MaskedStatisticsSliceCache::GetValueCounts(LabelPixelType label) const
+{
+  const auto finding = m_Labels.find(label);
+  return finding != m_Labels.cend() ? &(finding->second.valueCounts) : nullptr;
+}
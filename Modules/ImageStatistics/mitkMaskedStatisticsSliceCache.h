@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMaskedStatisticsSliceCache_h
+#define mitkMaskedStatisticsSliceCache_h
+
+#include <MitkImageStatisticsExports.h>
+
+#include <itkIndex.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Mergeable partial statistics of all mask labels of one 3D volume, kept per axial slice.
+   *
+   * For every slice (third index axis) and every mask label found in that slice, the cache stores
+   * count, sums of powers, minimum and maximum with their indices and the counts of the pixel
+   * values. The statistics of a label are merged from its slice entries. After the mask (or the
+   * image) has been edited, only the affected slices are marked with InvalidateSlices() and
+   * rescanned by the next Update(), so the costs of an update scale with the edited slices and the
+   * value range of the affected labels, not with the volume.
+   *
+   * Histograms are not stored as bins but as value counts, because the bins depend on the value
+   * range of a label, which may change with every edit. The counts are kept densely over the value
+   * range of a label, so the cache is only meant for pixel types with small integer ranges
+   * (8 and 16 bit integers).
+   */
+  class MITKIMAGESTATISTICS_EXPORT MaskedStatisticsSliceCache
+  {
+  public:
+    typedef unsigned short LabelPixelType;
+    typedef itk::Index<3> IndexType;
+
+    /** Counts of the integer pixel values firstValue, firstValue + 1, ... of one label. */
+    struct ValueCounts
+    {
+      long long firstValue = 0;
+      std::vector<std::size_t> counts;
+
+      /** Extends the counted range to cover minValue to maxValue. */
+      void Reserve(long long minValue, long long maxValue);
+      /** Counts one occurrence of value, which has to be in the reserved range. */
+      void Add(long long value) { ++counts[static_cast<std::size_t>(value - firstValue)]; }
+      void Merge(const ValueCounts &other);
+      /** Removes counts merged before and trims the range to the values that are left. */
+      void Subtract(const ValueCounts &other);
+      bool IsEmpty() const { return counts.empty(); }
+    };
+
+    typedef ValueCounts ValueCountsType;
+
+    /** Sums and extrema of the voxels of one label, either of a single slice or merged. */
+    struct Aggregate
+    {
+      std::size_t count = 0;
+      std::size_t countOfPositivePixels = 0;
+      double sum = 0.0;
+      double sumOfPositivePixels = 0.0;
+      double sumOfSquares = 0.0;
+      double sumOfCubes = 0.0;
+      double sumOfQuadruples = 0.0;
+      double min = 0.0;
+      double max = 0.0;
+      /** First occurrence of min and max in memory order. */
+      IndexType minIndex;
+      IndexType maxIndex;
+
+      void Add(double value, const IndexType &index);
+      void Merge(const Aggregate &other);
+    };
+
+    struct SliceStatistics
+    {
+      Aggregate aggregate;
+      ValueCountsType valueCounts;
+    };
+
+    typedef std::map<LabelPixelType, SliceStatistics> SliceStatisticsMapType;
+
+    /** Function that scans one slice of the volume and fills the statistics of every label found in it. */
+    typedef std::function<void(unsigned int slice, SliceStatisticsMapType &result)> SliceScannerType;
+
+    MaskedStatisticsSliceCache();
+
+    /** @brief Resets the cache to a volume of the given size. All slices are invalid afterwards. */
+    void Initialize(const unsigned int dimensions[3]);
+
+    /** @brief Returns true if the cache was initialized with the given volume size. */
+    bool HasDimensions(const unsigned int dimensions[3]) const;
+
+    /** @brief Marks the slices firstSlice to lastSlice (inclusive, clamped to the volume) for rescanning. */
+    void InvalidateSlices(unsigned int firstSlice, unsigned int lastSlice);
+
+    /** @brief Marks all slices for rescanning. */
+    void InvalidateAll();
+
+    /**
+     * @brief Rescans all invalidated slices with the passed scanner and re-merges the statistics of
+     *        every label that was or is found in these slices.
+     * The scanner is called concurrently for different slices.
+     */
+    void Update(const SliceScannerType &scanner);
+
+    /** @brief Returns all labels that occur in the volume as of the last Update(). */
+    std::vector<LabelPixelType> GetLabelValues() const;
+
+    /** @brief Returns the merged statistics of a label or nullptr if the label does not occur in the volume. */
+    const Aggregate *GetAggregate(LabelPixelType label) const;
+
+    /** @brief Returns the counts of all pixel values of a label or nullptr if the label does not occur in the volume. */
+    const ValueCountsType *GetValueCounts(LabelPixelType label) const;
+
+  private:
+    unsigned int m_Dimensions[3];
+
+    /** Merged statistics of every label in the volume. */
+    SliceStatisticsMapType m_Labels;
+
+    /** Statistics of every label found in a slice by the last scan of the slice. */
+    std::vector<SliceStatisticsMapType> m_Slices;
+
+    std::vector<bool> m_InvalidSlices;
+  };
+}
+
+#endif
@@ -25,6 +25,8 @@ found in the LICENSE file.
 #include <itkSimpleDataObjectDecorator.h>
 
 #include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace mitk
 {
@@ -42,6 +44,7 @@ namespace mitk
     itkTypeMacro(StatisticsImageFilter, itk::ImageSink);
 
     using RegionType = typename TInputImage::RegionType;
+    using IndexType = typename TInputImage::IndexType;
     using PixelType = typename TInputImage::PixelType;
 
     using RealType = typename itk::NumericTraits<PixelType>::RealType;
@@ -78,6 +81,19 @@ namespace mitk
 
     void SetHistogramParameters(unsigned int size, RealType lowerBound, RealType upperBound);
 
+    /** Computes a histogram with the given number of bins between the minimum and the maximum of the input. */
+    void SetHistogramParametersForDataRange(unsigned int size);
+
+    /** Computes a histogram between the minimum and the maximum of the input with bins of (roughly) the given size,
+        but at least 10 bins. */
+    void SetHistogramBinSizeForDataRange(RealType binSize);
+
+    /** Index of the first pixel (in memory order) with the minimum value. */
+    IndexType GetMinimumIndex() const { return m_MinIndex; }
+
+    /** Index of the first pixel (in memory order) with the maximum value. */
+    IndexType GetMaximumIndex() const { return m_MaxIndex; }
+
     using DataObjectIdentifierType = itk::ProcessObject::DataObjectIdentifierType;
     using Superclass::MakeOutput;
     
@@ -113,9 +129,21 @@ namespace mitk
     void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
   private:
+    /** Pixel types with at most 16 bit are counted per value in the threaded pass. Moments and histogram
+        are derived from these counts, so all statistics are gathered in a single pass over the image. */
+    static constexpr bool CountValues = std::is_integral<PixelType>::value && sizeof(PixelType) <= 2;
+
+    static std::size_t ValueToCountIndex(PixelType value);
+    static PixelType CountIndexToValue(std::size_t index);
+    static bool IsBefore(const IndexType &index, const IndexType &other);
+
     HistogramPointer CreateInitializedHistogram() const;
+    void MergeHistogram(const HistogramType *histogram);
+    void MergeMinimumAndMaximum(PixelType min, const IndexType &minIndex, PixelType max, const IndexType &maxIndex);
 
     bool m_ComputeHistogram;
+    bool m_HistogramRangeFromData;
+    RealType m_HistogramBinSize;
     unsigned int m_HistogramSize;
     RealType m_HistogramLowerBound;
     RealType m_HistogramUpperBound;
@@ -131,6 +159,9 @@ namespace mitk
     itk::SizeValueType m_CountOfPositivePixels;
     PixelType m_Min;
     PixelType m_Max;
+    IndexType m_MinIndex;
+    IndexType m_MaxIndex;
+    std::vector<itk::SizeValueType> m_ValueCounts;
 
     std::mutex m_Mutex;
   };
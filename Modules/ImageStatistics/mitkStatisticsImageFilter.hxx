@@ -16,10 +16,17 @@ found in the LICENSE file.
 #include <mitkStatisticsImageFilter.h>
 #include <mitkHistogramStatisticsCalculator.h>
 #include <itkImageScanlineConstIterator.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 template <typename TInputImage>
 mitk::StatisticsImageFilter<TInputImage>::StatisticsImageFilter()
   : m_ComputeHistogram(false),
+    m_HistogramRangeFromData(false),
+    m_HistogramBinSize(0),
     m_HistogramSize(0),
     m_HistogramLowerBound(itk::NumericTraits<RealType>::NonpositiveMin()),
     m_HistogramUpperBound(itk::NumericTraits<RealType>::max()),
@@ -35,6 +42,9 @@ mitk::StatisticsImageFilter<TInputImage>::StatisticsImageFilter()
 {
   this->SetNumberOfRequiredInputs(1);
 
+  m_MinIndex.Fill(0);
+  m_MaxIndex.Fill(0);
+
   this->SetMinimum(itk::NumericTraits<PixelType>::max());
   this->SetMaximum(itk::NumericTraits<PixelType>::NonpositiveMin());
   this->SetMean(itk::NumericTraits<RealType>::max());
@@ -116,12 +126,64 @@ void mitk::StatisticsImageFilter<TInputImage>::SetHistogramParameters(unsigned i
     modified = true;
   }
 
+  if (!m_ComputeHistogram || m_HistogramRangeFromData)
+    modified = true;
+
   m_ComputeHistogram = true;
+  m_HistogramRangeFromData = false;
 
   if (modified)
     this->Modified();
 }
 
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::SetHistogramParametersForDataRange(unsigned int size)
+{
+  if (!m_ComputeHistogram || !m_HistogramRangeFromData || m_HistogramSize != size || m_HistogramBinSize != 0)
+  {
+    m_ComputeHistogram = true;
+    m_HistogramRangeFromData = true;
+    m_HistogramSize = size;
+    m_HistogramBinSize = 0;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::SetHistogramBinSizeForDataRange(RealType binSize)
+{
+  if (!m_ComputeHistogram || !m_HistogramRangeFromData || m_HistogramBinSize != binSize)
+  {
+    m_ComputeHistogram = true;
+    m_HistogramRangeFromData = true;
+    m_HistogramBinSize = binSize;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage>
+std::size_t mitk::StatisticsImageFilter<TInputImage>::ValueToCountIndex(PixelType value)
+{
+  return static_cast<std::size_t>(static_cast<long long>(value) - std::numeric_limits<PixelType>::lowest());
+}
+
+template <typename TInputImage>
+auto mitk::StatisticsImageFilter<TInputImage>::CountIndexToValue(std::size_t index) -> PixelType
+{
+  return static_cast<PixelType>(static_cast<long long>(index) + std::numeric_limits<PixelType>::lowest());
+}
+
+template <typename TInputImage>
+bool mitk::StatisticsImageFilter<TInputImage>::IsBefore(const IndexType &index, const IndexType &other)
+{
+  for (int i = static_cast<int>(TInputImage::ImageDimension) - 1; i >= 0; --i)
+  {
+    if (index[i] != other[i])
+      return index[i] < other[i];
+  }
+  return false;
+}
+
 template <typename TInputImage>
 auto mitk::StatisticsImageFilter<TInputImage>::CreateInitializedHistogram() const -> HistogramPointer
 {
@@ -144,6 +206,41 @@ auto mitk::StatisticsImageFilter<TInputImage>::CreateInitializedHistogram() cons
   return histogram;
 }
 
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::MergeHistogram(const HistogramType *histogram)
+{
+  typename HistogramType::IndexType histogramIndex;
+  typename HistogramType::ConstIterator histogramIt = histogram->Begin();
+  typename HistogramType::ConstIterator histogramEnd = histogram->End();
+
+  while (histogramIt != histogramEnd)
+  {
+    m_Histogram->GetIndex(histogramIt.GetMeasurementVector(), histogramIndex);
+    m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, histogramIt.GetFrequency());
+    ++histogramIt;
+  }
+}
+
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::MergeMinimumAndMaximum(PixelType min,
+                                                                     const IndexType &minIndex,
+                                                                     PixelType max,
+                                                                     const IndexType &maxIndex)
+{
+  // ties are resolved by memory order, so the result does not depend on the split into threads
+  if (min < m_Min || (min == m_Min && IsBefore(minIndex, m_MinIndex)))
+  {
+    m_Min = min;
+    m_MinIndex = minIndex;
+  }
+
+  if (max > m_Max || (max == m_Max && IsBefore(maxIndex, m_MaxIndex)))
+  {
+    m_Max = max;
+    m_MaxIndex = maxIndex;
+  }
+}
+
 template <typename TInputImage>
 void mitk::StatisticsImageFilter<TInputImage>::BeforeStreamedGenerateData()
 {
@@ -158,104 +255,247 @@ void mitk::StatisticsImageFilter<TInputImage>::BeforeStreamedGenerateData()
   m_CountOfPositivePixels = 0;
   m_Min = itk::NumericTraits<PixelType>::max();
   m_Max = itk::NumericTraits<PixelType>::NonpositiveMin();
+  m_MinIndex = this->GetInput()->GetLargestPossibleRegion().GetUpperIndex();
+  m_MaxIndex = m_MinIndex;
 
-  if (m_ComputeHistogram)
+  if constexpr (CountValues)
+  {
+    m_ValueCounts.assign(std::size_t(1) << (8 * sizeof(PixelType)), 0);
+  }
+  else if (m_ComputeHistogram && !m_HistogramRangeFromData)
+  {
     m_Histogram = this->CreateInitializedHistogram();
+  }
 }
 
 template <typename TInputImage>
 void mitk::StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType& regionForThread)
 {
-  itk::CompensatedSummation<RealType> sum = 0;
-  itk::CompensatedSummation<RealType> sumOfPositivePixels = 0;
-  itk::CompensatedSummation<RealType> sumOfSquares = 0;
-  itk::CompensatedSummation<RealType> sumOfCubes = 0;
-  itk::CompensatedSummation<RealType> sumOfQuadruples = 0;
-  itk::SizeValueType count = 0;
-  itk::SizeValueType countOfPositivePixels = 0;
   auto min = itk::NumericTraits<PixelType>::max();
   auto max = itk::NumericTraits<PixelType>::NonpositiveMin();
-  RealType realValue = 0;
-  RealType squareValue = 0;
+  IndexType minIndex = regionForThread.GetIndex();
+  IndexType maxIndex = regionForThread.GetIndex();
 
-  HistogramPointer histogram;
-  typename HistogramType::MeasurementVectorType histogramMeasurement;
-  typename HistogramType::IndexType histogramIndex;
+  itk::ImageScanlineConstIterator<TInputImage> it(this->GetInput(), regionForThread);
 
-  if (m_ComputeHistogram) // Initialize histogram
+  if constexpr (CountValues)
   {
-    histogram = this->CreateInitializedHistogram();
-    histogramMeasurement.SetSize(1);
-  }
+    std::vector<itk::SizeValueType> valueCounts(m_ValueCounts.size(), 0);
 
-  itk::ImageScanlineConstIterator<TInputImage> it(this->GetInput(), regionForThread);
+    while (!it.IsAtEnd())
+    {
+      while (!it.IsAtEndOfLine())
+      {
+        const PixelType value = it.Get();
+        ++valueCounts[ValueToCountIndex(value)];
+
+        if (value < min)
+        {
+          min = value;
+          minIndex = it.GetIndex();
+        }
+        if (value > max)
+        {
+          max = value;
+          maxIndex = it.GetIndex();
+        }
+
+        ++it;
+      }
+
+      it.NextLine();
+    }
+
+    std::lock_guard<std::mutex> mutexHolder(m_Mutex);
 
-  while (!it.IsAtEnd())
+    for (std::size_t i = 0; i < valueCounts.size(); ++i)
+      m_ValueCounts[i] += valueCounts[i];
+
+    this->MergeMinimumAndMaximum(min, minIndex, max, maxIndex);
+  }
+  else
   {
-    while (!it.IsAtEndOfLine())
+    itk::CompensatedSummation<RealType> sum = 0;
+    itk::CompensatedSummation<RealType> sumOfPositivePixels = 0;
+    itk::CompensatedSummation<RealType> sumOfSquares = 0;
+    itk::CompensatedSummation<RealType> sumOfCubes = 0;
+    itk::CompensatedSummation<RealType> sumOfQuadruples = 0;
+    itk::SizeValueType count = 0;
+    itk::SizeValueType countOfPositivePixels = 0;
+    RealType realValue = 0;
+    RealType squareValue = 0;
+
+    // a histogram over the data range can only be computed once the range is known
+    const bool computeHistogram = m_ComputeHistogram && !m_HistogramRangeFromData;
+
+    HistogramPointer histogram;
+    typename HistogramType::MeasurementVectorType histogramMeasurement;
+    typename HistogramType::IndexType histogramIndex;
+
+    if (computeHistogram) // Initialize histogram
     {
-      const auto& value = it.Get();
-      realValue = static_cast<RealType>(value);
+      histogram = this->CreateInitializedHistogram();
+      histogramMeasurement.SetSize(1);
+    }
 
-      if (m_ComputeHistogram) // Compute histogram
+    while (!it.IsAtEnd())
+    {
+      while (!it.IsAtEndOfLine())
       {
-        histogramMeasurement[0] = realValue;
-        histogram->GetIndex(histogramMeasurement, histogramIndex);
-        histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        const auto& value = it.Get();
+        realValue = static_cast<RealType>(value);
+
+        if (computeHistogram) // Compute histogram
+        {
+          histogramMeasurement[0] = realValue;
+          histogram->GetIndex(histogramMeasurement, histogramIndex);
+          histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        }
+
+        if (value < min)
+        {
+          min = value;
+          minIndex = it.GetIndex();
+        }
+        if (value > max)
+        {
+          max = value;
+          maxIndex = it.GetIndex();
+        }
+
+        squareValue = realValue * realValue;
+
+        sum += realValue;
+        sumOfSquares += squareValue;
+        sumOfCubes += squareValue * realValue;
+        sumOfQuadruples += squareValue * squareValue;
+        ++count;
+
+        if (0 < realValue)
+        {
+          sumOfPositivePixels += realValue;
+          ++countOfPositivePixels;
+        }
+
+        ++it;
       }
 
-      min = std::min(min, value);
-      max = std::max(max, value);
-      squareValue = realValue * realValue;
+      it.NextLine();
+    }
+
+    std::lock_guard<std::mutex> mutexHolder(m_Mutex);
+
+    if (computeHistogram) // Merge histograms
+      this->MergeHistogram(histogram);
+
+    m_Sum += sum;
+    m_SumOfPositivePixels += sumOfPositivePixels;
+    m_SumOfSquares += sumOfSquares;
+    m_SumOfCubes += sumOfCubes;
+    m_SumOfQuadruples += sumOfQuadruples;
+    m_Count += count;
+    m_CountOfPositivePixels += countOfPositivePixels;
+    this->MergeMinimumAndMaximum(min, minIndex, max, maxIndex);
+  }
+}
+
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
+{
+  Superclass::AfterStreamedGenerateData();
+
+  if constexpr (CountValues)
+  {
+    for (std::size_t i = 0; i < m_ValueCounts.size(); ++i)
+    {
+      const itk::SizeValueType valueCount = m_ValueCounts[i];
+      if (0 == valueCount)
+        continue;
+
+      const RealType realValue = static_cast<RealType>(CountIndexToValue(i));
+      const RealType realCount = static_cast<RealType>(valueCount);
+      const RealType squareValue = realValue * realValue;
 
-      sum += realValue;
-      sumOfSquares += squareValue;
-      sumOfCubes += squareValue * realValue;
-      sumOfQuadruples += squareValue * squareValue;
-      ++count;
+      m_Sum += realValue * realCount;
+      m_SumOfSquares += squareValue * realCount;
+      m_SumOfCubes += squareValue * realValue * realCount;
+      m_SumOfQuadruples += squareValue * squareValue * realCount;
+      m_Count += valueCount;
 
       if (0 < realValue)
       {
-        sumOfPositivePixels += realValue;
-        ++countOfPositivePixels;
+        m_SumOfPositivePixels += realValue * realCount;
+        m_CountOfPositivePixels += valueCount;
       }
-
-      ++it;
     }
-
-    it.NextLine();
   }
 
-  std::lock_guard<std::mutex> mutexHolder(m_Mutex);
-
-  if (m_ComputeHistogram) // Merge histograms
+  if (m_ComputeHistogram && m_HistogramRangeFromData)
   {
-    typename HistogramType::ConstIterator histogramIt = histogram->Begin();
-    typename HistogramType::ConstIterator histogramEnd = histogram->End();
+    m_HistogramLowerBound = static_cast<RealType>(m_Min);
+    m_HistogramUpperBound = static_cast<RealType>(m_Max);
 
-    while (histogramIt != histogramEnd)
+    if (0 < m_HistogramBinSize)
     {
-      m_Histogram->GetIndex(histogramIt.GetMeasurementVector(), histogramIndex);
-      m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, histogramIt.GetFrequency());
-      ++histogramIt;
+      m_HistogramSize = static_cast<unsigned int>(
+        std::max(static_cast<double>(std::ceil(m_HistogramUpperBound - m_HistogramLowerBound)) / m_HistogramBinSize,
+                 10.)); // do not allow less than 10 bins
     }
   }
 
-  m_Sum += sum;
-  m_SumOfPositivePixels += sumOfPositivePixels;
-  m_SumOfSquares += sumOfSquares;
-  m_SumOfCubes += sumOfCubes;
-  m_SumOfQuadruples += sumOfQuadruples;
-  m_Count += count;
-  m_CountOfPositivePixels += countOfPositivePixels;
-  m_Min = std::min(min, m_Min);
-  m_Max = std::max(max, m_Max);
-}
+  if (m_ComputeHistogram && (CountValues || m_HistogramRangeFromData))
+  {
+    m_Histogram = this->CreateInitializedHistogram();
 
-template <typename TInputImage>
-void mitk::StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
-{
-  Superclass::AfterStreamedGenerateData();
+    typename HistogramType::MeasurementVectorType histogramMeasurement;
+    typename HistogramType::IndexType histogramIndex;
+    histogramMeasurement.SetSize(1);
+
+    if constexpr (CountValues)
+    {
+      for (std::size_t i = 0; i < m_ValueCounts.size(); ++i)
+      {
+        if (0 == m_ValueCounts[i])
+          continue;
+
+        histogramMeasurement[0] = static_cast<RealType>(CountIndexToValue(i));
+        m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+        m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, m_ValueCounts[i]);
+      }
+    }
+    else
+    {
+      // second pass, the range of the histogram was not known before
+      if (1 < this->GetNumberOfStreamDivisions())
+        itkExceptionMacro("A histogram over the data range requires the input to be processed in a single stream division.");
+
+      itk::MultiThreaderBase::New()->ParallelizeImageRegion<TInputImage::ImageDimension>(
+        this->GetInput()->GetBufferedRegion(),
+        [this](const RegionType &region) {
+          auto histogram = this->CreateInitializedHistogram();
+          typename HistogramType::MeasurementVectorType measurement;
+          typename HistogramType::IndexType index;
+          measurement.SetSize(1);
+
+          itk::ImageScanlineConstIterator<TInputImage> it(this->GetInput(), region);
+          while (!it.IsAtEnd())
+          {
+            while (!it.IsAtEndOfLine())
+            {
+              measurement[0] = static_cast<RealType>(it.Get());
+              histogram->GetIndex(measurement, index);
+              histogram->IncreaseFrequencyOfIndex(index, 1);
+              ++it;
+            }
+            it.NextLine();
+          }
+
+          std::lock_guard<std::mutex> mutexHolder(m_Mutex);
+          this->MergeHistogram(histogram);
+        },
+        nullptr);
+    }
+  }
 
   const RealType sum = m_Sum.GetSum();
   const RealType sumOfPositivePixels = m_SumOfPositivePixels.GetSum();
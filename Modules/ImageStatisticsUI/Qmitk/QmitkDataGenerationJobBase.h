@@ -51,11 +51,17 @@ public:
 
 signals:
     void Error(QString err, const QmitkDataGenerationJobBase* job);
-    /*! @brief Signal is emitted when results are available. 
+    /*! @brief Signal is emitted when results are available.
     @param results produced by the job and ready to be used.
     @param job the job that produced the data
     */
     void ResultsAvailable(ResultMapType results, const QmitkDataGenerationJobBase* job);
+    /*! @brief Signal may be emitted by jobs during the computation with incomplete results
+    (e.g. only some time steps). They are not final results and are followed by ResultsAvailable.
+    @param results produced by the job so far.
+    @param job the job that produced the data
+    */
+    void InterimResultsAvailable(ResultMapType results, const QmitkDataGenerationJobBase* job);
     
 protected:
   QmitkDataGenerationJobBase() = default;
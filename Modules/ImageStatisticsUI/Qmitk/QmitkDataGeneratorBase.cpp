@@ -36,6 +36,8 @@ QmitkDataGeneratorBase::~QmitkDataGeneratorBase()
     // remove "change node listener" from data storage
     dataStorage->ChangedNodeEvent.RemoveListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    dataStorage->RemoveNodeEvent.RemoveListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 }
 
@@ -66,6 +68,8 @@ void QmitkDataGeneratorBase::SetDataStorage(mitk::DataStorage* storage)
     // remove "change node listener" from old data storage
     oldStorage->ChangedNodeEvent.RemoveListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    oldStorage->RemoveNodeEvent.RemoveListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 
   m_Storage = storage;
@@ -77,6 +81,8 @@ void QmitkDataGeneratorBase::SetDataStorage(mitk::DataStorage* storage)
     // add change node listener for new data storage
     newStorage->ChangedNodeEvent.AddListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    newStorage->RemoveNodeEvent.AddListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 }
 
@@ -121,6 +127,22 @@ void QmitkDataGeneratorBase::OnFinalResultsAvailable(JobResultMapType results, c
   }
 }
 
+void QmitkDataGeneratorBase::OnInterimResultsAvailable(JobResultMapType results, const QmitkDataGenerationJobBase* /*job*/, mitk::DataNode* placeholderNode) const
+{
+  if (nullptr == placeholderNode || results.size() != 1 || results.begin()->second.IsNull())
+  {
+    return;
+  }
+
+  auto interimResult = results.begin()->second;
+  interimResult->SetProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str(), mitk::StringProperty::New(mitk::STATS_GENERATION_STATUS_VALUE_WORK_IN_PROGRESS));
+
+  std::lock_guard<std::mutex> mutexguard(m_DataMutex);
+  m_AddingToStorage = true;
+  placeholderNode->SetData(interimResult);
+  m_AddingToStorage = false;
+}
+
 void QmitkDataGeneratorBase::NodeAddedOrModified(const mitk::DataNode* node)
 {
   if (!m_AddingToStorage)
@@ -132,6 +154,15 @@ void QmitkDataGeneratorBase::NodeAddedOrModified(const mitk::DataNode* node)
   }
 }
 
+void QmitkDataGeneratorBase::NodeRemoved(const mitk::DataNode* node)
+{
+  this->ReleaseNodeResources(node);
+}
+
+void QmitkDataGeneratorBase::ReleaseNodeResources(const mitk::DataNode* /*node*/) const
+{
+}
+
 void QmitkDataGeneratorBase::EnsureRecheckingAndGeneration() const
 {
   m_RestartGeneration = true;
@@ -255,6 +286,10 @@ bool QmitkDataGeneratorBase::DoGenerate() const
         nextJob.second->GetData()->SetProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str(), mitk::StringProperty::New(mitk::STATS_GENERATION_STATUS_VALUE_WORK_IN_PROGRESS));
         connect(nextJob.first, &QmitkDataGenerationJobBase::Error, this, &QmitkDataGeneratorBase::OnJobError, Qt::BlockingQueuedConnection);
         connect(nextJob.first, &QmitkDataGenerationJobBase::ResultsAvailable, this, &QmitkDataGeneratorBase::OnFinalResultsAvailable, Qt::BlockingQueuedConnection);
+        mitk::DataNode::Pointer placeholderNode = nextJob.second;
+        connect(nextJob.first, &QmitkDataGenerationJobBase::InterimResultsAvailable, this,
+          [this, placeholderNode](JobResultMapType results, const QmitkDataGenerationJobBase* job) { this->OnInterimResultsAvailable(results, job, placeholderNode); },
+          Qt::BlockingQueuedConnection);
         emit DataGenerationStarted(imageAndSeg.first.GetPointer(), imageAndSeg.second.GetPointer(), nextJob.first);
         threadPool->start(nextJob.first);
       }
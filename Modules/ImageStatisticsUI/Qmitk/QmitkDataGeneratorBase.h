@@ -82,6 +82,9 @@ protected slots:
   void OnJobError(QString error, const QmitkDataGenerationJobBase* failedJob) const;
   /** Used by QmitkDataGenerationJobBase to signal and communicate the results of there computation. */
   void OnFinalResultsAvailable(JobResultMapType results, const QmitkDataGenerationJobBase *job) const;
+  /** Used by QmitkDataGenerationJobBase to communicate interim results. They replace the data of the WIP
+   placeholder node of the job, which keeps its status, so no further node is added and no recheck is triggered.*/
+  void OnInterimResultsAvailable(JobResultMapType results, const QmitkDataGenerationJobBase *job, mitk::DataNode* placeholderNode) const;
 
 signals:
 
@@ -137,6 +140,12 @@ protected:
   /*! Creates a data node for WIP place holder results. It can be used by IndicateFutureResults().*/
   static mitk::DataNode::Pointer CreateWIPDataNode(mitk::BaseData* dataDummy, const std::string& nodeName);
 
+  /** Is called when a node is removed from the storage. Derived classes can release everything they keep for the data of
+  the node (e.g. cached computation states). The default implementation does nothing.
+  @remark It may be called while m_DataMutex is locked by the generator itself (see RemoveObsoleteDataNodes()), so the
+  mutex must not be locked by implementations.*/
+  virtual void ReleaseNodeResources(const mitk::DataNode* node) const;
+
   /** Filters a passed pair vector. The returned pair vector only contains pair of nodes that exist in the data storage.*/
   InputPairVectorType FilterImageROICombinations(InputPairVectorType&& imageROICombinations) const;
 
@@ -168,6 +177,8 @@ private:
 
   /**Member is called when a node is added to the storage.*/
   void NodeAddedOrModified(const mitk::DataNode* node);
+  /**Member is called when a node is removed from the storage.*/
+  void NodeRemoved(const mitk::DataNode* node);
 
   unsigned long m_DataStorageDeletedTag;
 };
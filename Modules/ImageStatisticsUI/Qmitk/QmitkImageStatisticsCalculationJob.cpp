@@ -25,6 +25,7 @@ QmitkImageStatisticsCalculationJob::QmitkImageStatisticsCalculationJob()
   , m_IgnoreZeros(false)
   , m_HistogramNBins(100)
   , m_CalculationSuccessful(false)
+  , m_Calculator(mitk::ImageStatisticsCalculator::New())
 {
 }
 
@@ -103,13 +104,12 @@ bool QmitkImageStatisticsCalculationJob::GetStatisticsUpdateSuccessFlag() const
 void QmitkImageStatisticsCalculationJob::run()
 {
   bool statisticCalculationSuccessful = true;
-  mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+  // mask generators of the previous run are reused, so that the calculator only notices real changes of the inputs
+  mitk::ImageStatisticsCalculator::Pointer calculator = m_Calculator;
 
-  if(this->m_StatisticsImage.IsNotNull())
-  {
-    calculator->SetInputImage(m_StatisticsImage);
-  }
-  else
+  // also without image, the image of the previous run must not be used
+  calculator->SetInputImage(m_StatisticsImage);
+  if(this->m_StatisticsImage.IsNull())
   {
     statisticCalculationSuccessful = false;
   }
@@ -119,13 +119,6 @@ void QmitkImageStatisticsCalculationJob::run()
   // the same holds for the ::SetPlanarFigure()
   try
   {
-    if(this->m_BinaryMask.IsNotNull())
-    {
-      mitk::ImageMaskGenerator::Pointer imgMask = mitk::ImageMaskGenerator::New();
-      imgMask->SetInputImage(m_StatisticsImage);
-      imgMask->SetImageMask(m_BinaryMask);
-      calculator->SetMask(imgMask.GetPointer());
-    }
     if(this->m_PlanarFigureMask.IsNotNull())
     {
       mitk::PlanarFigureMaskGenerator::Pointer pfMaskGen = mitk::PlanarFigureMaskGenerator::New();
@@ -133,6 +126,21 @@ void QmitkImageStatisticsCalculationJob::run()
       pfMaskGen->SetPlanarFigure(m_PlanarFigureMask->Clone());
       calculator->SetMask(pfMaskGen.GetPointer());
     }
+    else if(this->m_BinaryMask.IsNotNull())
+    {
+      mitk::ImageMaskGenerator::Pointer imgMask = dynamic_cast<mitk::ImageMaskGenerator*>(calculator->GetMask());
+      if (imgMask.IsNull())
+      {
+        imgMask = mitk::ImageMaskGenerator::New();
+      }
+      imgMask->SetInputImage(m_StatisticsImage);
+      imgMask->SetImageMask(m_BinaryMask);
+      calculator->SetMask(imgMask.GetPointer());
+    }
+    else
+    {
+      calculator->SetMask(nullptr);
+    }
   }
   catch (const mitk::Exception& e)
   {
@@ -161,7 +169,11 @@ void QmitkImageStatisticsCalculationJob::run()
 
   if (this->m_IgnoreZeros)
   {
-      mitk::IgnorePixelMaskGenerator::Pointer ignorePixelValueMaskGen = mitk::IgnorePixelMaskGenerator::New();
+      mitk::IgnorePixelMaskGenerator::Pointer ignorePixelValueMaskGen = dynamic_cast<mitk::IgnorePixelMaskGenerator*>(calculator->GetSecondaryMask());
+      if (ignorePixelValueMaskGen.IsNull())
+      {
+        ignorePixelValueMaskGen = mitk::IgnorePixelMaskGenerator::New();
+      }
       ignorePixelValueMaskGen->SetIgnoredPixelValue(0);
       ignorePixelValueMaskGen->SetInputImage(m_StatisticsImage);
       calculator->SetSecondaryMask(ignorePixelValueMaskGen.GetPointer());
@@ -200,7 +212,8 @@ void QmitkImageStatisticsCalculationJob::run()
 
   if(statisticCalculationSuccessful)
   {
-    m_StatisticsContainer = calculator->GetStatistics();
+    // the calculator fills its containers further in later runs
+    m_StatisticsContainer = calculator->GetStatistics()->Clone();
     this->m_HistogramVector.clear();
 
     for (unsigned int i = 0; i < m_StatisticsImage->GetTimeSteps(); i++)
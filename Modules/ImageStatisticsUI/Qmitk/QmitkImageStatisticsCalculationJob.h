@@ -19,6 +19,7 @@ found in the LICENSE file.
 //mitk headers
 #include "mitkImage.h"
 #include "mitkPlanarFigure.h"
+#include "mitkImageStatisticsCalculator.h"
 #include "mitkImageStatisticsContainer.h"
 #include <MitkImageStatisticsUIExports.h>
 
@@ -94,5 +95,6 @@ private:
   bool m_CalculationSuccessful;                                   ///< flag set if statistics calculation was successful
   std::vector<HistogramType::ConstPointer> m_HistogramVector;          ///< member holds the histograms of all time steps.
   std::string m_message;
+  mitk::ImageStatisticsCalculator::Pointer m_Calculator;              ///< kept between runs, so that only outdated time steps are computed again.
 };
 #endif // QMITKIMAGESTATISTICSCALCULATIONTHREAD_H_INCLUDED
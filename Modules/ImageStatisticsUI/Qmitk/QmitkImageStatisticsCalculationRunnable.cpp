@@ -28,6 +28,7 @@ QmitkImageStatisticsCalculationRunnable::QmitkImageStatisticsCalculationRunnable
   , m_PlanarFigureMask(nullptr)
   , m_IgnoreZeros(false)
   , m_HistogramNBins(100)
+  , m_TimeStep(0)
 {
 }
 
@@ -84,6 +85,26 @@ unsigned int QmitkImageStatisticsCalculationRunnable::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsCalculationRunnable::SetTimeStep(mitk::TimeStepType timeStep)
+{
+  this->m_TimeStep = timeStep;
+}
+
+mitk::TimeStepType QmitkImageStatisticsCalculationRunnable::GetTimeStep() const
+{
+  return this->m_TimeStep;
+}
+
+void QmitkImageStatisticsCalculationRunnable::SetCalculator(mitk::ImageStatisticsCalculator* calculator)
+{
+  this->m_Calculator = calculator;
+}
+
+mitk::ImageStatisticsCalculator* QmitkImageStatisticsCalculationRunnable::GetCalculator() const
+{
+  return this->m_Calculator.GetPointer();
+}
+
 QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnable::GetResults() const
 {
   ResultMapType result;
@@ -91,93 +112,132 @@ QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnabl
   return result;
 }
 
-bool QmitkImageStatisticsCalculationRunnable::RunComputation()
+void QmitkImageStatisticsCalculationRunnable::ConfigureCalculator()
 {
-  bool statisticCalculationSuccessful = true;
-  mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+  m_Calculator->SetInputImage(m_StatisticsImage);
 
-  if (this->m_StatisticsImage.IsNotNull())
+  if (this->m_PlanarFigureMask.IsNotNull())
   {
-    calculator->SetInputImage(m_StatisticsImage);
+    mitk::PlanarFigureMaskGenerator::Pointer pfMaskGen = mitk::PlanarFigureMaskGenerator::New();
+    pfMaskGen->SetInputImage(m_StatisticsImage);
+    pfMaskGen->SetPlanarFigure(m_PlanarFigureMask->Clone());
+    m_Calculator->SetMask(pfMaskGen.GetPointer());
   }
-  else
-  {
-    statisticCalculationSuccessful = false;
-  }
-
-  // Bug 13416 : The ImageStatistics::SetImageMask() method can throw exceptions, i.e. when the dimensionality
-  // of the masked and input image differ, we need to catch them and mark the calculation as failed
-  // the same holds for the ::SetPlanarFigure()
-  try
+  else if (this->m_BinaryMask.IsNotNull())
   {
-    if (this->m_BinaryMask.IsNotNull())
+    mitk::ImageMaskGenerator::Pointer imgMask = dynamic_cast<mitk::ImageMaskGenerator*>(m_Calculator->GetMask());
+    if (imgMask.IsNull())
     {
-      mitk::ImageMaskGenerator::Pointer imgMask = mitk::ImageMaskGenerator::New();
-      imgMask->SetInputImage(m_StatisticsImage);
-      imgMask->SetImageMask(m_BinaryMask);
-      calculator->SetMask(imgMask.GetPointer());
-    }
-    if (this->m_PlanarFigureMask.IsNotNull())
-    {
-      mitk::PlanarFigureMaskGenerator::Pointer pfMaskGen = mitk::PlanarFigureMaskGenerator::New();
-      pfMaskGen->SetInputImage(m_StatisticsImage);
-      pfMaskGen->SetPlanarFigure(m_PlanarFigureMask->Clone());
-      calculator->SetMask(pfMaskGen.GetPointer());
+      imgMask = mitk::ImageMaskGenerator::New();
     }
+    imgMask->SetInputImage(m_StatisticsImage);
+    imgMask->SetImageMask(m_BinaryMask);
+    m_Calculator->SetMask(imgMask.GetPointer());
   }
-  catch (const std::exception &e)
+  else
   {
-    MITK_ERROR << "Error while configuring the statistics calculator: " << e.what();
-    m_LastErrorMessage = e.what();
-    statisticCalculationSuccessful = false;
+    m_Calculator->SetMask(nullptr);
   }
 
   if (this->m_IgnoreZeros)
   {
-    mitk::IgnorePixelMaskGenerator::Pointer ignorePixelValueMaskGen = mitk::IgnorePixelMaskGenerator::New();
+    mitk::IgnorePixelMaskGenerator::Pointer ignorePixelValueMaskGen = dynamic_cast<mitk::IgnorePixelMaskGenerator*>(m_Calculator->GetSecondaryMask());
+    if (ignorePixelValueMaskGen.IsNull())
+    {
+      ignorePixelValueMaskGen = mitk::IgnorePixelMaskGenerator::New();
+    }
     ignorePixelValueMaskGen->SetIgnoredPixelValue(0);
     ignorePixelValueMaskGen->SetInputImage(m_StatisticsImage);
-    calculator->SetSecondaryMask(ignorePixelValueMaskGen.GetPointer());
+    m_Calculator->SetSecondaryMask(ignorePixelValueMaskGen.GetPointer());
   }
   else
   {
-    calculator->SetSecondaryMask(nullptr);
+    m_Calculator->SetSecondaryMask(nullptr);
   }
 
-  calculator->SetNBinsForHistogramStatistics(m_HistogramNBins);
+  m_Calculator->SetNBinsForHistogramStatistics(m_HistogramNBins);
+}
+
+mitk::ImageStatisticsContainer::Pointer QmitkImageStatisticsCalculationRunnable::CreateResultContainer(const mitk::ImageStatisticsContainer* statistics) const
+{
+  auto result = statistics->Clone();
+
+  auto imageRule = mitk::StatisticsToImageRelationRule::New();
+  imageRule->Connect(result, m_StatisticsImage);
 
-  try
+  if (nullptr != m_PlanarFigureMask)
   {
-    calculator->GetStatistics();
+    auto maskRule = mitk::StatisticsToMaskRelationRule::New();
+    maskRule->Connect(result, m_PlanarFigureMask);
   }
-  catch (const std::exception &e)
+
+  if (nullptr != m_BinaryMask)
   {
-    m_LastErrorMessage = "Failure while calculating the statistics: " + std::string(e.what());
-    MITK_ERROR << m_LastErrorMessage;
-    statisticCalculationSuccessful = false;
+    auto maskRule = mitk::StatisticsToMaskRelationRule::New();
+    maskRule->Connect(result, m_BinaryMask);
   }
 
-  if (statisticCalculationSuccessful)
+  result->SetProperty(mitk::STATS_HISTOGRAM_BIN_PROPERTY_NAME.c_str(), mitk::UIntProperty::New(m_HistogramNBins));
+  result->SetProperty(mitk::STATS_IGNORE_ZERO_VOXEL_PROPERTY_NAME.c_str(), mitk::BoolProperty::New(m_IgnoreZeros));
+
+  return result;
+}
+
+bool QmitkImageStatisticsCalculationRunnable::RunComputation()
+{
+  if (this->m_StatisticsImage.IsNull())
   {
-    m_StatisticsContainer = calculator->GetStatistics();
+    m_LastErrorMessage = "No image set.";
+    return false;
+  }
 
-    auto imageRule = mitk::StatisticsToImageRelationRule::New();
-    imageRule->Connect(m_StatisticsContainer, m_StatisticsImage);
+  if (m_Calculator.IsNull())
+  {
+    m_Calculator = mitk::ImageStatisticsCalculator::New();
+  }
 
-    if (nullptr != m_PlanarFigureMask)
-    {
-      auto maskRule = mitk::StatisticsToMaskRelationRule::New();
-      maskRule->Connect(m_StatisticsContainer, m_PlanarFigureMask);
-    }
+  // Bug 13416 : The ImageStatistics::SetImageMask() method can throw exceptions, i.e. when the dimensionality
+  // of the masked and input image differ, we need to catch them and mark the calculation as failed
+  // the same holds for the ::SetPlanarFigure()
+  try
+  {
+    this->ConfigureCalculator();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error while configuring the statistics calculator: " << e.what();
+    m_LastErrorMessage = e.what();
+    return false;
+  }
 
-    if (nullptr != m_BinaryMask)
+  try
+  {
+    // the time step that is looked at is reported first, the others follow with the final result
+    if (m_StatisticsImage->IsValidTimeStep(m_TimeStep))
     {
-      auto maskRule = mitk::StatisticsToMaskRelationRule::New();
-      maskRule->Connect(m_StatisticsContainer, m_BinaryMask);
+      const auto statistics = m_Calculator->GetStatistics(1, m_TimeStep);
+
+      bool isComplete = true;
+      for (mitk::TimeStepType timeStep = 0; isComplete && timeStep < m_StatisticsImage->GetTimeSteps(); ++timeStep)
+      {
+        isComplete = statistics->TimeStepExists(timeStep);
+      }
+
+      if (!isComplete)
+      {
+        m_StatisticsContainer = this->CreateResultContainer(statistics);
+        emit InterimResultsAvailable(this->GetResults(), this);
+      }
     }
 
-    m_StatisticsContainer->SetProperty(mitk::STATS_HISTOGRAM_BIN_PROPERTY_NAME.c_str(), mitk::UIntProperty::New(m_HistogramNBins));
-    m_StatisticsContainer->SetProperty(mitk::STATS_IGNORE_ZERO_VOXEL_PROPERTY_NAME.c_str(), mitk::BoolProperty::New(m_IgnoreZeros));
+    m_StatisticsContainer = this->CreateResultContainer(m_Calculator->GetStatistics());
+  }
+  catch (const std::exception &e)
+  {
+    m_LastErrorMessage = "Failure while calculating the statistics: " + std::string(e.what());
+    MITK_ERROR << m_LastErrorMessage;
+    return false;
   }
-  return statisticCalculationSuccessful;
+
+  return true;
 }
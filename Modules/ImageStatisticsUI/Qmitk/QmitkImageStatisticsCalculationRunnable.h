@@ -15,6 +15,7 @@ found in the LICENSE file.
 //mitk headers
 #include "mitkImage.h"
 #include "mitkPlanarFigure.h"
+#include "mitkImageStatisticsCalculator.h"
 #include "mitkImageStatisticsContainer.h"
 
 #include "QmitkDataGenerationJobBase.h"
@@ -69,6 +70,18 @@ public:
   /*!
   /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
+  /*!
+  /brief Set the time step that is computed first (e.g. the one that is currently displayed).
+  If the image has further time steps that are not computed yet, the statistics of this time step
+  are signaled by InterimResultsAvailable before the remaining time steps are computed.*/
+  void SetTimeStep(mitk::TimeStepType timeStep);
+  mitk::TimeStepType GetTimeStep() const;
+  /*!
+  /brief Set the calculator that is used by the job. Passing the calculator of a previous job with
+  the same image and ROI, only time steps are computed that are not up to date. The calculator must
+  not be used by another job at the same time. If no calculator is set, a new one is created.*/
+  void SetCalculator(mitk::ImageStatisticsCalculator* calculator);
+  mitk::ImageStatisticsCalculator* GetCalculator() const;
 
   ResultMapType GetResults() const override;
 
@@ -76,11 +89,20 @@ protected:
   bool RunComputation() override;
 
 private:
+  /** Configures the calculator for the inputs of the job. Mask generators of a previous job are reused,
+   so that the calculator only notices real changes of the inputs.*/
+  void ConfigureCalculator();
+  /** Returns a copy of the statistics that is connected to the inputs and carries the settings of the job.
+   A copy is needed because the calculator fills its containers further with later time steps.*/
+  mitk::ImageStatisticsContainer::Pointer CreateResultContainer(const mitk::ImageStatisticsContainer* statistics) const;
+
   mitk::Image::ConstPointer m_StatisticsImage;                         ///< member variable holds the input image for which the statistics need to be calculated.
   mitk::Image::ConstPointer m_BinaryMask;                              ///< member variable holds the binary mask image for segmentation image statistics calculation.
   mitk::PlanarFigure::ConstPointer m_PlanarFigureMask;                 ///< member variable holds the planar figure for segmentation image statistics calculation.
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
+  mitk::TimeStepType m_TimeStep;                                      ///< member variable holds the time step that is computed first.
+  mitk::ImageStatisticsCalculator::Pointer m_Calculator;
 };
 #endif // QMITKIMAGESTATISTICSCALCULATIONRUNNABLE_H_INCLUDED
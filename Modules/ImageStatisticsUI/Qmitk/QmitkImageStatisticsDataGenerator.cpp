@@ -21,9 +21,15 @@ found in the LICENSE file.
 #include "mitkNodePredicateDataProperty.h"
 #include "mitkProperties.h"
 #include "mitkImageStatisticsContainerManager.h"
+#include "mitkLabelSetImage.h"
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
+QmitkImageStatisticsDataGenerator::~QmitkImageStatisticsDataGenerator()
+{
+  this->ReleaseMaskObservers({});
+}
+
 void QmitkImageStatisticsDataGenerator::SetIgnoreZeroValueVoxel(bool _arg)
 {
   if (m_IgnoreZeroValueVoxel != _arg)
@@ -60,6 +66,26 @@ unsigned int QmitkImageStatisticsDataGenerator::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsDataGenerator::SetUseSliceWiseMaskedStatistics(bool useSliceWiseStatistics)
+{
+  m_UseSliceWiseMaskedStatistics = useSliceWiseStatistics;
+}
+
+bool QmitkImageStatisticsDataGenerator::GetUseSliceWiseMaskedStatistics() const
+{
+  return this->m_UseSliceWiseMaskedStatistics;
+}
+
+void QmitkImageStatisticsDataGenerator::SetTimePoint(mitk::TimePointType timePoint)
+{
+  this->m_TimePoint = timePoint;
+}
+
+mitk::TimePointType QmitkImageStatisticsDataGenerator::GetTimePoint() const
+{
+  return this->m_TimePoint;
+}
+
 bool QmitkImageStatisticsDataGenerator::ChangedNodeIsRelevant(const mitk::DataNode* changedNode) const
 {
   auto result = QmitkImageAndRoiDataGeneratorBase::ChangedNodeIsRelevant(changedNode);
@@ -180,6 +206,46 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
     newJob->SetIgnoreZeroValueVoxel(m_IgnoreZeroValueVoxel);
     newJob->SetHistogramNBins(m_HistogramNBins);
 
+    const auto timeGeometry = image->GetTimeGeometry();
+    if (timeGeometry->IsValidTimePoint(m_TimePoint))
+    {
+      newJob->SetTimeStep(timeGeometry->TimePointToTimeStep(m_TimePoint));
+    }
+
+    // calculators of images and ROIs that are not selected anymore are released
+    const auto selectedKeys = this->GetSelectedCalculatorKeys();
+    for (auto pos = m_Calculators.begin(); pos != m_Calculators.end();)
+    {
+      pos = selectedKeys.count(pos->first) > 0 ? std::next(pos) : m_Calculators.erase(pos);
+    }
+    this->ReleaseMaskObservers(selectedKeys);
+
+    const auto key = GenerateCalculatorKey(image, nullptr != roiNode ? roiNode->GetData() : nullptr);
+    auto finding = m_Calculators.find(key);
+    mitk::ImageStatisticsCalculator::Pointer calculator;
+    if (finding != m_Calculators.end())
+    {
+      calculator = finding->second;
+      m_Calculators.erase(finding);
+    }
+    else
+    {
+      calculator = mitk::ImageStatisticsCalculator::New();
+    }
+    calculator->SetUseSliceWiseMaskedStatistics(m_UseSliceWiseMaskedStatistics);
+    newJob->SetCalculator(calculator);
+    this->ObserveMaskSlices(nullptr != roiNode ? roiNode->GetData() : nullptr);
+
+    // the job is deleted by the thread pool, the calculator is handed back in the thread of the generator
+    // unless its image or ROI was removed or deselected in the meantime
+    connect(newJob, &QObject::destroyed, this, [this, key, calculator]()
+    {
+      if (this->GetSelectedCalculatorKeys().count(key) > 0)
+      {
+        m_Calculators[key] = calculator;
+      }
+    });
+
     return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(newJob, resultDataNode.GetPointer());
   }
   else if (resultDataNode->GetStringProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str(), status) && status == mitk::STATS_GENERATION_STATUS_VALUE_WORK_IN_PROGRESS)
@@ -189,6 +255,133 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
   return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(nullptr, nullptr);
 }
 
+QmitkImageStatisticsDataGenerator::CalculatorKeyType QmitkImageStatisticsDataGenerator::GenerateCalculatorKey(const mitk::BaseData* image, const mitk::BaseData* roi)
+{
+  return CalculatorKeyType(image->GetUID(), nullptr != roi ? roi->GetUID() : std::string());
+}
+
+std::set<QmitkImageStatisticsDataGenerator::CalculatorKeyType> QmitkImageStatisticsDataGenerator::GetSelectedCalculatorKeys() const
+{
+  std::set<CalculatorKeyType> keys;
+  for (const auto& imageAndRoi : this->FilterImageROICombinations(this->GetAllImageROICombinations()))
+  {
+    if (imageAndRoi.first->GetData() != nullptr)
+    {
+      keys.insert(GenerateCalculatorKey(imageAndRoi.first->GetData(), imageAndRoi.second.IsNotNull() ? imageAndRoi.second->GetData() : nullptr));
+    }
+  }
+  return keys;
+}
+
+void QmitkImageStatisticsDataGenerator::ReleaseNodeResources(const mitk::DataNode* node) const
+{
+  if (nullptr == node || nullptr == node->GetData())
+  {
+    return;
+  }
+
+  const auto uid = node->GetData()->GetUID();
+  for (auto pos = m_Calculators.begin(); pos != m_Calculators.end();)
+  {
+    pos = (pos->first.first == uid || pos->first.second == uid) ? m_Calculators.erase(pos) : std::next(pos);
+  }
+
+  auto finding = m_MaskObservers.find(uid);
+  if (finding != m_MaskObservers.end())
+  {
+    auto segmentation = finding->second.roi.Lock();
+    if (segmentation.IsNotNull())
+    {
+      segmentation->RemoveObserver(finding->second.tag);
+    }
+    m_MaskObservers.erase(finding);
+  }
+}
+
+void QmitkImageStatisticsDataGenerator::ObserveMaskSlices(mitk::BaseData* roi) const
+{
+  auto segmentation = dynamic_cast<mitk::LabelSetImage*>(roi);
+  if (nullptr == segmentation)
+  {
+    return;
+  }
+
+  const auto uid = roi->GetUID();
+  auto finding = m_MaskObservers.find(uid);
+  if (finding != m_MaskObservers.end() && !finding->second.roi.IsExpired())
+  {
+    return;
+  }
+
+  MaskObserver observer;
+  observer.roi = segmentation;
+  observer.tag = segmentation->AddObserver(mitk::LabelSetImageSlicesModifiedEvent(),
+    [this, roi](const itk::EventObject& event) { this->OnMaskSlicesModified(roi, event); });
+  m_MaskObservers[uid] = observer;
+}
+
+void QmitkImageStatisticsDataGenerator::ReleaseMaskObservers(const std::set<CalculatorKeyType>& keys) const
+{
+  std::set<std::string> rois;
+  for (const auto& key : keys)
+  {
+    rois.insert(key.second);
+  }
+
+  for (auto pos = m_MaskObservers.begin(); pos != m_MaskObservers.end();)
+  {
+    auto segmentation = pos->second.roi.Lock();
+    if (segmentation.IsNotNull() && rois.count(pos->first) > 0)
+    {
+      ++pos;
+      continue;
+    }
+
+    if (segmentation.IsNotNull())
+    {
+      segmentation->RemoveObserver(pos->second.tag);
+    }
+    pos = m_MaskObservers.erase(pos);
+  }
+}
+
+void QmitkImageStatisticsDataGenerator::OnMaskSlicesModified(const mitk::BaseData* roi, const itk::EventObject& event) const
+{
+  auto slicesEvent = dynamic_cast<const mitk::LabelSetImageSlicesModifiedEvent*>(&event);
+  auto mask = dynamic_cast<const mitk::Image*>(roi);
+  if (nullptr == slicesEvent || nullptr == mask)
+  {
+    return;
+  }
+
+  // calculators of running jobs are not in the map, they compute the whole mask again in their next job
+  const auto roiUID = roi->GetUID();
+  for (const auto& keyAndCalculator : m_Calculators)
+  {
+    const auto image = keyAndCalculator.second->GetInputImage();
+    if (keyAndCalculator.first.second != roiUID || nullptr == image)
+    {
+      continue;
+    }
+
+    // the mask time step of each image time step is selected by time point, as done by mitk::ImageMaskGenerator
+    const auto maskTimeGeometry = mask->GetTimeGeometry();
+    for (mitk::TimeStepType timeStep = 0; timeStep < image->GetTimeSteps(); ++timeStep)
+    {
+      const auto timePoint = image->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
+      const auto maskTimeStep = maskTimeGeometry->IsValidTimePoint(timePoint)
+                                  ? maskTimeGeometry->TimePointToTimeStep(timePoint)
+                                  : mask->GetTimeSteps() - 1;
+
+      if (maskTimeStep == slicesEvent->GetTimeStep())
+      {
+        keyAndCalculator.second->SetMaskSlicesModified(
+          timeStep, slicesEvent->GetFirstSlice(), slicesEvent->GetLastSlice(), slicesEvent->GetMTimeBeforeWrite());
+      }
+    }
+  }
+}
+
 void QmitkImageStatisticsDataGenerator::RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const
 {
   if (imageNode == nullptr || !imageNode->GetData())
@@ -15,13 +15,30 @@ found in the LICENSE file.
 
 #include "QmitkImageAndRoiDataGeneratorBase.h"
 
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkWeakPointer.h>
+
 #include <MitkImageStatisticsUIExports.h>
 
+#include <map>
+#include <set>
+#include <string>
+
+namespace mitk
+{
+  class LabelSetImage;
+}
+
 /**
 Generates ImageStatisticContainers by using QmitkImageStatisticsCalculationRunnables for each pair if image and ROIs and ensures their
 validity.
 It also encodes the HistogramNBins and IgnoreZeroValueVoxel as properties to the results as these settings are important criteria for
 discreminating statistics results.
+The time step of the selected time point (see SetTimePoint()) is computed first, the other time steps follow in the background.
+The calculator of a job is reused by the next job for the same image and ROI, so that only outdated time steps are computed.
+Slice writes to segmentation ROIs (see mitk::LabelSetImageSlicesModifiedEvent) are reported to the calculators that are not used
+by a running job, so that the next job only computes the written time step again and, with slice-wise masked statistics
+(see SetUseSliceWiseMaskedStatistics()), only rescans the written slices.
 For more details of how the generation is done see QmitkDataGenerationBase.
 */
 class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public QmitkImageAndRoiDataGeneratorBase
@@ -29,6 +46,7 @@ class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public Qm
 public:
   QmitkImageStatisticsDataGenerator(mitk::DataStorage::Pointer storage, QObject* parent = nullptr) : QmitkImageAndRoiDataGeneratorBase(storage, parent) {};
   QmitkImageStatisticsDataGenerator(QObject* parent = nullptr) : QmitkImageAndRoiDataGeneratorBase(parent) {};
+  ~QmitkImageStatisticsDataGenerator() override;
 
   bool IsValidResultAvailable(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
 
@@ -52,6 +70,19 @@ public:
   /*! /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
 
+  /*! /brief Enable slice-wise masked statistics of the calculators (see
+  mitk::ImageStatisticsCalculator::SetUseSliceWiseMaskedStatistics()). Enabled by default. The results do not depend
+  on it, so changing it does not trigger a new generation.*/
+  void SetUseSliceWiseMaskedStatistics(bool useSliceWiseStatistics);
+  /*! /brief Get whether slice-wise masked statistics are enabled.*/
+  bool GetUseSliceWiseMaskedStatistics() const;
+
+  /*! /brief Set the time point that is currently displayed. Its time step is computed first.
+  Changing the time point does not trigger a new generation.*/
+  void SetTimePoint(mitk::TimePointType timePoint);
+  /*! /brief Get the time point that is currently displayed.*/
+  mitk::TimePointType GetTimePoint() const;
+
 protected:
   bool ChangedNodeIsRelevant(const mitk::DataNode* changedNode) const;
   void IndicateFutureResults(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
@@ -64,6 +95,37 @@ protected:
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+  bool m_UseSliceWiseMaskedStatistics = true;
+  mitk::TimePointType m_TimePoint = 0.;
+
+  /** UIDs of the image and the ROI (empty if there is none). UIDs are used instead of the data pointers, as the address of
+   a deleted data object may be reused by a new one.*/
+  using CalculatorKeyType = std::pair<std::string, std::string>;
+  static CalculatorKeyType GenerateCalculatorKey(const mitk::BaseData* image, const mitk::BaseData* roi);
+  /** Returns the keys of all selected image and ROI combinations whose nodes are in the storage.*/
+  std::set<CalculatorKeyType> GetSelectedCalculatorKeys() const;
+
+  /** Calculators of finished jobs per image and ROI. A job takes the calculator out of the map, so that it is never
+   shared by two running jobs, and it is put back when the job is deleted. As a calculator references its image and
+   mask, entries are released as soon as the image or ROI is removed from the storage or deselected.*/
+  mutable std::map<CalculatorKeyType, mitk::ImageStatisticsCalculator::Pointer> m_Calculators;
+
+  void ReleaseNodeResources(const mitk::DataNode* node) const override;
+
+  /** Observes the slice writes of the ROI if it is a segmentation, see OnMaskSlicesModified().*/
+  void ObserveMaskSlices(mitk::BaseData* roi) const;
+  /** Stops observing the ROIs that are not part of the passed keys.*/
+  void ReleaseMaskObservers(const std::set<CalculatorKeyType>& keys) const;
+  /** Reports the written slices of the ROI to its calculators in m_Calculators.*/
+  void OnMaskSlicesModified(const mitk::BaseData* roi, const itk::EventObject& event) const;
+
+  struct MaskObserver
+  {
+    mitk::WeakPointer<mitk::LabelSetImage> roi;
+    unsigned long tag = 0;
+  };
+  /** Observers of the segmentation ROIs by UID.*/
+  mutable std::map<std::string, MaskObserver> m_MaskObservers;
 };
 
 #endif
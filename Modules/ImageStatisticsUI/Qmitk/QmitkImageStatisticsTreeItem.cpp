@@ -84,21 +84,19 @@ QVariant QmitkImageStatisticsTreeItem::data(int column) const
   {
     if (column - 1 < static_cast<int>(m_statisticNames.size()))
     {
-      if (m_IsWIP)
+      auto statisticKey = m_statisticNames.at(column - 1);
+      if (m_statistics.HasStatistic(statisticKey))
+      {
+        // interim results of work in progress already contain the values of some time steps
+        return boost::apply_visitor(StatValueVisitor(), m_statistics.GetValueNonConverted(statisticKey));
+      }
+      else if (m_IsWIP)
       {
         result = QVariant(QString("..."));
       }
       else
       {
-        auto statisticKey = m_statisticNames.at(column - 1);
-        if (m_statistics.HasStatistic(statisticKey))
-        {
-          return boost::apply_visitor(StatValueVisitor(), m_statistics.GetValueNonConverted(statisticKey));
-        }
-        else
-        {
-          return QVariant();
-        }
+        return QVariant();
       }
     }
     else
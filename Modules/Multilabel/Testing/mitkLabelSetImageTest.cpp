@@ -11,6 +11,11 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
@@ -18,6 +23,9 @@ found in the LICENSE file.
 
 #include <mitkAutoCropImageFilter.h>
 
+#include <algorithm>
+#include <vector>
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
@@ -33,16 +41,36 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestExistsLabel);
   MITK_TEST(TestExistsLabelSet);
   MITK_TEST(TestSetActiveLayer);
+  MITK_TEST(TestSetActiveLayerReferencesLayerData);
+  MITK_TEST(TestReplacedPixelDataIsWrittenBackToLayer);
+  MITK_TEST(TestAddLayerTakesOverLayerImage);
+  MITK_TEST(TestGrabItkImageMemoryWritesToActiveLayer);
+  MITK_TEST(TestInitializeClearsAllLayers);
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestEraseLabels);
   MITK_TEST(TestMergeLabels);
+  MITK_TEST(TestMergeAndEraseLabelsIn4D);
   MITK_TEST(TestCreateLabelMask);
+  MITK_TEST(TestLabelStatistics);
+  MITK_TEST(TestSlicesModifiedEvent);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
+  static void SetLabelPixel(mitk::Image *image, const itk::Index<3> &index, mitk::Label::PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    accessor.SetPixelByIndex(index, value);
+  }
+
+  static mitk::Label::PixelType GetLabelPixel(const mitk::Image *image, const itk::Index<3> &index)
+  {
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(image);
+    return accessor.GetPixelByIndex(index);
+  }
+
 public:
   void setUp() override
   {
@@ -334,6 +362,144 @@ public:
                            mitk::Equal(*newlayer, *m_LabelSetImage->GetActiveLabelSet(), 0.00001, true));
   }
 
+  void TestSetActiveLayerReferencesLayerData()
+  {
+    const unsigned int secondLayer = m_LabelSetImage->AddLayer();
+
+    auto setPixel = [this](const itk::Index<3> &index, mitk::Label::PixelType value) {
+      SetLabelPixel(m_LabelSetImage, index, value);
+    };
+
+    const itk::Index<3> index = { { 10, 20, 30 } };
+
+    setPixel(index, 2);
+    CPPUNIT_ASSERT_MESSAGE("Active image does not share the data of the active layer",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 2);
+
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_MESSAGE("Data of layer 0 was changed", GetLabelPixel(m_LabelSetImage, index) == 0);
+
+    setPixel(index, 1);
+    CPPUNIT_ASSERT_MESSAGE("Active image does not share the data of the active layer",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(0), index) == 1);
+    CPPUNIT_ASSERT_MESSAGE("Data of the inactive layer was changed",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 2);
+
+    m_LabelSetImage->SetActiveLayer(secondLayer);
+    CPPUNIT_ASSERT_MESSAGE("Data of the layer was lost by switching layers", GetLabelPixel(m_LabelSetImage, index) == 2);
+
+    {
+      mitk::ImageReadAccessor activeAccessor(m_LabelSetImage.GetPointer());
+      mitk::ImageReadAccessor layerAccessor(m_LabelSetImage->GetLayerImage(secondLayer));
+      CPPUNIT_ASSERT_MESSAGE("Layer data was copied on switching layers", activeAccessor.GetData() == layerAccessor.GetData());
+    }
+
+    mitk::LabelSetImage::Pointer clone = m_LabelSetImage->Clone();
+    CPPUNIT_ASSERT_MESSAGE("Clone does not contain the data of the active layer", GetLabelPixel(clone, index) == 2);
+    setPixel(index, 3);
+    CPPUNIT_ASSERT_MESSAGE("Clone shares its data with the original", GetLabelPixel(clone, index) == 2);
+  }
+
+  void TestReplacedPixelDataIsWrittenBackToLayer()
+  {
+    const unsigned int secondLayer = m_LabelSetImage->AddLayer();
+    const itk::Index<3> index = { { 10, 20, 30 } };
+
+    mitk::Image::Pointer replacement = m_LabelSetImage->GetLayerImage(secondLayer)->Clone();
+    SetLabelPixel(replacement, index, 5);
+
+    {
+      mitk::ImageReadAccessor accessor(replacement);
+      m_LabelSetImage->SetImportChannel(const_cast<void *>(accessor.GetData()), 0, mitk::Image::CopyMemory);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Replaced pixel data is not visible in the active layer",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 5);
+
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_MESSAGE("Data of layer 0 was changed", GetLabelPixel(m_LabelSetImage, index) == 0);
+
+    m_LabelSetImage->SetActiveLayer(secondLayer);
+    CPPUNIT_ASSERT_MESSAGE("Replaced pixel data was lost by switching layers",
+                           GetLabelPixel(m_LabelSetImage, index) == 5);
+
+    SetLabelPixel(m_LabelSetImage, index, 6);
+    CPPUNIT_ASSERT_MESSAGE("Active image does not share the data of the active layer again",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 6);
+  }
+
+  void TestAddLayerTakesOverLayerImage()
+  {
+    const itk::Index<3> index = { { 10, 20, 30 } };
+
+    mitk::Image::Pointer layerImage = m_LabelSetImage->GetLayerImage(0)->Clone();
+    SetLabelPixel(layerImage, index, 4);
+
+    const unsigned int newLayer = m_LabelSetImage->AddLayer(layerImage);
+    CPPUNIT_ASSERT_MESSAGE("Content of the passed image is missing in the new layer",
+                           GetLabelPixel(m_LabelSetImage, index) == 4);
+    CPPUNIT_ASSERT_MESSAGE("New layer is not the passed image",
+                           m_LabelSetImage->GetLayerImage(newLayer) == layerImage.GetPointer());
+
+    SetLabelPixel(m_LabelSetImage, index, 7);
+    CPPUNIT_ASSERT_MESSAGE("Write to the layer is not visible in the passed image", GetLabelPixel(layerImage, index) == 7);
+  }
+
+  void TestGrabItkImageMemoryWritesToActiveLayer()
+  {
+    const unsigned int secondLayer = m_LabelSetImage->AddLayer();
+    const itk::Index<3> index = { { 10, 20, 30 } };
+
+    mitk::Image::Pointer layerImage = m_LabelSetImage->GetLayerImage(secondLayer)->Clone();
+    SetLabelPixel(layerImage, index, 5);
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.5, 2.0, 3.0);
+    layerImage->GetGeometry()->SetSpacing(spacing);
+
+    using ItkImageType = itk::Image<mitk::Label::PixelType, 3>;
+    ItkImageType::Pointer itkImage;
+    mitk::CastToItkImage(layerImage, itkImage);
+    mitk::GrabItkImageMemory(itkImage, m_LabelSetImage.GetPointer());
+
+    CPPUNIT_ASSERT_MESSAGE("Grabbed pixel data is not in the active layer",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 5);
+
+    SetLabelPixel(m_LabelSetImage, index, 6);
+    CPPUNIT_ASSERT_MESSAGE("Active image does not share the data of the active layer",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 6);
+
+    mitk::BaseGeometry::Pointer labelImageGeo = m_LabelSetImage->GetGeometry();
+    mitk::BaseGeometry::Pointer inactiveLayerGeo = m_LabelSetImage->GetLayerImage(0)->GetGeometry();
+    MITK_ASSERT_EQUAL(inactiveLayerGeo, labelImageGeo, "Inactive layer did not get the grabbed geometry");
+
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_MESSAGE("Layer 0 was not cleared by the re-initialization", GetLabelPixel(m_LabelSetImage, index) == 0);
+  }
+
+  void TestInitializeClearsAllLayers()
+  {
+    const itk::Index<3> index = { { 10, 20, 30 } };
+
+    SetLabelPixel(m_LabelSetImage, index, 1);
+    const unsigned int secondLayer = m_LabelSetImage->AddLayer();
+    SetLabelPixel(m_LabelSetImage, index, 2);
+
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = { 96, 128, 52 };
+    regularImage->Initialize(mitk::MakeScalarPixelType<char>(), 3, dimensions);
+    m_LabelSetImage->Initialize(regularImage);
+
+    CPPUNIT_ASSERT_EQUAL(2u, m_LabelSetImage->GetNumberOfLayers());
+    CPPUNIT_ASSERT_MESSAGE("Active layer was not cleared", GetLabelPixel(m_LabelSetImage, index) == 0);
+    CPPUNIT_ASSERT_MESSAGE("Layer 0 was not cleared", GetLabelPixel(m_LabelSetImage->GetLayerImage(0), index) == 0);
+    CPPUNIT_ASSERT_MESSAGE("Active layer image was not cleared",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 0);
+
+    SetLabelPixel(m_LabelSetImage, index, 3);
+    CPPUNIT_ASSERT_MESSAGE("Active image does not share the data of the active layer after Initialize()",
+                           GetLabelPixel(m_LabelSetImage->GetLayerImage(secondLayer), index) == 3);
+  }
+
   void TestRemoveLayer()
   {
     // Cache active layer
@@ -493,6 +659,57 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Labels were not correctly merged", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 5366);
   }
 
+  void TestMergeAndEraseLabelsIn4D()
+  {
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[4] = { 4, 5, 6, 3 };
+    regularImage->Initialize(mitk::MakeScalarPixelType<char>(), 4, dimensions);
+
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(regularImage);
+
+    const std::size_t numberOfPixels = 4 * 5 * 6 * 3;
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 4> accessor(m_LabelSetImage);
+      for (std::size_t i = 0; i < numberOfPixels; ++i)
+        accessor.GetData()[i] = static_cast<mitk::Label::PixelType>(i % 6);
+    }
+
+    for (mitk::Label::PixelType value = 1; value < 6; ++value)
+    {
+      mitk::Label::Pointer label = mitk::Label::New();
+      label->SetValue(value);
+      m_LabelSetImage->GetActiveLabelSet()->AddLabel(label);
+    }
+
+    auto countPixels = [this, numberOfPixels](mitk::Label::PixelType value) {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 4> accessor(m_LabelSetImage.GetPointer());
+      return std::count(accessor.GetData(), accessor.GetData() + numberOfPixels, value);
+    };
+
+    const std::ptrdiff_t pixelsPerLabel = numberOfPixels / 6;
+    const auto mTimeBeforeMerge = m_LabelSetImage->GetMTime();
+
+    // merging a label into itself must not remove it
+    std::vector<mitk::Label::PixelType> vectorOfSourcePixelValues{ 2, 3, 4 };
+    m_LabelSetImage->MergeLabels(2, vectorOfSourcePixelValues);
+
+    CPPUNIT_ASSERT_MESSAGE("Merge did not modify the image", m_LabelSetImage->GetMTime() > mTimeBeforeMerge);
+    CPPUNIT_ASSERT_MESSAGE("Merged label is not active", m_LabelSetImage->GetActiveLabel()->GetValue() == 2);
+    CPPUNIT_ASSERT_EQUAL(3 * pixelsPerLabel, countPixels(2));
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(0), countPixels(3));
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(0), countPixels(4));
+    CPPUNIT_ASSERT_EQUAL(pixelsPerLabel, countPixels(5));
+
+    std::vector<mitk::Label::PixelType> labelsToBeErased{ 1, 5 };
+    m_LabelSetImage->EraseLabels(labelsToBeErased);
+
+    CPPUNIT_ASSERT_EQUAL(3 * pixelsPerLabel, countPixels(0));
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(0), countPixels(1));
+    CPPUNIT_ASSERT_EQUAL(3 * pixelsPerLabel, countPixels(2));
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(0), countPixels(5));
+  }
+
   void TestCreateLabelMask()
   {
     mitk::Image::Pointer image =
@@ -514,6 +731,129 @@ public:
     // Count all pixels with value 6 = 507
     CPPUNIT_ASSERT_MESSAGE("Label mask not correctly created", maskImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 507);
   }
+
+  void TestLabelStatistics()
+  {
+    const unsigned int dimX = m_LabelSetImage->GetDimension(0);
+    const unsigned int dimY = m_LabelSetImage->GetDimension(1);
+
+    auto setPixel = [this, dimX, dimY](unsigned int x, unsigned int y, unsigned int z, mitk::Label::PixelType value) {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      accessor.GetData()[(static_cast<std::size_t>(z) * dimY + y) * dimX + x] = value;
+    };
+
+    // box of label 1 covering x 10..19, y 20..29, z 5..8
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      for (unsigned int z = 5; z < 9; ++z)
+        for (unsigned int y = 20; y < 30; ++y)
+          for (unsigned int x = 10; x < 20; ++x)
+            accessor.GetData()[(static_cast<std::size_t>(z) * dimY + y) * dimX + x] = 1;
+    }
+    m_LabelSetImage->Modified();
+
+    auto statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(400), statistics.voxelCount);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(10), statistics.minIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(29), statistics.maxIndex[1]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(5), statistics.minIndex[2]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(8), statistics.maxIndex[2]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(14.5, statistics.centerOfMassIndex[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(24.5, statistics.centerOfMassIndex[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.5, statistics.centerOfMassIndex[2], mitk::eps);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), statistics.voxelsPerSlice.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), statistics.voxelsPerSlice[5]);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_LabelSetImage->GetLabelStatistics(2).voxelCount);
+
+    // a slice write that is announced only causes the affected slices to be rescanned
+    auto mTimeBeforeWrite = m_LabelSetImage->GetMTime();
+    setPixel(50, 60, 20, 1);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->InvalidateLabelStatistics(
+      m_LabelSetImage->GetSlicedGeometry()->GetPlaneGeometry(20), 0, mTimeBeforeWrite);
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(401), statistics.voxelCount);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(50), statistics.maxIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(20), statistics.maxIndex[2]);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), statistics.voxelsPerSlice.size());
+
+    // an earlier unspecific modification is not covered by a later announced slice write
+    setPixel(0, 0, 40, 1);
+    m_LabelSetImage->Modified();
+    mTimeBeforeWrite = m_LabelSetImage->GetMTime();
+    setPixel(51, 60, 20, 1);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->InvalidateLabelStatistics(
+      m_LabelSetImage->GetSlicedGeometry()->GetPlaneGeometry(20), 0, mTimeBeforeWrite);
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(403), statistics.voxelCount);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(0), statistics.minIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(51), statistics.maxIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(40), statistics.maxIndex[2]);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), statistics.voxelsPerSlice.size());
+
+    // an unspecific modification causes a full rescan
+    setPixel(51, 60, 20, 0);
+    m_LabelSetImage->Modified();
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(402), statistics.voxelCount);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(0), statistics.minIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(50), statistics.maxIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(40), statistics.maxIndex[2]);
+
+    // label set changes do not touch pixel data, a following slice edit updates count and bounding box
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetValue(1);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label);
+
+    mTimeBeforeWrite = m_LabelSetImage->GetMTime();
+    setPixel(0, 0, 40, 0);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->InvalidateLabelStatistics(
+      m_LabelSetImage->GetSlicedGeometry()->GetPlaneGeometry(40), 0, mTimeBeforeWrite);
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(401), statistics.voxelCount);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(10), statistics.minIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(20), statistics.minIndex[1]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(5), statistics.minIndex[2]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(50), statistics.maxIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(60), statistics.maxIndex[1]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(20), statistics.maxIndex[2]);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), statistics.voxelsPerSlice.size());
+
+    m_LabelSetImage->UpdateCenterOfMass(1, m_LabelSetImage->GetActiveLayer());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics.centerOfMassIndex[2],
+                                 m_LabelSetImage->GetLabel(1)->GetCenterOfMassIndex()[2],
+                                 mitk::eps);
+  }
+
+  void TestSlicesModifiedEvent()
+  {
+    std::vector<mitk::LabelSetImageSlicesModifiedEvent> events;
+    auto tag = m_LabelSetImage->AddObserver(mitk::LabelSetImageSlicesModifiedEvent(),
+      [&events](const itk::EventObject &event) {
+        events.push_back(dynamic_cast<const mitk::LabelSetImageSlicesModifiedEvent &>(event));
+      });
+
+    // the slices of a write are reported together with the modification time before the write,
+    // also if the label statistics were not up to date
+    const auto mTimeBeforeWrite = m_LabelSetImage->GetMTime();
+    SetLabelPixel(m_LabelSetImage, {{50, 60, 20}}, 1);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->InvalidateLabelStatistics(
+      m_LabelSetImage->GetSlicedGeometry()->GetPlaneGeometry(20), 0, mTimeBeforeWrite);
+
+    m_LabelSetImage->RemoveObserver(tag);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), events.size());
+    CPPUNIT_ASSERT_EQUAL(mitk::TimeStepType(0), events[0].GetTimeStep());
+    CPPUNIT_ASSERT(events[0].GetFirstSlice() <= 20 && 20 <= events[0].GetLastSlice());
+    CPPUNIT_ASSERT(events[0].GetLastSlice() - events[0].GetFirstSlice() <= 2);
+    CPPUNIT_ASSERT_EQUAL(mTimeBeforeWrite, events[0].GetMTimeBeforeWrite());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
@@ -9,6 +9,7 @@ set(CPP_FILES
   mitkLabelSetImageToSurfaceFilter.cpp
   mitkLabelSetImageToSurfaceThreadedFilter.cpp
   mitkLabelSetImageVtkMapper2D.cpp
+  mitkLabelStatisticsCache.cpp
   mitkMultilabelObjectFactory.cpp
   mitkLabelSetIOHelper.cpp
   mitkDICOMSegmentationPropertyHelper.cpp
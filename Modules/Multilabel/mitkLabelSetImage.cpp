@@ -14,11 +14,14 @@ found in the LICENSE file.
 
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 #include "mitkImagePixelReadAccessor.h"
 #include "mitkImagePixelWriteAccessor.h"
 #include "mitkInteractionConst.h"
 #include "mitkLookupTableProperty.h"
 #include "mitkPadImageFilter.h"
+#include "mitkPlaneGeometry.h"
 #include "mitkRenderingManager.h"
 #include "mitkDICOMSegmentationPropertyHelper.h"
 #include "mitkDICOMQIPropertyHelper.h"
@@ -35,6 +38,13 @@ found in the LICENSE file.
 #include <itkCommand.h>
 
 #include <itkBinaryFunctorImageFilter.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
 
 
 template <typename TPixel, unsigned int VDimensions>
@@ -64,7 +74,7 @@ void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk:
 }
 
 mitk::LabelSetImage::LabelSetImage()
-  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
+  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr), m_LabelStatisticsMTime(0)
 {
   // Iniitlaize Background Label
   mitk::Color color;
@@ -81,10 +91,11 @@ mitk::LabelSetImage::LabelSetImage()
 }
 
 mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
-  : Image(other),
+  : Image(other, false),
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false),
-    m_ExteriorLabel(other.GetExteriorLabel()->Clone())
+    m_ExteriorLabel(other.GetExteriorLabel()->Clone()),
+    m_LabelStatisticsMTime(0)
 {
   for (unsigned int i = 0; i < other.GetNumberOfLayers(); i++)
   {
@@ -96,18 +107,21 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
+    // clone layer Image data (the pixel data of this image is not copied, it references the active layer)
     mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
     m_LayerContainer.push_back(liClone);
   }
 
+  if (!m_LayerContainer.empty())
+    this->ReferenceLayerImage(m_ActiveLayer);
+
   // Add some DICOM Tags as properties to segmentation image
   DICOMSegmentationPropertyHelper::DeriveDICOMSegmentationProperties(this);
 }
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
-  Superclass::Modified();
+  this->ModifiedWithoutPixelChanges();
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -154,13 +168,101 @@ void mitk::LabelSetImage::Initialize(const mitk::Image *other)
   // Transfer some general DICOM properties from the source image to derived image (e.g. Patient information,...)
   DICOMQIPropertyHelper::DeriveDICOMSourceProperties(other, this);
 
-  // Add a inital LabelSet ans corresponding image data to the stack
+  // Add a inital LabelSet ans corresponding image data to the stack. Existing layers have already been
+  // replaced by empty layers of the new size by Initialize(type, dimension, dimensions, channels).
   if (this->GetNumberOfLayers() == 0)
   {
     AddLayer();
   }
 }
 
+void mitk::LabelSetImage::Initialize(const mitk::PixelType &type,
+                                     unsigned int dimension,
+                                     const unsigned int *dimensions,
+                                     unsigned int channels)
+{
+  Superclass::Initialize(type, dimension, dimensions, channels);
+
+  if (m_LayerContainer.empty())
+    return;
+
+  // the image data was reset, so all layers are cleared and get buffers of the new size
+  for (auto &layerImage : m_LayerContainer)
+    layerImage = this->CreateLayerImage();
+
+  m_activeLayerInvalid = false;
+  if (static_cast<unsigned int>(m_ActiveLayer) < m_LayerContainer.size())
+    this->ReferenceLayerImage(m_ActiveLayer);
+}
+
+void mitk::LabelSetImage::SetGeometry(BaseGeometry *geometry)
+{
+  Superclass::SetGeometry(geometry);
+  this->UpdateLayerGeometries();
+}
+
+void mitk::LabelSetImage::SetTimeGeometry(TimeGeometry *geometry)
+{
+  Superclass::SetTimeGeometry(geometry);
+  this->UpdateLayerGeometries();
+}
+
+void mitk::LabelSetImage::UpdateLayerGeometries()
+{
+  const auto timeGeometry = this->GetTimeGeometry();
+  if (nullptr == timeGeometry)
+    return;
+
+  for (auto &layerImage : m_LayerContainer)
+    layerImage->SetClonedTimeGeometry(timeGeometry);
+}
+
+bool mitk::LabelSetImage::SetImportVolume(void *data, int t, int n, ImportMemoryManagementType importMemoryManagement)
+{
+  if (0 != n || m_activeLayerInvalid || static_cast<unsigned int>(m_ActiveLayer) >= m_LayerContainer.size())
+    return Superclass::SetImportVolume(data, t, n, importMemoryManagement);
+
+  if (!this->IsValidVolume(t, n))
+    return false;
+
+  this->ImportIntoActiveLayer(data, t, importMemoryManagement);
+  return true;
+}
+
+bool mitk::LabelSetImage::SetImportChannel(void *data, int n, ImportMemoryManagementType importMemoryManagement)
+{
+  if (0 != n || m_activeLayerInvalid || static_cast<unsigned int>(m_ActiveLayer) >= m_LayerContainer.size())
+    return Superclass::SetImportChannel(data, n, importMemoryManagement);
+
+  if (!this->IsValidChannel(n))
+    return false;
+
+  this->ImportIntoActiveLayer(data, -1, importMemoryManagement);
+  return true;
+}
+
+void mitk::LabelSetImage::ImportIntoActiveLayer(void *data, int t, ImportMemoryManagementType importMemoryManagement)
+{
+  // Replacing the data item would detach the pixel data from the active layer, so the data is
+  // copied into the referenced memory of the layer instead.
+  std::size_t numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < std::min(this->GetDimension(), 3u); ++dim)
+    numberOfPixels *= this->GetDimension(dim);
+
+  if (t < 0)
+    numberOfPixels *= this->GetDimension() > 3 ? this->GetDimension(3) : 1;
+
+  {
+    mitk::ImageWriteAccessor accessor(this, t < 0 ? this->GetChannelData(0) : this->GetVolumeData(t));
+    std::memcpy(accessor.GetData(), data, numberOfPixels * this->GetPixelType().GetSize());
+  }
+
+  if (ManageMemory == importMemoryManagement)
+    delete[] static_cast<unsigned char *>(data);
+
+  this->Modified();
+}
+
 mitk::LabelSetImage::~LabelSetImage()
 {
   m_LabelSetContainer.clear();
@@ -215,7 +317,7 @@ void mitk::LabelSetImage::RemoveLayer()
   this->Modified();
 }
 
-unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer labelSet)
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage() const
 {
   mitk::Image::Pointer newImage = mitk::Image::New();
   newImage->Initialize(this->GetPixelType(),
@@ -233,7 +335,12 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer labelSet)
     AccessFixedDimensionByItk(newImage, SetToZero, 4);
   }
 
-  unsigned int newLabelSetId = this->AddLayer(newImage, labelSet);
+  return newImage;
+}
+
+unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer labelSet)
+{
+  unsigned int newLabelSetId = this->AddLayer(this->CreateLayerImage(), labelSet);
 
   return newLabelSetId;
 }
@@ -262,6 +369,10 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
   // push a new working image for the new layer
   m_LayerContainer.push_back(layerImage);
 
+  // the first layer is already the active one, but the pixel data does not reference it yet
+  if (0 == newLabelSetId)
+    m_activeLayerInvalid = true;
+
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
 
@@ -303,56 +414,74 @@ void mitk::LabelSetImage::AddLabelSetToLayer(const unsigned int layerIdx, const
 
 void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
+  bool layerChanged = false;
+
   try
   {
-    if (4 == this->GetDimension())
+    if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
+      BeforeChangeLayerEvent.Send();
 
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
+      // The data of the current layer is owned by its layer image, so nothing has to be written back
+      m_activeLayerInvalid = false;
+      m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+      this->ReferenceLayerImage(layer);
+      layerChanged = true;
 
-        AfterChangeLayerEvent.Send();
-      }
-    }
-    else
-    {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
-
-        AfterChangeLayerEvent.Send();
-      }
+      AfterChangeLayerEvent.Send();
     }
   }
   catch (itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
-  this->Modified();
+
+  if (layerChanged)
+  {
+    this->Modified();
+  }
+  else
+  {
+    this->ModifiedWithoutPixelChanges();
+  }
+}
+
+void mitk::LabelSetImage::ReferenceLayerImage(unsigned int layer)
+{
+  const mitk::Image *layerImage = m_LayerContainer.at(layer);
+
+  std::size_t numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < this->GetDimension(); ++dim)
+    numberOfPixels *= this->GetDimension(dim);
+
+  std::size_t numberOfLayerPixels = 1;
+  for (unsigned int dim = 0; dim < layerImage->GetDimension(); ++dim)
+    numberOfLayerPixels *= layerImage->GetDimension(dim);
+
+  if (layerImage->GetPixelType() != this->GetPixelType() || numberOfLayerPixels != numberOfPixels)
+  {
+    mitkThrow() << "Layer image " << layer << " does not match the pixel type or size of the label set image.";
+  }
+
+  // The layer provides its data as one contiguous channel (all time steps), which is only
+  // combined once if the layer image was assembled from separate volumes.
+  ImageDataItemPointer layerChannel = layerImage->GetChannelData(0);
+  if (layerChannel.IsNull())
+  {
+    mitkThrow() << "Layer image " << layer << " does not provide any pixel data.";
+  }
+
+  // The new channel item is a child of the layer's item: it points to the layer's memory
+  // without owning it and keeps it alive as long as it is referenced.
+  ImageDataItemPointer channel = new ImageDataItem(*layerChannel, m_ImageDescriptor, -1, this->GetDimension());
+  channel->SetComplete(true);
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  // slices and volumes still point into the previous channel
+  std::fill(m_Slices.begin(), m_Slices.end(), nullptr);
+  std::fill(m_Volumes.begin(), m_Volumes.end(), nullptr);
+  m_Channels[0] = channel;
 }
 
 void mitk::LabelSetImage::ClearBuffer()
@@ -399,31 +528,18 @@ bool mitk::LabelSetImage::ExistLabelSet(unsigned int layer) const
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue, unsigned int layer)
 {
-  try
-  {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
-  GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  Modified();
+  std::vector<PixelType> vectorOfSourcePixelValues{ sourcePixelValue };
+  this->MergeLabels(pixelValue, vectorOfSourcePixelValues, layer);
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
-  try
-  {
-    for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
-    {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
-    }
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
+  auto lookupTable = CreateIdentityLookupTable();
+  for (const auto sourcePixelValue : vectorOfSourcePixelValues)
+    lookupTable[sourcePixelValue] = pixelValue;
+
+  this->ApplyLabelLookupTable(lookupTable);
+
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   Modified();
 }
@@ -438,35 +554,67 @@ void mitk::LabelSetImage::RemoveLabels(std::vector<PixelType>& VectorOfLabelPixe
 {
   for (unsigned int idx = 0; idx < VectorOfLabelPixelValues.size(); idx++)
   {
-    this->RemoveLabel(VectorOfLabelPixelValues[idx], layer);
+    this->GetLabelSet(layer)->RemoveLabel(VectorOfLabelPixelValues[idx]);
   }
+  this->EraseLabels(VectorOfLabelPixelValues);
 }
 
 void mitk::LabelSetImage::EraseLabel(PixelType pixelValue)
 {
-  try
-  {
-    if (4 == this->GetDimension())
-    {
-      AccessFixedDimensionByItk_1(this, EraseLabelProcessing, 4, pixelValue);
-    }
-    else
-    {
-      AccessByItk_1(this, EraseLabelProcessing, pixelValue);
-    }
-  }
-  catch (const itk::ExceptionObject& e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
-  Modified();
+  std::vector<PixelType> VectorOfLabelPixelValues{ pixelValue };
+  this->EraseLabels(VectorOfLabelPixelValues);
 }
 
 void mitk::LabelSetImage::EraseLabels(std::vector<PixelType>& VectorOfLabelPixelValues)
 {
-  for (unsigned int idx = 0; idx < VectorOfLabelPixelValues.size(); idx++)
+  auto lookupTable = CreateIdentityLookupTable();
+  for (const auto pixelValue : VectorOfLabelPixelValues)
+    lookupTable[pixelValue] = 0;
+
+  this->ApplyLabelLookupTable(lookupTable);
+  Modified();
+}
+
+std::vector<mitk::LabelSetImage::PixelType> mitk::LabelSetImage::CreateIdentityLookupTable()
+{
+  std::vector<PixelType> lookupTable(static_cast<std::size_t>(std::numeric_limits<PixelType>::max()) + 1);
+  std::iota(lookupTable.begin(), lookupTable.end(), PixelType(0));
+  return lookupTable;
+}
+
+void mitk::LabelSetImage::ApplyLabelLookupTable(const std::vector<PixelType> &lookupTable)
+{
+  if (lookupTable.size() <= std::numeric_limits<PixelType>::max())
+    mitkThrow() << "Invalid label lookup table; it has to contain an entry for every pixel value.";
+
+  std::size_t numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < this->GetDimension(); ++dim)
+    numberOfPixels *= static_cast<std::size_t>(this->GetDimension(dim));
+
+  try
+  {
+    ImageWriteAccessor accessor(this);
+    auto *data = static_cast<PixelType *>(accessor.GetData());
+    const PixelType *table = lookupTable.data();
+
+    // Split the buffer into chunks that are remapped concurrently
+    const std::size_t chunkSize = 1 << 20;
+    const std::size_t numberOfChunks = (numberOfPixels + chunkSize - 1) / chunkSize;
+
+    itk::MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [data, table, numberOfPixels, chunkSize](itk::SizeValueType chunk) {
+        PixelType *begin = data + chunk * chunkSize;
+        PixelType *end = data + std::min(numberOfPixels, (chunk + 1) * chunkSize);
+        for (PixelType *pixel = begin; pixel != end; ++pixel)
+          *pixel = table[*pixel];
+      },
+      nullptr);
+  }
+  catch (const itk::ExceptionObject &e)
   {
-    this->EraseLabel(VectorOfLabelPixelValues[idx]);
+    mitkThrow() << e.GetDescription();
   }
 }
 
@@ -528,13 +676,153 @@ const mitk::LabelSet* mitk::LabelSetImage::GetActiveLabelSet() const
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int layer)
 {
-  if (4 == this->GetDimension())
+  LabelStatisticsCache::Statistics statistics;
+
+  if (layer == this->GetActiveLayer())
   {
-    AccessFixedDimensionByItk_2(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer);
+    statistics = this->GetLabelStatistics(pixelValue);
   }
   else
   {
-    AccessByItk_2(this, CalculateCenterOfMassProcessing, pixelValue, layer);
+    const mitk::Image *layerImage = this->GetLayerImage(layer);
+    const unsigned int dimensions[3] = { this->GetDimension(0), this->GetDimension(1), this->GetDimension(2) };
+
+    LabelStatisticsCache cache;
+    cache.Initialize(dimensions);
+    ImageReadAccessor accessor(layerImage, layerImage->GetVolumeData(0));
+    cache.Update(static_cast<const PixelType *>(accessor.GetData()));
+
+    if (const auto *layerStatistics = cache.GetStatistics(pixelValue))
+      statistics = *layerStatistics;
+  }
+
+  mitk::Point3D pos;
+  pos.Fill(0.0);
+  if (0 != statistics.voxelCount)
+    pos = statistics.centerOfMassIndex;
+
+  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
+  this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
+  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
+}
+
+mitk::LabelStatisticsCache::Statistics mitk::LabelSetImage::GetLabelStatistics(PixelType pixelValue, TimeStepType t) const
+{
+  if (!this->IsValidTimeStep(t))
+  {
+    mitkThrow() << "Cannot get label statistics. Time step " << t << " is invalid.";
+  }
+
+  std::lock_guard<std::mutex> lock(m_LabelStatisticsMutex);
+
+  const auto *statistics = this->GetUpdatedLabelStatistics(t).GetStatistics(pixelValue);
+  return nullptr != statistics ? *statistics : LabelStatisticsCache::Statistics();
+}
+
+std::vector<mitk::LabelSetImage::PixelType> mitk::LabelSetImage::GetLabelValuesInImage(TimeStepType t) const
+{
+  if (!this->IsValidTimeStep(t))
+  {
+    mitkThrow() << "Cannot get label values. Time step " << t << " is invalid.";
+  }
+
+  std::lock_guard<std::mutex> lock(m_LabelStatisticsMutex);
+  return this->GetUpdatedLabelStatistics(t).GetLabelValues();
+}
+
+const mitk::LabelStatisticsCache &mitk::LabelSetImage::GetUpdatedLabelStatistics(TimeStepType t) const
+{
+  // pixel data was modified without telling which slices, so everything has to be rescanned
+  if (this->GetMTime() > m_LabelStatisticsMTime)
+  {
+    m_LabelStatistics.clear();
+    m_LabelStatisticsMTime = this->GetMTime();
+  }
+
+  m_LabelStatistics.resize(this->GetTimeSteps());
+  auto &cache = m_LabelStatistics[t];
+
+  if (nullptr == cache)
+  {
+    const unsigned int dimensions[3] = { this->GetDimension(0), this->GetDimension(1), this->GetDimension(2) };
+    cache.reset(new LabelStatisticsCache);
+    cache->Initialize(dimensions);
+  }
+
+  if (cache->IsModified())
+  {
+    ImageReadAccessor accessor(this, this->GetVolumeData(t));
+    cache->Update(static_cast<const PixelType *>(accessor.GetData()));
+  }
+
+  return *cache;
+}
+
+void mitk::LabelSetImage::InvalidateLabelStatistics(const PlaneGeometry *plane,
+                                                     TimeStepType t,
+                                                     itk::ModifiedTimeType mTimeBeforeWrite)
+{
+  if (nullptr == plane || !this->IsValidTimeStep(t))
+    return;
+
+  // slice range touched by the plane, with a margin for the interpolation of oblique planes
+  const BaseGeometry *geometry = this->GetGeometry(t);
+  ScalarType minSlice = std::numeric_limits<ScalarType>::max();
+  ScalarType maxSlice = std::numeric_limits<ScalarType>::lowest();
+
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index;
+    geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+    minSlice = std::min(minSlice, index[2]);
+    maxSlice = std::max(maxSlice, index[2]);
+  }
+
+  const ScalarType numberOfSlices = this->GetDimension(2);
+  minSlice = std::max<ScalarType>(std::floor(minSlice) - 1.0, 0.0);
+  maxSlice = std::min<ScalarType>(std::ceil(maxSlice) + 1.0, numberOfSlices - 1.0);
+
+  {
+    std::lock_guard<std::mutex> lock(m_LabelStatisticsMutex);
+
+    // pixel data was modified before without telling which slices, so the stamp must not cover it
+    // and GetLabelStatistics() rescans everything
+    if (m_LabelStatisticsMTime >= mTimeBeforeWrite)
+    {
+      if (minSlice <= maxSlice && t < m_LabelStatistics.size() && nullptr != m_LabelStatistics[t])
+      {
+        m_LabelStatistics[t]->InvalidateSlices(static_cast<unsigned int>(minSlice), static_cast<unsigned int>(maxSlice));
+      }
+
+      m_LabelStatisticsMTime = this->GetMTime();
+    }
+  }
+
+  // observers check themselves whether they were up to date before the write
+  if (minSlice <= maxSlice)
+  {
+    this->InvokeEvent(LabelSetImageSlicesModifiedEvent(
+      t, static_cast<unsigned int>(minSlice), static_cast<unsigned int>(maxSlice), mTimeBeforeWrite));
+  }
+}
+
+void mitk::LabelSetImage::ModifiedWithoutPixelChanges()
+{
+  itk::ModifiedTimeType previousMTime;
+  bool upToDate;
+  {
+    std::lock_guard<std::mutex> lock(m_LabelStatisticsMutex);
+    previousMTime = m_LabelStatisticsMTime;
+    upToDate = m_LabelStatisticsMTime >= this->GetMTime();
+  }
+
+  this->Modified();
+
+  if (upToDate)
+  {
+    std::lock_guard<std::mutex> lock(m_LabelStatisticsMutex);
+    if (previousMTime == m_LabelStatisticsMTime)
+      m_LabelStatisticsMTime = this->GetMTime();
   }
 }
 
@@ -755,143 +1043,12 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   this->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
-{
-  // for now, we just retrieve the voxel in the middle
-  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  std::vector<typename ImageType::IndexType> indexVector;
-
-  while (!iter.IsAtEnd())
-  {
-    // TODO fix comparison warning more effective
-    if (iter.Get() == pixelValue)
-    {
-      indexVector.push_back(iter.GetIndex());
-    }
-    ++iter;
-  }
-
-  mitk::Point3D pos;
-  pos.Fill(0.0);
-
-  if (!indexVector.empty())
-  {
-    typename itk::ImageRegionConstIteratorWithIndex<ImageType>::IndexType centerIndex;
-    centerIndex = indexVector.at(indexVector.size() / 2);
-    if (centerIndex.GetIndexDimension() == 3)
-    {
-      pos[0] = centerIndex[0];
-      pos[1] = centerIndex[1];
-      pos[2] = centerIndex[2];
-    }
-    else
-      return;
-  }
-
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
-  this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
-}
-
 template <typename ImageType>
 void mitk::LabelSetImage::ClearBufferProcessing(ImageType *itkImage)
 {
   itkImage->FillBuffer(0);
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *target,
-                                                          unsigned int layer)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkSource;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkSource);
-  itkSource = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(itkSource, itkSource->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(target, target->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source,
-                                                          unsigned int layer) const
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkTarget;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkTarget);
-  itkTarget = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(source, source->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(itkTarget, itkTarget->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
-template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    PixelType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
-template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    if (iter.Get() == index)
-    {
-      iter.Set(pixelValue);
-    }
-    ++iter;
-  }
-}
-
 bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
                  const mitk::LabelSetImage &rightHandSide,
                  ScalarType eps,
@@ -974,6 +1131,8 @@ bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
 }
 
 /** Functor class that implements the label transfer and is used in conjunction with the itk::BinaryFunctorImageFilter.
+* All label mappings are applied per pixel in the order of the mapping. This is equivalent to one pass per mapping,
+* but needs only a single pass over the image.
 * For details regarding the usage of the filter and the functor patterns, please see info of itk::BinaryFunctorImageFilter.
 */
 template <class TDestinationPixel, class TSourcePixel, class TOutputpixel>
@@ -981,15 +1140,17 @@ class LabelTransferFunctor
 {
 
 public:
+  typedef std::vector<std::pair<mitk::Label::PixelType, mitk::Label::PixelType> > LabelMappingType;
+
   LabelTransferFunctor() {};
 
   LabelTransferFunctor(const mitk::LabelSet* destinationLabelSet, mitk::Label::PixelType sourceBackground,
     mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked,
-    mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle,
+    const LabelMappingType& labelMapping, mitk::MultiLabelSegmentation::MergeStyle mergeStyle,
     mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle) :
     m_DestinationLabelSet(destinationLabelSet), m_SourceBackground(sourceBackground),
     m_DestinationBackground(destinationBackground), m_DestinationBackgroundLocked(destinationBackgroundLocked),
-    m_SourceLabel(sourceLabel), m_NewDestinationLabel(newDestinationLabel), m_MergeStyle(mergeStyle), m_OverwriteStyle(overwriteStyle)
+    m_LabelMapping(labelMapping), m_MergeStyle(mergeStyle), m_OverwriteStyle(overwriteStyle)
   {
   };
 
@@ -1004,8 +1165,7 @@ public:
     return this->m_SourceBackground == other.m_SourceBackground &&
       this->m_DestinationBackground == other.m_DestinationBackground &&
       this->m_DestinationBackgroundLocked == other.m_DestinationBackgroundLocked &&
-      this->m_SourceLabel == other.m_SourceLabel &&
-      this->m_NewDestinationLabel == other.m_NewDestinationLabel &&
+      this->m_LabelMapping == other.m_LabelMapping &&
       this->m_MergeStyle == other.m_MergeStyle &&
       this->m_OverwriteStyle == other.m_OverwriteStyle &&
       this->m_DestinationLabelSet == other.m_DestinationLabelSet;
@@ -1017,8 +1177,7 @@ public:
     this->m_SourceBackground = other.m_SourceBackground;
     this->m_DestinationBackground = other.m_DestinationBackground;
     this->m_DestinationBackgroundLocked = other.m_DestinationBackgroundLocked;
-    this->m_SourceLabel = other.m_SourceLabel;
-    this->m_NewDestinationLabel = other.m_NewDestinationLabel;
+    this->m_LabelMapping = other.m_LabelMapping;
     this->m_MergeStyle = other.m_MergeStyle;
     this->m_OverwriteStyle = other.m_OverwriteStyle;
 
@@ -1027,24 +1186,38 @@ public:
 
   inline TOutputpixel operator()(const TDestinationPixel& existingDestinationValue, const TSourcePixel& existingSourceValue)
   {
-    if (existingSourceValue == this->m_SourceLabel)
+    TDestinationPixel destinationValue = existingDestinationValue;
+
+    for (const auto& [sourceLabel, newDestinationLabel] : this->m_LabelMapping)
+    {
+      destinationValue = this->TransferLabel(destinationValue, existingSourceValue, sourceLabel, newDestinationLabel);
+    }
+
+    return destinationValue;
+  }
+
+private:
+  inline TDestinationPixel TransferLabel(const TDestinationPixel& existingDestinationValue, const TSourcePixel& existingSourceValue,
+    mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel) const
+  {
+    if (existingSourceValue == sourceLabel)
     {
       if (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle)
       {
-        return this->m_NewDestinationLabel;
+        return newDestinationLabel;
       }
       else
       {
         auto label = this->m_DestinationLabelSet->GetLabel(existingDestinationValue);
         if (nullptr == label || !label->GetLocked())
         {
-          return this->m_NewDestinationLabel;
+          return newDestinationLabel;
         }
       }
     }
     else if (mitk::MultiLabelSegmentation::MergeStyle::Replace == this->m_MergeStyle
       && existingSourceValue == this->m_SourceBackground
-      && existingDestinationValue == this->m_NewDestinationLabel
+      && existingDestinationValue == newDestinationLabel
       && (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle
           || !this->m_DestinationBackgroundLocked))
     {
@@ -1054,13 +1227,11 @@ public:
     return existingDestinationValue;
   }
 
-private:
   const mitk::LabelSet* m_DestinationLabelSet = nullptr;
   mitk::Label::PixelType m_SourceBackground = 0;
   mitk::Label::PixelType m_DestinationBackground = 0;
   bool m_DestinationBackgroundLocked = false;
-  mitk::Label::PixelType m_SourceLabel = 1;
-  mitk::Label::PixelType m_NewDestinationLabel = 1;
+  LabelMappingType m_LabelMapping = { {1,1} };
   mitk::MultiLabelSegmentation::MergeStyle m_MergeStyle = mitk::MultiLabelSegmentation::MergeStyle::Replace;
   mitk::MultiLabelSegmentation::OverwriteStyle m_OverwriteStyle = mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks;
 };
@@ -1069,7 +1240,7 @@ private:
 template<unsigned int VImageDimension>
 void TransferLabelContentHelper(const itk::Image<mitk::Label::PixelType, VImageDimension>* itkSourceImage, mitk::Image* destinationImage,
   const mitk::LabelSet* destinationLabelSet, mitk::Label::PixelType sourceBackground, mitk::Label::PixelType destinationBackground,
-  bool destinationBackgroundLocked, mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
+  bool destinationBackgroundLocked, const std::vector<std::pair<mitk::Label::PixelType, mitk::Label::PixelType> >& labelMapping, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
 {
   typedef itk::Image<mitk::Label::PixelType, VImageDimension> ContentImageType;
   typename ContentImageType::Pointer itkDestinationImage;
@@ -1088,7 +1259,7 @@ void TransferLabelContentHelper(const itk::Image<mitk::Label::PixelType, VImageD
   typedef itk::BinaryFunctorImageFilter<ContentImageType, ContentImageType, ContentImageType, LabelTransferFunctorType> FilterType;
 
   LabelTransferFunctorType transferFunctor(destinationLabelSet, sourceBackground, destinationBackground,
-    destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStyle);
+    destinationBackgroundLocked, labelMapping, mergeStyle, overwriteStyle);
 
   auto transferFilter = FilterType::New();
 
@@ -1131,15 +1302,17 @@ void mitk::TransferLabelContent(
     mitkThrow() << "Invalid call of TransferLabelContent; destinationImage does not have the requested time step: " << timeStep;
   }
 
-  for (const auto& [sourceLabel, newDestinationLabel] : labelMapping)
+  for (const auto& mappingElement : labelMapping)
   {
-    if (nullptr == destinationLabelSet->GetLabel(newDestinationLabel))
+    if (nullptr == destinationLabelSet->GetLabel(mappingElement.second))
     {
-      mitkThrow() << "Invalid call of TransferLabelContent. Defined destination label does not exist in destinationImage. newDestinationLabel: " << newDestinationLabel;
+      mitkThrow() << "Invalid call of TransferLabelContent. Defined destination label does not exist in destinationImage. newDestinationLabel: " << mappingElement.second;
     }
-
-    AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabelSet, sourceBackground, destinationBackground, destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStlye));
   }
+
+  // all mappings are transferred in a single pass
+  if (!labelMapping.empty())
+    AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabelSet, sourceBackground, destinationBackground, destinationBackgroundLocked, labelMapping, mergeStyle, overwriteStlye));
   destinationImage->Modified();
 }
 
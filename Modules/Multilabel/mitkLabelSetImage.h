@@ -15,11 +15,60 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include <mitkLabelSet.h>
+#include <mitkLabelStatisticsCache.h>
 
 #include <MitkMultilabelExports.h>
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
+  /**
+   * @brief Event of a LabelSetImage after pixel data of the axial slices FirstSlice to LastSlice
+   *        (inclusive) of a time step was written, see LabelSetImage::InvalidateLabelStatistics().
+   *        Observers that keep data derived from the pixels only have to rescan these slices, if
+   *        their data was up to date at MTimeBeforeWrite, the GetMTime() of the image before the write.
+   */
+  class MITKMULTILABEL_EXPORT LabelSetImageSlicesModifiedEvent : public itk::AnyEvent
+  {
+  public:
+    typedef LabelSetImageSlicesModifiedEvent Self;
+    typedef itk::AnyEvent Superclass;
+
+    LabelSetImageSlicesModifiedEvent(TimeStepType timeStep = 0,
+                                     unsigned int firstSlice = 0,
+                                     unsigned int lastSlice = 0,
+                                     itk::ModifiedTimeType mTimeBeforeWrite = 0)
+      : m_TimeStep(timeStep), m_FirstSlice(firstSlice), m_LastSlice(lastSlice), m_MTimeBeforeWrite(mTimeBeforeWrite)
+    {
+    }
+    LabelSetImageSlicesModifiedEvent(const Self &s)
+      : Superclass(s),
+        m_TimeStep(s.m_TimeStep),
+        m_FirstSlice(s.m_FirstSlice),
+        m_LastSlice(s.m_LastSlice),
+        m_MTimeBeforeWrite(s.m_MTimeBeforeWrite)
+    {
+    }
+    ~LabelSetImageSlicesModifiedEvent() override {}
+    const char *GetEventName() const override { return "LabelSetImageSlicesModifiedEvent"; }
+    bool CheckEvent(const itk::EventObject *e) const override { return dynamic_cast<const Self *>(e) != nullptr; }
+    itk::EventObject *MakeObject() const override { return new Self(*this); }
+
+    TimeStepType GetTimeStep() const { return m_TimeStep; }
+    unsigned int GetFirstSlice() const { return m_FirstSlice; }
+    unsigned int GetLastSlice() const { return m_LastSlice; }
+    itk::ModifiedTimeType GetMTimeBeforeWrite() const { return m_MTimeBeforeWrite; }
+
+  private:
+    TimeStepType m_TimeStep;
+    unsigned int m_FirstSlice;
+    unsigned int m_LastSlice;
+    itk::ModifiedTimeType m_MTimeBeforeWrite;
+    void operator=(const Self &);
+  };
+
   //##Documentation
   //## @brief LabelSetImage class for handling labels and layers in a segmentation session.
   //##
@@ -56,6 +105,43 @@ namespace mitk
     using mitk::Image::Initialize;
     void Initialize(const mitk::Image *image) override;
 
+    /**
+     * @brief Initializes the image like mitk::Image::Initialize(). All other Initialize() methods
+     *        (e.g. used by mitk::GrabItkImageMemory()) end up here. Existing layers are replaced by
+     *        empty layers of the new size and the pixel data references the active one again.
+     */
+    void Initialize(const mitk::PixelType &type,
+                    unsigned int dimension,
+                    const unsigned int *dimensions,
+                    unsigned int channels = 1) override;
+
+    /**
+     * @brief Sets the geometry like mitk::Image::SetGeometry() and passes a clone of it to all layer images.
+     */
+    void SetGeometry(BaseGeometry *geometry) override;
+
+    /**
+     * @brief Sets the time geometry and passes a clone of it to all layer images, so that layers created
+     *        before the geometry was known (e.g. by mitk::GrabItkImageMemory()) do not keep a default geometry.
+     */
+    void SetTimeGeometry(TimeGeometry *geometry) override;
+
+    /**
+     * @brief Imports the data into the active layer. The data is always copied into the memory
+     *        of the layer, as the pixel data of this image references it. If importMemoryManagement
+     *        is ManageMemory, the passed data is deleted afterwards.
+     */
+    bool SetImportVolume(void *data,
+                         int t = 0,
+                         int n = 0,
+                         ImportMemoryManagementType importMemoryManagement = CopyMemory) override;
+    using mitk::Image::SetImportVolume;
+
+    /** @brief Imports the data into the active layer, see SetImportVolume(). */
+    bool SetImportChannel(void *data,
+                          int n = 0,
+                          ImportMemoryManagementType importMemoryManagement = CopyMemory) override;
+
     /**
       * \brief  */
     void ClearBuffer();
@@ -71,6 +157,7 @@ namespace mitk
 
     /**
      * @brief Merges a list of mitk::Labels with the mitk::Label that has a specific value
+     *        All source labels are merged in a single pass over the image.
      *
      * @param pixelValue                  the value of the label that should be the new merged label
      * @param vectorOfSourcePixelValues   the list of label values that should be merge into the specified one
@@ -79,9 +166,41 @@ namespace mitk
     void MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer = 0);
 
     /**
-      * \brief  */
+     * @brief Sets the center of mass (index and world coordinates) of the label with the given value
+     *        to the mean position of its voxels in the first time step.
+     *        For the active layer the cached label statistics are used (see GetLabelStatistics()).
+     * @remark Before, the middle voxel of the label in scan order was used, which always lies within the
+     *         label. The mean position is the actual center of mass, but for non-convex labels (e.g. a
+     *         ring or a C-shape) it may lie outside of the label.
+     */
     void UpdateCenterOfMass(PixelType pixelValue, unsigned int layer = 0);
 
+    /**
+     * @brief Returns voxel count, bounding box, center of mass and per slice occupancy of a label
+     *        value in the active layer at the given time step.
+     *        The statistics are cached. Only slices invalidated by InvalidateLabelStatistics() are
+     *        rescanned. If the image was modified otherwise, the whole image is rescanned.
+     */
+    LabelStatisticsCache::Statistics GetLabelStatistics(PixelType pixelValue, TimeStepType t = 0) const;
+
+    /**
+     * @brief Returns all pixel values that occur in the active layer at the given time step, whether
+     *        they belong to a label of the active label set or not. Uses the same cache as GetLabelStatistics().
+     */
+    std::vector<PixelType> GetLabelValuesInImage(TimeStepType t = 0) const;
+
+    /**
+     * @brief Marks the axial slices of the active layer that are intersected by the plane as modified.
+     *        Call it after pixel data within the plane was written and Modified() was called.
+     * @param plane the plane the pixel data was written to
+     * @param t the time step the pixel data was written to
+     * @param mTimeBeforeWrite GetMTime() of the image before the pixel data was written. Only if the
+     *        statistics were up to date at that time, the slice write is applied incrementally.
+     *        Otherwise the whole image is rescanned by the next call of GetLabelStatistics().
+     *        The written slices are also reported to observers by a LabelSetImageSlicesModifiedEvent.
+     */
+    void InvalidateLabelStatistics(const PlaneGeometry *plane, TimeStepType t, itk::ModifiedTimeType mTimeBeforeWrite);
+
     /**
      * @brief Removes the label with the given value.
      *        The label is removed from the labelset of the given layer and
@@ -111,6 +230,7 @@ namespace mitk
 
     /**
      * @brief Erases a list of labels with the given values from the labelset image.
+     *        All labels are erased in a single pass over the image.
      * @param VectorOfLabelPixelValues the list of pixel values of the labels
      *                                 that will be erased from the labelset image
      */
@@ -207,7 +327,8 @@ namespace mitk
     void MaskStamp(mitk::Image *mask, bool forceOverwrite);
 
     /**
-      * \brief  */
+      * \brief Sets the active layer. The pixel data of this image is switched to reference
+      *        the data of the new layer, so no pixel data is copied. */
     void SetActiveLayer(unsigned int layer);
 
     /**
@@ -223,7 +344,8 @@ namespace mitk
 
     /**
     * \brief Adds a layer based on a provided mitk::Image.
-    * \param layerImage is added to the vector of label images
+    * \param layerImage is added to the vector of label images without copying its pixel data. The label set image
+    *        takes it over, so writes to the layer change layerImage and vice versa
     * \param labelSet   a labelset that will be added to the new layer if provided
     * \return the layer ID of the new layer
     */
@@ -278,23 +400,43 @@ namespace mitk
     LabelSetImage(const LabelSetImage &other);
     ~LabelSetImage() override;
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer);
+    /**
+     * @brief Lets the pixel data of this image reference the pixel data of the given layer image.
+     *        No pixel data is copied, all modifications of this image directly affect the layer image.
+     */
+    void ReferenceLayerImage(unsigned int layer);
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
+    /** @brief Returns the label statistics cache of time step t after rescanning invalidated slices.
+     *         m_LabelStatisticsMutex has to be locked by the caller. */
+    const LabelStatisticsCache &GetUpdatedLabelStatistics(TimeStepType t) const;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
+    /** @brief Passes a clone of the time geometry of this image to all layer images. */
+    void UpdateLayerGeometries();
+
+    /** @brief Creates a new zero initialized layer image matching the geometry of this image. */
+    mitk::Image::Pointer CreateLayerImage() const;
+
+    /**
+     * @brief Copies the data into the active layer (volume t or the whole channel if t is -1) and
+     *        deletes it if importMemoryManagement is ManageMemory.
+     */
+    void ImportIntoActiveLayer(void *data, int t, ImportMemoryManagementType importMemoryManagement);
+
+    /** @brief Calls Modified() but keeps cached label statistics valid. For changes that do not affect pixel data. */
+    void ModifiedWithoutPixelChanges();
 
     template <typename ImageType>
     void ClearBufferProcessing(ImageType *input);
 
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index);
+    /**
+     * @brief Replaces every pixel value v of the image (all time steps) by lookupTable[v].
+     *        The image is processed in a single, parallel pass. The lookup table has to
+     *        contain an entry for every possible PixelType value.
+     */
+    void ApplyLabelLookupTable(const std::vector<PixelType> &lookupTable);
 
-    template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
+    /** @brief Returns a lookup table that maps every pixel value to itself. */
+    static std::vector<PixelType> CreateIdentityLookupTable();
 
     template <typename ImageType>
     void MaskStampProcessing(ImageType *input, mitk::Image *mask, bool forceOverwrite);
@@ -303,13 +445,22 @@ namespace mitk
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
+
+    /** Owns the pixel data of every layer. The pixel data of this image references the data of the active layer. */
     std::vector<Image::Pointer> m_LayerContainer;
 
     int m_ActiveLayer;
 
+    /** Set if the pixel data of this image does not reference the data of the active layer (yet). */
     bool m_activeLayerInvalid;
 
     mitk::Label::Pointer m_ExteriorLabel;
+
+    /** Label statistics of the active layer, one cache per time step, created on first query. */
+    mutable std::vector<std::unique_ptr<LabelStatisticsCache>> m_LabelStatistics;
+    /** Modification time of the image up to which all pixel changes are known to m_LabelStatistics. */
+    mutable itk::ModifiedTimeType m_LabelStatisticsMTime;
+    mutable std::mutex m_LabelStatisticsMutex;
   };
 
   /**
@@ -0,0 +1,219 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelStatisticsCache.h"
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+mitk::LabelStatisticsCache::LabelStatisticsCache() : m_Modified(false)
+{
+  std::fill(m_Dimensions, m_Dimensions + 3, 0);
+}
+
+void mitk::LabelStatisticsCache::Initialize(const unsigned int dimensions[3])
+{
+  std::copy(dimensions, dimensions + 3, m_Dimensions);
+
+  m_Labels.clear();
+  m_LabelsPerSlice.assign(m_Dimensions[2], std::vector<PixelType>());
+  m_InvalidSlices.assign(m_Dimensions[2], true);
+  m_Modified = m_Dimensions[2] > 0;
+}
+
+void mitk::LabelStatisticsCache::InvalidateSlices(unsigned int firstSlice, unsigned int lastSlice)
+{
+  if (m_InvalidSlices.empty() || firstSlice > lastSlice || firstSlice >= m_InvalidSlices.size())
+    return;
+
+  lastSlice = std::min(lastSlice, static_cast<unsigned int>(m_InvalidSlices.size() - 1));
+  std::fill(m_InvalidSlices.begin() + firstSlice, m_InvalidSlices.begin() + lastSlice + 1, true);
+  m_Modified = true;
+}
+
+void mitk::LabelStatisticsCache::InvalidateAll()
+{
+  this->InvalidateSlices(0, std::numeric_limits<unsigned int>::max());
+}
+
+bool mitk::LabelStatisticsCache::IsModified() const
+{
+  return m_Modified;
+}
+
+void mitk::LabelStatisticsCache::ScanSlice(const PixelType *sliceData, SliceStatisticsMapType &result) const
+{
+  // Label images mostly consist of long runs of the same value, so the map is only consulted
+  // when the value changes.
+  for (unsigned int y = 0; y < m_Dimensions[1]; ++y)
+  {
+    const PixelType *row = sliceData + static_cast<std::size_t>(y) * m_Dimensions[0];
+    unsigned int x = 0;
+
+    while (x < m_Dimensions[0])
+    {
+      const PixelType value = row[x];
+      const unsigned int runStart = x;
+      while (x < m_Dimensions[0] && row[x] == value)
+        ++x;
+
+      const unsigned int runEnd = x - 1;
+      const std::size_t runLength = x - runStart;
+
+      const auto insertion = result.try_emplace(value);
+      SliceStatistics &statistics = insertion.first->second;
+      if (insertion.second)
+      {
+        statistics.minX = runStart;
+        statistics.maxX = runEnd;
+        statistics.minY = y;
+      }
+
+      statistics.voxelCount += runLength;
+      statistics.sumX += 0.5 * static_cast<double>(runStart + runEnd) * static_cast<double>(runLength);
+      statistics.sumY += static_cast<double>(y) * static_cast<double>(runLength);
+      statistics.minX = std::min(statistics.minX, runStart);
+      statistics.maxX = std::max(statistics.maxX, runEnd);
+      statistics.maxY = y;
+    }
+  }
+}
+
+void mitk::LabelStatisticsCache::UpdateStatistics(LabelEntry &entry)
+{
+  Statistics &statistics = entry.statistics;
+  statistics = Statistics();
+
+  double sumX = 0.0;
+  double sumY = 0.0;
+  double sumZ = 0.0;
+
+  for (const auto &slice : entry.slices)
+  {
+    const SliceStatistics &sliceStatistics = slice.second;
+
+    if (0 == statistics.voxelCount)
+    {
+      statistics.minIndex[0] = sliceStatistics.minX;
+      statistics.minIndex[1] = sliceStatistics.minY;
+      statistics.minIndex[2] = slice.first;
+      statistics.maxIndex[0] = sliceStatistics.maxX;
+      statistics.maxIndex[1] = sliceStatistics.maxY;
+    }
+    else
+    {
+      statistics.minIndex[0] = std::min<itk::IndexValueType>(statistics.minIndex[0], sliceStatistics.minX);
+      statistics.minIndex[1] = std::min<itk::IndexValueType>(statistics.minIndex[1], sliceStatistics.minY);
+      statistics.maxIndex[0] = std::max<itk::IndexValueType>(statistics.maxIndex[0], sliceStatistics.maxX);
+      statistics.maxIndex[1] = std::max<itk::IndexValueType>(statistics.maxIndex[1], sliceStatistics.maxY);
+    }
+    statistics.maxIndex[2] = slice.first; // slices are sorted
+
+    statistics.voxelCount += sliceStatistics.voxelCount;
+    statistics.voxelsPerSlice.emplace_hint(statistics.voxelsPerSlice.end(), slice.first, sliceStatistics.voxelCount);
+
+    sumX += sliceStatistics.sumX;
+    sumY += sliceStatistics.sumY;
+    sumZ += static_cast<double>(slice.first) * static_cast<double>(sliceStatistics.voxelCount);
+  }
+
+  statistics.centerOfMassIndex.Fill(0.0);
+  if (0 != statistics.voxelCount)
+  {
+    const double count = static_cast<double>(statistics.voxelCount);
+    statistics.centerOfMassIndex[0] = sumX / count;
+    statistics.centerOfMassIndex[1] = sumY / count;
+    statistics.centerOfMassIndex[2] = sumZ / count;
+  }
+}
+
+void mitk::LabelStatisticsCache::Update(const PixelType *data)
+{
+  if (!m_Modified)
+    return;
+
+  std::vector<unsigned int> invalidSlices;
+  for (unsigned int z = 0; z < m_InvalidSlices.size(); ++z)
+  {
+    if (m_InvalidSlices[z])
+      invalidSlices.push_back(z);
+  }
+
+  const std::size_t sliceSize = static_cast<std::size_t>(m_Dimensions[0]) * m_Dimensions[1];
+  std::vector<SliceStatisticsMapType> results(invalidSlices.size());
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    invalidSlices.size(),
+    [this, data, sliceSize, &invalidSlices, &results](itk::SizeValueType i) {
+      this->ScanSlice(data + invalidSlices[i] * sliceSize, results[i]);
+    },
+    nullptr);
+
+  std::set<PixelType> affectedLabels;
+
+  for (std::size_t i = 0; i < invalidSlices.size(); ++i)
+  {
+    const unsigned int z = invalidSlices[i];
+
+    // remove the contribution of the previous scan of the slice
+    for (const auto value : m_LabelsPerSlice[z])
+    {
+      m_Labels[value].slices.erase(z);
+      affectedLabels.insert(value);
+    }
+    m_LabelsPerSlice[z].clear();
+
+    for (const auto &result : results[i])
+    {
+      m_Labels[result.first].slices[z] = result.second;
+      m_LabelsPerSlice[z].push_back(result.first);
+      affectedLabels.insert(result.first);
+    }
+
+    m_InvalidSlices[z] = false;
+  }
+
+  for (const auto value : affectedLabels)
+  {
+    auto finding = m_Labels.find(value);
+    if (finding->second.slices.empty())
+    {
+      m_Labels.erase(finding);
+    }
+    else
+    {
+      UpdateStatistics(finding->second);
+    }
+  }
+
+  m_Modified = false;
+}
+
+const mitk::LabelStatisticsCache::Statistics *mitk::LabelStatisticsCache::GetStatistics(PixelType pixelValue) const
+{
+  const auto finding = m_Labels.find(pixelValue);
+  return finding != m_Labels.cend() ? &(finding->second.statistics) : nullptr;
+}
+
+std::vector<mitk::LabelStatisticsCache::PixelType> mitk::LabelStatisticsCache::GetLabelValues() const
+{
+  std::vector<PixelType> values;
+  values.reserve(m_Labels.size());
+  for (const auto &label : m_Labels)
+    values.push_back(label.first);
+
+  return values;
+}
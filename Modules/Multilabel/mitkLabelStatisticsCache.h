@@ -0,0 +1,123 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelStatisticsCache_h
+#define mitkLabelStatisticsCache_h
+
+#include <MitkMultilabelExports.h>
+
+#include <mitkLabel.h>
+#include <mitkVector.h>
+
+#include <itkIndex.h>
+
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Incrementally maintained statistics of all label values in one 3D label volume.
+   *
+   * The cache keeps, for every axial slice (third index axis) and every label value found in
+   * that slice, the voxel count, the index sums and the 2D bounding box. The statistics of a label
+   * (voxel count, bounding box, center of mass and per slice occupancy) are combined from its
+   * slice entries. After pixel data has been written, only the affected slices are marked with
+   * InvalidateSlices() and rescanned by the next Update(). Queries with GetStatistics() do not
+   * touch the pixel data at all.
+   *
+   * The cache does not reference the pixel data. The owner has to pass the current buffer to
+   * Update() before querying statistics of invalidated slices.
+   */
+  class MITKMULTILABEL_EXPORT LabelStatisticsCache
+  {
+  public:
+    typedef mitk::Label::PixelType PixelType;
+
+    struct Statistics
+    {
+      /** Number of voxels with the label value. All other members are only valid if it is not 0. */
+      std::size_t voxelCount = 0;
+      itk::Index<3> minIndex;
+      itk::Index<3> maxIndex;
+      /** Mean index of all voxels of the label. */
+      mitk::Point3D centerOfMassIndex;
+      /** Number of voxels per occupied axial slice. */
+      std::map<unsigned int, std::size_t> voxelsPerSlice;
+    };
+
+    LabelStatisticsCache();
+
+    /** @brief Resets the cache to a volume of the given size. All slices are invalid afterwards. */
+    void Initialize(const unsigned int dimensions[3]);
+
+    /** @brief Marks the slices firstSlice to lastSlice (inclusive, clamped to the volume) for rescanning. */
+    void InvalidateSlices(unsigned int firstSlice, unsigned int lastSlice);
+
+    /** @brief Marks all slices for rescanning. */
+    void InvalidateAll();
+
+    /** @brief Returns true if at least one slice has to be rescanned. */
+    bool IsModified() const;
+
+    /**
+     * @brief Rescans all invalidated slices of the passed buffer and updates the statistics of every
+     *        label that was or is found in these slices.
+     * @param data the pixel data of the volume, x running fastest. Has to match the size passed to Initialize().
+     */
+    void Update(const PixelType *data);
+
+    /**
+     * @brief Returns the statistics of a label value as of the last Update().
+     * @return nullptr if the label value does not occur in the volume.
+     */
+    const Statistics *GetStatistics(PixelType pixelValue) const;
+
+    /** @brief Returns all label values that occur in the volume as of the last Update(). */
+    std::vector<PixelType> GetLabelValues() const;
+
+  private:
+    struct SliceStatistics
+    {
+      std::size_t voxelCount = 0;
+      double sumX = 0.0;
+      double sumY = 0.0;
+      unsigned int minX = 0;
+      unsigned int maxX = 0;
+      unsigned int minY = 0;
+      unsigned int maxY = 0;
+    };
+
+    typedef std::map<PixelType, SliceStatistics> SliceStatisticsMapType;
+
+    struct LabelEntry
+    {
+      std::map<unsigned int, SliceStatistics> slices;
+      Statistics statistics;
+    };
+
+    void ScanSlice(const PixelType *sliceData, SliceStatisticsMapType &result) const;
+    static void UpdateStatistics(LabelEntry &entry);
+
+    unsigned int m_Dimensions[3];
+
+    std::map<PixelType, LabelEntry> m_Labels;
+
+    /** Label values found in every slice by the last scan of the slice. */
+    std::vector<std::vector<PixelType>> m_LabelsPerSlice;
+
+    std::vector<bool> m_InvalidSlices;
+    bool m_Modified;
+  };
+}
+
+#endif
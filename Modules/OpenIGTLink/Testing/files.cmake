@@ -2,4 +2,7 @@ set(MODULE_TESTS
    mitkOpenIGTLinkClientServerTest.cpp
    mitkOpenIGTLinkImageFactoryTest.cpp
    mitkOpenIGTLinkIGTLImageMessageFilterTest.cpp
+   mitkOpenIGTLinkMessageQueueTest.cpp
+   mitkOpenIGTLinkMessageRingBufferTest.cpp
+   mitkOpenIGTLinkMeasurementsTest.cpp
 )
@@ -0,0 +1,84 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+//TEST
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+//MITK
+#include "mitkIGTLMeasurements.h"
+
+class mitkOpenIGTLinkMeasurementsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkOpenIGTLinkMeasurementsTestSuite);
+  MITK_TEST(Test_GetLatencyPercentile_UsesNearestRank);
+  MITK_TEST(Test_GetLatencyPercentile_IgnoresIncompleteMeasurements);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::IGTLMeasurements* m_Measurements;
+
+public:
+
+  void setUp() override
+  {
+    m_Measurements = mitk::IGTLMeasurements::GetInstance();
+    CPPUNIT_ASSERT_MESSAGE("The measurements service is registered by the module", m_Measurements != nullptr);
+    m_Measurements->Reset();
+    m_Measurements->SetStarted(true);
+  }
+
+  void tearDown() override
+  {
+    m_Measurements->SetStarted(false);
+    m_Measurements->Reset();
+  }
+
+  void Test_GetLatencyPercentile_UsesNearestRank()
+  {
+    CPPUNIT_ASSERT_EQUAL(-1ll, m_Measurements->GetLatencyPercentile(0, 1, 50));
+
+    // the message with index i has a latency of i, added in reverse order
+    for (unsigned int i = 100; i > 0; --i)
+    {
+      m_Measurements->AddMeasurement(0, i, 1000 * i);
+      m_Measurements->AddMeasurement(1, i, 1000 * i + i);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), m_Measurements->GetLatencies(0, 1).size());
+    CPPUNIT_ASSERT_EQUAL(1ll, m_Measurements->GetLatencies(0, 1).front());
+    CPPUNIT_ASSERT_EQUAL(1ll, m_Measurements->GetLatencyPercentile(0, 1, 0));
+    CPPUNIT_ASSERT_EQUAL(50ll, m_Measurements->GetLatencyPercentile(0, 1, 50));
+    CPPUNIT_ASSERT_EQUAL(99ll, m_Measurements->GetLatencyPercentile(0, 1, 99));
+    CPPUNIT_ASSERT_EQUAL(100ll, m_Measurements->GetLatencyPercentile(0, 1, 100));
+    CPPUNIT_ASSERT_EQUAL(100ll, m_Measurements->GetLatencyPercentile(0, 1, 150));
+  }
+
+  void Test_GetLatencyPercentile_IgnoresIncompleteMeasurements()
+  {
+    m_Measurements->AddMeasurement(0, 1, 1000);
+    m_Measurements->AddMeasurement(0, 1, 1500); // only the first measurement of an index is used
+    m_Measurements->AddMeasurement(1, 1, 1010);
+    m_Measurements->AddMeasurement(0, 2, 2000); // never arrives at the second point
+    m_Measurements->AddMeasurement(1, 3, 3000); // never passed the first point
+
+    m_Measurements->SetStarted(false);
+    m_Measurements->AddMeasurement(0, 4, 4000);
+    m_Measurements->AddMeasurement(1, 4, 5000);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Measurements->GetLatencies(0, 1).size());
+    CPPUNIT_ASSERT_EQUAL(10ll, m_Measurements->GetLatencyPercentile(0, 1, 50));
+    CPPUNIT_ASSERT_EQUAL(-1ll, m_Measurements->GetLatencyPercentile(0, 2, 50));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkOpenIGTLinkMeasurements)
@@ -0,0 +1,213 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+//TEST
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+//MITK
+#include "mitkIGTLMessageQueue.h"
+
+//STD
+#include <string>
+#include <vector>
+
+//IGTL
+#include "igtlImageMessage.h"
+#include "igtlStatusMessage.h"
+#include "igtlTransformMessage.h"
+
+class mitkOpenIGTLinkMessageQueueTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkOpenIGTLinkMessageQueueTestSuite);
+  MITK_TEST(Test_DropOldest_KeepsNewestMessages);
+  MITK_TEST(Test_DropNewest_KeepsOldestMessages);
+  MITK_TEST(Test_KeepLatest_KeepsLatestMessage);
+  MITK_TEST(Test_NoBuffering_KeepsCommands);
+  MITK_TEST(Test_ImageMessages_AreSortedAndReused);
+  MITK_TEST(Test_ReusableMessages_OfOtherSizeAreEvicted);
+  MITK_TEST(Test_ReusableMessages_AreBoundedByCapacity);
+  MITK_TEST(Test_ReusableMessages_AreReleasedByNoBufferingMode);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::IGTLMessageQueue::Pointer m_Queue;
+
+  igtl::TransformMessage::Pointer CreateTransformMessage(int index)
+  {
+    igtl::TransformMessage::Pointer message = igtl::TransformMessage::New();
+    message->SetDeviceName(std::to_string(index).c_str());
+    return message;
+  }
+
+  int GetIndex(igtl::MessageBase* message)
+  {
+    return std::stoi(message->GetDeviceName());
+  }
+
+  igtl::ImageMessage::Pointer CreateImageMessage(int depth)
+  {
+    igtl::ImageMessage::Pointer message = igtl::ImageMessage::New();
+    message->SetDimensions(4, 4, depth);
+    message->SetScalarTypeToUint8();
+    message->AllocateScalars();
+    return message;
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_Queue = mitk::IGTLMessageQueue::New();
+    m_Queue->EnableNoBufferingMode(false);
+  }
+
+  void tearDown() override
+  {
+    m_Queue = nullptr;
+  }
+
+  void Test_DropOldest_KeepsNewestMessages()
+  {
+    m_Queue->SetCapacity(mitk::IGTLMessageQueue::TransformQueue, 3);
+    for (int i = 0; i < 5; ++i)
+      m_Queue->PushMessage(this->CreateTransformMessage(i).GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(3, m_Queue->GetSize());
+    CPPUNIT_ASSERT_EQUAL(2ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::TransformQueue));
+    for (int i = 2; i < 5; ++i)
+      CPPUNIT_ASSERT_EQUAL(i, this->GetIndex(m_Queue->PullTransformMessage()));
+    CPPUNIT_ASSERT(m_Queue->PullTransformMessage().IsNull());
+
+    m_Queue->ResetNumberOfDroppedMessages();
+    CPPUNIT_ASSERT_EQUAL(0ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::TransformQueue));
+  }
+
+  void Test_DropNewest_KeepsOldestMessages()
+  {
+    m_Queue->SetCapacity(mitk::IGTLMessageQueue::TransformQueue, 3);
+    m_Queue->SetDropPolicy(mitk::IGTLMessageQueue::TransformQueue, mitk::IGTLMessageQueue::DropNewest);
+    for (int i = 0; i < 5; ++i)
+      m_Queue->PushMessage(this->CreateTransformMessage(i).GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(2ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::TransformQueue));
+    for (int i = 0; i < 3; ++i)
+      CPPUNIT_ASSERT_EQUAL(i, this->GetIndex(m_Queue->PullTransformMessage()));
+    CPPUNIT_ASSERT(m_Queue->PullTransformMessage().IsNull());
+  }
+
+  void Test_KeepLatest_KeepsLatestMessage()
+  {
+    m_Queue->SetDropPolicy(mitk::IGTLMessageQueue::TransformQueue, mitk::IGTLMessageQueue::KeepLatest);
+    for (int i = 0; i < 5; ++i)
+      m_Queue->PushMessage(this->CreateTransformMessage(i).GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(4ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::TransformQueue));
+    CPPUNIT_ASSERT_EQUAL(4, this->GetIndex(m_Queue->PullTransformMessage()));
+    CPPUNIT_ASSERT(m_Queue->PullTransformMessage().IsNull());
+  }
+
+  void Test_NoBuffering_KeepsCommands()
+  {
+    m_Queue->EnableNoBufferingMode(true);
+    for (int i = 0; i < 3; ++i)
+    {
+      igtl::StatusMessage::Pointer command = igtl::StatusMessage::New();
+      command->SetDeviceName(std::to_string(i).c_str());
+      m_Queue->PushCommandMessage(command.GetPointer());
+      m_Queue->PushMessage(this->CreateTransformMessage(i).GetPointer());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::CommandQueue));
+    CPPUNIT_ASSERT_EQUAL(2ull, m_Queue->GetNumberOfDroppedMessages(mitk::IGTLMessageQueue::TransformQueue));
+    for (int i = 0; i < 3; ++i)
+      CPPUNIT_ASSERT_EQUAL(i, this->GetIndex(m_Queue->PullCommandMessage()));
+    CPPUNIT_ASSERT_EQUAL(2, this->GetIndex(m_Queue->PullTransformMessage()));
+  }
+
+  void Test_ImageMessages_AreSortedAndReused()
+  {
+    igtl::ImageMessage::Pointer image2d = this->CreateImageMessage(1);
+    igtl::ImageMessage::Pointer image3d = this->CreateImageMessage(4);
+    m_Queue->PushMessage(image2d.GetPointer());
+    m_Queue->PushMessage(image3d.GetPointer());
+    CPPUNIT_ASSERT(m_Queue->PullImage2dMessage() == image2d);
+    CPPUNIT_ASSERT(m_Queue->PullImage3dMessage() == image3d);
+
+    // still referenced here and as latest message
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage(image2d->GetDeviceType(), image2d->GetPackBodySize()).IsNull());
+
+    m_Queue->PushMessage(this->CreateTransformMessage(0).GetPointer());
+    igtl::MessageBase* image2dPointer = image2d.GetPointer();
+    const igtlUint64 image2dBodySize = image2d->GetPackBodySize();
+    image2d = nullptr;
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage(image3d->GetDeviceType(), image2dBodySize).GetPointer() == image2dPointer);
+  }
+
+  /** Pushes an image message, pulls it again and releases it, so only the reuse pool references it */
+  igtlUint64 PushAndReleaseImageMessage()
+  {
+    igtl::ImageMessage::Pointer image = this->CreateImageMessage(1);
+    const igtlUint64 bodySize = image->GetPackBodySize();
+    m_Queue->PushMessage(image.GetPointer());
+    m_Queue->PullImage2dMessage();
+    m_Queue->PushMessage(this->CreateTransformMessage(0).GetPointer());
+    return bodySize;
+  }
+
+  void Test_ReusableMessages_OfOtherSizeAreEvicted()
+  {
+    const igtlUint64 bodySize = this->PushAndReleaseImageMessage();
+
+    // the frame size changed, the kept message is of no use anymore
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage("IMAGE", bodySize + 1).IsNull());
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage("IMAGE", bodySize).IsNull());
+  }
+
+  void Test_ReusableMessages_AreBoundedByCapacity()
+  {
+    m_Queue->SetCapacity(mitk::IGTLMessageQueue::Image2dQueue, 2);
+    igtlUint64 bodySize = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+      igtl::ImageMessage::Pointer image = this->CreateImageMessage(1);
+      bodySize = image->GetPackBodySize();
+      m_Queue->PushMessage(image.GetPointer());
+    }
+    while (m_Queue->PullImage2dMessage().IsNotNull())
+    {
+    }
+    m_Queue->PushMessage(this->CreateTransformMessage(0).GetPointer());
+
+    // hold every returned message, so the next call returns another one
+    std::vector<igtl::MessageBase::Pointer> reusableMessages;
+    for (auto message = m_Queue->GetReusableMessage("IMAGE", bodySize); message.IsNotNull();
+         message = m_Queue->GetReusableMessage("IMAGE", bodySize))
+      reusableMessages.push_back(message);
+
+    // capacity of the image queue plus a slack of two messages
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), reusableMessages.size());
+  }
+
+  void Test_ReusableMessages_AreReleasedByNoBufferingMode()
+  {
+    const igtlUint64 bodySize = this->PushAndReleaseImageMessage();
+    m_Queue->EnableNoBufferingMode(true);
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage("IMAGE", bodySize).IsNull());
+
+    const igtlUint64 otherBodySize = this->PushAndReleaseImageMessage();
+    m_Queue->ClearReusableMessages();
+    CPPUNIT_ASSERT(m_Queue->GetReusableMessage("IMAGE", otherBodySize).IsNull());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkOpenIGTLinkMessageQueue)
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+//TEST
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+//MITK
+#include "mitkIGTLMessageRingBuffer.h"
+
+//STD
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class mitkOpenIGTLinkMessageRingBufferTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkOpenIGTLinkMessageRingBufferTestSuite);
+  MITK_TEST(Test_PushAndPull_KeepOrder);
+  MITK_TEST(Test_ConcurrentPushAndPull_DeliverEveryMessageOnce);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef std::shared_ptr<unsigned int> MessagePointer;
+  typedef mitk::IGTLMessageRingBuffer<MessagePointer> RingBufferType;
+
+public:
+
+  void Test_PushAndPull_KeepOrder()
+  {
+    RingBufferType buffer(3);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), buffer.GetCapacity());
+
+    for (unsigned int i = 0; i < 4; ++i)
+      CPPUNIT_ASSERT(buffer.Push(std::make_shared<unsigned int>(i)));
+    CPPUNIT_ASSERT(!buffer.Push(std::make_shared<unsigned int>(4)));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), buffer.GetSize());
+
+    for (unsigned int i = 0; i < 4; ++i)
+      CPPUNIT_ASSERT_EQUAL(i, *buffer.Pull());
+    CPPUNIT_ASSERT(buffer.Pull() == nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), buffer.GetSize());
+  }
+
+  void Test_ConcurrentPushAndPull_DeliverEveryMessageOnce()
+  {
+    const unsigned int numberOfProducers = 2;
+    const unsigned int numberOfConsumers = 3;
+    const unsigned int messagesPerProducer = 100000;
+    const unsigned int numberOfMessages = numberOfProducers * messagesPerProducer;
+
+    // a small buffer makes the producers run into a full and the consumers into an empty buffer
+    RingBufferType buffer(16);
+    std::vector<std::vector<unsigned int>> pulledMessages(numberOfConsumers);
+    std::atomic<unsigned int> numberOfPulledMessages(0);
+
+    std::vector<std::thread> threads;
+    for (unsigned int producer = 0; producer < numberOfProducers; ++producer)
+    {
+      threads.emplace_back([&buffer, producer, messagesPerProducer]() {
+        for (unsigned int i = 0; i < messagesPerProducer; ++i)
+        {
+          auto message = std::make_shared<unsigned int>(producer * messagesPerProducer + i);
+          while (!buffer.Push(message))
+            std::this_thread::yield();
+        }
+      });
+    }
+
+    for (unsigned int consumer = 0; consumer < numberOfConsumers; ++consumer)
+    {
+      threads.emplace_back([&buffer, &pulledMessages, &numberOfPulledMessages, consumer, numberOfMessages]() {
+        while (numberOfPulledMessages.load() < numberOfMessages)
+        {
+          auto message = buffer.Pull();
+          if (message == nullptr)
+          {
+            std::this_thread::yield();
+            continue;
+          }
+
+          pulledMessages[consumer].push_back(*message);
+          ++numberOfPulledMessages;
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT(buffer.Pull() == nullptr);
+
+    // every message arrives exactly once and every consumer sees the messages
+    // of a producer in the order they were pushed
+    std::vector<unsigned int> numberOfDeliveries(numberOfMessages, 0);
+    for (const auto& messages : pulledMessages)
+    {
+      std::vector<long long> lastMessageOfProducer(numberOfProducers, -1);
+      for (auto message : messages)
+      {
+        CPPUNIT_ASSERT(message < numberOfMessages);
+        ++numberOfDeliveries[message];
+
+        const unsigned int producer = message / messagesPerProducer;
+        CPPUNIT_ASSERT(static_cast<long long>(message) > lastMessageOfProducer[producer]);
+        lastMessageOfProducer[producer] = message;
+      }
+    }
+
+    for (auto deliveries : numberOfDeliveries)
+      CPPUNIT_ASSERT_EQUAL(1u, deliveries);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkOpenIGTLinkMessageRingBuffer)
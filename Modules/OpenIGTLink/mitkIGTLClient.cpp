@@ -91,8 +91,8 @@ void mitk::IGTLClient::Send()
 {
   mitk::IGTLMessage::Pointer mitkMessage;
 
-  //get the latest message from the queue
-  mitkMessage = this->m_MessageQueue->PullSendMessage();
+  //get the latest message from the queue, wait for one if there is none
+  mitkMessage = this->WaitForSendMessage();
 
   // there is no message => return
   if (mitkMessage.IsNull())
@@ -109,6 +109,7 @@ void mitk::IGTLClient::StopCommunicationWithSocket(igtl::Socket* /*socket*/)
   m_StopCommunicationMutex.lock();
   m_StopCommunication = true;
   m_StopCommunicationMutex.unlock();
+  m_CommunicationEventCondition.notify_all();
 }
 
 unsigned int mitk::IGTLClient::GetNumberOfConnections()
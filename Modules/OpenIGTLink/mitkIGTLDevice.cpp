@@ -14,7 +14,7 @@ found in the LICENSE file.
 //#include "mitkIGTException.h"
 //#include "mitkIGTTimeStamp.h"
 #include <itkMultiThreaderBase.h>
-#include <itksys/SystemTools.hxx>
+#include <chrono>
 #include <cstring>
 #include <thread>
 
@@ -43,6 +43,7 @@ mitk::IGTLDevice::IGTLDevice(bool ReadFully) :
 m_State(mitk::IGTLDevice::Setup),
 m_Name("Unspecified Device"),
 m_StopCommunication(false),
+m_CommunicationEventPending(false),
 m_Hostname("127.0.0.1"),
 m_PortNumber(-1),
 m_LogMessages(false)
@@ -179,9 +180,13 @@ unsigned int mitk::IGTLDevice::ReceivePrivate(igtl::Socket* socket)
         return IGTL_STATUS_OK;
       }
 
-      //Create a message according to the header message
+      //Reuse a received message that is not needed anymore, so the pack of
+      //large (image) messages is not allocated again for every message.
+      //Otherwise create a message according to the header message
       igtl::MessageBase::Pointer curMessage;
-      curMessage = m_MessageFactory->CreateInstance(headerMsg);
+      curMessage = m_MessageQueue->GetReusableMessage(curDevType, headerMsg->GetBodySizeToRead());
+      if (curMessage.IsNull())
+        curMessage = m_MessageFactory->CreateInstance(headerMsg);
 
       //check if the curMessage is created properly, if not the message type is
       //not supported and the message has to be skipped
@@ -313,9 +318,6 @@ void mitk::IGTLDevice::RunCommunication(void (IGTLDevice::*ComFunction)(void), s
       this->m_StopCommunicationMutex.lock();
       localStopCommunication = m_StopCommunication;
       this->m_StopCommunicationMutex.unlock();
-
-      // time to relax, this sets the maximum ever possible framerate to 1000 Hz
-      itksys::SystemTools::Delay(1);
     }
   }
   catch (...)
@@ -372,6 +374,7 @@ bool mitk::IGTLDevice::StopCommunication()
     m_StopCommunicationMutex.lock();
     m_StopCommunication = true;
     m_StopCommunicationMutex.unlock();
+    m_CommunicationEventCondition.notify_all();
     // we have to wait here that the other thread recognizes the STOP-command
     // and executes it
     m_SendingFinishedMutex.lock();
@@ -398,6 +401,9 @@ bool mitk::IGTLDevice::CloseConnection()
 
   m_Socket->CloseSocket();
 
+  //the next connection may stream images of another size
+  m_MessageQueue->ClearReusableMessages();
+
   /* return to setup mode */
   this->SetState(Setup);
 
@@ -431,6 +437,30 @@ bool mitk::IGTLDevice::SendRTSMessage(const char* type)
 void mitk::IGTLDevice::Connect()
 {
   MITK_DEBUG << "mitk::IGTLDevice::Connect();";
+  // nothing to do, just keep the thread from spinning
+  this->WaitForCommunicationEvent();
+}
+
+mitk::IGTLMessage::Pointer mitk::IGTLDevice::WaitForSendMessage()
+{
+  return m_MessageQueue->PullSendMessage(std::chrono::milliseconds(SOCKET_SEND_RECEIVE_TIMEOUT_MSEC));
+}
+
+void mitk::IGTLDevice::WaitForCommunicationEvent()
+{
+  std::unique_lock<std::mutex> lock(m_StopCommunicationMutex);
+  m_CommunicationEventCondition.wait_for(lock,
+    std::chrono::milliseconds(SOCKET_SEND_RECEIVE_TIMEOUT_MSEC),
+    [this] { return m_StopCommunication || m_CommunicationEventPending; });
+  m_CommunicationEventPending = false;
+}
+
+void mitk::IGTLDevice::NotifyCommunicationEvent()
+{
+  m_StopCommunicationMutex.lock();
+  m_CommunicationEventPending = true;
+  m_StopCommunicationMutex.unlock();
+  m_CommunicationEventCondition.notify_all();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLDevice::GetNextImage2dMessage()
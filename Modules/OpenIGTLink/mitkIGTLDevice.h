@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef MITKIGTLDEVICE_H
 #define MITKIGTLDEVICE_H
 
+#include <condition_variable>
 #include <mutex>
 #include <thread>
 
@@ -56,6 +57,11 @@ namespace mitk {
   * call StopCommunication() (to arrive in Ready state) or CloseConnection()
   * (to arrive in the Setup state).
   *
+  * The communication threads do not poll. Receiving waits for data on the
+  * socket, sending waits for a message in the send queue and checking for
+  * connections waits on the server socket, each with a timeout that bounds
+  * the time StopCommunication() takes.
+  *
   * \ingroup OpenIGTLink
   *
   */
@@ -108,7 +114,8 @@ namespace mitk {
      * \brief Continuously calls the given function
      *
      * This may only be called if the device is in Running state and only from
-     * a seperate thread.
+     * a seperate thread. The function is called again right after it returned,
+     * so it has to wait for its event (or a timeout) itself.
      *
      * \param ComFunction function pointer that specifies the method to be executed
      * \param mutex the mutex that corresponds to the function pointer
@@ -318,6 +325,31 @@ namespace mitk {
     */
     void SetState(IGTLDeviceState state);
 
+    /**
+    * \brief Returns the oldest message of the send queue, waits for one if
+    * the queue is empty
+    *
+    * \return The message or nullptr if no message was queued before the
+    * socket timeout expired
+    */
+    mitk::IGTLMessage::Pointer WaitForSendMessage();
+
+    /**
+    * \brief Blocks the calling communication thread until
+    * NotifyCommunicationEvent() or StopCommunication() is called or the socket
+    * timeout expired
+    *
+    * Communication functions call this if they have nothing to wait for,
+    * e.g. receiving if there is no connection yet.
+    */
+    void WaitForCommunicationEvent();
+
+    /**
+    * \brief Wakes up a communication thread that waits in
+    * WaitForCommunicationEvent()
+    */
+    void NotifyCommunicationEvent();
+
     IGTLDevice();
     ~IGTLDevice() override;
 
@@ -330,6 +362,10 @@ namespace mitk {
     bool m_StopCommunication;
     /** mutex to control access to m_StopCommunication */
     std::mutex m_StopCommunicationMutex;
+    /** signals StopCommunication() and other events to waiting communication threads */
+    std::condition_variable m_CommunicationEventCondition;
+    /** true if NotifyCommunicationEvent() was called, guarded by m_StopCommunicationMutex */
+    bool m_CommunicationEventPending;
     /** mutex used to make sure that the send thread is just started once */
     std::mutex m_SendingFinishedMutex;
     /** mutex used to make sure that the receive thread is just started once */
@@ -11,7 +11,11 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkIGTLMeasurements.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
 
 //Microservices
 #include "usServiceReference.h"
@@ -23,6 +27,7 @@ found in the LICENSE file.
 #include <fstream>
 
 mitk::IGTLMeasurements::IGTLMeasurements()
+  : m_IsStarted(false)
 {
 }
 
@@ -61,12 +66,15 @@ void mitk::IGTLMeasurements::AddMeasurement(unsigned int measurementPoint, unsig
   if (timestamp == 0) { timestamp = std::chrono::high_resolution_clock::now().time_since_epoch().count(); }
   if (m_IsStarted)
   {
+    std::lock_guard<std::mutex> lock(m_MeasurementPointsMutex);
     m_MeasurementPoints[measurementPoint].push_back(TimeStampIndexPair(timestamp, index));
   }
 }
 
 bool mitk::IGTLMeasurements::ExportData(std::string filename)
 {
+  std::lock_guard<std::mutex> lock(m_MeasurementPointsMutex);
+
   //open file
   std::ostream* out = new std::ofstream(filename.c_str());
 
@@ -113,6 +121,7 @@ bool mitk::IGTLMeasurements::ExportData(std::string filename)
 
 void mitk::IGTLMeasurements::Reset()
 {
+  std::lock_guard<std::mutex> lock(m_MeasurementPointsMutex);
   m_MeasurementPoints.clear();
 }
 
@@ -120,3 +129,52 @@ void mitk::IGTLMeasurements::SetStarted(bool started)
 {
   m_IsStarted = started;
 }
+
+std::vector<long long> mitk::IGTLMeasurements::GetLatencies(unsigned int fromMeasurementPoint, unsigned int toMeasurementPoint)
+{
+  std::vector<long long> latencies;
+
+  std::lock_guard<std::mutex> lock(m_MeasurementPointsMutex);
+  auto fromPoint = m_MeasurementPoints.find(fromMeasurementPoint);
+  auto toPoint = m_MeasurementPoints.find(toMeasurementPoint);
+  if (fromPoint == m_MeasurementPoints.end() || toPoint == m_MeasurementPoints.end())
+    return latencies;
+
+  std::unordered_map<unsigned int, long long> toTimeStamps;
+  for (const auto& timestampIndexPair : toPoint->second)
+    toTimeStamps.emplace(timestampIndexPair.second, timestampIndexPair.first);
+
+  std::vector<TimeStampIndexPair> fromTimeStamps;
+  fromTimeStamps.reserve(fromPoint->second.size());
+  std::unordered_set<unsigned int> visitedIndices;
+  for (const auto& timestampIndexPair : fromPoint->second)
+  {
+    if (visitedIndices.insert(timestampIndexPair.second).second)
+      fromTimeStamps.push_back(timestampIndexPair);
+  }
+  std::stable_sort(fromTimeStamps.begin(), fromTimeStamps.end(),
+    [](const TimeStampIndexPair& a, const TimeStampIndexPair& b) { return a.first < b.first; });
+
+  latencies.reserve(fromTimeStamps.size());
+  for (const auto& timestampIndexPair : fromTimeStamps)
+  {
+    auto toTimeStamp = toTimeStamps.find(timestampIndexPair.second);
+    if (toTimeStamp != toTimeStamps.end())
+      latencies.push_back(toTimeStamp->second - timestampIndexPair.first);
+  }
+
+  return latencies;
+}
+
+long long mitk::IGTLMeasurements::GetLatencyPercentile(unsigned int fromMeasurementPoint, unsigned int toMeasurementPoint, double percentile)
+{
+  std::vector<long long> latencies = this->GetLatencies(fromMeasurementPoint, toMeasurementPoint);
+  if (latencies.empty())
+    return -1;
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  auto rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * latencies.size()));
+  auto nth = latencies.begin() + (rank > 0 ? rank - 1 : 0);
+  std::nth_element(latencies.begin(), nth, latencies.end());
+  return *nth;
+}
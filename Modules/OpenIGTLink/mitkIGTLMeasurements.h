@@ -21,11 +21,23 @@ found in the LICENSE file.
 #include "itkObject.h"
 #include "mitkCommon.h"
 
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace mitk {
 
   /**
   * \brief Is a helper class to make measurments for latency and fps
   *
+  * A measurement point is a place in the processing pipeline, e.g. the
+  * reception of a message in the receive thread. Every measurement stores the
+  * time stamp at which the message with the given index passed the point.
+  * The latency between two points is measured for all indices that passed
+  * both of them. Measurements may be added from several threads.
+  *
   * \ingroup OpenIGTLink
   */
   class MITKOPENIGTLINK_EXPORT IGTLMeasurements : public itk::Object
@@ -55,6 +67,28 @@ namespace mitk {
 
     void SetStarted(bool started);
 
+    /**
+    * \brief Returns the latencies between two measurement points
+    *
+    * For every index that was measured at both points the difference of the
+    * time stamps (to minus from) is returned, ordered by the time stamps of
+    * the from point. The unit is the unit of the time stamps, which is the
+    * tick of std::chrono::high_resolution_clock if they were generated by
+    * AddMeasurement(). If an index was measured several times at a point, the
+    * first measurement is used.
+    */
+    std::vector<long long> GetLatencies(unsigned int fromMeasurementPoint, unsigned int toMeasurementPoint);
+
+    /**
+    * \brief Returns the given percentile (0 to 100) of the latencies between
+    * two measurement points, e.g. 50 for the median or 99 for the latency
+    * that 99 percent of the messages do not exceed
+    *
+    * The nearest-rank method is used, so the result is always one of the
+    * measured latencies. Returns -1 if there are no latencies.
+    */
+    long long GetLatencyPercentile(unsigned int fromMeasurementPoint, unsigned int toMeasurementPoint, double percentile);
+
   private:
     // Only our module activator class should be able to instantiate
     // a SingletonOneService object.
@@ -79,7 +113,11 @@ namespace mitk {
 
     MeasurementPoints                               m_MeasurementPoints;
 
-    bool m_IsStarted;
+    /** mutex to control access to m_MeasurementPoints */
+    std::mutex m_MeasurementPointsMutex;
+
+    /** read by every AddMeasurement() call, possibly from several threads */
+    std::atomic<bool> m_IsStarted;
   };
 } // namespace mitk
 #endif /* MITKIGTLMeasurements_H_HEADER_INCLUDED_ */
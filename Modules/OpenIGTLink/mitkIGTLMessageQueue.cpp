@@ -11,103 +11,173 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkIGTLMessageQueue.h"
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include "igtlMessageBase.h"
 
-void mitk::IGTLMessageQueue::PushSendMessage(mitk::IGTLMessage::Pointer message)
+namespace
 {
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_SendQueue.clear();
+  // number of image messages kept for reuse in addition to the capacity of the
+  // image queue: the message that is being received and the one a consumer
+  // currently processes
+  const std::size_t REUSABLE_IMAGE_MESSAGES_SLACK = 2;
 
-  m_SendQueue.push_back(message);
-  this->m_Mutex.unlock();
-}
+  bool IsCommandDeviceType(const char* deviceType)
+  {
+    return std::strncmp(deviceType, "GET_", 4) == 0 ||
+      std::strncmp(deviceType, "STP_", 4) == 0 ||
+      std::strncmp(deviceType, "RTS_", 4) == 0 ||
+      std::strncmp(deviceType, "STT_", 4) == 0;
+  }
 
-void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer message)
-{
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_CommandQueue.clear();
+  enum MessageKind
+  {
+    TrackingDataMessageKind,
+    TransformMessageKind,
+    StringMessageKind,
+    Image2dMessageKind,
+    Image3dMessageKind,
+    MiscMessageKind
+  };
+
+  MessageKind GetImageMessageKind(igtl::ImageMessage* imageMessage)
+  {
+    int dim[3];
+    imageMessage->GetDimensions(dim);
+    return dim[2] > 1 ? Image3dMessageKind : Image2dMessageKind;
+  }
 
-  m_CommandQueue.push_back(message);
-  this->m_Mutex.unlock();
+  MessageKind GetMessageKind(igtl::MessageBase* message)
+  {
+    // the standard device types tell which class to check, this saves the
+    // dynamic_casts to all the other classes for the frequent messages
+    const char* deviceType = message->GetDeviceType();
+    if (std::strcmp(deviceType, "TDATA") == 0 && dynamic_cast<igtl::TrackingDataMessage*>(message) != nullptr)
+      return TrackingDataMessageKind;
+    if (std::strcmp(deviceType, "TRANSFORM") == 0 && dynamic_cast<igtl::TransformMessage*>(message) != nullptr)
+      return TransformMessageKind;
+    if (std::strcmp(deviceType, "STRING") == 0 && dynamic_cast<igtl::StringMessage*>(message) != nullptr)
+      return StringMessageKind;
+    if (std::strcmp(deviceType, "IMAGE") == 0 && dynamic_cast<igtl::ImageMessage*>(message) != nullptr)
+      return GetImageMessageKind(static_cast<igtl::ImageMessage*>(message));
+
+    // message classes that were registered for other device types
+    if (dynamic_cast<igtl::TrackingDataMessage*>(message) != nullptr)
+      return TrackingDataMessageKind;
+    if (dynamic_cast<igtl::TransformMessage*>(message) != nullptr)
+      return TransformMessageKind;
+    if (dynamic_cast<igtl::StringMessage*>(message) != nullptr)
+      return StringMessageKind;
+    if (dynamic_cast<igtl::ImageMessage*>(message) != nullptr)
+      return GetImageMessageKind(static_cast<igtl::ImageMessage*>(message));
+
+    return MiscMessageKind;
+  }
 }
 
-void mitk::IGTLMessageQueue::PushMessage(igtl::MessageBase::Pointer msg)
+template <typename TRingBuffer, typename TMessagePointer>
+void mitk::IGTLMessageQueue::PushToRingBuffer(TRingBuffer& ringBuffer, QueueType queueType, const TMessagePointer& message)
 {
-  this->m_Mutex.lock();
+  QueueSettings& settings = m_QueueSettings[queueType];
 
-  std::stringstream infolog;
+  DropPolicy dropPolicy = settings.dropPolicy;
+  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering && queueType != CommandQueue)
+    dropPolicy = KeepLatest;
 
-  infolog << "Received message of type ";
+  const std::size_t capacity = settings.capacity;
+  unsigned long long numberOfDroppedMessages = 0;
 
-  if (dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()) != nullptr)
+  // the pulling threads only make room, so the size cannot grow while
+  // messages are dropped here
+  switch (dropPolicy)
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TrackingDataQueue.clear();
-
-    this->m_TrackingDataQueue.push_back(dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()));
-
-    infolog << "TDATA";
+    case KeepLatest:
+      while (ringBuffer.Pull())
+        ++numberOfDroppedMessages;
+      break;
+    case DropNewest:
+      if (ringBuffer.GetSize() >= capacity)
+      {
+        ++settings.numberOfDroppedMessages;
+        return;
+      }
+      break;
+    default:
+      while (ringBuffer.GetSize() >= capacity && ringBuffer.Pull())
+        ++numberOfDroppedMessages;
+      break;
   }
-  else if (dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()) != nullptr)
-  {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TransformQueue.clear();
 
-    this->m_TransformQueue.push_back(dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()));
-
-    infolog << "TRANSFORM";
-  }
-  else if (dynamic_cast<igtl::StringMessage*>(msg.GetPointer()) != nullptr)
+  // only fails if another thread pushed to the same queue in the meantime
+  while (!ringBuffer.Push(message))
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_StringQueue.clear();
+    if (ringBuffer.Pull())
+      ++numberOfDroppedMessages;
+  }
 
-    this->m_StringQueue.push_back(dynamic_cast<igtl::StringMessage*>(msg.GetPointer()));
+  if (numberOfDroppedMessages > 0)
+    settings.numberOfDroppedMessages += numberOfDroppedMessages;
+}
 
-    infolog << "STRING";
-  }
-  else if (dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()) != nullptr)
+void mitk::IGTLMessageQueue::PushSendMessage(mitk::IGTLMessage::Pointer message)
+{
   {
-    igtl::ImageMessage::Pointer imageMsg = dynamic_cast<igtl::ImageMessage*>(msg.GetPointer());
-    int* dim = new int[3];
-    imageMsg->GetDimensions(dim);
-    if (dim[2] > 1)
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
     {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image3dQueue.clear();
-
-      this->m_Image3dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
-
-      infolog << "IMAGE3D";
+      // commands are kept, every one of them has to reach the other side
+      m_SendQueue.erase(std::remove_if(m_SendQueue.begin(), m_SendQueue.end(),
+        [](const mitk::IGTLMessage::Pointer& queuedMessage)
+        {
+          igtl::MessageBase* igtlMessage = queuedMessage.IsNotNull() ? queuedMessage->GetMessage() : nullptr;
+          return igtlMessage == nullptr || !IsCommandDeviceType(igtlMessage->GetDeviceType());
+        }),
+        m_SendQueue.end());
     }
-    else
-    {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image2dQueue.clear();
-
-      this->m_Image2dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
 
-      infolog << "IMAGE2D";
-    }
+    m_SendQueue.push_back(message);
   }
-  else
-  {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_MiscQueue.clear();
+  m_SendQueueCondition.notify_one();
+}
+
+void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer message)
+{
+  this->PushToRingBuffer(m_CommandQueue, CommandQueue, message);
+}
 
-    this->m_MiscQueue.push_back(msg);
+void mitk::IGTLMessageQueue::PushMessage(igtl::MessageBase::Pointer msg)
+{
+  if (msg.IsNull())
+    return;
 
-    infolog << "OTHER";
+  igtl::MessageBase* message = msg.GetPointer();
+  switch (GetMessageKind(message))
+  {
+    case TrackingDataMessageKind:
+      this->PushToRingBuffer(m_TrackingDataQueue, TrackingDataQueue, igtl::TrackingDataMessage::Pointer(static_cast<igtl::TrackingDataMessage*>(message)));
+      break;
+    case TransformMessageKind:
+      this->PushToRingBuffer(m_TransformQueue, TransformQueue, igtl::TransformMessage::Pointer(static_cast<igtl::TransformMessage*>(message)));
+      break;
+    case StringMessageKind:
+      this->PushToRingBuffer(m_StringQueue, StringQueue, igtl::StringMessage::Pointer(static_cast<igtl::StringMessage*>(message)));
+      break;
+    case Image2dMessageKind:
+      this->AddReusableImageMessage(static_cast<igtl::ImageMessage*>(message), Image2dQueue);
+      this->PushToRingBuffer(m_Image2dQueue, Image2dQueue, igtl::ImageMessage::Pointer(static_cast<igtl::ImageMessage*>(message)));
+      break;
+    case Image3dMessageKind:
+      this->AddReusableImageMessage(static_cast<igtl::ImageMessage*>(message), Image3dQueue);
+      this->PushToRingBuffer(m_Image3dQueue, Image3dQueue, igtl::ImageMessage::Pointer(static_cast<igtl::ImageMessage*>(message)));
+      break;
+    default:
+      this->PushToRingBuffer(m_MiscQueue, MiscQueue, msg);
+      break;
   }
 
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   m_Latest_Message = msg;
-
-  //MITK_INFO << infolog.str();
-
-  this->m_Mutex.unlock();
 }
 
 mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage()
@@ -123,100 +193,56 @@ mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage()
   return ret;
 }
 
-igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
+mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage(std::chrono::milliseconds maxWaitingTime)
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_MiscQueue.size() > 0)
+  mitk::IGTLMessage::Pointer ret = nullptr;
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  if (m_SendQueueCondition.wait_for(lock, maxWaitingTime, [this] { return !m_SendQueue.empty(); }))
   {
-    ret = this->m_MiscQueue.front();
-    this->m_MiscQueue.pop_front();
+    ret = this->m_SendQueue.front();
+    this->m_SendQueue.pop_front();
   }
-  this->m_Mutex.unlock();
   return ret;
 }
 
+igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
+{
+  return this->m_MiscQueue.Pull();
+}
+
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage2dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image2dQueue.size() > 0)
-  {
-    ret = this->m_Image2dQueue.front();
-    this->m_Image2dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image2dQueue.Pull();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage3dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image3dQueue.size() > 0)
-  {
-    ret = this->m_Image3dQueue.front();
-    this->m_Image3dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image3dQueue.Pull();
 }
 
 igtl::TrackingDataMessage::Pointer mitk::IGTLMessageQueue::PullTrackingMessage()
 {
-  igtl::TrackingDataMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TrackingDataQueue.size() > 0)
-  {
-    ret = this->m_TrackingDataQueue.front();
-    this->m_TrackingDataQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TrackingDataQueue.Pull();
 }
 
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullCommandMessage()
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_CommandQueue.size() > 0)
-  {
-    ret = this->m_CommandQueue.front();
-    this->m_CommandQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_CommandQueue.Pull();
 }
 
 igtl::StringMessage::Pointer mitk::IGTLMessageQueue::PullStringMessage()
 {
-  igtl::StringMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_StringQueue.size() > 0)
-  {
-    ret = this->m_StringQueue.front();
-    this->m_StringQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_StringQueue.Pull();
 }
 
 igtl::TransformMessage::Pointer mitk::IGTLMessageQueue::PullTransformMessage()
 {
-  igtl::TransformMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TransformQueue.size() > 0)
-  {
-    ret = this->m_TransformQueue.front();
-    this->m_TransformQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TransformQueue.Pull();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgInformationString()
 {
-  this->m_Mutex.lock();
+  this->m_LatestMessageMutex.lock();
   std::stringstream s;
   if (this->m_Latest_Message != nullptr)
   {
@@ -227,13 +253,13 @@ std::string mitk::IGTLMessageQueue::GetNextMsgInformationString()
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
+  this->m_LatestMessageMutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  this->m_LatestMessageMutex.lock();
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -243,13 +269,13 @@ std::string mitk::IGTLMessageQueue::GetNextMsgDeviceType()
   {
     s << "";
   }
-  this->m_Mutex.unlock();
+  this->m_LatestMessageMutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgInformationString()
 {
-  this->m_Mutex.lock();
+  this->m_LatestMessageMutex.lock();
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -260,13 +286,13 @@ std::string mitk::IGTLMessageQueue::GetLatestMsgInformationString()
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
+  this->m_LatestMessageMutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  this->m_LatestMessageMutex.lock();
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -276,32 +302,138 @@ std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
   {
     s << "";
   }
-  this->m_Mutex.unlock();
+  this->m_LatestMessageMutex.unlock();
   return s.str();
 }
 
 int mitk::IGTLMessageQueue::GetSize()
 {
-  return (this->m_CommandQueue.size() + this->m_Image2dQueue.size() + this->m_Image3dQueue.size() + this->m_MiscQueue.size()
-    + this->m_StringQueue.size() + this->m_TrackingDataQueue.size() + this->m_TransformQueue.size());
+  return static_cast<int>(this->m_CommandQueue.GetSize() + this->m_Image2dQueue.GetSize() + this->m_Image3dQueue.GetSize() + this->m_MiscQueue.GetSize()
+    + this->m_StringQueue.GetSize() + this->m_TrackingDataQueue.GetSize() + this->m_TransformQueue.GetSize());
+}
+
+void mitk::IGTLMessageQueue::SetCapacity(QueueType queueType, std::size_t capacity)
+{
+  m_QueueSettings[queueType].capacity = std::min(std::max(capacity, std::size_t(1)), MaximumCapacity);
+}
+
+std::size_t mitk::IGTLMessageQueue::GetCapacity(QueueType queueType) const
+{
+  return m_QueueSettings[queueType].capacity;
+}
+
+void mitk::IGTLMessageQueue::SetDropPolicy(QueueType queueType, DropPolicy dropPolicy)
+{
+  m_QueueSettings[queueType].dropPolicy = dropPolicy;
+}
+
+mitk::IGTLMessageQueue::DropPolicy mitk::IGTLMessageQueue::GetDropPolicy(QueueType queueType) const
+{
+  return m_QueueSettings[queueType].dropPolicy;
+}
+
+unsigned long long mitk::IGTLMessageQueue::GetNumberOfDroppedMessages(QueueType queueType) const
+{
+  return m_QueueSettings[queueType].numberOfDroppedMessages;
+}
+
+void mitk::IGTLMessageQueue::ResetNumberOfDroppedMessages()
+{
+  for (auto& settings : m_QueueSettings)
+    settings.numberOfDroppedMessages = 0;
+}
+
+void mitk::IGTLMessageQueue::AddReusableImageMessage(igtl::ImageMessage* message, QueueType queueType)
+{
+  const std::size_t capacity = this->m_BufferingType == IGTLMessageQueue::NoBuffering
+    ? 1
+    : m_QueueSettings[queueType].capacity.load();
+
+  std::lock_guard<std::mutex> lock(m_ReusableImageMessagesMutex);
+  if (std::find(m_ReusableImageMessages.begin(), m_ReusableImageMessages.end(), message) != m_ReusableImageMessages.end())
+    return;
+
+  if (m_ReusableImageMessages.size() >= capacity + REUSABLE_IMAGE_MESSAGES_SLACK)
+  {
+    // make room by releasing a message that is not used anymore, otherwise
+    // all kept messages are still buffered or used and this one is not kept
+    auto unused = std::find_if(m_ReusableImageMessages.begin(), m_ReusableImageMessages.end(),
+      [](const igtl::ImageMessage::Pointer& reusableMessage) { return reusableMessage->GetReferenceCount() == 1; });
+
+    if (unused == m_ReusableImageMessages.end())
+      return;
+
+    m_ReusableImageMessages.erase(unused);
+  }
+
+  m_ReusableImageMessages.push_back(message);
+}
+
+igtl::MessageBase::Pointer mitk::IGTLMessageQueue::GetReusableMessage(const char* deviceType, igtlUint64 bodySize)
+{
+  std::lock_guard<std::mutex> lock(m_ReusableImageMessagesMutex);
+  igtl::MessageBase::Pointer reusableMessage;
+
+  auto it = m_ReusableImageMessages.begin();
+  while (it != m_ReusableImageMessages.end())
+  {
+    // a message that is only referenced by this list is neither buffered nor
+    // used by a consumer, and nobody can obtain a new reference to it
+    if ((*it)->GetReferenceCount() != 1 || std::strcmp((*it)->GetDeviceType(), deviceType) != 0)
+    {
+      ++it;
+    }
+    else if (static_cast<igtlUint64>((*it)->GetPackBodySize()) != bodySize)
+    {
+      // the frame size changed, the pack of this message would be reallocated
+      it = m_ReusableImageMessages.erase(it);
+    }
+    else
+    {
+      if (reusableMessage.IsNull())
+        reusableMessage = it->GetPointer();
+      ++it;
+    }
+  }
+
+  return reusableMessage;
+}
+
+void mitk::IGTLMessageQueue::ClearReusableMessages()
+{
+  std::lock_guard<std::mutex> lock(m_ReusableImageMessagesMutex);
+  m_ReusableImageMessages.clear();
 }
 
 void mitk::IGTLMessageQueue::EnableNoBufferingMode(bool enable)
 {
-  this->m_Mutex.lock();
   if (enable)
     this->m_BufferingType = IGTLMessageQueue::BufferingType::NoBuffering;
   else
     this->m_BufferingType = IGTLMessageQueue::BufferingType::Infinit;
-  this->m_Mutex.unlock();
+
+  this->ClearReusableMessages();
 }
 
 mitk::IGTLMessageQueue::IGTLMessageQueue()
+  : m_CommandQueue(MaximumCapacity),
+    m_Image2dQueue(MaximumCapacity),
+    m_Image3dQueue(MaximumCapacity),
+    m_TransformQueue(MaximumCapacity),
+    m_TrackingDataQueue(MaximumCapacity),
+    m_StringQueue(MaximumCapacity),
+    m_MiscQueue(MaximumCapacity),
+    m_BufferingType(IGTLMessageQueue::NoBuffering)
 {
-  this->m_BufferingType = IGTLMessageQueue::NoBuffering;
+  for (int queueType = 0; queueType < NumberOfQueueTypes; ++queueType)
+  {
+    const bool isImageQueue = queueType == Image2dQueue || queueType == Image3dQueue;
+    m_QueueSettings[queueType].capacity = isImageQueue ? DefaultImageCapacity : MaximumCapacity;
+    m_QueueSettings[queueType].dropPolicy = DropOldest;
+    m_QueueSettings[queueType].numberOfDroppedMessages = 0;
+  }
 }
 
 mitk::IGTLMessageQueue::~IGTLMessageQueue()
 {
-  this->m_Mutex.unlock();
 }
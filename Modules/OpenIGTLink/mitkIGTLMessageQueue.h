@@ -18,9 +18,14 @@ found in the LICENSE file.
 #include "itkObject.h"
 #include "mitkCommon.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <vector>
 #include <mitkIGTLMessage.h>
+#include <mitkIGTLMessageRingBuffer.h>
 
 //OpenIGTLink
 #include "igtlMessageBase.h"
@@ -34,6 +39,13 @@ namespace mitk {
   * \class IGTLMessageQueue
   * \brief Thread safe message queue to store OpenIGTLink messages.
   *
+  * Received messages are sorted by kind into lock-free ring buffers, so the
+  * receive thread never waits for a thread that pulls messages and vice
+  * versa. The capacity of each ring buffer and what happens to a message that
+  * does not fit (DropPolicy) can be configured per QueueType, dropped messages
+  * are counted. The send queue is a mutex guarded deque instead, because the
+  * sending thread waits on it for new messages.
+  *
   * \ingroup OpenIGTLink
   */
   class MITKOPENIGTLINK_EXPORT IGTLMessageQueue : public itk::Object
@@ -45,11 +57,88 @@ namespace mitk {
 
       /**
        * \brief Different buffering types
-       * Infinit buffering means that you can push as many messages as you want
-       * NoBuffering means that the queue just stores a single message
+       * Infinit buffering means that each queue stores messages up to its
+       * capacity according to its drop policy
+       * NoBuffering means that each queue just stores the latest message, except
+       * for the command queue, which keeps its drop policy because every
+       * command has to be answered
        */
     enum BufferingType { Infinit, NoBuffering };
 
+    /**
+    * \brief The receive queues, one per kind of message
+    */
+    enum QueueType { CommandQueue, Image2dQueue, Image3dQueue, TransformQueue,
+      TrackingDataQueue, StringQueue, MiscQueue, NumberOfQueueTypes };
+
+    /**
+    * \brief What to do with a message that is pushed to a full queue
+    * DropOldest removes the oldest message of the queue to make room
+    * DropNewest discards the pushed message
+    * KeepLatest replaces all messages of the queue by the pushed one, even if
+    * the queue is not full
+    */
+    enum DropPolicy { DropOldest, DropNewest, KeepLatest };
+
+    /**
+    * \brief Largest capacity of a receive queue
+    */
+    static constexpr std::size_t MaximumCapacity = 1024;
+
+    /**
+    * \brief Initial capacity of the image queues, which is smaller than the
+    * capacity of the other queues because of the size of image messages
+    */
+    static constexpr std::size_t DefaultImageCapacity = 16;
+
+    /**
+    * \brief Sets the number of messages the given queue can hold, the value
+    * is clamped to [1, MaximumCapacity]
+    *
+    * Messages that are already buffered are only dropped by the next push.
+    */
+    void SetCapacity(QueueType queueType, std::size_t capacity);
+    std::size_t GetCapacity(QueueType queueType) const;
+
+    /**
+    * \brief Sets what happens to a message pushed to the given queue if it is
+    * full, the default is DropOldest
+    */
+    void SetDropPolicy(QueueType queueType, DropPolicy dropPolicy);
+    DropPolicy GetDropPolicy(QueueType queueType) const;
+
+    /**
+    * \brief Returns the number of messages that were dropped by the given
+    * queue because of its capacity, its drop policy or NoBuffering mode
+    */
+    unsigned long long GetNumberOfDroppedMessages(QueueType queueType) const;
+
+    /**
+    * \brief Resets the counters of dropped messages of all queues to zero
+    */
+    void ResetNumberOfDroppedMessages();
+
+    /**
+    * \brief Returns a received image message of the given device type and
+    * body size that is neither buffered nor referenced by anybody else, or
+    * nullptr
+    *
+    * The receiving device reads the next message into it instead of
+    * creating a new one, so the pack buffer of an image stream is only
+    * allocated again if the image size changes. Unused messages of another
+    * body size are evicted, they would have to be reallocated anyway.
+    *
+    * Only the thread that receives messages may call this method, because a
+    * returned message is not marked as taken before the caller references it.
+    */
+    igtl::MessageBase::Pointer GetReusableMessage(const char* deviceType, igtlUint64 bodySize);
+
+    /**
+    * \brief Releases all received image messages that are kept for reuse,
+    * e.g. when the connection is closed
+    */
+    void ClearReusableMessages();
+
     void PushSendMessage(mitk::IGTLMessage::Pointer message);
 
     /**
@@ -73,6 +162,13 @@ namespace mitk {
     igtl::TransformMessage::Pointer PullTransformMessage();
     mitk::IGTLMessage::Pointer PullSendMessage();
 
+    /**
+    * \brief Returns and removes the oldest message from the send queue, waits
+    * up to the given time for a message if the queue is empty
+    * \return The message or nullptr if no message arrived in time
+    */
+    mitk::IGTLMessage::Pointer PullSendMessage(std::chrono::milliseconds maxWaitingTime);
+
     /**
     * \brief Get the number of messages in the queue
     */
@@ -101,7 +197,9 @@ namespace mitk {
     std::string GetLatestMsgDeviceType();
 
     /**
-     */
+    * \brief Switches between NoBuffering and Infinit buffering, releases the
+    * image messages kept for reuse because their number depends on the mode
+    */
     void EnableNoBufferingMode(bool enable);
 
   protected:
@@ -109,30 +207,74 @@ namespace mitk {
     ~IGTLMessageQueue() override;
 
   protected:
+    typedef IGTLMessageRingBuffer<igtl::MessageBase::Pointer> MessageRingBuffer;
+    typedef IGTLMessageRingBuffer<igtl::ImageMessage::Pointer> ImageRingBuffer;
+    typedef IGTLMessageRingBuffer<igtl::TransformMessage::Pointer> TransformRingBuffer;
+    typedef IGTLMessageRingBuffer<igtl::TrackingDataMessage::Pointer> TrackingDataRingBuffer;
+    typedef IGTLMessageRingBuffer<igtl::StringMessage::Pointer> StringRingBuffer;
+
+    struct QueueSettings
+    {
+      std::atomic<std::size_t> capacity;
+      std::atomic<DropPolicy> dropPolicy;
+      std::atomic<unsigned long long> numberOfDroppedMessages;
+    };
+
+    /**
+    * \brief Appends the message to the given ring buffer, drops messages
+    * according to the capacity and drop policy of the queue
+    */
+    template <typename TRingBuffer, typename TMessagePointer>
+    void PushToRingBuffer(TRingBuffer &ringBuffer, QueueType queueType, const TMessagePointer &message);
+
     /**
-    * \brief Mutex to take car of the queue
+    * \brief Remembers the image message for GetReusableMessage(), at most
+    * the capacity of the given queue plus a small slack are kept
+    */
+    void AddReusableImageMessage(igtl::ImageMessage* message, QueueType queueType);
+
+    /**
+    * \brief Mutex to take care of the send queue
     */
     std::mutex m_Mutex;
 
     /**
-    * \brief the queue that stores pointer to the inserted messages
+    * \brief Signals a new message in the send queue
     */
-    std::deque< igtl::MessageBase::Pointer > m_CommandQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image2dQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image3dQueue;
-    std::deque< igtl::TransformMessage::Pointer > m_TransformQueue;
-    std::deque< igtl::TrackingDataMessage::Pointer > m_TrackingDataQueue;
-    std::deque< igtl::StringMessage::Pointer > m_StringQueue;
-    std::deque< igtl::MessageBase::Pointer > m_MiscQueue;
+    std::condition_variable m_SendQueueCondition;
+
+    /**
+    * \brief the ring buffers that store pointers to the received messages
+    */
+    MessageRingBuffer m_CommandQueue;
+    ImageRingBuffer m_Image2dQueue;
+    ImageRingBuffer m_Image3dQueue;
+    TransformRingBuffer m_TransformQueue;
+    TrackingDataRingBuffer m_TrackingDataQueue;
+    StringRingBuffer m_StringQueue;
+    MessageRingBuffer m_MiscQueue;
+
+    QueueSettings m_QueueSettings[NumberOfQueueTypes];
+
+    /**
+    * \brief Received image messages that may be reused, see GetReusableMessage()
+    */
+    std::vector< igtl::ImageMessage::Pointer > m_ReusableImageMessages;
+    std::mutex m_ReusableImageMessagesMutex;
 
     std::deque< mitk::IGTLMessage::Pointer > m_SendQueue;
 
+    /**
+    * \brief Mutex to take care of m_Latest_Message
+    */
+    std::mutex m_LatestMessageMutex;
+
     igtl::MessageBase::Pointer m_Latest_Message;
 
     /**
     * \brief defines the kind of buffering
     */
-    BufferingType m_BufferingType;
+    std::atomic<BufferingType> m_BufferingType;
   };
 }
 
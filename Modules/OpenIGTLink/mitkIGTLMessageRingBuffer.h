@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIGTLMESSAGERINGBUFFER_H
+#define MITKIGTLMESSAGERINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mitk
+{
+  /**
+  * \brief Bounded lock-free FIFO for smart pointers to messages of one kind.
+  *
+  * Push() and Pull() never block and never allocate, all slots are created by
+  * the constructor. Every slot carries a sequence number that tells whether
+  * it is ready to be written or to be read (bounded queue of D. Vyukov), so
+  * the producer and the consumers only compete for their own position
+  * counter. The IGTLMessageQueue uses it with the receive thread as single
+  * producer and arbitrary threads as consumers, but any number of producers
+  * is safe as well.
+  *
+  * The capacity is rounded up to the next power of two.
+  *
+  * \ingroup OpenIGTLink
+  */
+  template <typename TMessagePointer>
+  class IGTLMessageRingBuffer
+  {
+  public:
+    explicit IGTLMessageRingBuffer(std::size_t capacity)
+      : m_PushPosition(0),
+        m_PullPosition(0)
+    {
+      std::size_t size = 2;
+      while (size < capacity)
+        size <<= 1;
+
+      m_Mask = size - 1;
+      m_Slots.reset(new Slot[size]);
+      for (std::size_t i = 0; i < size; ++i)
+        m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    IGTLMessageRingBuffer(const IGTLMessageRingBuffer &) = delete;
+    IGTLMessageRingBuffer &operator=(const IGTLMessageRingBuffer &) = delete;
+
+    /**
+    * \brief Appends the message, returns false if the buffer is full
+    */
+    bool Push(const TMessagePointer &message)
+    {
+      std::size_t position = m_PushPosition.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        Slot &slot = m_Slots[position & m_Mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+          if (m_PushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            slot.message = message;
+            slot.sequence.store(position + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (difference < 0)
+        {
+          return false;
+        }
+        else
+        {
+          position = m_PushPosition.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    /**
+    * \brief Removes and returns the oldest message, returns a null pointer if
+    * the buffer is empty
+    */
+    TMessagePointer Pull()
+    {
+      std::size_t position = m_PullPosition.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        Slot &slot = m_Slots[position & m_Mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+          if (m_PullPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            TMessagePointer message = slot.message;
+            slot.message = nullptr;
+            slot.sequence.store(position + m_Mask + 1, std::memory_order_release);
+            return message;
+          }
+        }
+        else if (difference < 0)
+        {
+          return nullptr;
+        }
+        else
+        {
+          position = m_PullPosition.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    /**
+    * \brief Removes all messages
+    */
+    void Clear()
+    {
+      while (this->Pull())
+      {
+      }
+    }
+
+    /**
+    * \brief Returns the number of stored messages
+    *
+    * The value is only a snapshot if other threads access the buffer.
+    */
+    std::size_t GetSize() const
+    {
+      const std::size_t pullPosition = m_PullPosition.load(std::memory_order_acquire);
+      const std::size_t pushPosition = m_PushPosition.load(std::memory_order_acquire);
+      return pushPosition > pullPosition ? pushPosition - pullPosition : 0;
+    }
+
+    std::size_t GetCapacity() const
+    {
+      return m_Mask + 1;
+    }
+
+  private:
+    struct Slot
+    {
+      std::atomic<std::size_t> sequence;
+      TMessagePointer message;
+    };
+
+    std::unique_ptr<Slot[]> m_Slots;
+    std::size_t m_Mask;
+
+    /** The positions are kept on separate cache lines, so that producer and
+    consumers do not invalidate each other's cache line on every access. */
+    alignas(64) std::atomic<std::size_t> m_PushPosition;
+    alignas(64) std::atomic<std::size_t> m_PullPosition;
+  };
+}
+
+#endif
@@ -20,6 +20,42 @@ found in the LICENSE file.
 #include <igtlImageMessage.h>
 #include <mitkIGTLStatus.h>
 
+#include <algorithm>
+#include <vector>
+
+// time the connecting thread waits for a new client and the receiving thread
+// waits for data of a client before they check whether to stop
+static const int WAIT_TIMEOUT_MSEC = 100;
+
+namespace
+{
+  /**
+  * igtl::Socket keeps the descriptor of a socket and select() protected. A
+  * class derived from it may access both, this one is never instantiated.
+  */
+  class ClientSocketSelector : public igtl::Socket
+  {
+  public:
+    static int GetDescriptor(igtl::Socket* socket)
+    {
+      return socket->*(&ClientSocketSelector::m_SocketDescriptor);
+    }
+
+    /**
+    * Waits until one of the sockets has data (or was closed by the peer) with
+    * a single select() over all of them.
+    * \return the index of the first socket that is ready, -1 on timeout
+    */
+    static int SelectReadySocket(const std::vector<int>& descriptors, unsigned long msec)
+    {
+      int selectedIndex = -1;
+      if (igtl::Socket::SelectSockets(descriptors.data(), static_cast<int>(descriptors.size()), msec, &selectedIndex) <= 0)
+        return -1;
+      return selectedIndex;
+    }
+  };
+}
+
 mitk::IGTLServer::IGTLServer(bool ReadFully) :
 IGTLDevice(ReadFully)
 {
@@ -85,7 +121,7 @@ void mitk::IGTLServer::Connect()
   igtl::Socket::Pointer socket;
   //check if another igtl device wants to connect to this socket
   socket =
-    ((igtl::ServerSocket*)(this->m_Socket.GetPointer()))->WaitForConnection(1);
+    ((igtl::ServerSocket*)(this->m_Socket.GetPointer()))->WaitForConnection(WAIT_TIMEOUT_MSEC);
   //if there is a new connection the socket is not null
   if (socket.IsNotNull())
   {
@@ -95,6 +131,8 @@ void mitk::IGTLServer::Connect()
     this->m_RegisteredClients.push_back(socket);
     m_SentListMutex.unlock();
     m_ReceiveListMutex.unlock();
+    //wake up the receiving thread if it is waiting for a client
+    this->NotifyCommunicationEvent();
     //inform observers about this new client
     this->InvokeEvent(NewClientConnectionEvent());
     MITK_INFO("IGTLServer") << "Connected to a new client: " << socket;
@@ -104,45 +142,74 @@ void mitk::IGTLServer::Connect()
 void mitk::IGTLServer::Receive()
 {
   unsigned int status = IGTL_STATUS_OK;
-  SocketListType socketsToBeRemoved;
 
-  //the server can be connected with several clients, therefore it has to check
-  //all registered clients
-  SocketListIteratorType it;
+  std::vector<igtl::Socket::Pointer> clients;
+  std::vector<int> descriptors;
   m_ReceiveListMutex.lock();
-  auto it_end = this->m_RegisteredClients.end();
-  for (it = this->m_RegisteredClients.begin(); it != it_end; ++it)
+  for (const auto& client : this->m_RegisteredClients)
   {
-    //it is possible that ReceivePrivate detects that the current socket is
-    //already disconnected. Therefore, it is necessary to remove this socket
-    //from the registered clients list
-    status = this->ReceivePrivate(*it);
-    if (status == IGTL_STATUS_NOT_PRESENT)
-    {
-      //remember this socket for later, it is not a good idea to remove it
-      //from the list directly because we iterate over the list at this point
-      socketsToBeRemoved.push_back(*it);
-      MITK_WARN("IGTLServer") << "Lost connection to a client socket. ";
-    }
-    else if (status != 1)
+    const int descriptor = ClientSocketSelector::GetDescriptor(client);
+    if (descriptor >= 0)
     {
-      MITK_DEBUG("IGTLServer") << "IGTL Message with status: " << status;
+      clients.push_back(client);
+      descriptors.push_back(descriptor);
     }
   }
   m_ReceiveListMutex.unlock();
-  if (socketsToBeRemoved.size() > 0)
+
+  if (descriptors.empty())
+  {
+    //there is nothing to receive until a client connects
+    this->WaitForCommunicationEvent();
+    return;
+  }
+
+  //wait for data of any client without holding the list, so that clients can
+  //connect and messages can be sent meanwhile. Only this wait is limited, a
+  //message that has begun to arrive is read completely.
+  const int selectedIndex = ClientSocketSelector::SelectReadySocket(descriptors, WAIT_TIMEOUT_MSEC);
+  if (selectedIndex < 0)
+    return;
+
+  igtl::Socket::Pointer client = clients[selectedIndex];
+
+  m_ReceiveListMutex.lock();
+  auto it = std::find(this->m_RegisteredClients.begin(), this->m_RegisteredClients.end(), client);
+  if (it == this->m_RegisteredClients.end())
+  {
+    //the client was removed meanwhile
+    m_ReceiveListMutex.unlock();
+    return;
+  }
+
+  //select() reports the first ready client of the list. Moving the client
+  //that is read to the end of the list lets the other clients go first the
+  //next time, so a client that sends continuously cannot starve them.
+  this->m_RegisteredClients.splice(this->m_RegisteredClients.end(), this->m_RegisteredClients, it);
+
+  //it is possible that ReceivePrivate detects that the current socket is
+  //already disconnected
+  status = this->ReceivePrivate(client);
+  m_ReceiveListMutex.unlock();
+
+  if (status == IGTL_STATUS_NOT_PRESENT)
   {
-    //remove the sockets that are not connected anymore
-    this->StopCommunicationWithSocket(socketsToBeRemoved);
-    //inform observers about loosing the connection to these sockets
+    MITK_WARN("IGTLServer") << "Lost connection to a client socket. ";
+    //remove the socket that is not connected anymore
+    this->StopCommunicationWithSocket(client);
+    //inform observers about loosing the connection to this socket
     this->InvokeEvent(LostConnectionEvent());
   }
+  else if (status != 1)
+  {
+    MITK_DEBUG("IGTLServer") << "IGTL Message with status: " << status;
+  }
 }
 
 void mitk::IGTLServer::Send()
 {
-  //get the latest message from the queue
-  mitk::IGTLMessage::Pointer curMessage = this->m_MessageQueue->PullSendMessage();
+  //get the latest message from the queue, wait for one if there is none
+  mitk::IGTLMessage::Pointer curMessage = this->WaitForSendMessage();
 
   // there is no message => return
   if (curMessage.IsNull())
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "mitkCalculateSegmentationVolume.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace mitk
@@ -80,6 +81,47 @@ namespace mitk
     }
   }
 
+  void CalculateSegmentationVolume::CalculateFromLabelStatistics(const LabelSetImage *image)
+  {
+    itk::Index<3> minIndex;
+    itk::Index<3> maxIndex;
+    minIndex.Fill(std::numeric_limits<itk::IndexValueType>::max());
+    maxIndex.Fill(std::numeric_limits<itk::IndexValueType>::min());
+
+    m_CenterOfMass.Fill(0.0);
+    m_Volume = 0;
+
+    // like the scan of the pixel data, every label value except the exterior label 0 is counted,
+    // not only the labels of the active label set
+    for (const auto labelValue : image->GetLabelValuesInImage())
+    {
+      if (0 == labelValue)
+        continue;
+
+      const auto statistics = image->GetLabelStatistics(labelValue);
+      if (0 == statistics.voxelCount)
+        continue;
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        m_CenterOfMass[i] += statistics.centerOfMassIndex[i] * statistics.voxelCount;
+        minIndex[i] = std::min(minIndex[i], statistics.minIndex[i]);
+        maxIndex[i] = std::max(maxIndex[i], statistics.maxIndex[i]);
+      }
+
+      m_Volume += statistics.voxelCount;
+    }
+
+    if (0 != m_Volume)
+      m_CenterOfMass /= static_cast<ScalarType>(m_Volume);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      m_MinIndexOfBoundingBox[i] = minIndex[i];
+      m_MaxIndexOfBoundingBox[i] = maxIndex[i];
+    }
+  }
+
   bool CalculateSegmentationVolume::ReadyToRun()
   {
     Image::Pointer image;
@@ -94,9 +136,17 @@ namespace mitk
     Image::Pointer image;
     GetPointerParameter("Input", image);
 
-    AccessFixedDimensionByItk(image.GetPointer(),
-                              ItkImageProcessing,
-                              3); // some magic to call the correctly templated function (we only do 3D images here!)
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(image.GetPointer());
+    if (nullptr != labelSetImage)
+    {
+      this->CalculateFromLabelStatistics(labelSetImage);
+    }
+    else
+    {
+      AccessFixedDimensionByItk(image.GetPointer(),
+                                ItkImageProcessing,
+                                3); // some magic to call the correctly templated function (we only do 3D images here!)
+    }
 
     // consider single voxel volume
     Vector3D spacing = image->GetSlicedGeometry()->GetSpacing();                           // spacing in mm
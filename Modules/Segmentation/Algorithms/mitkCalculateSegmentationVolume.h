@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITK_CALCULATE_SEGMENTATION_VOLUME_H_INCLUDET_WAD
 
 #include "mitkImageCast.h"
+#include "mitkLabelSetImage.h"
 #include "mitkSegmentationSink.h"
 #include <MitkSegmentationExports.h>
 
@@ -36,6 +37,12 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ItkImageProcessing(itk::Image<TPixel, VImageDimension> *itkImage, TPixel *dummy = nullptr);
 
+    /**
+     * Combines the cached statistics (see LabelSetImage::GetLabelStatistics()) of all label values
+     * except the exterior label, so only slices written since the last calculation are scanned again.
+     */
+    void CalculateFromLabelStatistics(const LabelSetImage *image);
+
   private:
     unsigned int m_Volume;
 
@@ -47,6 +47,7 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_TimeStep = timestep;
 
+  m_CompressedImageContainer.AdaptSettingsToImage(slice);
   m_CompressedImageContainer.CompressImage(slice);
 
   m_Image = imageVolume;
@@ -94,3 +95,18 @@ void mitk::DiffSliceOperation::OnImageDeleted()
   // if our imageVolume is removed e.g. from the datastorage the operation is no lnger valid
   m_ImageIsValid = false;
 }
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  return sizeof(DiffSliceOperation) - sizeof(CompressedImageContainer) + m_CompressedImageContainer.GetMemorySize();
+}
+
+bool mitk::DiffSliceOperation::SwapOut(std::ostream &stream)
+{
+  return m_CompressedImageContainer.SwapOut(stream);
+}
+
+void mitk::DiffSliceOperation::SwapIn(std::istream &stream)
+{
+  m_CompressedImageContainer.SwapIn(stream);
+}
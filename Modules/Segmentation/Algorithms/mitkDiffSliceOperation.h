@@ -73,6 +73,12 @@ namespace mitk
     const SlicedGeometry3D *GetSliceGeometry() const { return this->m_SliceGeometry; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     const BaseGeometry *GetWorldGeometry() const { return this->m_WorldGeometry; }
+
+    std::size_t GetMemorySize() const override;
+    /** \brief Swaps out the compressed slice.*/
+    bool SwapOut(std::ostream &stream) override;
+    void SwapIn(std::istream &stream) override;
+
   protected:
     ~DiffSliceOperation() override;
 
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkLabelSetImage.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
@@ -59,6 +60,7 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     extractor->SetVtkOutputRequest(true);
     extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
 
+    const auto mTimeBeforeWrite = imageOperation->GetImage()->GetMTime();
     extractor->Modified();
     extractor->Update();
 
@@ -66,6 +68,16 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     RenderingManager::GetInstance()->RequestUpdateAll();
     imageOperation->GetImage()->Modified();
 
+    // only the slices touched by the plane have to be rescanned for the label statistics
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (nullptr != labelSetImage)
+    {
+      labelSetImage->InvalidateLabelStatistics(
+        dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()),
+        imageOperation->GetTimeStep(),
+        mTimeBeforeWrite);
+    }
+
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
     extractor2->SetTimeStep(imageOperation->GetTimeStep());
@@ -27,6 +27,8 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  // mouse moves only change the end point, the path is then traced back in the search of the last update
+  m_ShortestPathFilter->SetReuseShortestPathTree(true);
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
 }
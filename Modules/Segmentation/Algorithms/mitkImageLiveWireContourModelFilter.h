@@ -39,6 +39,10 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   The features and local costs of the input slice are computed once and kept until the input or the cost map
+   changes. As long as the start point does not change, the shortest path tree of the last update is kept, so
+   moving the end point only traces the path back or continues the search up to the new end point.
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -595,6 +595,7 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   extractor->SetVtkOutputRequest(false);
   extractor->SetResliceTransformByGeometry(workingImage->GetGeometry(sliceInfo.timestep));
 
+  const auto mTimeBeforeWrite = workingImage->GetMTime();
   extractor->Modified();
   extractor->Update();
 
@@ -602,6 +603,13 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   workingImage->Modified();
   workingImage->GetVtkImageData()->Modified();
 
+  // only the slices touched by the plane have to be rescanned for the label statistics
+  auto* labelSetImage = dynamic_cast<LabelSetImage*>(workingImage);
+  if (nullptr != labelSetImage)
+  {
+    labelSetImage->InvalidateLabelStatistics(sliceInfo.plane, sliceInfo.timestep, mTimeBeforeWrite);
+  }
+
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
@@ -1,4 +1,5 @@
 set(MODULE_TESTS
+  mitkCalculateSegmentationVolumeTest.cpp
   mitkContourMapper2DTest.cpp
   mitkContourTest.cpp
   mitkContourModelSetToImageFilterTest.cpp
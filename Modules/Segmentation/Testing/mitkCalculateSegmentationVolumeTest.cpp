@@ -0,0 +1,126 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCalculateSegmentationVolume.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkProperties.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+namespace
+{
+  /** Runs the calculation in the calling thread instead of a separate one. */
+  class TestCalculateSegmentationVolume : public mitk::CalculateSegmentationVolume
+  {
+  public:
+    mitkClassMacro(TestCalculateSegmentationVolume, mitk::CalculateSegmentationVolume);
+    mitkAlgorithmNewMacro(TestCalculateSegmentationVolume);
+
+    bool Calculate() { return this->ThreadedUpdateFunction(); }
+  };
+}
+
+class mitkCalculateSegmentationVolumeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCalculateSegmentationVolumeTestSuite);
+  MITK_TEST(TestMultiLayerLabelSetImageMatchesPixelScan);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+
+  static void SetLabelPixel(mitk::Image *image, const itk::Index<3> &index, mitk::Label::PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    accessor.SetPixelByIndex(index, value);
+  }
+
+  static mitk::DataNode::Pointer Calculate(mitk::Image *image)
+  {
+    auto groupNode = mitk::DataNode::New();
+
+    auto algorithm = TestCalculateSegmentationVolume::New();
+    algorithm->SetPointerParameter("Input", image);
+    algorithm->SetPointerParameter("Group node", groupNode);
+    CPPUNIT_ASSERT_MESSAGE("Calculation failed", algorithm->Calculate());
+
+    return groupNode;
+  }
+
+  static void AssertEqualVectorProperty(const mitk::DataNode *expected, const mitk::DataNode *actual, const char *name)
+  {
+    auto expectedProperty = dynamic_cast<mitk::Vector3DProperty *>(expected->GetProperty(name));
+    auto actualProperty = dynamic_cast<mitk::Vector3DProperty *>(actual->GetProperty(name));
+    CPPUNIT_ASSERT_MESSAGE(std::string("Missing property ") + name, nullptr != expectedProperty && nullptr != actualProperty);
+    CPPUNIT_ASSERT_MESSAGE(std::string("Wrong ") + name,
+                           mitk::Equal(expectedProperty->GetValue(), actualProperty->GetValue(), 1e-6, true));
+  }
+
+public:
+  void setUp() override
+  {
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = { 20, 30, 10 };
+    regularImage->Initialize(mitk::MakeScalarPixelType<char>(), 3, dimensions);
+
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(regularImage);
+  }
+
+  void tearDown() override { m_LabelSetImage = nullptr; }
+
+  void TestMultiLayerLabelSetImageMatchesPixelScan()
+  {
+    auto label1 = mitk::Label::New();
+    label1->SetValue(1);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label1);
+    SetLabelPixel(m_LabelSetImage, { { 1, 1, 1 } }, 1);
+
+    const auto secondLayer = m_LabelSetImage->AddLayer();
+    auto label2 = mitk::Label::New();
+    label2->SetValue(2);
+    m_LabelSetImage->GetLabelSet(secondLayer)->AddLabel(label2);
+
+    // the active layer contains a label of its own label set and one of the first layer
+    SetLabelPixel(m_LabelSetImage, { { 2, 3, 4 } }, 2);
+    SetLabelPixel(m_LabelSetImage, { { 5, 6, 7 } }, 2);
+    SetLabelPixel(m_LabelSetImage, { { 10, 20, 8 } }, 1);
+    m_LabelSetImage->Modified();
+
+    // the pixel scan of a plain image with the same pixel data is the reference
+    mitk::Image::Pointer plainImage = mitk::Image::New();
+    plainImage->Initialize(m_LabelSetImage->GetPixelType(), 3, m_LabelSetImage->GetDimensions());
+    plainImage->SetClonedTimeGeometry(m_LabelSetImage->GetTimeGeometry());
+    {
+      mitk::ImageReadAccessor accessor(m_LabelSetImage.GetPointer());
+      plainImage->SetVolume(accessor.GetData());
+    }
+
+    auto expected = Calculate(plainImage);
+    auto actual = Calculate(m_LabelSetImage);
+
+    float expectedVolume = 0.0f;
+    float actualVolume = 0.0f;
+    CPPUNIT_ASSERT(expected->GetFloatProperty("volume", expectedVolume));
+    CPPUNIT_ASSERT(actual->GetFloatProperty("volume", actualVolume));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedVolume, actualVolume, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 / 1000.0, actualVolume, 1e-6);
+
+    AssertEqualVectorProperty(expected, actual, "centerOfMass");
+    AssertEqualVectorProperty(expected, actual, "boundingBoxMinimum");
+    AssertEqualVectorProperty(expected, actual, "boundingBoxMaximum");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCalculateSegmentationVolume)
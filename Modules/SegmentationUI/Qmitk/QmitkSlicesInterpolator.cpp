@@ -31,6 +31,7 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
 #include <mitkPlaneProposer.h>
 #include <mitkUnstructuredGridClusteringFilter.h>
 #include <mitkVtkImageOverwrite.h>
@@ -686,6 +687,7 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
     extractor->SetVtkOutputRequest(true);
     extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
 
+    const auto mTimeBeforeWrite = m_Segmentation->GetMTime();
     extractor->Modified();
     extractor->Update();
 
@@ -693,6 +695,12 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
     m_Segmentation->Modified();
     m_Segmentation->GetVtkImageData()->Modified();
 
+    auto* labelSetImage = dynamic_cast<mitk::LabelSetImage*>(m_Segmentation);
+    if (nullptr != labelSetImage)
+    {
+      labelSetImage->InvalidateLabelStatistics(m_LastSNC->GetCurrentPlaneGeometry(), timeStep, mTimeBeforeWrite);
+    }
+
     m_FeedbackNode->SetData(nullptr);
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
   }
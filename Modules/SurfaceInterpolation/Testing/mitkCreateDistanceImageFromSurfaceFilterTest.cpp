@@ -14,10 +14,22 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <itkImageRegionConstIterator.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,6 +38,8 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestPartitionOfUnitySolverForTube);
+  MITK_TEST(TestPartitionOfUnitySolverWithDuplicatedCenters);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -128,6 +142,179 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  mitk::Image::Pointer CreateTubeDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter::SolverType solver,
+                                               double &spacing,
+                                               mitk::Surface *additionalContour = nullptr)
+  {
+    mitk::Image::Pointer segmentationImage =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("SurfaceInterpolation/Reference/SegmentationWithHoles.nrrd"));
+
+    mitk::ComputeContourSetNormalsFilter::Pointer normalsFilter = mitk::ComputeContourSetNormalsFilter::New();
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+    interpolateSurfaceFilter->SetSolver(solver);
+
+    normalsFilter->SetSegmentationBinaryImage(segmentationImage);
+    itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+    AccessFixedDimensionByItk_1(segmentationImage, GetImageBase, 3, itkImage);
+    interpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      std::stringstream s;
+      s << "SurfaceInterpolation/InterpolateWithHoles/ContourWithHoles_" << i << ".vtk";
+      normalsFilter->SetInput(i, mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath(s.str())));
+      interpolateSurfaceFilter->SetInput(i, normalsFilter->GetOutput(i));
+    }
+
+    if (nullptr != additionalContour)
+      interpolateSurfaceFilter->SetInput(5, additionalContour);
+
+    interpolateSurfaceFilter->Update();
+    spacing = interpolateSurfaceFilter->GetDistanceImageSpacing();
+
+    return interpolateSurfaceFilter->GetOutput();
+  }
+
+  // The partition of unity solver has to reproduce the distance function of the dense solver
+  void TestPartitionOfUnitySolverForTube()
+  {
+    typedef mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType DistanceImageType;
+
+    double denseSpacing = 0.0;
+    double partitionOfUnitySpacing = 0.0;
+
+    mitk::Image::Pointer denseImage =
+      this->CreateTubeDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter::DENSE_SOLVER, denseSpacing);
+    mitk::Image::Pointer partitionOfUnityImage = this->CreateTubeDistanceImage(
+      mitk::CreateDistanceImageFromSurfaceFilter::PARTITION_OF_UNITY_SOLVER, partitionOfUnitySpacing);
+
+    CPPUNIT_ASSERT(partitionOfUnityImage.IsNotNull());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(denseSpacing, partitionOfUnitySpacing, mitk::eps);
+
+    DistanceImageType::Pointer dense;
+    DistanceImageType::Pointer partitionOfUnity;
+    mitk::CastToItkImage(denseImage, dense);
+    mitk::CastToItkImage(partitionOfUnityImage, partitionOfUnity);
+
+    CPPUNIT_ASSERT(dense->GetLargestPossibleRegion() == partitionOfUnity->GetLargestPossibleRegion());
+
+    itk::ImageRegionConstIterator<DistanceImageType> denseIt(dense, dense->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<DistanceImageType> partitionOfUnityIt(partitionOfUnity,
+                                                                        partitionOfUnity->GetLargestPossibleRegion());
+
+    // Within the narrow band both distance functions are evaluated, outside of it only the sign is set
+    const double narrowBand = 2 * denseSpacing;
+    std::size_t numberOfPixels = 0;
+    std::size_t numberOfDifferentSigns = 0;
+    std::size_t numberOfNarrowBandPixels = 0;
+    std::size_t numberOfDifferentSignsOffSurface = 0;
+    double sumOfDifferences = 0.0;
+    double maximumDifference = 0.0;
+
+    for (; !denseIt.IsAtEnd(); ++denseIt, ++partitionOfUnityIt)
+    {
+      ++numberOfPixels;
+      const bool differentSigns = (denseIt.Get() < 0) != (partitionOfUnityIt.Get() < 0);
+      if (differentSigns)
+        ++numberOfDifferentSigns;
+
+      if (std::fabs(denseIt.Get()) <= narrowBand && std::fabs(partitionOfUnityIt.Get()) <= narrowBand)
+      {
+        ++numberOfNarrowBandPixels;
+        const double difference = std::fabs(denseIt.Get() - partitionOfUnityIt.Get());
+        sumOfDifferences += difference;
+        maximumDifference = std::max(maximumDifference, difference);
+
+        if (differentSigns && std::fabs(denseIt.Get()) >= denseSpacing)
+          ++numberOfDifferentSignsOffSurface;
+      }
+    }
+
+    CPPUNIT_ASSERT(numberOfNarrowBandPixels > 0);
+    CPPUNIT_ASSERT_MESSAGE("Inside and outside agree for at least 99.5% of the pixels",
+                           numberOfDifferentSigns * 200 <= numberOfPixels);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Narrow band pixels at least one spacing away from the surface lie on the same side",
+                                 std::size_t(0), numberOfDifferentSignsOffSurface);
+    CPPUNIT_ASSERT_MESSAGE("Mean difference within the narrow band is below 15% of the spacing",
+                           sumOfDifferences / numberOfNarrowBandPixels < 0.15 * denseSpacing);
+    CPPUNIT_ASSERT_MESSAGE("Maximum difference within the narrow band is below the spacing",
+                           maximumDifference < denseSpacing);
+  }
+
+  // A single contour point without normal in the middle of a tube contour
+  mitk::Surface::Pointer CreateIsolatedContourPointWithoutNormal()
+  {
+    auto tubeContour =
+      mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath("SurfaceInterpolation/InterpolateWithHoles/ContourWithHoles_2.vtk"));
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->InsertNextPoint(tubeContour->GetVtkPolyData()->GetCenter());
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(1);
+    polys->InsertCellPoint(0);
+
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    normals->InsertNextTuple3(0.0, 0.0, 0.0);
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    auto contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  // Without a normal, the inner and outer centers of a contour point coincide with it, so its local
+  // equation system is singular. The point is also isolated, its patch holds too few centers by itself.
+  void TestPartitionOfUnitySolverWithDuplicatedCenters()
+  {
+    typedef mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType DistanceImageType;
+
+    double spacing = 0.0;
+    double referenceSpacing = 0.0;
+
+    mitk::Image::Pointer referenceImage = this->CreateTubeDistanceImage(
+      mitk::CreateDistanceImageFromSurfaceFilter::PARTITION_OF_UNITY_SOLVER, referenceSpacing);
+    mitk::Image::Pointer distanceImage =
+      this->CreateTubeDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter::PARTITION_OF_UNITY_SOLVER,
+                                    spacing,
+                                    this->CreateIsolatedContourPointWithoutNormal());
+
+    CPPUNIT_ASSERT(distanceImage.IsNotNull());
+
+    DistanceImageType::Pointer reference;
+    DistanceImageType::Pointer distance;
+    mitk::CastToItkImage(referenceImage, reference);
+    mitk::CastToItkImage(distanceImage, distance);
+
+    CPPUNIT_ASSERT(reference->GetLargestPossibleRegion() == distance->GetLargestPossibleRegion());
+
+    itk::ImageRegionConstIterator<DistanceImageType> referenceIt(reference, reference->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<DistanceImageType> distanceIt(distance, distance->GetLargestPossibleRegion());
+
+    std::size_t numberOfPixels = 0;
+    std::size_t numberOfNonFinitePixels = 0;
+    std::size_t numberOfDifferentSigns = 0;
+
+    for (; !distanceIt.IsAtEnd(); ++distanceIt, ++referenceIt)
+    {
+      ++numberOfPixels;
+      if (!std::isfinite(distanceIt.Get()))
+        ++numberOfNonFinitePixels;
+      else if ((distanceIt.Get() < 0) != (referenceIt.Get() < 0))
+        ++numberOfDifferentSigns;
+    }
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Distance values are finite", std::size_t(0), numberOfNonFinitePixels);
+    CPPUNIT_ASSERT_MESSAGE("The isolated point changes the inside and outside of at most 1% of the pixels",
+                           numberOfDifferentSigns * 100 <= numberOfPixels);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -20,9 +20,30 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <queue>
+#include <unordered_set>
+
+namespace
+{
+  /** Smallest number of centers a local equation system of the partition of unity solver is fitted to. */
+  const std::size_t MINIMUM_NUMBER_OF_PATCH_CENTERS = 24;
+
+  /** Wendland's C2 function, compactly supported on [0, 1] and positive definite in 3D. */
+  double WendlandWeight(double r)
+  {
+    if (r >= 1.0)
+      return 0.0;
+
+    const double t = 1.0 - r;
+    return t * t * t * t * (4.0 * r + 1.0);
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,8 +126,15 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_CellSize(0.0),
+    m_PatchRadius(0.0),
+    m_Solver(DENSE_SOLVER),
+    m_PointsPerPatch(64),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
+  m_GridSize[0] = m_GridSize[1] = m_GridSize[2] = 0;
+
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 5;
@@ -130,7 +158,14 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_Solver == PARTITION_OF_UNITY_SOLVER)
+  {
+    this->CreatePartitionOfUnityPatches();
+  }
+  else
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -143,6 +178,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_Patches.clear();
+  m_CellPatches.clear();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -264,6 +301,10 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   // Now we have created all centers and all function values. Next step is to create the solution matrix
   numberOfCenters = m_Centers.size();
 
+  // The partition of unity solver sets up its local equation systems itself
+  if (m_Solver == PARTITION_OF_UNITY_SOLVER)
+    return;
+
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
   m_Weights.resize(numberOfCenters);
@@ -421,6 +462,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
 
 double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
 {
+  if (m_Solver == PARTITION_OF_UNITY_SOLVER)
+    return this->CalculatePartitionOfUnityDistanceValue(p);
+
   double distanceValue(0);
   PointType p1;
   PointType p2;
@@ -440,6 +484,243 @@ double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointT
   return distanceValue;
 }
 
+double mitk::CreateDistanceImageFromSurfaceFilter::DetermineCellSize(const PointType &minPoint,
+                                                                     const PointType &maxPoint) const
+{
+  const PointType extent = maxPoint - minPoint;
+
+  // Cells must not be smaller than the narrow band that FillDistanceImage() evaluates. The relative
+  // lower bound limits the number of cells per axis, the absolute one covers a degenerated extent
+  // and spacing (all centers in one point).
+  const double minCellSize = std::max({ 2 * m_DistanceImageSpacing, 1e-3 * extent.max_value(), 1e-6 });
+  const double pointsPerPatch = std::max(1u, m_PointsPerPatch);
+
+  double cellSize = std::max(extent.max_value(), minCellSize);
+
+  // Halve the cell size until the occupied cells hold about pointsPerPatch centers on average
+  while (cellSize > minCellSize)
+  {
+    long long gridSize[3];
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      gridSize[dim] = static_cast<long long>(extent[dim] / cellSize) + 1;
+
+    std::unordered_set<long long> occupiedCells;
+    for (const auto &center : m_Centers)
+    {
+      long long cell[3];
+      for (unsigned int dim = 0; dim < 3; ++dim)
+        cell[dim] = std::min(static_cast<long long>((center[dim] - minPoint[dim]) / cellSize), gridSize[dim] - 1);
+
+      occupiedCells.insert(cell[0] + gridSize[0] * (cell[1] + gridSize[1] * cell[2]));
+    }
+
+    if (m_Centers.size() <= pointsPerPatch * occupiedCells.size())
+      break;
+
+    cellSize = std::max(0.5 * cellSize, minCellSize);
+  }
+
+  return cellSize;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreatePartitionOfUnityPatches()
+{
+  m_Patches.clear();
+  m_CellPatches.clear();
+
+  const unsigned int numberOfCenters = m_Centers.size();
+
+  PointType minPoint = m_Centers.at(0);
+  PointType maxPoint = m_Centers.at(0);
+  for (const auto &center : m_Centers)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minPoint[dim] = std::min(minPoint[dim], center[dim]);
+      maxPoint[dim] = std::max(maxPoint[dim], center[dim]);
+    }
+  }
+
+  m_CellSize = this->DetermineCellSize(minPoint, maxPoint);
+
+  // Every point within the narrow band (2 * spacing) around a center must be covered by the patch
+  // of the center's cell, so the patch radius exceeds half of the cell diagonal by a margin
+  m_PatchRadius = 0.5 * std::sqrt(3.0) * m_CellSize + 4 * m_DistanceImageSpacing;
+
+  m_GridOrigin = minPoint;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    m_GridSize[dim] = static_cast<int>((maxPoint[dim] - minPoint[dim]) / m_CellSize) + 1;
+
+  auto cellOf = [this](const PointType &p, unsigned int dim) {
+    return std::min(static_cast<int>((p[dim] - m_GridOrigin[dim]) / m_CellSize), m_GridSize[dim] - 1);
+  };
+
+  // Sort the centers by their cells. Most cells of the bounding box are empty, so only the occupied
+  // cells are stored, each with the range of its centers in sortedCenters.
+  std::vector<std::pair<std::size_t, unsigned int>> sortedCenters(numberOfCenters);
+  for (unsigned int i = 0; i < numberOfCenters; ++i)
+  {
+    const PointType &center = m_Centers[i];
+    sortedCenters[i] = std::make_pair(this->GetLinearCellIndex(cellOf(center, 0), cellOf(center, 1), cellOf(center, 2)), i);
+  }
+
+  std::sort(sortedCenters.begin(), sortedCenters.end());
+
+  struct OccupiedCell
+  {
+    std::size_t cellIndex;
+    unsigned int begin;
+    unsigned int end;
+  };
+
+  std::vector<OccupiedCell> occupiedCells;
+  std::unordered_map<std::size_t, std::size_t> occupiedCellIds;
+  for (unsigned int begin = 0, end = 0; begin < numberOfCenters; begin = end)
+  {
+    while (end < numberOfCenters && sortedCenters[end].first == sortedCenters[begin].first)
+      ++end;
+
+    occupiedCellIds.emplace(sortedCenters[begin].first, occupiedCells.size());
+    occupiedCells.push_back({ sortedCenters[begin].first, begin, end });
+  }
+
+  // Create one patch per occupied cell and collect the centers within the patch radius
+  m_Patches.reserve(occupiedCells.size());
+  m_CellPatches.reserve(occupiedCells.size());
+  const int range = static_cast<int>(std::ceil(m_PatchRadius / m_CellSize + 0.5));
+  const double squaredRadius = m_PatchRadius * m_PatchRadius;
+
+  for (const auto &cell : occupiedCells)
+  {
+    const int x = static_cast<int>(cell.cellIndex % m_GridSize[0]);
+    const int y = static_cast<int>((cell.cellIndex / m_GridSize[0]) % m_GridSize[1]);
+    const int z = static_cast<int>(cell.cellIndex / (static_cast<std::size_t>(m_GridSize[0]) * m_GridSize[1]));
+
+    Patch patch;
+    patch.center[0] = m_GridOrigin[0] + (x + 0.5) * m_CellSize;
+    patch.center[1] = m_GridOrigin[1] + (y + 0.5) * m_CellSize;
+    patch.center[2] = m_GridOrigin[2] + (z + 0.5) * m_CellSize;
+
+    for (int nz = std::max(0, z - range); nz <= std::min(m_GridSize[2] - 1, z + range); ++nz)
+    {
+      for (int ny = std::max(0, y - range); ny <= std::min(m_GridSize[1] - 1, y + range); ++ny)
+      {
+        for (int nx = std::max(0, x - range); nx <= std::min(m_GridSize[0] - 1, x + range); ++nx)
+        {
+          const auto neighbor = occupiedCellIds.find(this->GetLinearCellIndex(nx, ny, nz));
+          if (neighbor == occupiedCellIds.end())
+            continue;
+
+          const OccupiedCell &neighborCell = occupiedCells[neighbor->second];
+          for (unsigned int k = neighborCell.begin; k < neighborCell.end; ++k)
+          {
+            const unsigned int centerId = sortedCenters[k].second;
+            if ((m_Centers[centerId] - patch.center).squared_magnitude() < squaredRadius)
+              patch.centerIds.push_back(centerId);
+          }
+        }
+      }
+    }
+
+    // An isolated contour point yields a patch whose interpolant is barely determined. The patch is
+    // merged with its neighbourhood by fitting it to the nearest centers instead, which amounts to
+    // the global solve if there are only a few centers in total.
+    if (patch.centerIds.size() < MINIMUM_NUMBER_OF_PATCH_CENTERS)
+    {
+      std::vector<unsigned int> nearestCenterIds(numberOfCenters);
+      std::iota(nearestCenterIds.begin(), nearestCenterIds.end(), 0u);
+
+      const auto numberOfNearestCenters = std::min<std::size_t>(MINIMUM_NUMBER_OF_PATCH_CENTERS, numberOfCenters);
+      std::partial_sort(nearestCenterIds.begin(),
+                        nearestCenterIds.begin() + numberOfNearestCenters,
+                        nearestCenterIds.end(),
+                        [this, &patch](unsigned int a, unsigned int b) {
+                          return (m_Centers[a] - patch.center).squared_magnitude() <
+                                 (m_Centers[b] - patch.center).squared_magnitude();
+                        });
+
+      nearestCenterIds.resize(numberOfNearestCenters);
+      patch.centerIds = std::move(nearestCenterIds);
+    }
+
+    m_CellPatches.emplace(cell.cellIndex, static_cast<unsigned int>(m_Patches.size()));
+    m_Patches.push_back(std::move(patch));
+  }
+
+  // The local equation systems are independent of each other
+  auto solvePatch = [this](itk::SizeValueType patchIndex) {
+    Patch &patch = m_Patches[patchIndex];
+    const auto numberOfPatchCenters = static_cast<Eigen::Index>(patch.centerIds.size());
+
+    Eigen::MatrixXd solutionMatrix(numberOfPatchCenters, numberOfPatchCenters);
+    Eigen::VectorXd functionValues(numberOfPatchCenters);
+
+    for (Eigen::Index i = 0; i < numberOfPatchCenters; ++i)
+    {
+      const PointType &p1 = m_Centers[patch.centerIds[i]];
+      functionValues[i] = m_FunctionValues[patch.centerIds[i]];
+
+      for (Eigen::Index j = 0; j < numberOfPatchCenters; ++j)
+        solutionMatrix(i, j) = (p1 - m_Centers[patch.centerIds[j]]).two_norm();
+    }
+
+    // Duplicated centers (e.g. of a contour point without normal) make the system singular. Unlike
+    // the LU decomposition, the rank revealing QR decomposition still yields finite weights then.
+    patch.weights = solutionMatrix.colPivHouseholderQr().solve(functionValues);
+  };
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, m_Patches.size(), solvePatch, nullptr);
+}
+
+std::size_t mitk::CreateDistanceImageFromSurfaceFilter::GetLinearCellIndex(int x, int y, int z) const
+{
+  return static_cast<std::size_t>(x) +
+         m_GridSize[0] * (static_cast<std::size_t>(y) + m_GridSize[1] * static_cast<std::size_t>(z));
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculatePartitionOfUnityDistanceValue(const PointType &p) const
+{
+  int cell[3];
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    cell[dim] = static_cast<int>(std::floor((p[dim] - m_GridOrigin[dim]) / m_CellSize));
+
+  const int range = static_cast<int>(std::ceil(m_PatchRadius / m_CellSize + 0.5));
+
+  double weightedDistance = 0.0;
+  double sumOfWeights = 0.0;
+
+  for (int z = std::max(0, cell[2] - range); z <= std::min(m_GridSize[2] - 1, cell[2] + range); ++z)
+  {
+    for (int y = std::max(0, cell[1] - range); y <= std::min(m_GridSize[1] - 1, cell[1] + range); ++y)
+    {
+      for (int x = std::max(0, cell[0] - range); x <= std::min(m_GridSize[0] - 1, cell[0] + range); ++x)
+      {
+        const auto patchIndex = m_CellPatches.find(this->GetLinearCellIndex(x, y, z));
+        if (patchIndex == m_CellPatches.end())
+          continue;
+
+        const Patch &patch = m_Patches[patchIndex->second];
+        const double weight = WendlandWeight((p - patch.center).two_norm() / m_PatchRadius);
+        if (weight <= 0.0)
+          continue;
+
+        double localDistance = 0.0;
+        for (std::size_t i = 0; i < patch.centerIds.size(); ++i)
+          localDistance += (p - m_Centers[patch.centerIds[i]]).two_norm() * patch.weights[i];
+
+        weightedDistance += weight * localDistance;
+        sumOfWeights += weight;
+      }
+    }
+  }
+
+  // Points that are not covered by any patch are far away from all contours
+  if (sumOfWeights <= 0.0)
+    return m_DistanceImageDefaultBufferValue;
+
+  return weightedDistance / sumOfWeights;
+}
+
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
 {
 }
@@ -25,6 +25,8 @@ found in the LICENSE file.
 
 #include <Eigen/Dense>
 
+#include <unordered_map>
+
 namespace mitk
 {
   /**
@@ -57,6 +59,16 @@ namespace mitk
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
   by the image.
 
+         Two engines are available to solve for and evaluate the distance function (see SetSolver()):
+         - DENSE_SOLVER (default): one global interpolant with Phi(r) = r. The complete equation system is solved
+  with a dense LU decomposition and every evaluation sums over all centers.
+         - PARTITION_OF_UNITY_SOLVER: the bounding box of the centers is divided into cubic cells. Each cell
+  containing centers gets a local interpolant (same basis function) that is fitted to the centers within the
+  patch radius around the cell. The local interpolants are blended with compactly supported Wendland weights,
+  so the equation systems stay small and an evaluation only visits the patches of neighbouring cells. A patch
+  with too few centers is fitted to the nearest centers instead, and the local systems are solved with a
+  column pivoting QR decomposition, which tolerates duplicated centers.
+
   \ingroup Process
 
   $Author: fetzer$
@@ -74,6 +86,12 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    enum SolverType
+    {
+      DENSE_SOLVER = 0,
+      PARTITION_OF_UNITY_SOLVER = 1
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,6 +117,17 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /** \brief Selects the engine used to solve for and evaluate the distance function. Default is DENSE_SOLVER. */
+    itkSetMacro(Solver, SolverType);
+    itkGetMacro(Solver, SolverType);
+
+    /**
+    \brief Average number of centers per cell that the PARTITION_OF_UNITY_SOLVER aims at when choosing
+           its cell size. Smaller values result in more, but smaller local equation systems. Default is 64.
+    */
+    itkSetMacro(PointsPerPatch, unsigned int);
+    itkGetMacro(PointsPerPatch, unsigned int);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -130,6 +159,21 @@ namespace mitk
     void CreateSolutionMatrixAndFunctionValues();
     double CalculateDistanceValue(PointType p);
 
+    /**
+    * \brief Builds the cell grid of the PARTITION_OF_UNITY_SOLVER and solves the
+    * local equation system of every patch.
+    */
+    void CreatePartitionOfUnityPatches();
+    double CalculatePartitionOfUnityDistanceValue(const PointType &p) const;
+    std::size_t GetLinearCellIndex(int x, int y, int z) const;
+
+    /**
+    * \brief Chooses the cell size so that cells hold about m_PointsPerPatch centers on average.
+    * The cell size is never below the narrow band width (2 * spacing) and never below
+    * 1/1000 of the extent of the centers.
+    */
+    double DetermineCellSize(const PointType &minPoint, const PointType &maxPoint) const;
+
     void FillDistanceImage();
 
     /**
@@ -162,6 +206,24 @@ namespace mitk
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    // Datastructures of the partition of unity solver
+    struct Patch
+    {
+      PointType center;
+      std::vector<unsigned int> centerIds;
+      Eigen::VectorXd weights;
+    };
+
+    std::vector<Patch> m_Patches;
+    std::unordered_map<std::size_t, unsigned int> m_CellPatches; // index into m_Patches for every occupied cell
+    PointType m_GridOrigin;
+    int m_GridSize[3];
+    double m_CellSize;
+    double m_PatchRadius;
+
+    SolverType m_Solver;
+    unsigned int m_PointsPerPatch;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
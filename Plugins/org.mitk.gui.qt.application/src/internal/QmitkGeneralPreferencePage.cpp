@@ -14,18 +14,44 @@ found in the LICENSE file.
 
 #include "QmitkDataNodeGlobalReinitAction.h"
 
+#include <mitkUndoController.h>
+
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
+
+#include <algorithm>
 
 #include <berryIPreferencesService.h>
 #include <berryPlatform.h>
 
+namespace
+{
+  const QString UndoPreferencesNodeName = "/org.mitk.undo";
+  const QString UndoMemoryLimitKey = "Undo memory limit (MB)";
+  const QString UndoSwappingKey = "Swap undo history to disk";
+
+  berry::IPreferences::Pointer GetUndoPreferences()
+  {
+    return berry::Platform::GetPreferencesService()->GetSystemPreferences()->Node(UndoPreferencesNodeName);
+  }
+}
+
 QmitkGeneralPreferencePage::QmitkGeneralPreferencePage()
   : m_MainControl(nullptr)
 {
   // nothing here
 }
 
+void QmitkGeneralPreferencePage::ApplyUndoPreferences()
+{
+  auto undoPreferences = GetUndoPreferences();
+  const auto memoryLimit = std::max(0, undoPreferences->GetInt(UndoMemoryLimitKey, 0));
+
+  mitk::UndoController::SetUndoMemoryLimit(static_cast<std::size_t>(memoryLimit) * 1024 * 1024,
+                                           undoPreferences->GetBool(UndoSwappingKey, false));
+}
+
 void QmitkGeneralPreferencePage::Init(berry::IWorkbench::Pointer)
 {
   // nothing here
@@ -35,15 +61,26 @@ void QmitkGeneralPreferencePage::CreateQtControl(QWidget* parent)
 {
   berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
   m_GeneralPreferencesNode = prefService->GetSystemPreferences()->Node(QmitkDataNodeGlobalReinitAction::ACTION_ID);
+  m_UndoPreferencesNode = GetUndoPreferences();
 
   m_MainControl = new QWidget(parent);
 
   m_GlobalReinitOnNodeDelete = new QCheckBox;
   m_GlobalReinitOnNodeVisibilityChanged = new QCheckBox;
 
+  m_UndoMemoryLimit = new QSpinBox;
+  m_UndoMemoryLimit->setRange(0, 1024 * 1024);
+  m_UndoMemoryLimit->setSuffix(" MB");
+  m_UndoMemoryLimit->setSpecialValueText("Unlimited");
+  m_UndoMemoryLimit->setToolTip("The oldest undo steps are swapped to disk or dropped if the undo history exceeds this limit.");
+
+  m_UndoSwapping = new QCheckBox;
+
   auto formLayout = new QFormLayout;
   formLayout->addRow("&Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete);
   formLayout->addRow("&Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged);
+  formLayout->addRow("&Undo memory limit", m_UndoMemoryLimit);
+  formLayout->addRow("&Swap undo history to disk instead of dropping it", m_UndoSwapping);
 
   m_MainControl->setLayout(formLayout);
   Update();
@@ -59,6 +96,10 @@ bool QmitkGeneralPreferencePage::PerformOk()
   m_GeneralPreferencesNode->PutBool("Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete->isChecked());
   m_GeneralPreferencesNode->PutBool("Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged->isChecked());
 
+  m_UndoPreferencesNode->PutInt(UndoMemoryLimitKey, m_UndoMemoryLimit->value());
+  m_UndoPreferencesNode->PutBool(UndoSwappingKey, m_UndoSwapping->isChecked());
+  ApplyUndoPreferences();
+
   return true;
 }
 
@@ -71,4 +112,6 @@ void QmitkGeneralPreferencePage::Update()
 {
   m_GlobalReinitOnNodeDelete->setChecked(m_GeneralPreferencesNode->GetBool("Call global reinit if node is deleted", true));
   m_GlobalReinitOnNodeVisibilityChanged->setChecked(m_GeneralPreferencesNode->GetBool("Call global reinit if node visibility is changed", false));
+  m_UndoMemoryLimit->setValue(m_UndoPreferencesNode->GetInt(UndoMemoryLimitKey, 0));
+  m_UndoSwapping->setChecked(m_UndoPreferencesNode->GetBool(UndoSwappingKey, false));
 }
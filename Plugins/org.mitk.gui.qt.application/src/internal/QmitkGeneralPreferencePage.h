@@ -18,6 +18,7 @@ found in the LICENSE file.
 
 class QWidget;
 class QCheckBox;
+class QSpinBox;
 
 class QmitkGeneralPreferencePage : public QObject, public berry::IQtPreferencePage
 {
@@ -28,6 +29,13 @@ public:
 
   QmitkGeneralPreferencePage();
 
+  /**
+  * @brief Passes the undo memory limit and swapping of the preferences to the UndoController.
+  *
+  * Called when the plugin is started and when the preferences are accepted.
+  */
+  static void ApplyUndoPreferences();
+
   /**
   * @see berry::IPreferencePage::Init(berry::IWorkbench::Pointer workbench)
   */
@@ -64,8 +72,11 @@ protected:
 
     QCheckBox* m_GlobalReinitOnNodeDelete;
     QCheckBox* m_GlobalReinitOnNodeVisibilityChanged;
+    QSpinBox* m_UndoMemoryLimit;
+    QCheckBox* m_UndoSwapping;
 
     berry::IPreferences::Pointer m_GeneralPreferencesNode;
+    berry::IPreferences::Pointer m_UndoPreferencesNode;
 };
 
 #endif // QMITKGENERALPREFERENCEPAGE_H
@@ -38,6 +38,8 @@ namespace mitk
 
     this->m_PrefServiceTracker.reset(new ctkServiceTracker<berry::IPreferencesService*>(context));
     this->m_PrefServiceTracker->open();
+
+    QmitkGeneralPreferencePage::ApplyUndoPreferences();
   }
 
   void org_mitk_gui_qt_application_Activator::stop(ctkPluginContext* context)
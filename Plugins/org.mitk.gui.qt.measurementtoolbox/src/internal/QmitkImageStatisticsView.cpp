@@ -83,6 +83,7 @@ void QmitkImageStatisticsView::CreateQtPartControl(QWidget *parent)
 
   this->m_TimePointChangeListener.RenderWindowPartActivated(this->GetRenderWindowPart());
   connect(&m_TimePointChangeListener, &QmitkSliceNavigationListener::SelectedTimePointChanged, this, & QmitkImageStatisticsView::OnSelectedTimePointChanged);
+  m_DataGenerator->SetTimePoint(m_TimePointChangeListener.GetCurrentSelectedTimePoint());
 }
 
 void QmitkImageStatisticsView::RenderWindowPartActivated(mitk::IRenderWindowPart* renderWindowPart)
@@ -269,8 +270,9 @@ void QmitkImageStatisticsView::OnGenerationFinished()
   this->UpdateHistogramWidget();
 }
 
-void QmitkImageStatisticsView::OnSelectedTimePointChanged(const mitk::TimePointType& /*newTimePoint*/)
+void QmitkImageStatisticsView::OnSelectedTimePointChanged(const mitk::TimePointType& newTimePoint)
 {
+  m_DataGenerator->SetTimePoint(newTimePoint);
   this->UpdateHistogramWidget();
 }
 